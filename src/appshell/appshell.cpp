@@ -329,9 +329,11 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     bool forceMode = task.params[CommandLineController::ParamKey::ForceMode].toBool();
 
     switch (task.type) {
-    case CommandLineController::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
-        break;
+    case CommandLineController::ConvertType::Batch: {
+        size_t workersCount = task.params.value(CommandLineController::ParamKey::WorkersCount, 1).toUInt();
+        io::path_t reportPath = task.params[CommandLineController::ParamKey::JobReportPath].toString();
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, workersCount, reportPath);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
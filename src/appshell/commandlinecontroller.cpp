@@ -54,6 +54,9 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("workers", "Use with '-j <file>', number of worker processes converting the jobs concurrently",
+                                          "N"));
+    m_parser.addOption(QCommandLineOption("job-report", "Use with '-j <file>', write the results of the jobs to a JSON file", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -93,6 +96,9 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addOption(QCommandLineOption("gp-linked", "create tabulature linked staves for guitar pro"));
     m_parser.addOption(QCommandLineOption("gp-experimental", "experimental features for guitar pro import"));
 
+    m_parser.addOption(QCommandLineOption("musicxml-skip-validation",
+                                          "Don't validate the imported MusicXML files against the schema, for trusted sources"));
+
     //! NOTE Currently only implemented `full` mode
     m_parser.addOption(QCommandLineOption("migration", "Whether to do migration with given mode, `full` - full migration", "mode"));
 
@@ -218,6 +224,19 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("workers")) {
+            std::optional<int> val = intValue("workers");
+            if (val && val.value() > 0) {
+                m_converterTask.params[CommandLineController::ParamKey::WorkersCount] = val.value();
+            } else {
+                LOGE() << "Option: --workers not recognized workers count: " << m_parser.value("workers");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::JobReportPath] = m_parser.value("job-report");
+        }
     }
 
     if (m_parser.isSet("score-media")) {
@@ -353,6 +372,10 @@ void CommandLineController::apply()
         guitarProConfiguration()->setExperimental(true);
     }
 
+    if (m_parser.isSet("musicxml-skip-validation")) {
+        musicXmlConfiguration()->setMusicxmlImportValidation(false);
+    }
+
     if (application()->runMode() == IApplication::RunMode::Converter) {
         project::MigrationOptions migration;
         migration.appVersion = mu::engraving::MSCVERSION;
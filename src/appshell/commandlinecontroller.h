@@ -37,6 +37,7 @@
 #include "notation/inotationconfiguration.h"
 #include "project/iprojectconfiguration.h"
 #include "importexport/guitarpro/iguitarproconfiguration.h"
+#include "importexport/musicxml/imusicxmlconfiguration.h"
 
 namespace mu::appshell {
 class CommandLineController
@@ -52,6 +53,7 @@ class CommandLineController
     INJECT(appshell, notation::INotationConfiguration, notationConfiguration)
     INJECT(appshell, project::IProjectConfiguration, projectConfiguration)
     INJECT(appshell, iex::guitarpro::IGuitarProConfiguration, guitarProConfiguration);
+    INJECT(appshell, iex::musicxml::IMusicXmlConfiguration, musicXmlConfiguration);
 
 public:
     CommandLineController() = default;
@@ -75,6 +77,8 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        WorkersCount,
+        JobReportPath,
 
         // Video
     };
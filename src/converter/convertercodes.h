@@ -32,6 +32,8 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    BatchJobFailed = 1303,
+    BatchReportFailedWrite = 1304,
 
     ConvertTypeUnknown = 1310,
 
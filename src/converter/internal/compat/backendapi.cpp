@@ -520,6 +520,7 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
 Ret BackendApi::doExportScoreParts(const notation::INotationPtr notation, QIODevice& destinationDevice)
 {
     mu::engraving::MasterScore* score = notation->elements()->msScore()->masterScore();
+    score->loadExcerpts();
 
     QJsonArray partsObjList;
     QJsonArray partsMetaList;
@@ -569,6 +570,8 @@ Ret BackendApi::doExportScorePartsPdfs(const IMasterNotationPtr masterNotation,
     QJsonArray partsArray;
     QJsonArray partsNamesArray;
     for (IExcerptNotationPtr e : masterNotation->excerpts().val) {
+        e->ensureLoaded();
+
         QJsonValue partNameVal(e->name());
         partsNamesArray.append(partNameVal);
 
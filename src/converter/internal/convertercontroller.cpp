@@ -21,11 +21,19 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#include <QCoreApplication>
+#include <QEventLoop>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QProcess>
+#include <QTemporaryDir>
 
 #include "convertercodes.h"
 #include "stringutils.h"
@@ -40,7 +48,45 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
+//! NOTE Several chunks per worker, so that the workers finish at about the same time
+static constexpr size_t CHUNKS_PER_WORKER = 4;
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t elapsedMs(const Clock::time_point& start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+//! NOTE The worker gets all the options of the current process, except the ones set up for it separately
+static QStringList workerArguments(const QStringList& appArguments, const QString& batchJobFile, const QString& reportFile)
+{
+    static const QStringList OWN_OPTIONS { "-j", "--job", "--workers", "--job-report" };
+
+    QStringList result;
+    for (int i = 0; i < appArguments.size(); ++i) {
+        const QString& arg = appArguments.at(i);
+
+        if (OWN_OPTIONS.contains(arg)) {
+            ++i; // skip the value
+            continue;
+        }
+
+        bool isOwnOptionWithValue = std::any_of(OWN_OPTIONS.cbegin(), OWN_OPTIONS.cend(), [&arg](const QString& opt) {
+            return arg.startsWith(opt + "=");
+        });
+
+        if (!isOwnOptionWithValue) {
+            result << arg;
+        }
+    }
+
+    result << "-j" << batchJobFile << "--job-report" << reportFile;
+    return result;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
+                                          size_t workersCount, const io::path_t& reportPath)
 {
     TRACEFUNC;
 
@@ -50,16 +96,176 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
+    Clock::time_point start = Clock::now();
+
+    BatchResult result;
+    if (workersCount > 1 && batchJob.val.size() > 1) {
+        result = convertJobsInWorkers(batchJob.val, workersCount);
+    } else {
+        workersCount = 1;
+        result = convertJobs(batchJob.val, stylePath, forceMode);
+    }
+
+    int64_t durationMs = elapsedMs(start);
+
+    size_t failedCount = std::count_if(result.cbegin(), result.cend(), [](const JobResult& jobResult) {
+        return !jobResult.ret;
+    });
+
+    LOGI() << "converted " << result.size() - failedCount << " of " << result.size() << " jobs, "
+           << "workers: " << workersCount << ", duration: " << durationMs << " ms";
+
+    if (!reportPath.empty()) {
+        Ret ret = writeBatchReport(reportPath, result, workersCount, durationMs);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+            LOGE() << "failed write batch report, err: " << ret.toString() << ", path: " << reportPath;
+            return ret;
         }
     }
 
-    return ret;
+    return failedCount == 0 ? make_ret(Ret::Code::Ok) : make_ret(Err::BatchJobFailed);
+}
+
+ConverterController::BatchResult ConverterController::convertJobs(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    BatchResult result;
+    result.reserve(batchJob.size());
+
+    for (const Job& job : batchJob) {
+        Clock::time_point start = Clock::now();
+
+        JobResult jobResult;
+        jobResult.job = job;
+        jobResult.ret = fileConvert(job.in, job.out, stylePath, forceMode);
+        jobResult.durationMs = elapsedMs(start);
+
+        if (!jobResult.ret) {
+            LOGE() << "failed convert, err: " << jobResult.ret.toString() << ", in: " << job.in << ", out: " << job.out;
+        }
+
+        result.push_back(std::move(jobResult));
+    }
+
+    return result;
+}
+
+//! NOTE The engraving keeps a part of its state in static variables (the printing mode, the image store, etc.),
+//! so the scores can't be loaded and laid out concurrently in one process.
+//! Instead, the jobs are split into chunks, and every chunk is converted by a worker process,
+//! which is this application run in the batch mode.
+//! The worker loads the fonts, the instrument templates and the styles once for all the jobs of its chunk.
+ConverterController::BatchResult ConverterController::convertJobsInWorkers(const BatchJob& batchJob, size_t workersCount) const
+{
+    TRACEFUNC;
+
+    BatchResult result(batchJob.size());
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        result[i].job = batchJob[i];
+        result[i].ret = make_ret(Err::UnknownError, "not converted");
+    }
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temporary dir, err: " << tempDir.errorString();
+        return result;
+    }
+
+    struct Chunk {
+        size_t firstJob = 0;
+        size_t jobsCount = 0;
+        io::path_t jobFile;
+        io::path_t reportFile;
+    };
+
+    const size_t chunksCount = std::min(batchJob.size(), workersCount * CHUNKS_PER_WORKER);
+    std::vector<Chunk> chunks(chunksCount);
+
+    for (size_t i = 0; i < chunksCount; ++i) {
+        Chunk& chunk = chunks[i];
+        chunk.firstJob = batchJob.size() * i / chunksCount;
+        chunk.jobsCount = batchJob.size() * (i + 1) / chunksCount - chunk.firstJob;
+        chunk.jobFile = tempDir.filePath(QString("job-%1.json").arg(i));
+        chunk.reportFile = tempDir.filePath(QString("report-%1.json").arg(i));
+
+        BatchJob chunkJob(batchJob.begin() + chunk.firstJob, batchJob.begin() + chunk.firstJob + chunk.jobsCount);
+        Ret ret = writeBatchJob(chunk.jobFile, chunkJob);
+        if (!ret) {
+            LOGE() << "failed write batch job file, err: " << ret.toString() << ", path: " << chunk.jobFile;
+            return result;
+        }
+    }
+
+    auto collectChunk = [this, &result](const Chunk& chunk, size_t worker, const Ret& workerRet) {
+        RetVal<BatchResult> chunkResult = readBatchReport(chunk.reportFile);
+        bool hasReport = chunkResult.ret && chunkResult.val.size() == chunk.jobsCount;
+
+        for (size_t i = 0; i < chunk.jobsCount; ++i) {
+            JobResult& jobResult = result[chunk.firstJob + i];
+            jobResult.worker = worker;
+
+            if (hasReport) {
+                jobResult.ret = chunkResult.val[i].ret;
+                jobResult.durationMs = chunkResult.val[i].durationMs;
+            } else {
+                jobResult.ret = workerRet;
+            }
+        }
+    };
+
+    const QString program = QCoreApplication::applicationFilePath();
+    const QStringList appArguments = QCoreApplication::arguments().mid(1);
+
+    QEventLoop loop;
+    size_t nextChunk = 0;
+    size_t runningWorkers = 0;
+
+    std::function<void(size_t)> startNextChunk = [&](size_t worker) {
+        while (nextChunk < chunks.size()) {
+            const Chunk& chunk = chunks[nextChunk++];
+
+            QProcess* process = new QProcess();
+            process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+            QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                             [&, process, worker, chunk](int exitCode, QProcess::ExitStatus exitStatus) {
+                Ret workerRet = make_ret(Err::UnknownError, exitStatus == QProcess::CrashExit
+                                         ? "worker crashed"
+                                         : "worker failed, exit code: " + std::to_string(exitCode));
+                collectChunk(chunk, worker, workerRet);
+
+                process->deleteLater();
+                --runningWorkers;
+
+                startNextChunk(worker);
+            });
+
+            process->start(program, workerArguments(appArguments, chunk.jobFile.toQString(), chunk.reportFile.toQString()));
+            if (process->waitForStarted()) {
+                ++runningWorkers;
+                return;
+            }
+
+            LOGE() << "failed start worker, err: " << process->errorString();
+            collectChunk(chunk, worker, make_ret(Err::UnknownError, "failed start worker"));
+            delete process;
+        }
+
+        if (runningWorkers == 0) {
+            loop.quit();
+        }
+    };
+
+    for (size_t worker = 0; worker < workersCount; ++worker) {
+        startNextChunk(worker);
+    }
+
+    if (runningWorkers > 0) {
+        loop.exec();
+    }
+
+    return result;
 }
 
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
@@ -92,7 +298,7 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
         ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
     }
 
-    return make_ret(Ret::Code::Ok);
+    return ret;
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
@@ -165,6 +371,100 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+mu::Ret ConverterController::writeBatchJob(const io::path_t& batchJobFile, const BatchJob& batchJob) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = job.out.toQString();
+        arr << obj;
+    }
+
+    QFile file(batchJobFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchJobFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::BatchResult> ConverterController::readBatchReport(const io::path_t& reportPath) const
+{
+    RetVal<BatchResult> rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    const QJsonArray jobs = doc.object().value("jobs").toArray();
+    for (const QJsonValue v : jobs) {
+        QJsonObject obj = v.toObject();
+
+        JobResult jobResult;
+        jobResult.job.in = obj["in"].toString();
+        jobResult.job.out = obj["out"].toString();
+        jobResult.ret = Ret(obj["code"].toInt(), obj["error"].toString().toStdString());
+        jobResult.durationMs = static_cast<int64_t>(obj["durationMs"].toDouble());
+        jobResult.worker = obj["worker"].toInt();
+
+        rv.val.push_back(std::move(jobResult));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::writeBatchReport(const io::path_t& reportPath, const BatchResult& result, size_t workersCount,
+                                              int64_t durationMs) const
+{
+    QJsonArray jobs;
+    size_t failedCount = 0;
+
+    for (const JobResult& jobResult : result) {
+        QJsonObject obj;
+        obj["in"] = jobResult.job.in.toQString();
+        obj["out"] = jobResult.job.out.toQString();
+        obj["success"] = jobResult.ret.success();
+        obj["code"] = jobResult.ret.code();
+        obj["error"] = QString::fromStdString(jobResult.ret.text());
+        obj["durationMs"] = static_cast<qint64>(jobResult.durationMs);
+        obj["worker"] = static_cast<int>(jobResult.worker);
+        jobs << obj;
+
+        if (!jobResult.ret) {
+            ++failedCount;
+        }
+    }
+
+    QJsonObject report;
+    report["workers"] = static_cast<int>(workersCount);
+    report["durationMs"] = static_cast<qint64>(durationMs);
+    report["succeeded"] = static_cast<int>(result.size() - failedCount);
+    report["failed"] = static_cast<int>(failedCount);
+    report["jobs"] = jobs;
+
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchReportFailedWrite);
+    }
+
+    if (file.write(QJsonDocument(report).toJson()) == -1) {
+        return make_ret(Err::BatchReportFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
@@ -232,6 +532,7 @@ mu::Ret ConverterController::convertScorePartsToPdf(INotationWriterPtr writer, I
     notations.push_back(masterNotation->notation());
 
     for (IExcerptNotationPtr e : masterNotation->excerpts().val) {
+        e->ensureLoaded();
         notations.push_back(e->notation());
     }
 
@@ -267,6 +568,7 @@ mu::Ret ConverterController::convertScorePartsToPngs(INotationWriterPtr writer,
 
     INotationPtrList excerpts;
     for (IExcerptNotationPtr e : masterNotation->excerpts().val) {
+        e->ensureLoaded();
         excerpts.push_back(e->notation());
     }
 
@@ -22,7 +22,7 @@
 #ifndef MU_CONVERTER_CONVERTERCONTROLLER_H
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
-#include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -47,7 +47,8 @@ public:
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
-    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                     size_t workersCount = 1, const io::path_t& reportPath = io::path_t()) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -74,9 +75,25 @@ private:
         io::path_t out;
     };
 
-    using BatchJob = std::list<Job>;
+    using BatchJob = std::vector<Job>;
+
+    struct JobResult {
+        Job job;
+        Ret ret;
+        int64_t durationMs = 0;
+        size_t worker = 0;
+    };
+
+    using BatchResult = std::vector<JobResult>;
 
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
+    Ret writeBatchJob(const io::path_t& batchJobFile, const BatchJob& batchJob) const;
+
+    BatchResult convertJobs(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode);
+    BatchResult convertJobsInWorkers(const BatchJob& batchJob, size_t workersCount) const;
+
+    RetVal<BatchResult> readBatchReport(const io::path_t& reportPath) const;
+    Ret writeBatchReport(const io::path_t& reportPath, const BatchResult& result, size_t workersCount, int64_t durationMs) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "benchmarkutils.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/infrastructure/localfileinfoprovider.h"
+
+#include "libmscore/masterscore.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+QString benchmarks::dataRoot()
+{
+    return QString::fromUtf8(engraving_benchmarks_DATA_ROOT);
+}
+
+MasterScore* benchmarks::readScore(const QString& path)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(io::path_t(path)));
+
+    if (compat::loadMsczOrMscx(score, path, false) != Err::NoError) {
+        delete score;
+        return nullptr;
+    }
+
+    return score;
+}
+
+void benchmarks::layoutScore(MasterScore* score)
+{
+    for (Score* s : score->scoreList()) {
+        s->doLayout();
+    }
+}
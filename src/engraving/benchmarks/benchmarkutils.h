@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_BENCHMARKUTILS_H
+#define MU_ENGRAVING_BENCHMARKUTILS_H
+
+#include <QString>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mu::engraving {
+class MasterScore;
+}
+
+namespace mu::engraving::benchmarks {
+using Durations = std::vector<double>;
+
+//! NOTE Milliseconds
+inline double measure(const std::function<void()>& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! NOTE The root of the engraving test data
+QString dataRoot();
+
+MasterScore* readScore(const QString& path);
+void layoutScore(MasterScore* score);
+
+//! NOTE The durations in ms of one run of a micro benchmark by the measured operations,
+//! e.g. { "build": 1.2, "query": 3.4 }
+using Measurements = std::map<std::string, double>;
+
+//! NOTE Micro benchmarks time a single component, e.g. a lookup structure or a scheduler,
+//! they return false if the component gave wrong results
+struct MicroBenchmark {
+    std::string name;
+    std::function<bool(Measurements&)> run;
+};
+
+std::vector<MicroBenchmark> microBenchmarks();
+}
+
+#endif // MU_ENGRAVING_BENCHMARKUTILS_H
@@ -0,0 +1,602 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QGuiApplication>
+#include <QBuffer>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPdfWriter>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "framework/global/runtime.h"
+#include "testing/environment.h"
+
+#include "draw/drawmodule.h"
+#include "fonts/fontsmodule.h"
+#include "engraving/engravingmodule.h"
+
+#include "io/buffer.h"
+
+#include "engraving/compat/writescorehook.h"
+#include "engraving/infrastructure/paint.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/factory.h"
+#include "libmscore/instrtemplate.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscore.h"
+#include "libmscore/note.h"
+#include "libmscore/page.h"
+#include "libmscore/segment.h"
+#include "libmscore/stafftext.h"
+#include "libmscore/undo.h"
+
+#include "imagesexport/internal/svggenerator.h"
+
+#include "benchmarkutils.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::benchmarks;
+
+//! NOTE Times the main engraving operations over a corpus of scores and writes the results as JSON,
+//! so that the numbers of different builds can be compared with each other.
+//! Usage: engraving_benchmarks [--repeat N] [--output report.json] [--no-export] [--no-corpus] [--no-micro]
+//!                             [score or directory ...]
+//! Without scores the test data of the engraving (compat 114/206 and current format scores) is used.
+//! The micro benchmarks (see microbenchmarks.cpp) time single components on the test data
+
+static constexpr int EXPORT_DPI = 300;
+
+//---------------------------------------------------------
+//   Options
+//---------------------------------------------------------
+
+struct Options {
+    int repeat = 3;
+    bool exportEnabled = true;
+    bool corpusEnabled = true;
+    bool microEnabled = true;
+    QString outputPath;
+    QStringList inputs;
+};
+
+static Options parseOptions(const QStringList& args)
+{
+    Options opt;
+
+    for (int i = 1; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--repeat" && i + 1 < args.size()) {
+            opt.repeat = std::max(1, args.at(++i).toInt());
+        } else if (arg == "--output" && i + 1 < args.size()) {
+            opt.outputPath = args.at(++i);
+        } else if (arg == "--no-export") {
+            opt.exportEnabled = false;
+        } else if (arg == "--no-corpus") {
+            opt.corpusEnabled = false;
+        } else if (arg == "--no-micro") {
+            opt.microEnabled = false;
+        } else {
+            opt.inputs << arg;
+        }
+    }
+
+    if (opt.inputs.isEmpty()) {
+        const QString root = dataRoot();
+        opt.inputs << root + "/compat114_data"
+                   << root + "/compat206_data"
+                   << root + "/all_elements_data"
+                   << root + "/concertpitch_data";
+    }
+
+    return opt;
+}
+
+static QStringList scoreFiles(const QStringList& inputs)
+{
+    QStringList files;
+
+    for (const QString& input : inputs) {
+        if (QFileInfo(input).isDir()) {
+            QStringList dirFiles;
+            QDirIterator it(input, { "*.mscz", "*.mscx" }, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                QString file = it.next();
+
+                //! NOTE The references of the tests are the expected results in the current format, not the input
+                if (!QFileInfo(file).completeBaseName().endsWith("-ref")) {
+                    dirFiles << file;
+                }
+            }
+            dirFiles.sort();
+            files << dirFiles;
+        } else {
+            files << input;
+        }
+    }
+
+    return files;
+}
+
+//---------------------------------------------------------
+//   Measurement
+//---------------------------------------------------------
+
+static double median(Durations values)
+{
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+static QJsonObject statistic(const Durations& values)
+{
+    QJsonObject obj;
+    if (values.empty()) {
+        return obj;
+    }
+
+    double sum = 0;
+    for (double v : values) {
+        sum += v;
+    }
+
+    obj["runs"] = static_cast<int>(values.size());
+    obj["min_ms"] = *std::min_element(values.begin(), values.end());
+    obj["median_ms"] = median(values);
+    obj["mean_ms"] = sum / values.size();
+    obj["max_ms"] = *std::max_element(values.begin(), values.end());
+    return obj;
+}
+
+//---------------------------------------------------------
+//   Score helpers
+//---------------------------------------------------------
+
+static std::string readerName(int mscVersion)
+{
+    if (mscVersion <= 114) {
+        return "read114";
+    } else if (mscVersion <= 207) {
+        return "read206";
+    } else if (mscVersion < 400) {
+        return "read302";
+    }
+
+    return "read400";
+}
+
+//! NOTE The edits are done in the middle of the score, so that the layout has work to do on both sides
+static Chord* middleChord(MasterScore* score)
+{
+    Chord* result = nullptr;
+    const size_t middle = score->nmeasures() / 2;
+    size_t index = 0;
+
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure(), ++index) {
+        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            EngravingItem* e = s->element(0);
+            if (e && e->isChord()) {
+                result = toChord(e);
+                break;
+            }
+        }
+
+        if (result && index >= middle) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   Edits
+//    every edit is one undoable command, the time includes the incremental layout of endCmd()
+//---------------------------------------------------------
+
+struct Edit {
+    std::string name;
+    std::function<bool(MasterScore*)> apply;
+};
+
+static std::vector<Edit> edits()
+{
+    return {
+        { "edit_pitch", [](MasterScore* score) {
+                Chord* chord = middleChord(score);
+                if (!chord) {
+                    return false;
+                }
+
+                score->select(chord->upNote());
+                score->startCmd();
+                score->upDown(true, UpDownMode::CHROMATIC);
+                score->endCmd();
+                return true;
+            } },
+        { "edit_add_text", [](MasterScore* score) {
+                Chord* chord = middleChord(score);
+                if (!chord) {
+                    return false;
+                }
+
+                Segment* segment = chord->segment();
+                StaffText* text = Factory::createStaffText(segment);
+                text->setTrack(0);
+                text->setParent(segment);
+                text->setXmlText("benchmark");
+
+                score->startCmd();
+                score->undoAddElement(text);
+                score->endCmd();
+                return true;
+            } },
+        { "edit_delete", [](MasterScore* score) {
+                Chord* chord = middleChord(score);
+                if (!chord) {
+                    return false;
+                }
+
+                score->select(chord->upNote());
+                score->startCmd();
+                score->cmdDeleteSelection();
+                score->endCmd();
+                return true;
+            } },
+        { "transpose", [](MasterScore* score) {
+                score->cmdSelectAll();
+                score->startCmd();
+                score->transpose(TransposeMode::BY_INTERVAL, TransposeDirection::UP, Key::C, 4, true, true, true);
+                score->endCmd();
+                return true;
+            } },
+        { "concert_pitch", [](MasterScore* score) {
+                score->startCmd();
+                score->cmdConcertPitchChanged(!score->styleB(Sid::concertPitch));
+                score->endCmd();
+                return true;
+            } },
+        { "parts", [](MasterScore* score) {
+                if (score->parts().empty()) {
+                    return false;
+                }
+
+                score->startCmd();
+                for (Excerpt* excerpt : Excerpt::createExcerptsFromParts(score->parts())) {
+                    score->initAndAddExcerpt(excerpt, false);
+                }
+                score->endCmd();
+                return true;
+            } },
+    };
+}
+
+//---------------------------------------------------------
+//   Export
+//    paints all the pages the same way as the image export writers of the app
+//---------------------------------------------------------
+
+static Paint::Options exportOptions(int deviceDpi)
+{
+    Paint::Options opt;
+    opt.isSetViewport = true;
+    opt.isMultiPage = false;
+    opt.isPrinting = true;
+    opt.deviceDpi = deviceDpi;
+    opt.printPageBackground = false;
+    return opt;
+}
+
+static void exportPng(MasterScore* score)
+{
+    const SizeF pageSizeInch = Paint::pageSizeInch(score);
+    QImage image(std::lrint(pageSizeInch.width() * EXPORT_DPI), std::lrint(pageSizeInch.height() * EXPORT_DPI),
+                 QImage::Format_ARGB32_Premultiplied);
+
+    for (size_t i = 0; i < score->pages().size(); ++i) {
+        image.fill(Qt::white);
+
+        draw::Painter painter(&image, "engraving_benchmarks");
+        Paint::Options opt = exportOptions(EXPORT_DPI);
+        opt.fromPage = static_cast<int>(i);
+        opt.toPage = opt.fromPage;
+        Paint::paintScore(&painter, score, opt);
+        painter.endDraw();
+
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "png");
+    }
+}
+
+static void exportSvg(MasterScore* score)
+{
+    for (size_t i = 0; i < score->pages().size(); ++i) {
+        const RectF pageRect = score->pages().at(i)->abbox();
+
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+
+        SvgGenerator printer;
+        printer.setOutputDevice(&buffer);
+        printer.setSize(QSize(pageRect.width(), pageRect.height()));
+        printer.setViewBox(QRectF(0, 0, pageRect.width(), pageRect.height()));
+
+        draw::Painter painter(&printer, "engraving_benchmarks");
+        Paint::Options opt = exportOptions(printer.logicalDpiX());
+        opt.fromPage = static_cast<int>(i);
+        opt.toPage = opt.fromPage;
+        Paint::paintScore(&painter, score, opt);
+        painter.endDraw();
+    }
+}
+
+static void exportPdf(MasterScore* score)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    QPdfWriter pdfWriter(&buffer);
+    pdfWriter.setResolution(EXPORT_DPI);
+    pdfWriter.setPageMargins(QMarginsF());
+    pdfWriter.setPageLayout(QPageLayout(QPageSize(Paint::pageSizeInch(score).toQSizeF(), QPageSize::Inch),
+                                        QPageLayout::Orientation::Portrait, QMarginsF()));
+
+    draw::Painter painter(&pdfWriter, "engraving_benchmarks");
+    Paint::Options opt = exportOptions(pdfWriter.logicalDpiX());
+    opt.onNewPage = [&pdfWriter]() { pdfWriter.newPage(); };
+    Paint::paintScore(&painter, score, opt);
+    painter.endDraw();
+}
+
+//---------------------------------------------------------
+//   benchmarkScore
+//---------------------------------------------------------
+
+static QJsonObject benchmarkScore(const QString& path, const Options& options, std::map<std::string, double>& totals)
+{
+    QJsonObject result;
+    result["file"] = path;
+    result["size_bytes"] = QFileInfo(path).size();
+
+    std::map<std::string, Durations> durations;
+    auto add = [&durations](const std::string& name, double ms) {
+        durations[name].push_back(ms);
+    };
+
+    // load
+    MasterScore* score = nullptr;
+    for (int i = 0; i < options.repeat; ++i) {
+        delete score;
+        score = nullptr;
+        add("load", measure([&score, &path]() { score = readScore(path); }));
+
+        if (!score) {
+            result["error"] = "failed to load";
+            return result;
+        }
+    }
+
+    result["format"] = score->mscVersion();
+    result["reader"] = QString::fromStdString(readerName(score->mscVersion()));
+
+    // layout
+    for (int i = 0; i < options.repeat; ++i) {
+        add("layout_full", measure([score]() { layoutScore(score); }));
+    }
+
+    result["pages"] = static_cast<int>(score->pages().size());
+    result["measures"] = static_cast<int>(score->nmeasures());
+    result["staves"] = static_cast<int>(score->nstaves());
+    result["parts"] = static_cast<int>(score->parts().size());
+
+    // save
+    for (int i = 0; i < options.repeat; ++i) {
+        add("save", measure([score]() {
+            io::Buffer buffer;
+            buffer.open(io::IODevice::WriteOnly);
+            compat::WriteScoreHook hook;
+            score->writeScore(&buffer, false, false, hook);
+        }));
+    }
+
+    // edits with the incremental layout, undo and redo
+    //! NOTE Every edit is undone at the end, so the next one starts from the loaded score
+    for (const Edit& edit : edits()) {
+        for (int i = 0; i < options.repeat; ++i) {
+            bool applied = false;
+            double ms = measure([score, &edit, &applied]() { applied = edit.apply(score); });
+            score->deselectAll();
+
+            if (!applied) {
+                break;
+            }
+
+            add(edit.name, ms);
+            add("undo", measure([score]() { score->undoRedo(true, nullptr); }));
+            add("redo", measure([score]() { score->undoRedo(false, nullptr); }));
+            score->undoRedo(true, nullptr);
+        }
+    }
+
+    // export
+    if (options.exportEnabled && !score->pages().empty()) {
+        score->setPrinting(true);
+        MScore::pdfPrinting = true;
+
+        for (int i = 0; i < options.repeat; ++i) {
+            add("export_png", measure([score]() { exportPng(score); }));
+            add("export_pdf", measure([score]() { exportPdf(score); }));
+
+            MScore::svgPrinting = true;
+            add("export_svg", measure([score]() { exportSvg(score); }));
+            MScore::svgPrinting = false;
+        }
+
+        MScore::pdfPrinting = false;
+        score->setPrinting(false);
+    }
+
+    delete score;
+
+    QJsonObject operations;
+    for (const auto& pair : durations) {
+        QJsonObject stat = statistic(pair.second);
+        operations[QString::fromStdString(pair.first)] = stat;
+        totals[pair.first] += stat["median_ms"].toDouble();
+    }
+    result["operations"] = operations;
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   benchmarkMicro
+//---------------------------------------------------------
+
+static QJsonObject benchmarkMicro(const MicroBenchmark& benchmark, const Options& options)
+{
+    QJsonObject result;
+    std::map<std::string, Durations> durations;
+
+    for (int i = 0; i < options.repeat; ++i) {
+        Measurements measurements;
+        if (!benchmark.run(measurements)) {
+            result["error"] = "wrong results";
+            return result;
+        }
+
+        for (const auto& pair : measurements) {
+            durations[pair.first].push_back(pair.second);
+        }
+    }
+
+    QJsonObject operations;
+    for (const auto& pair : durations) {
+        operations[QString::fromStdString(pair.first)] = statistic(pair.second);
+    }
+    result["operations"] = operations;
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    QGuiApplication app(argc, argv);
+
+    mu::runtime::mainThreadId(); //! NOTE Needs only call
+    mu::runtime::setThreadName("main");
+
+    mu::testing::Environment::setDependency({
+        new mu::draw::DrawModule(),
+        new mu::fonts::FontsModule(),
+        new mu::engraving::EngravingModule()
+    });
+
+    mu::testing::Environment::setPostInit([]() {
+        MScore::noGui = true;
+        loadInstrumentTemplates(":/data/instruments.xml");
+    });
+
+    mu::testing::Environment::setup();
+
+    const Options options = parseOptions(app.arguments());
+    const QStringList files = options.corpusEnabled ? scoreFiles(options.inputs) : QStringList();
+
+    QJsonArray scores;
+    std::map<std::string, double> totals;
+    int failed = 0;
+
+    for (const QString& file : files) {
+        LOGI() << "benchmark: " << file;
+
+        QJsonObject result = benchmarkScore(file, options, totals);
+        if (result.contains("error")) {
+            LOGE() << "failed to benchmark: " << file;
+            ++failed;
+        }
+
+        scores << result;
+    }
+
+    QJsonObject micro;
+    if (options.microEnabled) {
+        for (const MicroBenchmark& benchmark : microBenchmarks()) {
+            LOGI() << "micro benchmark: " << benchmark.name;
+
+            QJsonObject result = benchmarkMicro(benchmark, options);
+            if (result.contains("error")) {
+                LOGE() << "failed to benchmark: " << benchmark.name;
+                ++failed;
+            }
+
+            micro[QString::fromStdString(benchmark.name)] = result;
+        }
+    }
+
+    //! NOTE Sums of the medians over the corpus, the quick way to compare two reports
+    QJsonObject summary;
+    for (const auto& pair : totals) {
+        summary[QString::fromStdString(pair.first)] = pair.second;
+        LOGI() << pair.first << ": " << pair.second << " ms";
+    }
+
+    QJsonObject report;
+    report["repeat"] = options.repeat;
+    report["scores_count"] = static_cast<int>(files.size());
+    report["failed_count"] = failed;
+    report["summary_median_ms"] = summary;
+    report["scores"] = scores;
+    report["micro"] = micro;
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (options.outputPath.isEmpty()) {
+        std::fwrite(json.constData(), 1, json.size(), stdout);
+    } else {
+        QFile file(options.outputPath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            LOGE() << "failed to open: " << options.outputPath;
+            return 1;
+        }
+        file.write(json);
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "benchmarkutils.h"
+
+#include <QMimeData>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "internal/qmimedataadapter.h"
+#include "libmscore/factory.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/part.h"
+#include "libmscore/segment.h"
+#include "libmscore/spannerintervaltree.h"
+#include "libmscore/spatialindex.h"
+#include "libmscore/staff.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::benchmarks;
+
+//---------------------------------------------------------
+//   measureLayout
+//    the full layout with the elements of the measures laid out
+//    on the TaskScheduler pool, compared with the layout measure by measure
+//---------------------------------------------------------
+
+static bool measureLayout(Measurements& measurements)
+{
+    MasterScore* score = readScore(dataRoot() + "/concertpitch_data/concertpitchbenchmark.mscx");
+    if (!score) {
+        return false;
+    }
+
+    //! NOTE The first layout also creates the elements, it is not measured
+    score->doLayout();
+
+    score->setParallelMeasureLayout(false);
+    measurements["serial"] = measure([score]() {
+        score->doLayout();
+    });
+    const size_t serialPages = score->npages();
+
+    score->setParallelMeasureLayout(true);
+    measurements["parallel"] = measure([score]() {
+        score->doLayout();
+    });
+    const size_t parallelPages = score->npages();
+
+    delete score;
+
+    return serialPages == parallelPages;
+}
+
+//---------------------------------------------------------
+//   spatialIndex
+//    the page index used by the paint and the hit tests:
+//    building it over the items of the pages and querying viewports moving through the pages,
+//    the found items are checked against the linear search
+//---------------------------------------------------------
+
+static void collectItem(void* data, EngravingItem* item)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(item);
+}
+
+static bool spatialIndex(Measurements& measurements)
+{
+    constexpr int BUILDS = 50;
+    constexpr int QUERIES = 2000;
+
+    MasterScore* score = readScore(dataRoot() + "/all_elements_data/moonlight.mscx");
+    if (!score) {
+        return false;
+    }
+
+    layoutScore(score);
+
+    double buildTime = 0.0;
+    double queryTime = 0.0;
+    size_t foundCount = 0;
+    size_t expectedCount = 0;
+
+    for (Page* page : score->pages()) {
+        std::vector<EngravingItem*> items;
+        page->scanElements(&items, collectItem, false);
+
+        const RectF pageRect = page->abbox();
+        std::vector<RectF> viewports;
+        for (int i = 0; i < QUERIES; ++i) {
+            const double width = pageRect.width() / 2;
+            const double height = pageRect.height() / 4;
+            const double x = pageRect.left() + (pageRect.width() - width) * (i % 7) / 6.0;
+            const double y = pageRect.top() + (pageRect.height() - height) * (i % 13) / 12.0;
+            viewports.emplace_back(x, y, width, height);
+        }
+
+        SpatialIndex index;
+        buildTime += measure([&index, &pageRect, &items]() {
+            for (int i = 0; i < BUILDS; ++i) {
+                index.build(pageRect, items);
+            }
+        });
+
+        std::vector<EngravingItem*> found;
+        queryTime += measure([&index, &viewports, &found, &foundCount]() {
+            for (const RectF& viewport : viewports) {
+                found.clear();
+                index.items(viewport, found);
+                foundCount += found.size();
+            }
+        });
+
+        for (const RectF& viewport : viewports) {
+            expectedCount += std::count_if(items.begin(), items.end(), [&viewport](const EngravingItem* item) {
+                return item->pageBoundingRect().intersects(viewport);
+            });
+        }
+    }
+
+    delete score;
+
+    measurements["build"] = buildTime;
+    measurements["query"] = queryTime;
+
+    return foundCount == expectedCount;
+}
+
+//---------------------------------------------------------
+//   measureTickIndex
+//    the lookups of the measures by tick on a score of about 1500 measures,
+//    the index compared with walking the measures as tick2measure() did before,
+//    and the commands doing many lookups: transpose, paste and add instrument
+//---------------------------------------------------------
+
+static Measure* linearTick2measure(const Score* score, const Fraction& tick)
+{
+    Measure* lm = nullptr;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+
+    return nullptr;
+}
+
+static bool measureTickIndex(Measurements& measurements)
+{
+    MasterScore* score = readScore(dataRoot() + "/all_elements_data/moonlight.mscx");
+    MasterScore* source = readScore(dataRoot() + "/all_elements_data/moonlight.mscx");
+    if (!score || !source) {
+        delete score;
+        delete source;
+        return false;
+    }
+
+    while (score->nmeasures() < size_t(1500)) {
+        score->appendMeasuresFromScore(source, Fraction(0, 1), source->last()->endTick());
+    }
+
+    delete source;
+
+    layoutScore(score);
+
+    std::vector<Fraction> ticks;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        ticks.push_back(s->tick());
+    }
+
+    std::vector<Measure*> linearFound;
+    measurements["lookup_linear"] = measure([score, &ticks, &linearFound]() {
+        for (const Fraction& tick : ticks) {
+            linearFound.push_back(linearTick2measure(score, tick));
+        }
+    });
+
+    std::vector<Measure*> indexFound;
+    measurements["lookup_index"] = measure([score, &ticks, &indexFound]() {
+        for (const Fraction& tick : ticks) {
+            indexFound.push_back(score->tick2measure(tick));
+        }
+    });
+
+    measurements["transpose"] = measure([score]() {
+        score->cmdSelectAll();
+        score->startCmd();
+        score->transpose(TransposeMode::BY_INTERVAL, TransposeDirection::UP, Key::C, 4, true, true, true);
+        score->endCmd();
+    });
+
+    //! NOTE Paste of 16 measures in the middle of the score
+    Measure* dst = score->crMeasure(static_cast<int>(score->nmeasures() / 2));
+    score->select(score->crMeasure(10), SelectType::RANGE, 0);
+    score->select(score->crMeasure(25), SelectType::RANGE, score->nstaves() - 1);
+
+    QMimeData* mimeData = new QMimeData;
+    mimeData->setData(score->selection().mimeType(), score->selection().mimeData().toQByteArray());
+    QMimeDataAdapter ma(mimeData);
+
+    measurements["paste"] = measure([score, dst, &ma]() {
+        score->select(dst->first(SegmentType::ChordRest)->element(0));
+        score->startCmd();
+        score->cmdPaste(&ma, 0);
+        score->endCmd();
+    });
+
+    measurements["add_instrument"] = measure([score]() {
+        score->startCmd();
+        Part* part = new Part(score);
+        score->undoInsertPart(part, static_cast<int>(score->parts().size()));
+        Staff* staff = Factory::createStaff(part);
+        staff->setPart(part);
+        score->undoInsertStaff(staff, 0, true);
+        score->endCmd();
+    });
+
+    delete mimeData;
+    delete score;
+
+    return linearFound == indexFound;
+}
+
+//---------------------------------------------------------
+//   spannerIntervalTree
+//    like pasting the spanners one by one: every insert is followed by a query,
+//    the incremental insert compared with the rebuild of the tree after every change
+//---------------------------------------------------------
+
+static bool spannerIntervalTree(Measurements& measurements)
+{
+    constexpr size_t COUNT = 2000;
+
+    using IntervalList = SpannerIntervalTree::IntervalList;
+
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> startDist(0, 10000);
+    std::uniform_int_distribution<int> lengthDist(0, 500);
+
+    //! NOTE The tree doesn't dereference the values, so the fake pointers are enough
+    IntervalList intervals;
+    for (size_t i = 0; i < COUNT; ++i) {
+        const int start = startDist(gen);
+        intervals.emplace_back(start, start + lengthDist(gen), reinterpret_cast<Spanner*>((i + 1) * sizeof(void*)));
+    }
+
+    SpannerIntervalTree incrementalTree;
+    size_t incrementalFound = 0;
+
+    measurements["insert"] = measure([&intervals, &incrementalTree, &incrementalFound]() {
+        IntervalList found;
+        for (size_t i = 0; i < COUNT; ++i) {
+            incrementalTree.insert(intervals[i], i);
+
+            found.clear();
+            incrementalTree.findOverlapping(intervals[i].start, intervals[i].stop, found);
+            incrementalFound += found.size();
+        }
+    });
+
+    size_t rebuiltFound = 0;
+
+    measurements["rebuild"] = measure([&intervals, &rebuiltFound]() {
+        SpannerIntervalTree tree;
+        IntervalList added;
+        IntervalList found;
+        for (size_t i = 0; i < COUNT; ++i) {
+            added.push_back(intervals[i]);
+            tree.build(added);
+
+            found.clear();
+            tree.findOverlapping(intervals[i].start, intervals[i].stop, found);
+            rebuiltFound += found.size();
+        }
+    });
+
+    return incrementalTree.isValid() && incrementalFound == rebuiltFound && incrementalFound >= COUNT;
+}
+
+std::vector<MicroBenchmark> benchmarks::microBenchmarks()
+{
+    return {
+        { "measure_layout", measureLayout },
+        { "spatial_index", spatialIndex },
+        { "measure_tick_index", measureTickIndex },
+        { "spanner_interval_tree", spannerIntervalTree },
+    };
+}
@@ -60,6 +60,7 @@ EngravingProject::EngravingProject()
     ObjectAllocator::used++;
 }
 
+//! NOTE Every score releases the memory of its elements at once with its arena, see Score::objectArena()
 EngravingProject::~EngravingProject()
 {
     delete m_masterScore;
@@ -145,11 +146,13 @@ MasterScore* EngravingProject::masterScore() const
     return m_masterScore;
 }
 
-Err EngravingProject::loadMscz(const MscReader& msc, bool ignoreVersionError)
+Err EngravingProject::loadMscz(const MscReader& msc, bool ignoreVersionError, bool deferExcerptsLoading)
 {
     TRACEFUNC;
+    ObjectArena::Scope arenaScope(m_masterScore->objectArena());
     MScore::setError(MsError::MS_NO_ERROR);
     ScoreReader scoreReader;
+    scoreReader.setDeferExcerptsLoading(deferExcerptsLoading);
     Err err = scoreReader.loadMscz(m_masterScore, msc, ignoreVersionError);
     return err;
 }
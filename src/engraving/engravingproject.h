@@ -67,7 +67,7 @@ public:
     MasterScore* masterScore() const;
     Err setupMasterScore(bool forceMode);
 
-    Err loadMscz(const MscReader& msc, bool ignoreVersionError);
+    Err loadMscz(const MscReader& msc, bool ignoreVersionError, bool deferExcerptsLoading = false);
     bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail);
 
 private:
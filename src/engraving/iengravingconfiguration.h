@@ -92,6 +92,11 @@ public:
 
     virtual bool isAccessibleEnabled() const = 0;
 
+    //! NOTE In bytes, 0 - no limit. The oldest undo history is compacted and dropped above the limit
+    virtual size_t undoHistoryMemoryLimit() const = 0;
+    virtual void setUndoHistoryMemoryLimit(size_t bytes) = 0;
+    virtual async::Channel<size_t> undoHistoryMemoryLimitChanged() const = 0;
+
     /// these configurations will be removed after solving https://github.com/musescore/MuseScore/issues/14294
     virtual bool guitarProImportExperimental() const = 0;
     virtual bool negativeFretsAllowed() const = 0;
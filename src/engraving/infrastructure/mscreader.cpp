@@ -21,6 +21,7 @@
  */
 #include "mscreader.h"
 
+#include "io/buffer.h"
 #include "io/file.h"
 #include "io/fileinfo.h"
 #include "io/dir.h"
@@ -246,7 +247,15 @@ bool MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
 {
     m_device = device;
     if (!m_device) {
-        m_device = new File(filePath);
+        //! NOTE The file is mapped into memory, so the entries are read without the intermediate copies
+        RetVal<ByteArray> data = File::mapFile(filePath);
+        if (!data.ret) {
+            LOGD() << "failed open file: " << filePath;
+            return false;
+        }
+
+        m_mappedData = data.val;
+        m_device = new Buffer(&m_mappedData);
         m_selfDeviceOwner = true;
     }
 
@@ -271,6 +280,11 @@ void MscReader::ZipFileReader::close()
     if (m_device) {
         m_device->close();
     }
+
+    //! NOTE The stored entries refer to the mapping and keep it alive, it's released with the last of them
+    m_mappedData = ByteArray();
+    m_fileList.clear();
+    m_fileListValid = false;
 }
 
 bool MscReader::ZipFileReader::isOpened() const
@@ -289,6 +303,10 @@ StringList MscReader::ZipFileReader::fileList() const
         return StringList();
     }
 
+    if (m_fileListValid) {
+        return m_fileList;
+    }
+
     StringList files;
     std::vector<ZipReader::FileInfo> fileInfoList = m_zip->fileInfoList();
     if (m_zip->hasError()) {
@@ -301,6 +319,9 @@ StringList MscReader::ZipFileReader::fileList() const
         }
     }
 
+    m_fileList = files;
+    m_fileListValid = true;
+
     return files;
 }
 
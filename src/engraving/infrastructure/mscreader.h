@@ -100,7 +100,10 @@ private:
     private:
         io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
+        ByteArray m_mappedData;
         ZipReader* m_zip = nullptr;
+        mutable StringList m_fileList;
+        mutable bool m_fileListValid = false;
     };
 
     struct DirReader : public IReader
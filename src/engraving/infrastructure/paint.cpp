@@ -33,6 +33,33 @@
 
 using namespace mu::engraving;
 
+static int deviceDpi(const Paint::Options& opt)
+{
+    //! NOTE This is DPI of paint device,  ex screen, image, printer and etc.
+    //! Should be set, but if not set, we will use our default DPI.
+    return opt.deviceDpi > 0 ? opt.deviceDpi : mu::engraving::DPI;
+}
+
+static void setupDrawSystem(Score* score, const Paint::Options& opt)
+{
+    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / deviceDpi(opt);
+    score->setPrinting(opt.isPrinting);
+    mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+}
+
+void Paint::prepareScore(Score* score, const Options& opt)
+{
+    if (!score) {
+        return;
+    }
+
+    setupDrawSystem(score, opt);
+
+    for (Page* page : score->pages()) {
+        page->rebuildSpatialIndexIfNeeded();
+    }
+}
+
 void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
 {
     TRACEFUNC;
@@ -45,9 +72,7 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
         return;
     }
 
-    //! NOTE This is DPI of paint device,  ex screen, image, printer and etc.
-    //! Should be set, but if not set, we will use our default DPI.
-    const int DEVICE_DPI = opt.deviceDpi > 0 ? opt.deviceDpi : mu::engraving::DPI;
+    const int DEVICE_DPI = deviceDpi(opt);
 
     //! NOTE Depending on the view mode,
     //! if the view mode is PAGE, then this is one page size (ex A4),
@@ -64,15 +89,14 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
         painter->setWindow(RectF(0.0, 0.0, pageSize.width() * mu::engraving::DPI, pageSize.height() * mu::engraving::DPI));
     }
 
-    // Setup score draw system
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / DEVICE_DPI;
-    score->setPrinting(opt.isPrinting);
-    mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+    setupDrawSystem(score, opt);
 
     // Setup page counts
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
     int toPage = (opt.toPage >= 0 && opt.toPage < int(pages.size())) ? opt.toPage : (int(pages.size()) - 1);
 
+    std::vector<EngravingItem*> elements;
+
     for (int copy = 0; copy < opt.copyCount; ++copy) {
         bool firstPage = true;
         for (int pi = fromPage; pi <= toPage; ++pi) {
@@ -127,7 +151,8 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
             // Draw page elements
             painter->setClipping(true);
             painter->setClipRect(pageRect);
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
+            elements.clear();
+            page->items(drawRect.translated(-pagePos), elements);
             paintElements(*painter, elements, opt.isPrinting);
             painter->setClipping(false);
 
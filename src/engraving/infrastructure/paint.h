@@ -50,6 +50,10 @@ public:
         std::function<void()> onNewPage;
     };
 
+    //! NOTE Sets up the score draw system and the spatial indexes of the pages,
+    //! so they are not checked for every tile, when the view is painted by tiles.
+    //! The painting is done on the main thread only: EngravingItem::draw() is not thread-safe
+    static void prepareScore(Score* score, const Options& opt);
     static void paintScore(draw::Painter* painter, Score* score, const Options& opt);
     static void paintElement(draw::Painter& painter, const EngravingItem* element);
     static void paintElements(draw::Painter& painter, const std::vector<EngravingItem*>& elements, bool isPrinting);
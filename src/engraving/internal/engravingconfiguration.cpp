@@ -43,6 +43,9 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+static const Settings::Key UNDO_HISTORY_MEMORY_LIMIT_MB("engraving", "engraving/undo/memoryLimitMb");
+static constexpr size_t MB = 1024 * 1024;
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -60,9 +63,14 @@ void EngravingConfiguration::init()
     };
 
     settings()->setDefaultValue(INVERT_SCORE_COLOR, Val(false));
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_LIMIT_MB, Val(512));
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MEMORY_LIMIT_MB, true);
     settings()->valueChanged(INVERT_SCORE_COLOR).onReceive(nullptr, [this](const Val&) {
         m_scoreInversionChanged.notify();
     });
+    settings()->valueChanged(UNDO_HISTORY_MEMORY_LIMIT_MB).onReceive(nullptr, [this](const Val&) {
+        m_undoHistoryMemoryLimitChanged.send(undoHistoryMemoryLimit());
+    });
 
     for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
         Settings::Key key("engraving", "engraving/colors/voice" + std::to_string(voice + 1));
@@ -276,6 +284,22 @@ bool EngravingConfiguration::isAccessibleEnabled() const
     return accessibilityConfiguration() ? accessibilityConfiguration()->enabled() : false;
 }
 
+size_t EngravingConfiguration::undoHistoryMemoryLimit() const
+{
+    int limitMb = settings()->value(UNDO_HISTORY_MEMORY_LIMIT_MB).toInt();
+    return limitMb > 0 ? static_cast<size_t>(limitMb) * MB : 0;
+}
+
+void EngravingConfiguration::setUndoHistoryMemoryLimit(size_t bytes)
+{
+    settings()->setSharedValue(UNDO_HISTORY_MEMORY_LIMIT_MB, Val(static_cast<int>(bytes / MB)));
+}
+
+mu::async::Channel<size_t> EngravingConfiguration::undoHistoryMemoryLimitChanged() const
+{
+    return m_undoHistoryMemoryLimitChanged;
+}
+
 bool EngravingConfiguration::guitarProImportExperimental() const
 {
     return guitarProConfiguration() ? guitarProConfiguration()->experimental() : false;
@@ -88,6 +88,10 @@ public:
 
     bool isAccessibleEnabled() const override;
 
+    size_t undoHistoryMemoryLimit() const override;
+    void setUndoHistoryMemoryLimit(size_t bytes) override;
+    async::Channel<size_t> undoHistoryMemoryLimitChanged() const override;
+
     bool guitarProImportExperimental() const override;
     bool negativeFretsAllowed() const override;
     bool tablatureParenthesesZIndexWorkaround() const override;
@@ -100,6 +104,7 @@ public:
 private:
     async::Channel<voice_idx_t, draw::Color> m_voiceColorChanged;
     async::Notification m_scoreInversionChanged;
+    async::Channel<size_t> m_undoHistoryMemoryLimitChanged;
 
     ValNt<DebuggingOptions> m_debuggingOptions;
 
@@ -74,6 +74,7 @@ Layout::Layout(Score* score)
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(m_score);
+    ObjectArena::Scope arenaScope(m_score->objectArena());
     LayoutContext ctx(m_score);
 
     Fraction stick(st);
@@ -87,6 +88,7 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         DeleteAll(m_score->pages());
         m_score->pages().clear();
         LayoutPage::getNextPage(options, ctx);
+        m_score->setAllChanged();
         return;
     }
 
@@ -140,11 +142,23 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         ctx.prevMeasure = 0;
         ctx.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         ctx.startTick   = m->tick();
+        m_score->setAllChanged();
         layoutLinear(layoutAll, options, ctx);
         return;
     }
 
     if (!layoutAll && m->system()) {
+        ctx.startTick = m->tick();
+        ctx.useMeasureLayoutStamps = true;
+
+        //! NOTE The range is what the edits of the command requested to lay out (add, remove, property changes),
+        //! the measures in it are never reused, even if their inputs out of the measure are the same
+        for (MeasureBase* mb = m; mb && mb->tick() <= etick; mb = mb->next()) {
+            if (mb->isMeasure()) {
+                toMeasure(mb)->invalidateLayoutStamp();
+            }
+        }
+
         System* system = m->system();
         system_idx_t systemIndex = mu::indexOf(m_score->_systems, system);
         ctx.page = system->page();
@@ -207,12 +221,17 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
 
         DeleteAll(m_score->pages());
         m_score->pages().clear();
+        m_score->setAllChanged();
 
         ctx.nextMeasure = options.showVBox ? m_score->first() : m_score->firstMeasure();
     }
 
     ctx.prevMeasure = 0;
 
+    if (layoutAll && options.parallelMeasureLayout) {
+        LayoutMeasure::prepareMeasures(options, ctx);
+    }
+
     LayoutMeasure::getNextMeasure(options, ctx);
     ctx.curSystem = LayoutSystem::collectSystem(options, ctx, m_score);
 
@@ -224,7 +243,12 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
     MeasureBase* lmb;
     do {
         LayoutPage::getNextPage(options, lc);
+
+        //! NOTE The pages keep their places on the canvas, so the collected pages cover
+        //! both the previous and the new layout of the range
+        mu::RectF pageRect = lc.page->canvasBoundingRect();
         LayoutPage::collectPage(options, lc);
+        lc.score()->addChangedArea(pageRect.united(lc.page->canvasBoundingRect()));
 
         if (lc.page && !lc.page->systems().empty()) {
             lmb = lc.page->systems().back()->measures().back();
@@ -252,12 +276,14 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
         while (lc.score()->npages() > lc.curPage) {
             Page* p = lc.score()->pages().back();
             lc.score()->pages().pop_back();
+            lc.score()->addChangedArea(p->canvasBoundingRect());
             delete p;
         }
     } else {
         Page* p = lc.curSystem->page();
         if (p && (p != lc.page)) {
-            p->invalidateBspTree();
+            p->invalidateSpatialIndex();
+            lc.score()->addChangedArea(p->canvasBoundingRect());
         }
     }
     lc.score()->systems().insert(lc.score()->systems().end(), lc.systemList.begin(), lc.systemList.end());
@@ -526,5 +552,5 @@ void Layout::layoutLinear(const LayoutOptions& options, LayoutContext& ctx)
     system->setPos(lm, tm);
     ctx.page->setWidth(lm + system->width() + rm);
     ctx.page->setHeight(tm + system->height() + bm);
-    ctx.page->invalidateBspTree();
+    ctx.page->invalidateSpatialIndex();
 }
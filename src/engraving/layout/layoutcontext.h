@@ -29,6 +29,7 @@
 #include "types/types.h"
 
 namespace mu::engraving {
+class Measure;
 class MeasureBase;
 class Page;
 class Score;
@@ -68,6 +69,11 @@ public:
     int measureNo = 0;
     Fraction startTick;
     Fraction endTick;
+    bool useMeasureLayoutStamps = false; // skip the unchanged measures out of [startTick, endTick]
+    bool measuresPrepared = false; // all the measures are laid out by LayoutMeasure::prepareMeasures()
+
+    bool deferMeasureElementsLayout = false;
+    std::vector<Measure*> deferredMeasures;
 
     double totalBracketsWidth = -1.0;
 
@@ -21,10 +21,16 @@
  */
 #include "layoutmeasure.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <optional>
+
 #include "libmscore/ambitus.h"
 #include "libmscore/barline.h"
 #include "libmscore/beam.h"
 #include "libmscore/factory.h"
+#include "libmscore/instrument.h"
 #include "libmscore/keysig.h"
 #include "libmscore/layoutbreak.h"
 #include "libmscore/lyrics.h"
@@ -33,6 +39,8 @@
 #include "libmscore/mmrest.h"
 #include "libmscore/part.h"
 #include "libmscore/score.h"
+#include "libmscore/staff.h"
+#include "libmscore/stafftype.h"
 #include "libmscore/stem.h"
 #include "libmscore/timesig.h"
 #include "libmscore/undo.h"
@@ -42,10 +50,14 @@
 #include "layoutchords.h"
 #include "layouttremolo.h"
 
+#include "concurrency/taskscheduler.h"
+
 #include "log.h"
 
 using namespace mu::engraving;
 
+static constexpr size_t MIN_MEASURES_PER_TASK = 8;
+
 //---------------------------------------------------------
 //   createMMRest
 //    create a multimeasure rest
@@ -579,6 +591,288 @@ static void layoutDrumsetChord(Chord* c, const Drumset* drumset, const StaffType
     }
 }
 
+//---------------------------------------------------------
+//   measureLayoutStamp
+//    collects everything out of the measure the layout of the measure depends on.
+//    Only the values are hashed: the staff types, instruments and time signatures
+//    are replaced on edits and a new object may get the address of the old one
+//---------------------------------------------------------
+
+static Measure::LayoutStamp measureLayoutStamp(const LayoutContext& ctx, const Measure* measure)
+{
+    const Score* score = ctx.score();
+    const Fraction tick = measure->tick();
+
+    Measure::LayoutStamp stamp;
+    stamp.valid = true;
+    stamp.styleGeneration = score->style().generation();
+    stamp.tick = tick;
+    stamp.stavesCount = score->nstaves();
+
+    auto combine = [&stamp](size_t value) {
+        stamp.stavesContextHash ^= value + 0x9e3779b9 + (stamp.stavesContextHash << 6) + (stamp.stavesContextHash >> 2);
+    };
+
+    auto combineFraction = [&combine](const Fraction& f) {
+        combine(static_cast<size_t>(f.numerator()));
+        combine(static_cast<size_t>(f.denominator()));
+    };
+
+    for (const Staff* staff : score->staves()) {
+        KeySigEvent key = staff->keySigEvent(tick);
+        combine(static_cast<size_t>(key.key()));
+        combine(static_cast<size_t>(key.mode()));
+        combine(static_cast<size_t>(staff->clef(tick)));
+        combine(std::hash<double>()(staff->staffMag(tick)));
+        combine(staff->show() ? 1 : 0);
+
+        const StaffType* staffType = staff->staffType(tick);
+        combine(static_cast<size_t>(staffType->group()));
+        combine(static_cast<size_t>(staffType->lines()));
+        combine(static_cast<size_t>(staffType->stepOffset()));
+        combine(std::hash<double>()(staffType->lineDistance().val()));
+        combine(std::hash<double>()(staffType->userMag()));
+        combine(staffType->isSmall() ? 1 : 0);
+        combine(staffType->stemless() ? 1 : 0);
+
+        const Instrument* instrument = staff->part()->instrument(tick);
+        combine(instrument->useDrumset() ? 1 : 0);
+        combine(static_cast<size_t>(instrument->transpose().chromatic));
+        combine(static_cast<size_t>(instrument->transpose().diatonic));
+
+        const TimeSig* timeSig = staff->timeSig(tick);
+        if (timeSig) {
+            combineFraction(timeSig->sig());
+            combineFraction(timeSig->stretch());
+            combine(static_cast<size_t>(timeSig->timeSigType()));
+            for (const GroupNode& node : timeSig->groups().nodes()) {
+                combine(static_cast<size_t>(node.pos));
+                combine(static_cast<size_t>(node.action));
+            }
+        } else {
+            combine(0);
+        }
+    }
+
+    return stamp;
+}
+
+//---------------------------------------------------------
+//   dependsOnOtherMeasures
+//    the beams over the barlines, the cross-staff notes and the lyrics lines (melismas, dashes)
+//    are laid out together with the other measures and staves
+//---------------------------------------------------------
+
+static bool dependsOnOtherMeasures(const Measure* measure)
+{
+    for (const Segment& segment : measure->segments()) {
+        if (!segment.isChordRestType()) {
+            continue;
+        }
+
+        for (const EngravingItem* e : segment.elist()) {
+            if (!e || !e->isChordRest()) {
+                continue;
+            }
+
+            const ChordRest* cr = toChordRest(e);
+            if (cr->staffMove() != 0) {
+                return true;
+            }
+
+            for (const Lyrics* l : cr->lyrics()) {
+                if (l && (l->ticks().isNotZero() || l->syllabic() == Lyrics::Syllabic::BEGIN
+                          || l->syllabic() == Lyrics::Syllabic::MIDDLE)) {
+                    return true;
+                }
+            }
+
+            const Beam* beam = cr->beam();
+            if (beam && (beam->cross() || beam->elements().front()->measure() != measure
+                         || beam->elements().back()->measure() != measure)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------
+//   canReuseMeasureLayout
+//    The edited measures and their neighbours are always laid out:
+//    the accidentals, ties and beams of a measure depend on the adjacent ones
+//---------------------------------------------------------
+
+static bool canReuseMeasureLayout(const LayoutContext& ctx, const Measure* measure, const Measure::LayoutStamp& stamp)
+{
+    if (!ctx.useMeasureLayoutStamps && !ctx.measuresPrepared) {
+        return false;
+    }
+
+    if (measure->isMMRest() || measure->mmRest() || ctx.score()->styleB(Sid::createMultiMeasureRests)) {
+        return false;
+    }
+
+    if (ctx.measuresPrepared) {
+        return measure->layoutStamp() == stamp;
+    }
+
+    const bool beforeRange = measure->endTick() < ctx.startTick;
+    const bool afterRange = ctx.prevMeasure && ctx.prevMeasure->isMeasure() && ctx.prevMeasure->tick() > ctx.endTick;
+    if (!beforeRange && !afterRange) {
+        return false;
+    }
+
+    return measure->layoutStamp() == stamp && !dependsOnOtherMeasures(measure);
+}
+
+//---------------------------------------------------------
+//   extendTremoloStems
+//    if there is a two-note tremolo attached, and it is too steep,
+//    extend stem of one of the chords (if not cross-staff)
+//    or extend both stems (if cross-staff)
+//    this should be done after the stem lengths of two notes are both calculated
+//---------------------------------------------------------
+
+static void extendTremoloStems(Chord* chord)
+{
+    if (!chord->tremolo() || chord != chord->tremolo()->chord2()) {
+        return;
+    }
+
+    Stem* stem1 = chord->tremolo()->chord1()->stem();
+    Stem* stem2 = chord->tremolo()->chord2()->stem();
+    if (stem1 && stem2) {
+        std::pair<double, double> extendedLen = LayoutTremolo::extendedStemLenWithTwoNoteTremolo(
+            chord->tremolo(),
+            stem1->p2().y(),
+            stem2->p2().y());
+        stem1->setBaseLength(Millimetre(extendedLen.first));
+        stem2->setBaseLength(Millimetre(extendedLen.second));
+    }
+}
+
+//---------------------------------------------------------
+//   resetReusedMeasureLayout
+//    The system layout changes the stems and the shapes of the measure after this pass
+//    (final beams, skylines, spacing), so for a reused measure they are brought back
+//    to the state the pass leaves them in
+//---------------------------------------------------------
+
+static void resetReusedMeasureLayout(Measure* measure)
+{
+    for (Segment& segment : measure->segments()) {
+        if (!segment.isChordRestType()) {
+            continue;
+        }
+
+        for (EngravingItem* e : segment.elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+
+            Chord* chord = toChord(e);
+            for (Chord* c : chord->graceNotes()) {
+                c->computeUp();
+                c->layoutStem();
+            }
+            chord->computeUp();
+            chord->layoutStem();
+            extendTremoloStems(chord);
+        }
+    }
+
+    for (Segment& segment : measure->segments()) {
+        if (segment.isChordRestType()) {
+            LayoutBeams::layoutNonCrossBeams(&segment);
+        }
+    }
+
+    for (Segment& segment : measure->segments()) {
+        if (segment.isEndBarLineType()) {
+            continue;
+        }
+        segment.createShapes();
+    }
+
+    measure->computeTicks();
+}
+
+//---------------------------------------------------------
+//   layoutMeasureElements
+//    The part of the measure layout that touches only the elements of the measure,
+//    so it can be done for several measures at the same time
+//---------------------------------------------------------
+
+static void layoutMeasureElements(Score* score, Measure* measure)
+{
+    for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+        for (Segment& segment : measure->segments()) {
+            if (segment.isChordRestType()) {
+                LayoutChords::layoutChords1(score, &segment, staffIdx);
+            }
+        }
+    }
+
+    for (Segment& segment : measure->segments()) {
+        if (segment.isBreathType()) {
+            for (EngravingItem* e : segment.elist()) {
+                if (e && e->isBreath()) {
+                    e->layout();
+                }
+            }
+        } else if (segment.isChordRestType()) {
+            for (EngravingItem* e : segment.annotations()) {
+                if (e->isSymbol()) {
+                    e->layout();
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   layoutMeasureAnnotations
+//    The rest of the measure layout, it is done on the calling thread:
+//    the lyrics create and remove their lines and look up the chords of the other measures,
+//    the chord symbols are laid out during the creation of the segment shapes
+//---------------------------------------------------------
+
+static void layoutMeasureAnnotations(Score* score, Measure* measure)
+{
+    for (Segment& segment : measure->segments()) {
+        if (!segment.isChordRestType()) {
+            continue;
+        }
+
+        for (track_idx_t track = 0; track < score->ntracks(); ++track) {
+            ChordRest* cr = segment.cr(track);
+            if (!cr) {
+                continue;
+            }
+
+            for (Lyrics* l : cr->lyrics()) {
+                if (l) {
+                    l->layout();
+                }
+            }
+        }
+    }
+
+    for (Segment& s : measure->segments()) {
+        if (s.isEndBarLineType()) {
+            continue;
+        }
+        s.createShapes();
+    }
+
+    LayoutChords::updateGraceNotes(measure);
+
+    measure->computeTicks(); // Must be called *after* Segment::createShapes() because it relies on the
+    // Segment::visible() property, which is determined by Segment::createShapes().
+}
+
 void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext& ctx)
 {
     Score* score = ctx.score();
@@ -655,6 +949,15 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         return;
     }
 
+    const Measure::LayoutStamp stamp = measureLayoutStamp(ctx, measure);
+    if (canReuseMeasureLayout(ctx, measure, stamp)) {
+        if (!ctx.measuresPrepared) {
+            resetReusedMeasureLayout(measure);
+        }
+        ctx.tick += measure->ticks();
+        return;
+    }
+
     measure->connectTremolo();
 
     //
@@ -719,22 +1022,7 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
                         chord->layoutStem();               // create stems needed to calculate spacing
                                                            // stem direction can change later during beam processing
 
-                        // if there is a two-note tremolo attached, and it is too steep,
-                        // extend stem of one of the chords (if not cross-staff)
-                        // or extend both stems (if cross-staff)
-                        // this should be done after the stem lengths of two notes are both calculated
-                        if (chord->tremolo() && chord == chord->tremolo()->chord2()) {
-                            Stem* stem1 = chord->tremolo()->chord1()->stem();
-                            Stem* stem2 = chord->tremolo()->chord2()->stem();
-                            if (stem1 && stem2) {
-                                std::pair<double, double> extendedLen = LayoutTremolo::extendedStemLenWithTwoNoteTremolo(
-                                    chord->tremolo(),
-                                    stem1->p2().y(),
-                                    stem2->p2().y());
-                                stem1->setBaseLength(Millimetre(extendedLen.first));
-                                stem2->setBaseLength(Millimetre(extendedLen.second));
-                            }
-                        }
+                        extendTremoloStems(chord);
                     }
                     cr->setMag(m);
                 }
@@ -766,40 +1054,6 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         LayoutBeams::layoutNonCrossBeams(&s);
     }
 
-    for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
-        for (Segment& segment : measure->segments()) {
-            if (segment.isChordRestType()) {
-                LayoutChords::layoutChords1(score, &segment, staffIdx);
-                for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
-                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
-                    if (cr) {
-                        for (Lyrics* l : cr->lyrics()) {
-                            if (l) {
-                                l->layout();
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    for (Segment& segment : measure->segments()) {
-        if (segment.isBreathType()) {
-            for (EngravingItem* e : segment.elist()) {
-                if (e && e->isBreath()) {
-                    e->layout();
-                }
-            }
-        } else if (segment.isChordRestType()) {
-            for (EngravingItem* e : segment.annotations()) {
-                if (e->isSymbol()) {
-                    e->layout();
-                }
-            }
-        }
-    }
-
     Segment* seg = measure->findSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
     if (measure->repeatStart()) {
         if (!seg) {
@@ -817,21 +1071,104 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
         score->undoRemoveElement(seg);
     }
 
-    for (Segment& s : measure->segments()) {
-        if (s.isEndBarLineType()) {
-            continue;
-        }
-        s.createShapes();
+    if (ctx.deferMeasureElementsLayout) {
+        ctx.deferredMeasures.push_back(measure);
+        ctx.tick += measure->ticks();
+        return;
     }
 
-    LayoutChords::updateGraceNotes(measure);
-
-    measure->computeTicks(); // Must be called *after* Segment::createShapes() because it relies on the
-    // Segment::visible() property, which is determined by Segment::createShapes().
+    layoutMeasureElements(score, measure);
+    layoutMeasureAnnotations(score, measure);
+    measure->setLayoutStamp(stamp);
 
     ctx.tick += measure->ticks();
 }
 
+//---------------------------------------------------------
+//   prepareMeasures
+//---------------------------------------------------------
+
+void LayoutMeasure::prepareMeasures(const LayoutOptions& options, LayoutContext& ctx)
+{
+    Score* score = ctx.score();
+
+    //! NOTE The multimeasure rests are created during the layout, it can't be done ahead
+    if (score->styleB(Sid::createMultiMeasureRests)) {
+        return;
+    }
+
+    MeasureBase* prevMeasure = ctx.prevMeasure;
+    MeasureBase* curMeasure = ctx.curMeasure;
+    MeasureBase* nextMeasure = ctx.nextMeasure;
+    int measureNo = ctx.measureNo;
+    Fraction tick = ctx.tick;
+
+    //! NOTE Everything that creates or removes elements is done on the calling thread
+    ctx.deferMeasureElementsLayout = true;
+    do {
+        getNextMeasure(options, ctx);
+    } while (ctx.curMeasure);
+    ctx.deferMeasureElementsLayout = false;
+
+    std::vector<Measure*> measures;
+    measures.swap(ctx.deferredMeasures);
+
+    const size_t threadsCount = static_cast<size_t>(mu::TaskScheduler::instance()->threadPoolSize());
+    const size_t chunksCount = std::min(measures.size() / MIN_MEASURES_PER_TASK, threadsCount * 4);
+
+    if (chunksCount < 2) {
+        for (Measure* m : measures) {
+            layoutMeasureElements(score, m);
+        }
+    } else {
+        std::vector<std::future<void> > tasks;
+        tasks.reserve(chunksCount);
+
+        //! NOTE Every task collects its own refresh rect, they are added to the score state here
+        std::vector<std::optional<mu::RectF> > refreshes(chunksCount);
+
+        for (size_t chunk = 0; chunk < chunksCount; ++chunk) {
+            const size_t begin = measures.size() * chunk / chunksCount;
+            const size_t end = measures.size() * (chunk + 1) / chunksCount;
+
+            tasks.push_back(mu::TaskScheduler::instance()->submit([score, &measures, &refreshes, chunk, begin, end]() {
+                ObjectArena::Scope arenaScope(score->objectArena());
+                Score::RefreshCollector refreshCollector;
+
+                for (size_t i = begin; i < end; ++i) {
+                    layoutMeasureElements(score, measures[i]);
+                }
+
+                if (refreshCollector.added) {
+                    refreshes[chunk] = refreshCollector.refresh;
+                }
+            }));
+        }
+
+        for (std::future<void>& task : tasks) {
+            task.get();
+        }
+
+        for (const std::optional<mu::RectF>& refresh : refreshes) {
+            if (refresh) {
+                score->addRefresh(*refresh);
+            }
+        }
+    }
+
+    for (Measure* m : measures) {
+        layoutMeasureAnnotations(score, m);
+        m->setLayoutStamp(measureLayoutStamp(ctx, m));
+    }
+
+    ctx.prevMeasure = prevMeasure;
+    ctx.curMeasure = curMeasure;
+    ctx.nextMeasure = nextMeasure;
+    ctx.measureNo = measureNo;
+    ctx.tick = tick;
+    ctx.measuresPrepared = true;
+}
+
 //---------------------------------------------------------
 //   adjustMeasureNo
 //---------------------------------------------------------
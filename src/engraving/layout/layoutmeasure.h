@@ -36,6 +36,12 @@ public:
     LayoutMeasure() = default;
 
     static void getNextMeasure(const LayoutOptions& options, LayoutContext& lc);
+
+    //! NOTE Runs the per-measure layout for the whole score ahead of the system collection.
+    //! The part that touches only the elements of a measure (chords, notes, breaths, symbols)
+    //! is done on the TaskScheduler pool, the lyrics and the segment shapes after it on the calling thread.
+    //! getNextMeasure() then reuses the result
+    static void prepareMeasures(const LayoutOptions& options, LayoutContext& lc);
     static void computePreSpacingItems(Measure* m);
 
 private:
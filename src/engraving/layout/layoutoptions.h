@@ -45,6 +45,10 @@ struct LayoutOptions
 
     bool showVBox = true;
 
+    //! NOTE Lay out the elements of the measures on the TaskScheduler pool (see LayoutMeasure::prepareMeasures).
+    //! Off until the shared state written by the layout() of the items laid out there is audited
+    bool parallelMeasureLayout = false;
+
     // from style
     double loWidth = 0;
     double loHeight = 0;
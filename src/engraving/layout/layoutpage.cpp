@@ -347,7 +347,7 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
         }
     }
 
-    ctx.page->invalidateBspTree();
+    ctx.page->invalidateSpatialIndex();
 }
 
 //---------------------------------------------------------
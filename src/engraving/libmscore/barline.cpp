@@ -62,6 +62,8 @@ namespace mu::engraving {
 
 static void undoChangeBarLineType(BarLine* bl, BarLineType barType, bool allStaves)
 {
+    bl->score()->loadLinkedExcerpts();
+
     Measure* m = bl->measure();
     if (!m) {
         return;
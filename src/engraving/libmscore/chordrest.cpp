@@ -368,6 +368,8 @@ void ChordRest::undoSetSmall(bool val)
 
 EngravingItem* ChordRest::drop(EditData& data)
 {
+    score()->loadLinkedExcerpts(this);
+
     EngravingItem* e       = data.dropElement;
     Measure* m       = measure();
     bool fromPalette = (e->track() == mu::nidx);
@@ -285,6 +285,11 @@ void Score::startCmd()
         return;
     }
     undoStack()->beginMacro(this);
+
+    //! NOTE The elements created by the command come from the arena of the score, see objectArena()
+    if (ObjectArena* arena = objectArena()) {
+        masterScore()->m_cmdArenaScope = std::make_unique<ObjectArena::Scope>(arena);
+    }
 }
 
 //---------------------------------------------------------
@@ -302,6 +307,8 @@ void Score::undoRedo(bool undo, EditData* ed)
     //! 2. for the redo operation, the list of changed elements will be available after redo()
     UndoMacro::ChangesInfo changes = changesInfo(undoStack());
 
+    ObjectArena::Scope arenaScope(objectArena());
+
     cmdState().reset();
     if (undo) {
         undoStack()->undo(ed);
@@ -331,6 +338,43 @@ void Score::undoRedo(bool undo, EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   loadLinkedExcerpts
+///   The changes are propagated to the linked elements of
+///   the parts, so the unloaded parts the changes of the
+///   object reach are loaded before them. The system objects
+///   and the objects without a staff (e.g. measures) reach
+///   all the parts, as does nullptr.
+//---------------------------------------------------------
+
+void Score::loadLinkedExcerpts(const EngravingObject* object)
+{
+    MasterScore* ms = masterScore();
+    if (!ms->hasUnloadedExcerpts()) {
+        return;
+    }
+
+    const Part* part = nullptr;
+    if (object && object->isEngravingItem()) {
+        const EngravingItem* item = toEngravingItem(object);
+        if (!item->systemFlag() && item->staff()) {
+            part = item->part();
+        }
+    } else if (object && object->isStaff()) {
+        part = toStaff(object)->part();
+    } else if (object && object->isPart()) {
+        part = toPart(object);
+    }
+
+    //! NOTE The parts of the excerpts have the same ids as the master parts
+    const Part* masterPart = part ? ms->partById(part->id()) : nullptr;
+    if (masterPart) {
+        ms->loadExcerpts(masterPart);
+    } else {
+        ms->loadExcerpts();
+    }
+}
+
 //---------------------------------------------------------
 //   endCmd
 ///   End a GUI command by (if \a undo) ending a user-visible undo
@@ -343,6 +387,9 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
         return;
     }
 
+    //! NOTE The scope of the command ends with this function
+    std::unique_ptr<ObjectArena::Scope> arenaScope = std::move(masterScore()->m_cmdArenaScope);
+
     if (!undoStack()->active()) {
         LOGW() << "no command active";
         update();
@@ -359,6 +406,11 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
 
     update(false, layoutAllParts);
 
+    //! NOTE The parts that aren't open aren't laid out, but the next command may look them up
+    for (const Score* s : masterScore()->scoreList()) {
+        s->_measures.updateTickIndex(s);
+    }
+
     ScoreChangesRange range = changesRange();
 
     LOGD() << "Undo stack current macro child count: " << undoStack()->current()->childCount();
@@ -422,6 +474,10 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
 
+        for (Score* s : ms->scoreList()) {
+            s->resetChangedArea();
+        }
+
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
                 if (s != this && !s->isOpen() && ms->scoreList().size() > 1 && !layoutAllParts) {
@@ -443,14 +499,20 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
         CmdState& cs = ms->cmdState();
         if (updateAll || cs.updateAll()) {
             for (Score* s : scoreList()) {
+                //! NOTE The layout collects the changed area itself, without the layout it is unknown
+                if (!updateAll) {
+                    s->setAllChanged();
+                }
                 for (MuseScoreView* v : s->viewer) {
                     v->updateAll();
                 }
             }
+            addChangedArea(_updateState.refresh);
         } else if (cs.updateRange()) {
             // updateRange updates only current score
             double d = spatium() * .5;
             _updateState.refresh.adjust(-d, -d, 2 * d, 2 * d);
+            addChangedArea(_updateState.refresh);
             for (MuseScoreView* v : viewer) {
                 v->dataChanged(_updateState.refresh);
             }
@@ -796,6 +858,8 @@ Note* Score::setGraceNote(Chord* ch, int pitch, NoteType type, int len)
 
 void Score::createCRSequence(const Fraction& f, ChordRest* cr, const Fraction& t)
 {
+    loadLinkedExcerpts(cr);
+
     Fraction tick(t);
     Measure* measure = cr->measure();
     ChordRest* ocr = 0;
@@ -3423,6 +3487,8 @@ void Score::cmdImplode()
 
 void Score::cmdSlashFill()
 {
+    loadLinkedExcerpts();
+
     staff_idx_t startStaff = selection().staffStart();
     staff_idx_t endStaff = selection().staffEnd();
     Segment* startSegment = selection().startSegment();
@@ -3562,6 +3628,8 @@ void Score::cmdSlashFill()
 
 void Score::cmdSlashRhythm()
 {
+    loadLinkedExcerpts();
+
     std::set<Chord*> chords;
     // loop through all notes in selection
     for (EngravingItem* e : selection().elements()) {
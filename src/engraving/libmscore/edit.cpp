@@ -1212,6 +1212,8 @@ bool Score::rewriteMeasures(Measure* fm, const Fraction& ns, staff_idx_t staffId
 
 void Score::cmdAddTimeSig(Measure* fm, staff_idx_t staffIdx, TimeSig* ts, bool local)
 {
+    loadLinkedExcerpts();
+
     deselectAll();
 
     if (fm->isMMRest()) {
@@ -1543,6 +1545,8 @@ ChordRest* Score::searchNote(const Fraction& tick, track_idx_t track) const
 
 void Score::regroupNotesAndRests(const Fraction& startTick, const Fraction& endTick, track_idx_t track)
 {
+    loadLinkedExcerpts(staff(track / VOICES));
+
     Segment* inputSegment = _is.segment();   // store this so we can get back to it later.
     Segment* seg = tick2segment(startTick, true, SegmentType::ChordRest);
     for (Measure* msr = seg->measure(); msr && msr->tick() < endTick; msr = msr->nextMeasure()) {
@@ -2289,6 +2293,9 @@ void Score::deleteItem(EngravingItem* el)
     if (!el) {
         return;
     }
+
+    loadLinkedExcerpts(el);
+
     // cannot remove generated elements
     if (el->generated() && !(el->isBracket() || el->isBarLine() || el->isClef() || el->isMeasureNumber())) {
         return;
@@ -3131,6 +3138,9 @@ void Score::cmdDeleteSelection()
         Segment* s2 = selection().endSegment();
         const Fraction stick1 = selection().tickStart();
         const Fraction stick2 = selection().tickEnd();
+        for (staff_idx_t staffIdx = selection().staffStart(); staffIdx < selection().staffEnd(); ++staffIdx) {
+            loadLinkedExcerpts(staff(staffIdx));
+        }
         cr = deleteRange(s1, s2, staff2track(selection().staffStart()), staff2track(selection().staffEnd()), selectionFilter());
         s1 = tick2segment(stick1);
         s2 = tick2segment(stick2, true);
@@ -3154,6 +3164,8 @@ void Score::cmdDeleteSelection()
         std::set<Spanner*> deletedSpanners;
 
         for (EngravingItem* e : el) {
+            loadLinkedExcerpts(e);
+
             // these are the linked elements we are about to delete
             std::list<EngravingObject*> links;
             if (e->links()) {
@@ -3666,6 +3678,8 @@ void Score::nextInputPos(ChordRest* cr, bool doSelect)
 
 MeasureBase* Score::insertMeasure(ElementType type, MeasureBase* beforeMeasure, const InsertMeasureOptions& options)
 {
+    loadLinkedExcerpts();
+
     Fraction tick;
     if (beforeMeasure) {
         if (beforeMeasure->isMeasure()) {
@@ -4142,6 +4156,8 @@ void Score::timeDelete(Measure* m, Segment* startSegment, const Fraction& f)
         return;
     }
 
+    loadLinkedExcerpts();
+
     const Fraction tick  = startSegment->rtick();
     const Fraction len   = f;
     const Fraction etick = tick + len;
@@ -4246,6 +4262,9 @@ void Score::timeDelete(Measure* m, Segment* startSegment, const Fraction& f)
 
 void Score::cloneVoice(track_idx_t strack, track_idx_t dtrack, Segment* sf, const Fraction& lTick, bool link, bool spanner)
 {
+    loadLinkedExcerpts(staff(strack / VOICES));
+    loadLinkedExcerpts(staff(dtrack / VOICES));
+
     Fraction start = sf->tick();
     TieMap tieMap;
     TupletMap tupletMap;      // tuplets cannot cross measure boundaries
@@ -4515,6 +4534,8 @@ void Score::cloneVoice(track_idx_t strack, track_idx_t dtrack, Segment* sf, cons
 
 bool Score::undoPropertyChanged(EngravingItem* e, Pid t, const PropertyValue& st, PropertyFlags ps)
 {
+    loadLinkedExcerpts(e);
+
     bool changed = false;
 
     if (propertyLink(t) && e->links()) {
@@ -4588,6 +4609,8 @@ void Score::undoChangeElement(EngravingItem* oldElement, EngravingItem* newEleme
 
 void Score::undoChangePitch(Note* note, int pitch, int tpc1, int tpc2)
 {
+    loadLinkedExcerpts(note);
+
     for (EngravingObject* e : note->linkList()) {
         Note* n = toNote(e);
         undoStack()->push(new ChangePitch(n, pitch, tpc1, tpc2), 0);
@@ -4605,6 +4628,8 @@ void Score::undoChangePitch(Note* note, int pitch, int tpc1, int tpc2)
 
 void Score::undoChangeFretting(Note* note, int pitch, int string, int fret, int tpc1, int tpc2)
 {
+    loadLinkedExcerpts(note);
+
     const LinkedObjects* l = note->links();
     if (l) {
         for (EngravingObject* e : *l) {
@@ -4622,6 +4647,8 @@ void Score::undoChangeFretting(Note* note, int pitch, int string, int fret, int
 
 void Score::undoChangeKeySig(Staff* ostaff, const Fraction& tick, KeySigEvent key)
 {
+    loadLinkedExcerpts(ostaff);
+
     KeySig* lks = 0;
 
     for (Staff* staff : ostaff->staffList()) {
@@ -4722,6 +4749,8 @@ void Score::updateInstrumentChangeTranspositions(KeySigEvent& key, Staff* staff,
 
 void Score::undoChangeClef(Staff* ostaff, EngravingItem* e, ClefType ct, bool forInstrumentChange)
 {
+    loadLinkedExcerpts(ostaff);
+
     bool moveClef = false;
     SegmentType st = SegmentType::Clef;
     if (e->isMeasure()) {
@@ -4942,6 +4971,8 @@ static Chord* findLinkedChord(Chord* c, Staff* nstaff)
 
 void Score::undoChangeChordRestLen(ChordRest* cr, const TDuration& d)
 {
+    loadLinkedExcerpts(cr);
+
     auto sl = cr->staff()->staffList();
     for (Staff* staff : sl) {
         ChordRest* ncr;
@@ -4973,6 +5004,9 @@ void Score::undoTransposeHarmony(Harmony* h, int rootTpc, int baseTpc)
 
 void Score::undoExchangeVoice(Measure* measure, voice_idx_t srcVoice, voice_idx_t dstVoice, staff_idx_t srcStaff, staff_idx_t dstStaff)
 {
+    loadLinkedExcerpts(staff(srcStaff));
+    loadLinkedExcerpts(staff(dstStaff));
+
     Fraction tick = measure->tick();
 
     for (staff_idx_t staffIdx = srcStaff; staffIdx < dstStaff; ++staffIdx) {
@@ -5090,6 +5124,8 @@ void Score::undoExchangeVoice(Measure* measure, voice_idx_t srcVoice, voice_idx_
 
 void Score::undoRemovePart(Part* part, staff_idx_t idx)
 {
+    loadLinkedExcerpts(part);
+
     undo(new RemovePart(part, idx));
 }
 
@@ -5109,6 +5145,8 @@ void Score::undoInsertPart(Part* part, int idx)
 
 void Score::undoRemoveStaff(Staff* staff)
 {
+    loadLinkedExcerpts(staff);
+
     const staff_idx_t staffIndex = staff->idx();
     assert(staffIndex != mu::nidx);
 
@@ -5195,6 +5233,8 @@ void Score::undoChangeInvisible(EngravingItem* e, bool v)
 
 void Score::undoAddElement(EngravingItem* element, bool addToLinkedStaves, bool ctrlModifier)
 {
+    loadLinkedExcerpts(element);
+
     Staff* ostaff = element->staff();
     track_idx_t strack = mu::nidx;
     if (ostaff) {
@@ -5781,6 +5821,8 @@ void Score::undoAddElement(EngravingItem* element, bool addToLinkedStaves, bool
 
 void Score::undoAddCR(ChordRest* cr, Measure* measure, const Fraction& tick)
 {
+    loadLinkedExcerpts(cr);
+
     assert(!cr->isChord() || !(toChord(cr)->notes()).empty());
     if (!cr->lyrics().empty()) {
         // Add chordrest and lyrics separately for correct
@@ -5931,6 +5973,8 @@ void Score::undoRemoveElement(EngravingItem* element)
     if (!element) {
         return;
     }
+
+    loadLinkedExcerpts(element);
     std::list<Segment*> segments;
     for (EngravingObject* ee : element->linkList()) {
         EngravingItem* e = static_cast<EngravingItem*>(ee);
@@ -5962,6 +6006,8 @@ void Score::undoRemoveElement(EngravingItem* element)
 
 void Score::undoChangeSpannerElements(Spanner* spanner, EngravingItem* startElement, EngravingItem* endElement)
 {
+    loadLinkedExcerpts(spanner);
+
     EngravingItem* oldStartElement = spanner->startElement();
     EngravingItem* oldEndElement = spanner->endElement();
     track_idx_t startDeltaTrack = startElement && oldStartElement ? startElement->track() - oldStartElement->track() : 0;
@@ -6061,6 +6107,8 @@ void Score::undoInsertTime(const Fraction& tick, const Fraction& len)
         return;
     }
 
+    loadLinkedExcerpts();
+
     std::list<Spanner*> sl;
     for (auto i : _spanner.map()) {
         Spanner* s = i.second;
@@ -6261,6 +6309,8 @@ void Score::undoRemoveMeasures(Measure* m1, Measure* m2, bool preserveTies)
 
 void Score::undoChangeMeasureRepeatCount(Measure* m, int i, staff_idx_t staffIdx)
 {
+    loadLinkedExcerpts(staff(staffIdx));
+
     for (Staff* st : staff(staffIdx)->staffList()) {
         Score* linkedScore = st->score();
         staff_idx_t linkedStaffIdx = st->idx();
@@ -389,6 +389,7 @@ static void changeProperty(EngravingObject* e, Pid t, const PropertyValue& st, P
 static void changeProperties(EngravingObject* e, Pid t, const PropertyValue& st, PropertyFlags ps)
 {
     if (propertyLink(t)) {
+        e->score()->loadLinkedExcerpts(e);
         for (EngravingObject* ee : e->linkList()) {
             changeProperty(ee, t, st, ps);
         }
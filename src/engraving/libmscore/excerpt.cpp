@@ -91,6 +91,39 @@ void Excerpt::setInited(bool inited)
     m_inited = inited;
 }
 
+bool Excerpt::isLoaded() const
+{
+    return !m_loader;
+}
+
+void Excerpt::setLoader(const Loader& loader)
+{
+    m_loader = loader;
+}
+
+void Excerpt::load()
+{
+    if (!m_loader) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    ObjectArena::Scope arenaScope(m_excerptScore ? m_excerptScore->objectArena() : nullptr);
+
+    //! NOTE Reset the loader before the reading, so that the excerpt is considered as loaded during it
+    Loader loader = std::move(m_loader);
+    m_loader = nullptr;
+
+    loader(this);
+
+    if (m_masterScore && !m_inited) {
+        //! NOTE The parts known before the loading are replaced by the linked ones
+        m_parts.clear();
+        m_masterScore->initParts(this);
+    }
+}
+
 const ID& Excerpt::initialPartId() const
 {
     return m_initialPartId;
@@ -180,6 +213,10 @@ size_t Excerpt::nstaves() const
 
 bool Excerpt::isEmpty() const
 {
+    if (!isLoaded()) {
+        return false;
+    }
+
     return excerptScore() ? excerptScore()->parts().empty() : true;
 }
 
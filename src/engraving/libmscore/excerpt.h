@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_EXCERPT_H
 #define MU_ENGRAVING_EXCERPT_H
 
+#include <functional>
 #include <map>
 
 #include "types/fraction.h"
@@ -49,6 +50,15 @@ public:
 
     bool inited() const;
 
+    //! NOTE The excerpts read from the file might stay unparsed until they are really needed,
+    //! in this case the excerpt score is an empty placeholder, filled in by the loader (see ScoreReader::loadMscz).
+    //! The master parts of an unloaded excerpt are known, so it's loaded only when the changes reach them
+    using Loader = std::function<void (Excerpt*)>;
+
+    bool isLoaded() const;
+    void setLoader(const Loader& loader);
+    void load();
+
     const ID& initialPartId() const;
     void setInitialPartId(const ID& id);
 
@@ -107,6 +117,7 @@ private:
     TracksMap m_tracksMapping;
     bool m_inited = false;
     ID m_initialPartId;
+    Loader m_loader;
 };
 }
 
@@ -983,6 +983,8 @@ void FretDiagram::setBarre(int string, int fret, bool add /*= false*/)
 
 void FretDiagram::undoSetFretDot(int _string, int _fret, bool _add /*= true*/, FretDotType _dtype /*= FretDotType::NORMAl*/)
 {
+    score()->loadLinkedExcerpts(this);
+
     for (EngravingObject* e : linkList()) {
         FretDiagram* fd = toFretDiagram(e);
         fd->score()->undo(new FretDot(fd, _string, _fret, _add, _dtype));
@@ -995,6 +997,8 @@ void FretDiagram::undoSetFretDot(int _string, int _fret, bool _add /*= true*/, F
 
 void FretDiagram::undoSetFretMarker(int _string, FretMarkerType _mtype)
 {
+    score()->loadLinkedExcerpts(this);
+
     for (EngravingObject* e : linkList()) {
         FretDiagram* fd = toFretDiagram(e);
         fd->score()->undo(new FretMarker(fd, _string, _mtype));
@@ -1008,6 +1012,8 @@ void FretDiagram::undoSetFretMarker(int _string, FretMarkerType _mtype)
 
 void FretDiagram::undoSetFretBarre(int _string, int _fret, bool _add /*= false*/)
 {
+    score()->loadLinkedExcerpts(this);
+
     for (EngravingObject* e : linkList()) {
         FretDiagram* fd = toFretDiagram(e);
         fd->score()->undo(new FretBarre(fd, _string, _fret, _add));
@@ -1124,6 +1130,8 @@ void FretDiagram::clear()
 
 void FretDiagram::undoFretClear()
 {
+    score()->loadLinkedExcerpts(this);
+
     for (EngravingObject* e : linkList()) {
         FretDiagram* fd = toFretDiagram(e);
         fd->score()->undo(new FretClear(fd));
@@ -85,6 +85,8 @@ void InstrumentChange::setInstrument(const Instrument& i)
 
 void InstrumentChange::setupInstrument(const Instrument* instrument)
 {
+    score()->loadLinkedExcerpts(this);
+
     if (_init) {
         Fraction tickStart = segment()->tick();
         Part* part = staff()->part();
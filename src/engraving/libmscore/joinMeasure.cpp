@@ -37,6 +37,8 @@ namespace mu::engraving {
 
 void Score::cmdJoinMeasure(Measure* m1, Measure* m2)
 {
+    loadLinkedExcerpts();
+
     if (!m1 || !m2) {
         return;
     }
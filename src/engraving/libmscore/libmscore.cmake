@@ -47,8 +47,6 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/bracketItem.h
     ${CMAKE_CURRENT_LIST_DIR}/breath.cpp
     ${CMAKE_CURRENT_LIST_DIR}/breath.h
-    ${CMAKE_CURRENT_LIST_DIR}/bsp.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/bsp.h
     ${CMAKE_CURRENT_LIST_DIR}/bsymbol.cpp
     ${CMAKE_CURRENT_LIST_DIR}/bsymbol.h
     ${CMAKE_CURRENT_LIST_DIR}/changeMap.cpp
@@ -182,6 +180,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/measurenumberbase.h
     ${CMAKE_CURRENT_LIST_DIR}/measurerepeat.cpp
     ${CMAKE_CURRENT_LIST_DIR}/measurerepeat.h
+    ${CMAKE_CURRENT_LIST_DIR}/measuretickindex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/measuretickindex.h
     ${CMAKE_CURRENT_LIST_DIR}/midimapping.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mmrest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mmrest.h
@@ -270,8 +270,12 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/spacer.h
     ${CMAKE_CURRENT_LIST_DIR}/spanner.cpp
     ${CMAKE_CURRENT_LIST_DIR}/spanner.h
+    ${CMAKE_CURRENT_LIST_DIR}/spannerintervaltree.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/spannerintervaltree.h
     ${CMAKE_CURRENT_LIST_DIR}/spannermap.cpp
     ${CMAKE_CURRENT_LIST_DIR}/spannermap.h
+    ${CMAKE_CURRENT_LIST_DIR}/spatialindex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/spatialindex.h
     ${CMAKE_CURRENT_LIST_DIR}/splitMeasure.cpp
     ${CMAKE_CURRENT_LIST_DIR}/staff.cpp
     ${CMAKE_CURRENT_LIST_DIR}/staff.h
@@ -62,6 +62,10 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
     _repeatList2 = new RepeatList(this);
     setMasterScore(this);
 
+    if (configuration()) {
+        _undoStack->setMemoryLimit(configuration()->undoHistoryMemoryLimit());
+    }
+
     _pos[int(POS::CURRENT)] = Fraction(0, 1);
     _pos[int(POS::LEFT)]    = Fraction(0, 1);
     _pos[int(POS::RIGHT)]   = Fraction(0, 1);
@@ -97,6 +101,8 @@ MasterScore::MasterScore(const MStyle& s, std::weak_ptr<engraving::EngravingProj
 
 MasterScore::~MasterScore()
 {
+    ObjectArena::Scope arenaScope(objectArena());
+
     if (m_project.lock()) {
         m_project.lock()->m_masterScore = nullptr;
     }
@@ -225,6 +231,10 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
         return false;
     }
 
+    if (!onlySelection) {
+        loadExcerpts();
+    }
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
@@ -374,7 +384,7 @@ bool MasterScore::exportPart(MscWriter& mscWriter, Score* partScore)
 
 void MasterScore::addExcerpt(Excerpt* ex, size_t index)
 {
-    if (!ex->inited()) {
+    if (!ex->inited() && ex->isLoaded()) {
         initParts(ex);
     }
 
@@ -382,6 +392,45 @@ void MasterScore::addExcerpt(Excerpt* ex, size_t index)
     setExcerptsChanged(true);
 }
 
+//---------------------------------------------------------
+//   hasUnloadedExcerpts
+//---------------------------------------------------------
+
+bool MasterScore::hasUnloadedExcerpts() const
+{
+    for (const Excerpt* excerpt : _excerpts) {
+        if (!excerpt->isLoaded()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------
+//   loadExcerpts
+//    the unloaded excerpts are linked to the master score
+//    through the read context, which is valid only until
+//    the master score is changed
+//---------------------------------------------------------
+
+void MasterScore::loadExcerpts()
+{
+    for (Excerpt* excerpt : _excerpts) {
+        excerpt->load();
+    }
+}
+
+void MasterScore::loadExcerpts(const Part* masterPart)
+{
+    for (Excerpt* excerpt : _excerpts) {
+        //! NOTE The parts of the excerpt might be unknown, e.g. its staves aren't linked
+        if (!excerpt->isLoaded() && (excerpt->parts().empty() || excerpt->containsPart(masterPart))) {
+            excerpt->load();
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   removeExcerpt
 //---------------------------------------------------------
@@ -122,6 +122,7 @@ class MasterScore : public Score
     int updateMidiMapping();
 
     friend class EngravingProject;
+    friend class Excerpt;
     friend class compat::ScoreAccess;
     friend class compat::Read114;
     friend class compat::Read206;
@@ -214,6 +215,10 @@ public:
     void removeExcerpt(Excerpt*);
     void deleteExcerpt(Excerpt*);
 
+    bool hasUnloadedExcerpts() const;
+    void loadExcerpts();
+    void loadExcerpts(const Part* masterPart);
+
     void initAndAddExcerpt(Excerpt*, bool);
     void initExcerpt(Excerpt*);
     void initEmptyExcerpt(Excerpt*);
@@ -915,6 +915,8 @@ void Measure::add(EngravingItem* e)
         e->setParent(this);
     }
 
+    invalidateLayoutStamp();
+
     ElementType type = e->type();
 
     switch (type) {
@@ -1000,7 +1002,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -1050,6 +1052,8 @@ void Measure::remove(EngravingItem* e)
     assert(e->explicitParent() == this);
     assert(e->score() == score());
 
+    invalidateLayoutStamp();
+
     switch (e->type()) {
     case ElementType::SEGMENT:
     {
@@ -1119,7 +1123,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -1318,6 +1322,8 @@ void Measure::cmdRemoveStaves(staff_idx_t sStaff, staff_idx_t eStaff)
 
 void Measure::cmdAddStaves(staff_idx_t sStaff, staff_idx_t eStaff, bool createRest)
 {
+    score()->loadLinkedExcerpts();
+
     score()->undo(new InsertStaves(this, sStaff, eStaff));
 
     Segment* ts = findSegment(SegmentType::TimeSig, tick());
@@ -1555,6 +1561,8 @@ bool Measure::acceptDrop(EditData& data) const
 
 EngravingItem* Measure::drop(EditData& data)
 {
+    score()->loadLinkedExcerpts();
+
     EngravingItem* e = data.dropElement;
     staff_idx_t staffIdx = mu::nidx;
     Segment* seg = nullptr;
@@ -1875,6 +1883,8 @@ EngravingItem* Measure::drop(EditData& data)
 
 void Measure::adjustToLen(Fraction nf, bool appendRestsIfNecessary)
 {
+    score()->loadLinkedExcerpts();
+
     Fraction ol   = ticks();
     Fraction nl   = nf;
     Fraction diff = nl - ol;
@@ -2644,7 +2654,7 @@ Measure* Measure::cloneMeasure(Score* sc, const Fraction& tick, TieMap* tieMap)
 {
     Measure* m      = new Measure(sc->dummy()->system());
     m->m_timesig    = m_timesig;
-    m->_len         = _len;
+    m->setTicks(_len);
     m->m_repeatCount = m_repeatCount;
 
     assert(sc->staves().size() >= m_mstaves.size());   // destination score we're cloning into must have at least as many staves as measure being cloned
@@ -2883,7 +2893,7 @@ bool Measure::setProperty(Pid propertyId, const PropertyValue& value)
         m_timesig = value.value<Fraction>();
         break;
     case Pid::TIMESIG_ACTUAL:
-        _len = value.value<Fraction>();
+        setTicks(value.value<Fraction>());
         break;
     case Pid::MEASURE_NUMBER_MODE:
         setMeasureNumberMode(MeasureNumberMode(value.toInt()));
@@ -2932,6 +2942,18 @@ PropertyValue Measure::propertyDefault(Pid propertyId) const
     return MeasureBase::propertyDefault(propertyId);
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest != m) {
+        m_mmRest = m;
+        invalidateTickIndex();
+    }
+}
+
 //-------------------------------------------------------------------
 //   mmRestFirst
 //    this is a multi measure rest
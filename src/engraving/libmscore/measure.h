@@ -308,7 +308,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* mmRest1() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -374,6 +374,26 @@ public:
 
     void respaceSegments();
 
+    //! NOTE Inputs of the last LayoutMeasure::getNextMeasure() pass over the measure.
+    //! The pass is skipped for the measures out of the edited range, if the inputs are the same
+    struct LayoutStamp {
+        bool valid = false;
+        uint64_t styleGeneration = 0;
+        Fraction tick;
+        size_t stavesCount = 0;
+        size_t stavesContextHash = 0;
+
+        bool operator==(const LayoutStamp& s) const
+        {
+            return valid && s.valid && styleGeneration == s.styleGeneration && tick == s.tick
+                   && stavesCount == s.stavesCount && stavesContextHash == s.stavesContextHash;
+        }
+    };
+
+    const LayoutStamp& layoutStamp() const { return m_layoutStamp; }
+    void setLayoutStamp(const LayoutStamp& stamp) { m_layoutStamp = stamp; }
+    void invalidateLayoutStamp() { m_layoutStamp.valid = false; }
+
 private:
     double _squeezableSpace = 0;
     friend class Factory;
@@ -415,6 +435,8 @@ private:
 
     double m_layoutStretch = 1.0;
     bool _isWidthLocked = false;
+
+    LayoutStamp m_layoutStamp;
 };
 } // namespace mu::engraving
 #endif
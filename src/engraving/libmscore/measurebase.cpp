@@ -345,7 +345,55 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
-    _tick = f;
+    if (_tick != f) {
+        _tick = f;
+        invalidateTickIndex();
+    }
+}
+
+//---------------------------------------------------------
+//   setTicks
+//---------------------------------------------------------
+
+void MeasureBase::setTicks(const Fraction& f)
+{
+    if (_len != f) {
+        _len = f;
+        invalidateTickIndex();
+    }
+}
+
+//---------------------------------------------------------
+//   setNext
+//    multimeasure rests are linked to the measure list without being in it,
+//    so the links matter for the tick index too
+//---------------------------------------------------------
+
+void MeasureBase::setNext(MeasureBase* e)
+{
+    if (_next != e) {
+        _next = e;
+        invalidateTickIndex();
+    }
+}
+
+void MeasureBase::setPrev(MeasureBase* e)
+{
+    if (_prev != e) {
+        _prev = e;
+        invalidateTickIndex();
+    }
+}
+
+//---------------------------------------------------------
+//   invalidateTickIndex
+//---------------------------------------------------------
+
+void MeasureBase::invalidateTickIndex()
+{
+    if (score()) {
+        score()->measures()->invalidateTickIndex();
+    }
 }
 
 //---------------------------------------------------------
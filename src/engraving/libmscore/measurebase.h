@@ -91,6 +91,7 @@ protected:
 
     Fraction _len  { Fraction(0, 1) };    ///< actual length of measure
     void cleanupLayoutBreaks(bool undo);
+    void invalidateTickIndex();
 
 public:
 
@@ -108,10 +109,10 @@ public:
 
     MeasureBase* next() const { return _next; }
     MeasureBase* nextMM() const;
-    void setNext(MeasureBase* e) { _next = e; }
+    void setNext(MeasureBase* e);
     MeasureBase* prev() const { return _prev; }
     MeasureBase* prevMM() const;
-    void setPrev(MeasureBase* e) { _prev = e; }
+    void setPrev(MeasureBase* e);
     MeasureBase* top() const;
 
     Measure* nextMeasure() const;
@@ -148,7 +149,7 @@ public:
     void setTick(const Fraction& f);
 
     Fraction ticks() const { return _len; }
-    void setTicks(const Fraction& f) { _len = f; }
+    void setTicks(const Fraction& f);
 
     Fraction endTick() const { return _tick + _len; }
 
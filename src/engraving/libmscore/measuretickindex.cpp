@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "measuretickindex.h"
+
+#include <algorithm>
+
+#include "measure.h"
+#include "score.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   invalidate
+//---------------------------------------------------------
+
+void MeasureTickIndex::invalidate()
+{
+    m_measures.valid.store(false, std::memory_order_release);
+    m_measuresMM.valid.store(false, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   update
+//    the list with the multimeasure rests depends on the style too
+//---------------------------------------------------------
+
+void MeasureTickIndex::update(const Score* score) const
+{
+    if (!m_measures.valid.load(std::memory_order_acquire)) {
+        build(m_measures, score->firstMeasure(), false);
+    }
+
+    const bool mmRests = score->styleB(Sid::createMultiMeasureRests);
+    if (!m_measuresMM.valid.load(std::memory_order_acquire) || m_measuresMM.mmRests != mmRests) {
+        build(m_measuresMM, score->firstMeasureMM(), true);
+        m_measuresMM.mmRests = mmRests;
+    }
+}
+
+//---------------------------------------------------------
+//   isValid
+//---------------------------------------------------------
+
+bool MeasureTickIndex::isValid() const
+{
+    return m_measures.valid.load(std::memory_order_acquire);
+}
+
+//---------------------------------------------------------
+//   measure
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::measure(const Score* score, const Fraction& tick) const
+{
+    if (!m_measures.valid.load(std::memory_order_acquire)) {
+        return walk(score->firstMeasure(), tick, false);
+    }
+
+    return m_measures.find(tick);
+}
+
+//---------------------------------------------------------
+//   measureMM
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::measureMM(const Score* score, const Fraction& tick) const
+{
+    if (!m_measuresMM.valid.load(std::memory_order_acquire) || m_measuresMM.mmRests != score->styleB(Sid::createMultiMeasureRests)) {
+        return walk(score->firstMeasureMM(), tick, true);
+    }
+
+    return m_measuresMM.find(tick);
+}
+
+//---------------------------------------------------------
+//   build
+//    the ticks may be out of order while they are being set up,
+//    then the list stays invalid and the lookups walk the measures
+//---------------------------------------------------------
+
+void MeasureTickIndex::build(List& list, Measure* first, bool mm)
+{
+    list.valid.store(false, std::memory_order_release);
+    list.entries.clear();
+
+    for (Measure* m = first; m; m = mm ? m->nextMeasureMM() : m->nextMeasure()) {
+        const Fraction tick = m->tick();
+        if (!list.entries.empty() && tick < list.entries.back().tick) {
+            list.entries.clear();
+            return;
+        }
+        list.entries.push_back({ tick, m });
+    }
+
+    list.valid.store(true, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   walk
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::walk(Measure* first, const Fraction& tick, bool mm)
+{
+    Measure* lm = nullptr;
+    for (Measure* m = first; m; m = mm ? m->nextMeasureMM() : m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+
+    // check last measure
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   find
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::List::find(const Fraction& tick) const
+{
+    if (entries.empty()) {
+        return nullptr;
+    }
+
+    auto it = std::upper_bound(entries.begin(), entries.end(), tick, [](const Fraction& t, const Entry& e) {
+        return t < e.tick;
+    });
+
+    if (it != entries.end()) {
+        return it == entries.begin() ? nullptr : std::prev(it)->measure;
+    }
+
+    // check last measure
+    const Entry& last = entries.back();
+    if (tick >= last.tick && tick <= last.measure->endTick()) {
+        return last.measure;
+    }
+
+    return nullptr;
+}
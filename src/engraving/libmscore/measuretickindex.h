@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MU_ENGRAVING_MEASURETICKINDEX_H
+#define MU_ENGRAVING_MEASURETICKINDEX_H
+
+#include <atomic>
+#include <vector>
+
+#include "types/fraction.h"
+
+namespace mu::engraving {
+class Measure;
+class Score;
+
+//---------------------------------------------------------
+//   MeasureTickIndex
+//    Start ticks of the measures in the score order, for the binary search by tick.
+//    There are two lists: of the measures and of the measures with the
+//    multimeasure rests in place of the measures they replace.
+//    invalidate() is called on any change of the measure list, of the measure
+//    ticks or lengths, or of the multimeasure rests. The lists are rebuilt by
+//    update() on the thread of the command: once the ticks are set up again
+//    (Score::setUpTempoMap()), after every undoable change pushed by a command
+//    (Score::undo()), at the end of the command and after the layout,
+//    which creates the multimeasure rests. update() does nothing while the lists are valid.
+//    The lookups don't modify the index, so they can be done from the layout threads,
+//    the command thread waits for them and doesn't update the index meanwhile;
+//    until update() they walk the measures as before.
+//---------------------------------------------------------
+
+class MeasureTickIndex
+{
+public:
+    MeasureTickIndex() = default;
+
+    void invalidate();
+    void update(const Score* score) const;
+    bool isValid() const;
+
+    //! NOTE The last measure starting at or before the tick,
+    //! the tick after the last measure is accepted up to its end tick
+    Measure* measure(const Score* score, const Fraction& tick) const;
+    Measure* measureMM(const Score* score, const Fraction& tick) const;
+
+private:
+    struct Entry {
+        Fraction tick;
+        Measure* measure = nullptr;
+    };
+
+    struct List {
+        std::vector<Entry> entries;
+        //! NOTE Released once the entries are built, acquired before they are read
+        std::atomic<bool> valid = false;
+        bool mmRests = false;
+
+        Measure* find(const Fraction& tick) const;
+    };
+
+    static void build(List& list, Measure* first, bool mm);
+    static Measure* walk(Measure* first, const Fraction& tick, bool mm);
+
+    //! NOTE The lists are a cache of the measure list, update() may be done from the const methods
+    mutable List m_measures;
+    mutable List m_measuresMM;
+};
+}
+
+#endif // MU_ENGRAVING_MEASURETICKINDEX_H
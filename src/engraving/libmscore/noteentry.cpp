@@ -696,6 +696,8 @@ Ret Score::insertChord(const Position& pos)
 
 void Score::localInsertChord(const Position& pos)
 {
+    loadLinkedExcerpts(staff(pos.staffIdx));
+
     const TDuration duration = _is.duration();
     const Fraction fraction  = duration.fraction();
     const Fraction len       = fraction;
@@ -51,7 +51,7 @@ static String revision;
 Page::Page(RootItem* parent)
     : EngravingItem(ElementType::PAGE, parent, ElementFlag::NOT_SELECTABLE), _no(0)
 {
-    bspTreeValid = false;
+    spatialIndexValid = false;
 }
 
 //---------------------------------------------------------
@@ -60,18 +60,32 @@ Page::Page(RootItem* parent)
 
 std::vector<EngravingItem*> Page::items(const RectF& rect)
 {
-    if (!bspTreeValid) {
-        doRebuildBspTree();
-    }
-    return bspTree.items(rect);
+    std::vector<EngravingItem*> result;
+    items(rect, result);
+    return result;
 }
 
 std::vector<EngravingItem*> Page::items(const mu::PointF& point)
 {
-    if (!bspTreeValid) {
-        doRebuildBspTree();
+    std::vector<EngravingItem*> result;
+    items(point, result);
+    return result;
+}
+
+void Page::items(const RectF& rect, std::vector<EngravingItem*>& result)
+{
+    if (!spatialIndexValid) {
+        doRebuildSpatialIndex();
     }
-    return bspTree.items(point);
+    spatialIndex.items(rect, result);
+}
+
+void Page::items(const mu::PointF& point, std::vector<EngravingItem*>& result)
+{
+    if (!spatialIndexValid) {
+        doRebuildSpatialIndex();
+    }
+    spatialIndex.items(point, result);
 }
 
 //---------------------------------------------------------
@@ -319,27 +333,22 @@ void Page::scanElements(void* data, void (* func)(void*, EngravingItem*), bool a
 }
 
 //---------------------------------------------------------
-//   bspInsert
+//   collectElement
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, EngravingItem* e)
-{
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, EngravingItem* /*e*/)
+static void collectElement(void* data, EngravingItem* e)
 {
-    ++(*(int*)data);
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
 }
 
 //---------------------------------------------------------
-//   doRebuildBspTree
+//   doRebuildSpatialIndex
 //---------------------------------------------------------
 
-void Page::doRebuildBspTree()
+void Page::doRebuildSpatialIndex()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    std::vector<EngravingItem*> elements;
+    scanElements(&elements, collectElement, false);
 
     RectF r;
     if (score()->linearMode()) {
@@ -357,9 +366,8 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
-    bspTreeValid = true;
+    spatialIndex.build(r, elements);
+    spatialIndexValid = true;
 }
 
 //---------------------------------------------------------
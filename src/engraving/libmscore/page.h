@@ -26,7 +26,7 @@
 #include <vector>
 
 #include "engravingitem.h"
-#include "bsp.h"
+#include "spatialindex.h"
 
 namespace mu::engraving {
 class RootItem;
@@ -50,10 +50,10 @@ class Page final : public EngravingItem
     std::vector<System*> _systems;
     page_idx_t _no;                        // page number
 
-    BspTree bspTree;
-    bool bspTreeValid;
+    SpatialIndex spatialIndex;
+    bool spatialIndexValid;
 
-    void doRebuildBspTree();
+    void doRebuildSpatialIndex();
 
     friend class Factory;
     Page(RootItem* parent);
@@ -92,7 +92,15 @@ public:
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
-    void invalidateBspTree() { bspTreeValid = false; }
+    void items(const mu::RectF& r, std::vector<EngravingItem*>& result);
+    void items(const mu::PointF& p, std::vector<EngravingItem*>& result);
+    void invalidateSpatialIndex() { spatialIndexValid = false; }
+    void rebuildSpatialIndexIfNeeded()
+    {
+        if (!spatialIndexValid) {
+            doRebuildSpatialIndex();
+        }
+    }
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
@@ -101,6 +101,8 @@ static void transposeChord(Chord* c, Interval srcTranspose, const Fraction& tick
 
 bool Score::pasteStaff(XmlReader& e, Segment* dst, staff_idx_t dstStaff, Fraction scale)
 {
+    loadLinkedExcerpts();
+
     assert(dst->isChordRestType());
 
     std::vector<Harmony*> pastedHarmony;
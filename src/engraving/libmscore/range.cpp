@@ -709,6 +709,8 @@ void ScoreRange::read(Segment* first, Segment* last, bool readSpanner)
 
 bool ScoreRange::write(Score* score, const Fraction& tick) const
 {
+    score->loadLinkedExcerpts();
+
     for (TrackList* dl : tracks) {
         track_idx_t track = dl->track();
         if (!dl->write(score, tick)) {
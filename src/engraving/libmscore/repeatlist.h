@@ -23,6 +23,7 @@
 #ifndef __REPEATLIST_H__
 #define __REPEATLIST_H__
 
+#include <atomic>
 #include <set>
 #include <vector>
 
@@ -80,7 +81,7 @@ class RepeatList : public std::vector<RepeatSegment*>
     OBJECT_ALLOCATOR(engraving, RepeatList)
 
     Score* _score = nullptr;
-    mutable unsigned idx1, idx2;     // cached values
+    mutable std::atomic<unsigned> idx1, idx2;     // cached values, the playback events are rendered from several threads
 
     bool _expanded = false;
     bool _scoreChanged = true;
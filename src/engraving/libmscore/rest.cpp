@@ -172,7 +172,7 @@ mu::RectF Rest::drag(EditData& ed)
     }
     setOffset(PointF(s.x(), s.y()));
     layout();
-    score()->rebuildBspTree();
+    score()->rebuildSpatialIndex();
     return abbox().united(r);
 }
 
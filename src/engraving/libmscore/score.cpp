@@ -155,6 +155,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -174,6 +175,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -194,6 +196,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
 
 void MeasureBaseList::add(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     MeasureBase* el = e->next();
     if (el == 0) {
         push_back(e);
@@ -215,6 +218,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    _tickIndex.invalidate();
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -234,6 +238,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    _tickIndex.invalidate();
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -258,6 +263,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    _tickIndex.invalidate();
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -282,6 +288,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    _tickIndex.invalidate();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -315,6 +322,13 @@ Score::Score()
     _selection(this),
     m_layout(this)
 {
+    if (ObjectAllocator::enabled()) {
+        static std::atomic<int> scoresCount = 0;
+        m_objectArena = std::make_unique<ObjectArena>("score " + std::to_string(++scoresCount));
+    }
+
+    ObjectArena::Scope arenaScope(m_objectArena.get());
+
     Score::validScores.insert(this);
     _masterScore = 0;
     Layer l;
@@ -395,6 +409,16 @@ Score::Score(MasterScore* parent, const MStyle& s)
 
 Score::~Score()
 {
+    //! NOTE The scope of an unfinished command can't outlive its arena
+    m_cmdArenaScope.reset();
+    if (_masterScore && _masterScore->m_cmdArenaScope && _masterScore->m_cmdArenaScope->arena() == m_objectArena.get()) {
+        _masterScore->m_cmdArenaScope.reset();
+    }
+
+    //! NOTE The elements are still destroyed one by one, but their chunks only go to the cache of the scope,
+    //! the memory is released at once with the arena
+    ObjectArena::Scope arenaScope(m_objectArena.get());
+
     Score::validScores.erase(this);
 
     for (MuseScoreView* v : viewer) {
@@ -626,6 +650,8 @@ void Score::setUpTempoMap()
 
     masterScore()->updateRepeatListTempo();
     _needSetUpTempoMap = false;
+
+    _measures.updateTickIndex(this);
 }
 
 //---------------------------------------------------------
@@ -842,10 +868,10 @@ void Score::dragPosition(const PointF& p, staff_idx_t* rst, Segment** seg, doubl
 void Score::setShowInvisible(bool v)
 {
     _showInvisible = v;
-    // BSP tree does not include elements which are not
+    // the spatial index of the pages does not include elements which are not
     // displayed, so we need to refresh it to get
     // invisible elements displayed or properly hidden.
-    rebuildBspTree();
+    rebuildSpatialIndex();
 }
 
 //---------------------------------------------------------
@@ -2350,6 +2376,8 @@ bool Score::appendMeasuresFromScore(Score* score, const Fraction& startTick, con
 
 void Score::splitStaff(staff_idx_t staffIdx, int splitPoint)
 {
+    loadLinkedExcerpts(staff(staffIdx));
+
 //      LOGD("split staff %d point %d", staffIdx, splitPoint);
 
     //
@@ -2517,6 +2545,8 @@ void Score::splitStaff(staff_idx_t staffIdx, int splitPoint)
 
 void Score::cmdRemovePart(Part* part)
 {
+    loadLinkedExcerpts(part);
+
     if (!part) {
         return;
     }
@@ -2890,6 +2920,8 @@ KeyList Score::keyList() const
 
 void Score::cmdRemoveStaff(staff_idx_t staffIdx)
 {
+    loadLinkedExcerpts(staff(staffIdx));
+
     Staff* s = staff(staffIdx);
     adjustBracketsDel(staffIdx, staffIdx + 1);
 
@@ -3029,6 +3061,9 @@ void Score::sortStaves(std::vector<staff_idx_t>& dst)
             m->mmRest()->sortStaves(dst);
         }
     }
+    //! NOTE The staves of the spanners might be moved to other parts without a track change,
+    //! the lookup trees of the spanners are rebuilt at once
+    _spanner.setDirty();
     for (auto i : _spanner.map()) {
         Spanner* sp = i.second;
         voice_idx_t voice    = sp->voice();
@@ -3070,6 +3105,8 @@ void Score::mapExcerptTracks(const std::vector<staff_idx_t>& dst)
 
 void Score::cmdConcertPitchChanged(bool flag)
 {
+    loadLinkedExcerpts();
+
     if (flag == styleB(Sid::concertPitch)) {
         return;
     }
@@ -4368,11 +4405,17 @@ void Score::cmdSelectSection()
 
 //---------------------------------------------------------
 //   undo
+//    the lookups by tick done by the rest of the command
+//    shouldn't walk the measures changed by this one
 //---------------------------------------------------------
 
 void Score::undo(UndoCommand* cmd, EditData* ed) const
 {
     undoStack()->push(cmd, ed);
+
+    for (const Score* s : masterScore()->scoreList()) {
+        s->_measures.updateTickIndex(s);
+    }
 }
 
 //---------------------------------------------------------
@@ -5528,12 +5571,35 @@ String Score::name() const
     return _excerpt ? _excerpt->name() : String();
 }
 
+//---------------------------------------------------------
+//   RefreshCollector
+//---------------------------------------------------------
+
+static thread_local Score::RefreshCollector* s_refreshCollector = nullptr;
+
+Score::RefreshCollector::RefreshCollector()
+    : m_prev(s_refreshCollector)
+{
+    s_refreshCollector = this;
+}
+
+Score::RefreshCollector::~RefreshCollector()
+{
+    s_refreshCollector = m_prev;
+}
+
 //---------------------------------------------------------
 //   addRefresh
 //---------------------------------------------------------
 
 void Score::addRefresh(const mu::RectF& r)
 {
+    if (s_refreshCollector) {
+        s_refreshCollector->refresh.unite(r);
+        s_refreshCollector->added = true;
+        return;
+    }
+
     _updateState.refresh.unite(r);
     cmdState().setUpdateMode(UpdateMode::Update);
 }
@@ -5612,10 +5678,10 @@ ShadowNote& Score::shadowNote() const
     return *m_shadowNote;
 }
 
-void Score::rebuildBspTree()
+void Score::rebuildSpatialIndex()
 {
     for (Page* page : pages()) {
-        page->invalidateBspTree();
+        page->invalidateSpatialIndex();
     }
 }
 
@@ -5739,6 +5805,9 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     m_layoutOptions.updateFromStyle(style());
     m_layout.doLayoutRange(m_layoutOptions, st, et);
 
+    //! NOTE The layout creates and moves the multimeasure rests
+    _measures.updateTickIndex(this);
+
     if (_resetAutoplace) {
         _resetAutoplace = false;
         resetAutoplace();
@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "async/channel.h"
+#include "global/allocator.h"
 #include "io/iodevice.h"
 #include "types/ret.h"
 
@@ -46,6 +47,7 @@
 
 #include "chordlist.h"
 #include "input.h"
+#include "measuretickindex.h"
 #include "mscore.h"
 #include "property.h"
 #include "scoreorder.h"
@@ -164,6 +166,7 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first = nullptr;
     MeasureBase* _last = nullptr;
+    MeasureTickIndex _tickIndex;
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -172,7 +175,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; _tickIndex.invalidate(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -180,6 +183,10 @@ public:
     void change(MeasureBase* o, MeasureBase* n);
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
+
+    const MeasureTickIndex& tickIndex() const { return _tickIndex; }
+    void invalidateTickIndex() { _tickIndex.invalidate(); }
+    void updateTickIndex(const Score* score) const { _tickIndex.update(score); }
 };
 
 //---------------------------------------------------------
@@ -311,6 +318,8 @@ class UpdateState
 {
 public:
     mu::RectF refresh;                 ///< area to update, canvas coordinates
+    mu::RectF changedArea;             ///< area changed by the last update, canvas coordinates
+    bool allChanged { false };         ///< the systems are moved by the last update, everything is changed
     bool _playNote   { false };     ///< play selected note after command
     bool _playChord  { false };     ///< play whole chord for the selected note
     bool _selectionChanged { false };
@@ -371,6 +380,10 @@ private:
     friend class Layout;
 
     static std::set<Score*> validScores;
+
+    std::unique_ptr<ObjectArena> m_objectArena;
+    std::unique_ptr<ObjectArena::Scope> m_cmdArenaScope; // of the master score, from startCmd() to endCmd()
+
     int _linkId { 0 };
     MasterScore* _masterScore { 0 };
     std::list<MuseScoreView*> viewer;
@@ -543,7 +556,7 @@ public:
 
     mu::async::Channel<EngravingItem*> elementDestroyed();
 
-    void rebuildBspTree();
+    void rebuildSpatialIndex();
     bool noStaves() const { return _staves.empty(); }
     void insertPart(Part*, staff_idx_t);
     void appendPart(Part*);
@@ -751,6 +764,7 @@ public:
 
     void startCmd();                    // start undoable command
     void endCmd(bool rollback = false, bool layoutAllParts = false); // end undoable command
+    void loadLinkedExcerpts(const EngravingObject* object = nullptr);
     void update() { update(true); }
     void lockUpdates(bool locked);
     void undoRedo(bool undo, EditData*);
@@ -770,6 +784,19 @@ public:
     virtual void setInstrumentsChanged(bool);
     void addRefresh(const mu::RectF&);
 
+    //! NOTE While it exists, addRefresh() on its thread collects the rects into it instead of the score state,
+    //! the layout tasks on the TaskScheduler pool add them to the score afterwards (see LayoutMeasure::prepareMeasures)
+    struct RefreshCollector {
+        RefreshCollector();
+        ~RefreshCollector();
+
+        mu::RectF refresh;
+        bool added = false;
+
+    private:
+        RefreshCollector* m_prev = nullptr;
+    };
+
     void cmdToggleAutoplace(bool all);
 
     bool playNote() const { return _updateState._playNote; }
@@ -780,6 +807,14 @@ public:
     bool selectionChanged() const { return _updateState._selectionChanged; }
     void setSelectionChanged(bool val) { _updateState._selectionChanged = val; }
     void deleteLater(EngravingObject* e) { _updateState._deleteList.push_back(e); }
+
+    //! NOTE The area changed by the last update(), e.g. for the caches of the painted score.
+    //! It's collected by the layout (the pages laid out again) and from the refresh of the command
+    const mu::RectF& changedArea() const { return _updateState.changedArea; }
+    bool isAllChanged() const { return _updateState.allChanged; }
+    void addChangedArea(const mu::RectF& r) { _updateState.changedArea.unite(r); }
+    void setAllChanged() { _updateState.allChanged = true; }
+    void resetChangedArea() { _updateState.changedArea = mu::RectF(); _updateState.allChanged = false; }
     void deletePostponed();
 
     void changeSelectedNotesVoice(voice_idx_t);
@@ -1056,6 +1091,12 @@ public:
     void updateHairpin(Hairpin*);         // add/modify hairpin to pitchOffset list
 
     MasterScore* masterScore() const { return _masterScore; }
+
+    //! NOTE The memory of the elements of the score, nullptr if the custom allocator isn't built (BUILD_ALLOCATOR).
+    //! The arena is current while the score is created, read, laid out and destroyed, during the commands
+    //! (from startCmd() to endCmd()) and undo/redo; the elements created elsewhere come from the global allocators.
+    //! The linked elements created by a command in the other scores come from the arena of the command's score
+    ObjectArena* objectArena() const { return m_objectArena.get(); }
     void setMasterScore(MasterScore* s) { _masterScore = s; }
     void writeSegments(XmlWriter& xml, track_idx_t strack, track_idx_t etrack, Segment* sseg, Segment* eseg, bool, bool);
 
@@ -1097,6 +1138,7 @@ public:
     const LayoutOptions& layoutOptions() const { return m_layoutOptions; }
     void setLayoutMode(LayoutMode lm) { m_layoutOptions.mode = lm; }
     void setShowVBox(bool v) { m_layoutOptions.showVBox = v; }
+    void setParallelMeasureLayout(bool v) { m_layoutOptions.parallelMeasureLayout = v; }
 
     // temporary methods
     bool isLayoutMode(LayoutMode lm) const { return m_layoutOptions.isMode(lm); }
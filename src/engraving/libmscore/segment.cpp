@@ -566,6 +566,10 @@ void Segment::add(EngravingItem* el)
         el->setParent(this);
     }
 
+    if (measure()) {
+        measure()->invalidateLayoutStamp();
+    }
+
     track_idx_t track = el->track();
     assert(track != mu::nidx);
     assert(el->score() == score());
@@ -715,6 +719,10 @@ void Segment::remove(EngravingItem* el)
 
     track_idx_t track = el->track();
 
+    if (measure()) {
+        measure()->invalidateLayoutStamp();
+    }
+
     switch (el->type()) {
     case ElementType::CHORD:
     case ElementType::REST:
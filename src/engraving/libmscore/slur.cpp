@@ -230,6 +230,8 @@ bool SlurSegment::edit(EditData& ed)
 
 void SlurSegment::changeAnchor(EditData& ed, EngravingItem* element)
 {
+    score()->loadLinkedExcerpts(spanner());
+
     ChordRest* cr = element->isChordRest() ? toChordRest(element) : nullptr;
     ChordRest* scr = spanner()->startCR();
     ChordRest* ecr = spanner()->endCR();
@@ -2030,7 +2032,7 @@ void Slur::layout()
 
 void Slur::setTrack(track_idx_t n)
 {
-    EngravingItem::setTrack(n);
+    Spanner::setTrack(n);
     for (SpannerSegment* ss : spannerSegments()) {
         ss->setTrack(n);
     }
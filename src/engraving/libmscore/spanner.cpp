@@ -1196,6 +1196,25 @@ EngravingItem* Spanner::prevSegmentElement()
     return score()->firstElement();
 }
 
+//---------------------------------------------------------
+//   setTrack
+//---------------------------------------------------------
+
+void Spanner::setTrack(track_idx_t v)
+{
+    if (track() == v) {
+        return;
+    }
+
+    EngravingItem::setTrack(v);
+
+    Score* score = this->score();
+
+    if (score) {
+        score->spannerMap().updateSpanner(this);   // the part might be changed
+    }
+}
+
 //---------------------------------------------------------
 //   setTick
 //---------------------------------------------------------
@@ -1211,7 +1230,7 @@ void Spanner::setTick(const Fraction& v)
     Score* score = this->score();
 
     if (score) {
-        score->spannerMap().setDirty();
+        score->spannerMap().updateSpanner(this);
     }
 
     _startUniqueTicks = score ? score->repeatList().tick2utick(tick().ticks()) : 0;
@@ -1241,7 +1260,7 @@ void Spanner::setTicks(const Fraction& f)
     Score* score = this->score();
 
     if (score) {
-        score->spannerMap().setDirty();
+        score->spannerMap().updateSpanner(this);
     }
 
     _endUniqueTicks = score ? score->repeatList().tick2utick(tick2().ticks()) : 0;
@@ -213,6 +213,8 @@ public:
     int startUniqueTicks() const;
     int endUniqueTicks() const;
 
+    void setTrack(track_idx_t v) override;
+
     track_idx_t track2() const { return _track2; }
     void setTrack2(track_idx_t v) { _track2 = v; }
     track_idx_t effectiveTrack2() const { return _track2 == mu::nidx ? track() : _track2; }
@@ -0,0 +1,418 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spannerintervaltree.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   build
+//---------------------------------------------------------
+
+void SpannerIntervalTree::build(const IntervalList& intervals)
+{
+    std::vector<uint64_t> orders(intervals.size());
+    for (size_t i = 0; i < orders.size(); ++i) {
+        orders[i] = i;
+    }
+
+    build(intervals, orders);
+}
+
+void SpannerIntervalTree::build(const IntervalList& intervals, const std::vector<uint64_t>& orders)
+{
+    clear();
+
+    m_nodes.reserve(intervals.size());
+    m_nodeByValue.reserve(intervals.size());
+
+    std::vector<NodeIdx> sorted;
+    sorted.reserve(intervals.size());
+
+    for (size_t i = 0; i < intervals.size(); ++i) {
+        NodeIdx idx = newNode(intervals[i], orders[i]);
+        m_nodeByValue[intervals[i].value] = idx;
+        sorted.push_back(idx);
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [this](NodeIdx a, NodeIdx b) {
+        return less(a, b);
+    });
+
+    m_root = buildRange(sorted, 0, sorted.size());
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::buildRange(const std::vector<NodeIdx>& sorted, size_t from, size_t to)
+{
+    if (from >= to) {
+        return NO_NODE;
+    }
+
+    const size_t mid = from + (to - from) / 2;
+    const NodeIdx idx = sorted[mid];
+
+    m_nodes[idx].left = buildRange(sorted, from, mid);
+    m_nodes[idx].right = buildRange(sorted, mid + 1, to);
+    updateNode(idx);
+
+    return idx;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerIntervalTree::clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_nodeByValue.clear();
+    m_root = NO_NODE;
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void SpannerIntervalTree::insert(const Interval& interval, uint64_t order)
+{
+    const NodeIdx idx = newNode(interval, order);
+    m_nodeByValue[interval.value] = idx;
+    m_root = insert(m_root, idx);
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::insert(NodeIdx root, NodeIdx idx)
+{
+    if (root == NO_NODE) {
+        return idx;
+    }
+
+    if (less(idx, root)) {
+        const NodeIdx left = insert(m_nodes[root].left, idx);
+        m_nodes[root].left = left;
+    } else {
+        const NodeIdx right = insert(m_nodes[root].right, idx);
+        m_nodes[root].right = right;
+    }
+
+    return balance(root);
+}
+
+//---------------------------------------------------------
+//   remove
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::remove(const Spanner* value)
+{
+    auto it = m_nodeByValue.find(value);
+    if (it == m_nodeByValue.end()) {
+        return false;
+    }
+
+    const NodeIdx idx = it->second;
+    m_nodeByValue.erase(it);
+
+    m_root = remove(m_root, idx);
+
+    m_nodes[idx] = Node();
+    m_freeNodes.push_back(idx);
+
+    return true;
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::remove(NodeIdx root, NodeIdx idx)
+{
+    if (root == NO_NODE) {
+        return NO_NODE;
+    }
+
+    if (root == idx) {
+        const NodeIdx left = m_nodes[root].left;
+        NodeIdx right = m_nodes[root].right;
+        if (right == NO_NODE) {
+            return left;
+        }
+
+        //! NOTE The next node takes the place of the removed one
+        NodeIdx minIdx = NO_NODE;
+        right = removeMin(right, minIdx);
+        m_nodes[minIdx].left = left;
+        m_nodes[minIdx].right = right;
+        return balance(minIdx);
+    }
+
+    if (less(idx, root)) {
+        const NodeIdx left = remove(m_nodes[root].left, idx);
+        m_nodes[root].left = left;
+    } else {
+        const NodeIdx right = remove(m_nodes[root].right, idx);
+        m_nodes[root].right = right;
+    }
+
+    return balance(root);
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::removeMin(NodeIdx root, NodeIdx& minIdx)
+{
+    if (m_nodes[root].left == NO_NODE) {
+        minIdx = root;
+        return m_nodes[root].right;
+    }
+
+    const NodeIdx left = removeMin(m_nodes[root].left, minIdx);
+    m_nodes[root].left = left;
+
+    return balance(root);
+}
+
+bool SpannerIntervalTree::contains(const Spanner* value) const
+{
+    return m_nodeByValue.find(value) != m_nodeByValue.end();
+}
+
+//---------------------------------------------------------
+//   findOverlapping
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findOverlapping(int start, int stop, IntervalList& result) const
+{
+    findOverlapping(m_root, start, stop, result);
+}
+
+void SpannerIntervalTree::findOverlapping(NodeIdx idx, int start, int stop, IntervalList& result) const
+{
+    if (idx == NO_NODE) {
+        return;
+    }
+
+    const Node& node = m_nodes[idx];
+    if (node.maxStop < start) {
+        return;
+    }
+
+    findOverlapping(node.left, start, stop, result);
+
+    //! NOTE The nodes to the right start even later
+    if (node.start > stop) {
+        return;
+    }
+
+    if (node.stop >= start) {
+        result.emplace_back(node.start, node.stop, node.value);
+    }
+
+    findOverlapping(node.right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   findContained
+//---------------------------------------------------------
+
+void SpannerIntervalTree::findContained(int start, int stop, IntervalList& result) const
+{
+    findContained(m_root, start, stop, result);
+}
+
+void SpannerIntervalTree::findContained(NodeIdx idx, int start, int stop, IntervalList& result) const
+{
+    if (idx == NO_NODE) {
+        return;
+    }
+
+    const Node& node = m_nodes[idx];
+
+    if (node.start >= start) {
+        findContained(node.left, start, stop, result);
+    }
+
+    if (node.start > stop) {
+        return;
+    }
+
+    if (node.start >= start && node.stop <= stop) {
+        result.emplace_back(node.start, node.stop, node.value);
+    }
+
+    findContained(node.right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   newNode
+//---------------------------------------------------------
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::newNode(const Interval& interval, uint64_t order)
+{
+    NodeIdx idx = NO_NODE;
+    if (m_freeNodes.empty()) {
+        idx = static_cast<NodeIdx>(m_nodes.size());
+        m_nodes.emplace_back();
+    } else {
+        idx = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+
+    Node& node = m_nodes[idx];
+    node.start = interval.start;
+    node.stop = interval.stop;
+    node.maxStop = interval.stop;
+    node.order = order;
+    node.value = interval.value;
+
+    return idx;
+}
+
+bool SpannerIntervalTree::less(NodeIdx a, NodeIdx b) const
+{
+    const Node& na = m_nodes[a];
+    const Node& nb = m_nodes[b];
+    return na.start < nb.start || (na.start == nb.start && na.order < nb.order);
+}
+
+//---------------------------------------------------------
+//   balance
+//---------------------------------------------------------
+
+void SpannerIntervalTree::updateNode(NodeIdx idx)
+{
+    Node& node = m_nodes[idx];
+    node.height = 1 + std::max(height(node.left), height(node.right));
+    node.maxStop = node.stop;
+
+    if (node.left != NO_NODE) {
+        node.maxStop = std::max(node.maxStop, m_nodes[node.left].maxStop);
+    }
+
+    if (node.right != NO_NODE) {
+        node.maxStop = std::max(node.maxStop, m_nodes[node.right].maxStop);
+    }
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::rotateLeft(NodeIdx idx)
+{
+    const NodeIdx right = m_nodes[idx].right;
+    m_nodes[idx].right = m_nodes[right].left;
+    m_nodes[right].left = idx;
+
+    updateNode(idx);
+    updateNode(right);
+
+    return right;
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::rotateRight(NodeIdx idx)
+{
+    const NodeIdx left = m_nodes[idx].left;
+    m_nodes[idx].left = m_nodes[left].right;
+    m_nodes[left].right = idx;
+
+    updateNode(idx);
+    updateNode(left);
+
+    return left;
+}
+
+SpannerIntervalTree::NodeIdx SpannerIntervalTree::balance(NodeIdx idx)
+{
+    updateNode(idx);
+
+    const NodeIdx left = m_nodes[idx].left;
+    const NodeIdx right = m_nodes[idx].right;
+    const int factor = height(left) - height(right);
+
+    if (factor > 1) {
+        if (height(m_nodes[left].left) < height(m_nodes[left].right)) {
+            m_nodes[idx].left = rotateLeft(left);
+        }
+        return rotateRight(idx);
+    }
+
+    if (factor < -1) {
+        if (height(m_nodes[right].right) < height(m_nodes[right].left)) {
+            m_nodes[idx].right = rotateRight(right);
+        }
+        return rotateLeft(idx);
+    }
+
+    return idx;
+}
+
+//---------------------------------------------------------
+//   isValid
+//---------------------------------------------------------
+
+bool SpannerIntervalTree::isValid() const
+{
+    int maxStop = 0;
+    int h = 0;
+    if (!isValid(m_root, maxStop, h)) {
+        return false;
+    }
+
+    //! NOTE In-order traversal, the nodes must go in the order of the keys
+    std::vector<NodeIdx> sorted;
+    std::vector<NodeIdx> stack;
+    NodeIdx idx = m_root;
+    while (idx != NO_NODE || !stack.empty()) {
+        while (idx != NO_NODE) {
+            stack.push_back(idx);
+            idx = m_nodes[idx].left;
+        }
+
+        idx = stack.back();
+        stack.pop_back();
+
+        if (!sorted.empty() && !less(sorted.back(), idx)) {
+            return false;
+        }
+
+        sorted.push_back(idx);
+        idx = m_nodes[idx].right;
+    }
+
+    return sorted.size() == m_nodeByValue.size() && sorted.size() + m_freeNodes.size() == m_nodes.size();
+}
+
+bool SpannerIntervalTree::isValid(NodeIdx idx, int& maxStop, int& h) const
+{
+    if (idx == NO_NODE) {
+        h = 0;
+        return true;
+    }
+
+    const Node& node = m_nodes[idx];
+    int leftMaxStop = node.stop;
+    int rightMaxStop = node.stop;
+    int leftHeight = 0;
+    int rightHeight = 0;
+
+    if (!isValid(node.left, leftMaxStop, leftHeight) || !isValid(node.right, rightMaxStop, rightHeight)) {
+        return false;
+    }
+
+    maxStop = std::max({ node.stop, node.left != NO_NODE ? leftMaxStop : node.stop, node.right != NO_NODE ? rightMaxStop : node.stop });
+    h = 1 + std::max(leftHeight, rightHeight);
+
+    return node.maxStop == maxStop && node.height == h && std::abs(leftHeight - rightHeight) <= 1;
+}
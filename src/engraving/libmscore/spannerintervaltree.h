@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_SPANNERINTERVALTREE_H
+#define MU_ENGRAVING_SPANNERINTERVALTREE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "thirdparty/intervaltree/IntervalTree.h"
+
+namespace mu::engraving {
+class Spanner;
+
+//---------------------------------------------------------
+//   SpannerIntervalTree
+//    AVL tree of the intervals ordered by (start, order),
+//    every node keeps the max stop of its subtree.
+//    Insert and remove are O(log n), the queries are O(log n + k)
+//    and append the found intervals in the tree order.
+//    The nodes are stored in one array and linked by indexes.
+//    The const methods don't change anything, so they may be called from several threads at the same time.
+//---------------------------------------------------------
+
+class SpannerIntervalTree
+{
+public:
+    using Interval = interval_tree::Interval<Spanner*>;
+    using IntervalList = std::vector<Interval>;
+
+    SpannerIntervalTree() = default;
+
+    //! NOTE The order sorts the intervals with the same start, it must be unique.
+    //! Without the orders the intervals get the orders of their indexes
+    void build(const IntervalList& intervals);
+    void build(const IntervalList& intervals, const std::vector<uint64_t>& orders);
+    void clear();
+
+    //! NOTE The value must not be in the tree yet
+    void insert(const Interval& interval, uint64_t order);
+    bool remove(const Spanner* value);
+    bool contains(const Spanner* value) const;
+
+    //! NOTE interval.start <= stop && interval.stop >= start
+    void findOverlapping(int start, int stop, IntervalList& result) const;
+
+    //! NOTE interval.start >= start && interval.stop <= stop
+    void findContained(int start, int stop, IntervalList& result) const;
+
+    size_t size() const { return m_nodeByValue.size(); }
+    bool empty() const { return m_nodeByValue.empty(); }
+
+    //! NOTE For the tests, checks the order, the balance and the max stops
+    bool isValid() const;
+
+private:
+    using NodeIdx = int32_t;
+    static constexpr NodeIdx NO_NODE = -1;
+
+    struct Node {
+        int start = 0;
+        int stop = 0;
+        int maxStop = 0;
+        int height = 1;
+        uint64_t order = 0;
+        Spanner* value = nullptr;
+        NodeIdx left = NO_NODE;
+        NodeIdx right = NO_NODE;
+    };
+
+    NodeIdx newNode(const Interval& interval, uint64_t order);
+    bool less(NodeIdx a, NodeIdx b) const;
+
+    int height(NodeIdx idx) const { return idx == NO_NODE ? 0 : m_nodes[idx].height; }
+    void updateNode(NodeIdx idx);
+    NodeIdx rotateLeft(NodeIdx idx);
+    NodeIdx rotateRight(NodeIdx idx);
+    NodeIdx balance(NodeIdx idx);
+
+    NodeIdx insert(NodeIdx root, NodeIdx idx);
+    NodeIdx remove(NodeIdx root, NodeIdx idx);
+    NodeIdx removeMin(NodeIdx root, NodeIdx& minIdx);
+    NodeIdx buildRange(const std::vector<NodeIdx>& sorted, size_t from, size_t to);
+
+    void findOverlapping(NodeIdx idx, int start, int stop, IntervalList& result) const;
+    void findContained(NodeIdx idx, int start, int stop, IntervalList& result) const;
+    bool isValid(NodeIdx idx, int& maxStop, int& height) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<NodeIdx> m_freeNodes;
+    std::unordered_map<const Spanner*, NodeIdx> m_nodeByValue;
+    NodeIdx m_root = NO_NODE;
+};
+} // namespace mu::engraving
+
+#endif // MU_ENGRAVING_SPANNERINTERVALTREE_H
@@ -29,6 +29,11 @@
 using namespace mu;
 
 namespace mu::engraving {
+//!Note Because of the current UX of spanners adjustments spanners collision is a regular thing,
+//!     so we have to manage those cases when two similar spanners (e.g. Pedal line) are overlapping
+//!     with each other.
+static constexpr int COLLIDING_SPANNERS_PADDING = 1;
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
@@ -46,99 +51,207 @@ SpannerMap::SpannerMap()
 
 void SpannerMap::update() const
 {
+    std::lock_guard<std::mutex> lock(updateMutex);
+    rebuild();
+    dirty.store(false, std::memory_order_release);
+}
+
+void SpannerMap::ensureUpdated() const
+{
+    if (!dirty.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(updateMutex);
+    if (dirty.load(std::memory_order_relaxed)) {
+        rebuild();
+        dirty.store(false, std::memory_order_release);
+    }
+}
+
+//---------------------------------------------------------
+//   rebuild
+//    the spanners go to the trees in the order of the map
+//---------------------------------------------------------
+
+void SpannerMap::rebuild() const
+{
+    groups.clear();
+
     IntervalList regularIntervals;
-    IntervalList collisionFreeIntervals;
+    std::vector<uint64_t> regularOrders;
+    regularIntervals.reserve(size());
+    regularOrders.reserve(size());
+
+    for (const auto& pair : *this) {
+        Spanner* s = pair.second;
+        Entry& entry = entries.at(s);
 
-    collectIntervals(regularIntervals, collisionFreeIntervals);
+        regularIntervals.emplace_back(s->tick().ticks(), s->tick2().ticks(), s);
+        regularOrders.push_back(entry.order);
+
+        const Part* part = s->part();
+        entry.grouped = part != nullptr;
+        if (entry.grouped) {
+            entry.groupKey = GroupKey(part->id(), s->type());
+            groups[entry.groupKey].emplace(GroupOrder(pair.first, entry.order), s);
+        }
+    }
 
-    tree = interval_tree::IntervalTree<Spanner*>(regularIntervals);
-    collisionFreeTree = interval_tree::IntervalTree<Spanner*>(collisionFreeIntervals);
-    dirty = false;
+    IntervalList collisionFreeIntervals;
+    std::vector<uint64_t> collisionFreeOrders;
+    collisionFreeIntervals.reserve(size());
+    collisionFreeOrders.reserve(size());
+
+    for (const auto& pair : groups) {
+        for (auto it = pair.second.cbegin(); it != pair.second.cend(); ++it) {
+            collisionFreeIntervals.push_back(collisionFreeInterval(it, pair.second));
+            collisionFreeOrders.push_back(it->first.second);
+        }
+    }
+
+    //! NOTE The same orders as for the incremental updates, the order of adding sorts the spanners with the same start
+    tree.build(regularIntervals, regularOrders);
+    collisionFreeTree.build(collisionFreeIntervals, collisionFreeOrders);
 }
 
 //---------------------------------------------------------
-//   findContained
+//   collisionFreeInterval
+//    the interval is cut by the start of the next spanner of the group
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
+SpannerIntervalTree::Interval SpannerMap::collisionFreeInterval(Group::const_iterator it, const Group& group)
 {
-    if (dirty) {
-        update();
+    Spanner* s = it->second;
+    const int start = s->tick().ticks();
+    int stop = s->tick2().ticks();
+
+    auto next = std::next(it);
+    if (next != group.cend()) {
+        const int nextStart = next->second->tick().ticks();
+        if (stop >= nextStart) {
+            stop = nextStart - COLLIDING_SPANNERS_PADDING;
+        }
     }
 
-    results.clear();
+    return SpannerIntervalTree::Interval(start, stop, s);
+}
 
-    if (excludeCollisions) {
-        collisionFreeTree.findContained(start, stop, results);
-    } else {
-        tree.findContained(start, stop, results);
+//---------------------------------------------------------
+//   insertIntervals
+//---------------------------------------------------------
+
+void SpannerMap::insertIntervals(Spanner* s, Entry& entry)
+{
+    const Part* part = s->part();
+    if (!part) {
+        setDirty();
+        return;
     }
 
-    return results;
+    tree.insert(SpannerIntervalTree::Interval(s->tick().ticks(), s->tick2().ticks(), s), entry.order);
+
+    entry.groupKey = GroupKey(part->id(), s->type());
+    entry.grouped = true;
+
+    Group& group = groups[entry.groupKey];
+    auto it = group.emplace(GroupOrder(entry.it->first, entry.order), s).first;
+
+    collisionFreeTree.insert(collisionFreeInterval(it, group), entry.order);
+
+    //! NOTE The previous spanner of the group might be cut by the new one now
+    if (it != group.begin()) {
+        updateCollisionFreeInterval(std::prev(it), group);
+    }
 }
 
 //---------------------------------------------------------
-//   findOverlapping
+//   removeIntervals
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
+void SpannerMap::removeIntervals(Spanner* s, Entry& entry)
 {
-    if (dirty) {
-        update();
+    tree.remove(s);
+    collisionFreeTree.remove(s);
+
+    if (!entry.grouped) {
+        return;
     }
 
-    results.clear();
+    entry.grouped = false;
 
-    if (excludeCollisions) {
-        collisionFreeTree.findOverlapping(start, stop, results);
-    } else {
-        tree.findOverlapping(start, stop, results);
+    auto groupIt = groups.find(entry.groupKey);
+    IF_ASSERT_FAILED(groupIt != groups.end()) {
+        return;
+    }
+
+    Group& group = groupIt->second;
+    auto it = group.find(GroupOrder(entry.it->first, entry.order));
+    IF_ASSERT_FAILED(it != group.end()) {
+        return;
+    }
+
+    auto prev = it != group.begin() ? std::prev(it) : group.end();
+    group.erase(it);
+
+    //! NOTE The previous spanner of the group is cut by the next one now
+    if (prev != group.end()) {
+        updateCollisionFreeInterval(prev, group);
     }
 
-    return results;
+    if (group.empty()) {
+        groups.erase(groupIt);
+    }
 }
 
-void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const
+void SpannerMap::updateCollisionFreeInterval(Group::const_iterator it, const Group& group)
 {
-    using IntervalsByType = std::map<ElementType, IntervalList>;
-    using IntervalsByPart = std::map<ID, IntervalsByType>;
+    const uint64_t order = it->first.second;
+    collisionFreeTree.remove(it->second);
+    collisionFreeTree.insert(collisionFreeInterval(it, group), order);
+}
 
-    IntervalsByPart intervalsByPart;
+//---------------------------------------------------------
+//   findContained
+//---------------------------------------------------------
 
-    //!Note Because of the current UX of spanners adjustments spanners collision is a regular thing,
-    //!     so we have to manage those cases when two similar spanners (e.g. Pedal line) are overlapping
-    //!     with each other.
-    constexpr int collidingSpannersPadding = 1;
+SpannerMap::IntervalList SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
+{
+    IntervalList result;
+    findContained(start, stop, result, excludeCollisions);
+    return result;
+}
 
-    for (const auto& pair : *this) {
-        int newSpannerStartTick = pair.second->tick().ticks();
-        int newSpannerEndTick = pair.second->tick2().ticks();
+void SpannerMap::findContained(int start, int stop, IntervalList& result, bool excludeCollisions) const
+{
+    ensureUpdated();
 
-        IntervalsByType& intervalsByType = intervalsByPart[pair.second->part()->id()];
-        IntervalList& intervalList = intervalsByType[pair.second->type()];
+    if (excludeCollisions) {
+        collisionFreeTree.findContained(start, stop, result);
+    } else {
+        tree.findContained(start, stop, result);
+    }
+}
 
-        if (!intervalList.empty()) {
-            auto lastIntervalIt = intervalList.rbegin();
-            if (lastIntervalIt->stop >= newSpannerStartTick) {
-                lastIntervalIt->stop = newSpannerStartTick - collidingSpannersPadding;
-            }
-        }
+//---------------------------------------------------------
+//   findOverlapping
+//---------------------------------------------------------
 
-        intervalList.emplace_back(interval_tree::Interval<Spanner*>(newSpannerStartTick,
-                                                                    newSpannerEndTick,
-                                                                    pair.second));
+SpannerMap::IntervalList SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
+{
+    IntervalList result;
+    findOverlapping(start, stop, result, excludeCollisions);
+    return result;
+}
 
-        regularIntervals.push_back(interval_tree::Interval(newSpannerStartTick,
-                                                           newSpannerEndTick,
-                                                           pair.second));
-    }
+void SpannerMap::findOverlapping(int start, int stop, IntervalList& result, bool excludeCollisions) const
+{
+    ensureUpdated();
 
-    for (const auto& pair : intervalsByPart) {
-        for (const auto& intervals : pair.second) {
-            collisionFreeIntervals.insert(collisionFreeIntervals.end(),
-                                          intervals.second.begin(),
-                                          intervals.second.end());
-        }
+    if (excludeCollisions) {
+        collisionFreeTree.findOverlapping(start, stop, result);
+    } else {
+        tree.findOverlapping(start, stop, result);
     }
 }
 
@@ -148,8 +261,18 @@ void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList&
 
 void SpannerMap::addSpanner(Spanner* s)
 {
-    insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    if (entries.find(s) != entries.end()) {
+        LOGD("%s (%p) already added", s->typeName(), s);
+        return;
+    }
+
+    Entry& entry = entries[s];
+    entry.it = insert(std::pair<int, Spanner*>(s->tick().ticks(), s));
+    entry.order = nextOrder++;
+
+    if (!dirty) {
+        insertIntervals(s, entry);
+    }
 }
 
 //---------------------------------------------------------
@@ -158,15 +281,51 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
-        }
+    auto it = entries.find(s);
+    if (it == entries.end()) {
+        LOGD("%s (%p) not found", s->typeName(), s);
+        return false;
     }
-    LOGD("%s (%p) not found", s->typeName(), s);
-    return false;
+
+    if (!dirty) {
+        removeIntervals(s, it->second);
+    }
+
+    erase(it->second.it);
+    entries.erase(it);
+
+    return true;
+}
+
+//---------------------------------------------------------
+//   updateSpanner
+//    the position in the map stays the same, only the lookup trees are updated
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+{
+    if (dirty) {
+        return;
+    }
+
+    auto it = entries.find(s);
+    if (it == entries.end()) {
+        return;
+    }
+
+    removeIntervals(s, it->second);
+    insertIntervals(s, it->second);
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    entries.clear();
+    dirty = true;
 }
 
 #ifndef NDEBUG
@@ -23,50 +23,88 @@
 #ifndef __SPANNERMAP_H__
 #define __SPANNERMAP_H__
 
+#include <atomic>
 #include <map>
-#include "thirdparty/intervaltree/IntervalTree.h"
+#include <mutex>
+#include <unordered_map>
+
+#include "types/id.h"
+#include "types/types.h"
+
+#include "spannerintervaltree.h"
 
 namespace mu::engraving {
 class Spanner;
 
 //---------------------------------------------------------
 //   SpannerMap
+//    Keeps the lookup trees up to date on every add/remove in O(log n).
+//    Only setDirty() and clear() make the next query rebuild the trees.
+//    The queries don't change the map, so several threads may run them at the same time.
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*>
 {
-    mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
-    mutable interval_tree::IntervalTree<Spanner*> collisionFreeTree;
-    mutable std::vector<interval_tree::Interval<Spanner*> > results;
-
 public:
     typedef typename std::multimap<int, Spanner*>::const_reverse_iterator const_reverse_it;
     typedef typename std::multimap<int, Spanner*>::const_iterator const_it;
 
-    using IntervalList = std::vector<interval_tree::Interval<Spanner*> >;
+    using IntervalList = SpannerIntervalTree::IntervalList;
 
     SpannerMap();
 
-    const IntervalList& findContained(int start, int stop, bool excludeCollisions = false) const;
-    const IntervalList& findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+    IntervalList findContained(int start, int stop, bool excludeCollisions = false) const;
+    IntervalList findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+    //! NOTE Append to the result passed by the caller
+    void findContained(int start, int stop, IntervalList& result, bool excludeCollisions = false) const;
+    void findOverlapping(int start, int stop, IntervalList& result, bool excludeCollisions = false) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
 
-    void collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const;
-
     const_reverse_it crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
     const_reverse_it crend() const { return std::multimap<int, Spanner*>::crend(); }
     const_it cbegin() const { return std::multimap<int, Spanner*>::cbegin(); }
     const_it cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
+    void updateSpanner(Spanner* s);               // must be called if a spanner changes start/length/track
+    void clear();
     bool empty() const { return std::multimap<int, Spanner*>::empty(); }
     void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void setDirty() const { dirty = true; }     // the lookup trees will be rebuilt on the next query
 #ifndef NDEBUG
     void dump() const;
 #endif
+
+private:
+    //! NOTE The spanners of one part and one type, the collision free intervals are cut by the next spanner of the group
+    using GroupKey = std::pair<ID, ElementType>;
+    using GroupOrder = std::pair<int, uint64_t>;
+    using Group = std::map<GroupOrder, Spanner*>;
+
+    struct Entry {
+        std::multimap<int, Spanner*>::iterator it;
+        uint64_t order = 0;
+        GroupKey groupKey;
+        bool grouped = false;
+    };
+
+    void ensureUpdated() const;
+    void rebuild() const;
+
+    void insertIntervals(Spanner* s, Entry& entry);
+    void removeIntervals(Spanner* s, Entry& entry);
+    void updateCollisionFreeInterval(Group::const_iterator it, const Group& group);
+
+    static SpannerIntervalTree::Interval collisionFreeInterval(Group::const_iterator it, const Group& group);
+
+    mutable std::unordered_map<const Spanner*, Entry> entries;
+    uint64_t nextOrder = 0;
+
+    mutable std::atomic<bool> dirty;
+    mutable std::mutex updateMutex;
+    mutable SpannerIntervalTree tree;
+    mutable SpannerIntervalTree collisionFreeTree;
+    mutable std::map<GroupKey, Group> groups;
 };
 } // namespace mu::engraving
 
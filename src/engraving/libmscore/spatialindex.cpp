@@ -0,0 +1,294 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spatialindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "engravingitem.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static constexpr size_t ITEMS_PER_CELL = 4;
+static constexpr size_t MAX_CELLS_COUNT = 16384;
+static constexpr size_t MAX_CELLS_PER_ITEM = 32;
+
+//---------------------------------------------------------
+//   build
+//---------------------------------------------------------
+
+void SpatialIndex::build(const RectF& rect, const std::vector<EngravingItem*>& items)
+{
+    clear();
+    setupGrid(rect, items.size());
+
+    m_items.reserve(items.size());
+    m_left.reserve(items.size());
+    m_top.reserve(items.size());
+    m_right.reserve(items.size());
+    m_bottom.reserve(items.size());
+
+    for (EngravingItem* item : items) {
+        addItem(item, item->pageBoundingRect());
+    }
+
+    rebuildCells();
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpatialIndex::clear()
+{
+    m_rect = RectF();
+    m_columns = 0;
+    m_rows = 0;
+
+    m_items.clear();
+    m_left.clear();
+    m_top.clear();
+    m_right.clear();
+    m_bottom.clear();
+
+    m_cellStart.clear();
+    m_cellSlots.clear();
+    m_largeSlots.clear();
+}
+
+//---------------------------------------------------------
+//   items
+//---------------------------------------------------------
+
+void SpatialIndex::items(const RectF& rect, std::vector<EngravingItem*>& result) const
+{
+    const RectF r = rect.normalized();
+    if (r.width() <= 0.0 || r.height() <= 0.0) {
+        return;
+    }
+
+    if (!m_cellStart.empty()) {
+        const CellRange range = cellRange(r.left(), r.top(), r.right(), r.bottom());
+
+        for (int row = range.row1; row <= range.row2; ++row) {
+            for (int col = range.col1; col <= range.col2; ++col) {
+                const size_t cell = size_t(row) * size_t(m_columns) + size_t(col);
+
+                for (Slot i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                    const Slot slot = m_cellSlots[i];
+
+                    //! NOTE An item is added to every cell it covers,
+                    //! report it only from the first cell shared by the item and the rect
+                    if (col != std::max(column(m_left[slot]), range.col1) || row != std::max(this->row(m_top[slot]), range.row1)) {
+                        continue;
+                    }
+
+                    if (intersects(slot, r)) {
+                        result.push_back(m_items[slot]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (Slot slot : m_largeSlots) {
+        if (intersects(slot, r)) {
+            result.push_back(m_items[slot]);
+        }
+    }
+}
+
+void SpatialIndex::items(const PointF& pos, std::vector<EngravingItem*>& result) const
+{
+    auto check = [this, &pos, &result](Slot slot) {
+        EngravingItem* item = m_items[slot];
+        if (containsPoint(slot, pos) && item->contains(pos)) {
+            result.push_back(item);
+        }
+    };
+
+    if (!m_cellStart.empty()) {
+        const size_t cell = size_t(row(pos.y())) * size_t(m_columns) + size_t(column(pos.x()));
+
+        for (Slot i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+            check(m_cellSlots[i]);
+        }
+    }
+
+    for (Slot slot : m_largeSlots) {
+        check(slot);
+    }
+}
+
+//---------------------------------------------------------
+//   setupGrid
+//    about ITEMS_PER_CELL items per cell, the cells are close to square
+//---------------------------------------------------------
+
+void SpatialIndex::setupGrid(const RectF& rect, size_t itemsCount)
+{
+    m_rect = rect.normalized();
+
+    const size_t cellsCount = std::clamp(itemsCount / ITEMS_PER_CELL, size_t(1), MAX_CELLS_COUNT);
+    const double width = m_rect.width();
+    const double height = m_rect.height();
+
+    if (width > 0.0 && height > 0.0) {
+        const double columns = std::round(std::sqrt(double(cellsCount) * width / height));
+        m_columns = std::clamp(static_cast<int>(columns), 1, static_cast<int>(cellsCount));
+        m_rows = std::max(1, static_cast<int>(cellsCount) / m_columns);
+        m_cellWidth = width / m_columns;
+        m_cellHeight = height / m_rows;
+    } else {
+        m_columns = 1;
+        m_rows = 1;
+        m_cellWidth = 1.0;
+        m_cellHeight = 1.0;
+    }
+}
+
+//---------------------------------------------------------
+//   rebuildCells
+//    counting sort of the slots by cells
+//---------------------------------------------------------
+
+void SpatialIndex::rebuildCells()
+{
+    const size_t cellsCount = size_t(m_columns) * size_t(m_rows);
+
+    m_largeSlots.clear();
+    m_cellStart.assign(cellsCount + 1, 0);
+
+    for (Slot slot = 0; slot < m_items.size(); ++slot) {
+        const CellRange range = cellRange(m_left[slot], m_top[slot], m_right[slot], m_bottom[slot]);
+        if (range.cellsCount() > MAX_CELLS_PER_ITEM) {
+            m_largeSlots.push_back(slot);
+            continue;
+        }
+
+        for (int row = range.row1; row <= range.row2; ++row) {
+            for (int col = range.col1; col <= range.col2; ++col) {
+                ++m_cellStart[size_t(row) * size_t(m_columns) + size_t(col) + 1];
+            }
+        }
+    }
+
+    for (size_t cell = 0; cell < cellsCount; ++cell) {
+        m_cellStart[cell + 1] += m_cellStart[cell];
+    }
+
+    m_cellSlots.resize(m_cellStart[cellsCount]);
+    std::vector<Slot> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+
+    for (Slot slot = 0; slot < m_items.size(); ++slot) {
+        const CellRange range = cellRange(m_left[slot], m_top[slot], m_right[slot], m_bottom[slot]);
+        if (range.cellsCount() > MAX_CELLS_PER_ITEM) {
+            continue;
+        }
+
+        for (int row = range.row1; row <= range.row2; ++row) {
+            for (int col = range.col1; col <= range.col2; ++col) {
+                m_cellSlots[cursor[size_t(row) * size_t(m_columns) + size_t(col)]++] = slot;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   addItem
+//---------------------------------------------------------
+
+SpatialIndex::Slot SpatialIndex::addItem(EngravingItem* item, const RectF& rect)
+{
+    const RectF r = rect.normalized();
+    const Slot slot = static_cast<Slot>(m_items.size());
+
+    m_items.push_back(item);
+    m_left.push_back(r.left());
+    m_top.push_back(r.top());
+    m_right.push_back(r.right());
+    m_bottom.push_back(r.bottom());
+
+    return slot;
+}
+
+//---------------------------------------------------------
+//   cellRange
+//---------------------------------------------------------
+
+SpatialIndex::CellRange SpatialIndex::cellRange(double left, double top, double right, double bottom) const
+{
+    CellRange range;
+    range.col1 = column(left);
+    range.row1 = row(top);
+    range.col2 = column(right);
+    range.row2 = row(bottom);
+    return range;
+}
+
+//---------------------------------------------------------
+//   column
+//    the items out of the grid go to the border cells
+//---------------------------------------------------------
+
+int SpatialIndex::column(double x) const
+{
+    const double col = (x - m_rect.left()) / m_cellWidth;
+    if (!(col >= 0.0)) {
+        return 0;
+    }
+
+    return col < m_columns ? static_cast<int>(col) : m_columns - 1;
+}
+
+int SpatialIndex::row(double y) const
+{
+    const double row = (y - m_rect.top()) / m_cellHeight;
+    if (!(row >= 0.0)) {
+        return 0;
+    }
+
+    return row < m_rows ? static_cast<int>(row) : m_rows - 1;
+}
+
+//---------------------------------------------------------
+//   intersects
+//    same as RectF::intersects, the empty boxes don't intersect anything
+//---------------------------------------------------------
+
+bool SpatialIndex::intersects(Slot slot, const RectF& rect) const
+{
+    if (!(m_left[slot] < m_right[slot]) || !(m_top[slot] < m_bottom[slot])) {
+        return false;
+    }
+
+    return m_left[slot] < rect.right() && rect.left() < m_right[slot]
+           && m_top[slot] < rect.bottom() && rect.top() < m_bottom[slot];
+}
+
+bool SpatialIndex::containsPoint(Slot slot, const PointF& pos) const
+{
+    return m_left[slot] <= pos.x() && pos.x() <= m_right[slot]
+           && m_top[slot] <= pos.y() && pos.y() <= m_bottom[slot];
+}
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_SPATIALINDEX_H
+#define MU_ENGRAVING_SPATIALINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "draw/types/geometry.h"
+
+namespace mu::engraving {
+class EngravingItem;
+
+//---------------------------------------------------------
+//   SpatialIndex
+//    Uniform grid over the page. The cells are packed into one array (CSR),
+//    the bounding boxes are stored next to the item pointers (SoA).
+//    The items covering a lot of cells are kept in a separate list and checked linearly.
+//    The index is rebuilt as a whole when the page changes.
+//    Queries append the found items into the buffer passed by the caller.
+//---------------------------------------------------------
+
+class SpatialIndex
+{
+public:
+    SpatialIndex() = default;
+
+    void build(const mu::RectF& rect, const std::vector<EngravingItem*>& items);
+    void clear();
+
+    //! NOTE Items, which bounding boxes intersect the rect
+    void items(const mu::RectF& rect, std::vector<EngravingItem*>& result) const;
+
+    //! NOTE Items, which contain the point (see EngravingItem::contains)
+    void items(const mu::PointF& pos, std::vector<EngravingItem*>& result) const;
+
+    size_t size() const { return m_items.size(); }
+    bool empty() const { return size() == 0; }
+
+private:
+    using Slot = uint32_t;
+
+    struct CellRange {
+        int col1 = 0;
+        int row1 = 0;
+        int col2 = 0;
+        int row2 = 0;
+
+        size_t cellsCount() const { return size_t(col2 - col1 + 1) * size_t(row2 - row1 + 1); }
+    };
+
+    void setupGrid(const mu::RectF& rect, size_t itemsCount);
+    void rebuildCells();
+
+    Slot addItem(EngravingItem* item, const mu::RectF& rect);
+    CellRange cellRange(double left, double top, double right, double bottom) const;
+    int column(double x) const;
+    int row(double y) const;
+
+    bool intersects(Slot slot, const mu::RectF& rect) const;
+    bool containsPoint(Slot slot, const mu::PointF& pos) const;
+
+    // grid
+    mu::RectF m_rect;
+    int m_columns = 0;
+    int m_rows = 0;
+    double m_cellWidth = 1.0;
+    double m_cellHeight = 1.0;
+
+    // items (SoA)
+    std::vector<EngravingItem*> m_items;
+    std::vector<double> m_left;
+    std::vector<double> m_top;
+    std::vector<double> m_right;
+    std::vector<double> m_bottom;
+
+    // cells: the slots of the cell i are m_cellSlots[m_cellStart[i] .. m_cellStart[i + 1])
+    std::vector<Slot> m_cellStart;
+    std::vector<Slot> m_cellSlots;
+
+    std::vector<Slot> m_largeSlots; // cover too many cells
+};
+} // namespace mu::engraving
+
+#endif // MU_ENGRAVING_SPATIALINDEX_H
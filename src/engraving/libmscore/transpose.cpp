@@ -250,6 +250,8 @@ int transposeTpcDiatonicByKey(int tpc, int steps, Key key, bool keepAlteredDegre
 
 bool Score::transpose(Note* n, Interval interval, bool useDoubleSharpsFlats)
 {
+    loadLinkedExcerpts(n);
+
     int npitch;
     int ntpc1, ntpc2;
     transposeInterval(n->pitch(), n->tpc1(), &npitch, &ntpc1, interval, useDoubleSharpsFlats);
@@ -790,6 +792,8 @@ void Score::transposeDiatonicAlterations(TransposeDirection direction)
 
 void Score::transpositionChanged(Part* part, Interval oldV, Fraction tickStart, Fraction tickEnd)
 {
+    loadLinkedExcerpts(part);
+
     if (tickStart == Fraction(-1, 1)) {
         tickStart = Fraction(0, 1);
     }
@@ -863,6 +867,8 @@ void Score::transpositionChanged(Part* part, Interval oldV, Fraction tickStart,
 
 void Score::transpositionChanged(Part* part, const Fraction& instrumentTick, Interval oldTransposition)
 {
+    loadLinkedExcerpts(part);
+
     Fraction tickStart = instrumentTick;
     Fraction tickEnd = { -1, 1 };
 
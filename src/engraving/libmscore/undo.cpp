@@ -34,6 +34,8 @@
 
 #include "undo.h"
 
+#include <set>
+
 #include "iengravingfont.h"
 
 #include "bend.h"
@@ -146,6 +148,49 @@ void updateNoteLines(Segment* segment, track_idx_t track)
     }
 }
 
+//! NOTE The recent history is never compacted by the memory limit
+static constexpr size_t KEPT_MACROS_COUNT = 10;
+
+//---------------------------------------------------------
+//   elementMemoryUsage
+//    the real items are larger, EngravingItem is the common part of them
+//---------------------------------------------------------
+
+static size_t elementMemoryUsage(const EngravingObject* e)
+{
+    size_t result = sizeof(EngravingItem);
+    for (const EngravingObject* child : e->scanChildren()) {
+        result += elementMemoryUsage(child);
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   partMemoryUsage
+//---------------------------------------------------------
+
+static size_t partMemoryUsage(const Part* part)
+{
+    return sizeof(Part) + part->nstaves() * sizeof(Staff) + part->instruments().size() * sizeof(Instrument);
+}
+
+//---------------------------------------------------------
+//   scoreMemoryUsage
+//    the measures with their elements and the parts
+//---------------------------------------------------------
+
+static size_t scoreMemoryUsage(const Score* score)
+{
+    size_t result = sizeof(Score);
+    for (const MeasureBase* mb = score->first(); mb; mb = mb->next()) {
+        result += elementMemoryUsage(mb);
+    }
+    for (const Part* part : score->parts()) {
+        result += partMemoryUsage(part);
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   UndoCommand
 //---------------------------------------------------------
@@ -168,6 +213,19 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t result = sizeof(UndoCommand);
+    for (const UndoCommand* c : childList) {
+        result += c->memoryUsage();
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -247,10 +305,21 @@ bool UndoCommand::hasUnfilteredChildren(const std::vector<UndoCommand::Filter>&
 //---------------------------------------------------------
 
 void UndoCommand::filterChildren(UndoCommand::Filter f, EngravingItem* target)
+{
+    removeChildren([f, target](const UndoCommand* cmd) {
+        return cmd->isFiltered(f, target);
+    });
+}
+
+//---------------------------------------------------------
+//   removeChildren
+//---------------------------------------------------------
+
+void UndoCommand::removeChildren(const std::function<bool(const UndoCommand*)>& pred)
 {
     std::list<UndoCommand*> acceptedList;
     for (UndoCommand* cmd : childList) {
-        if (cmd->isFiltered(f, target)) {
+        if (pred(cmd)) {
             delete cmd;
         } else {
             acceptedList.push_back(cmd);
@@ -381,6 +450,7 @@ void UndoStack::remove(size_t idx)
     while (list.size() > curIdx) {
         UndoCommand* cmd = mu::takeLast(list);
         stateList.pop_back();
+        memoryList.pop_back();
         cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
         delete cmd;
 //            --curIdx;
@@ -388,6 +458,7 @@ void UndoStack::remove(size_t idx)
     while (list.size() > idx) {
         UndoCommand* cmd = mu::takeLast(list);
         stateList.pop_back();
+        memoryList.pop_back();
         cmd->cleanup(true);
         delete cmd;
     }
@@ -400,6 +471,9 @@ void UndoStack::remove(size_t idx)
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    //! NOTE The index is from getCurIdx(), the compacted macros are counted in it
+    startIdx = startIdx > removedCount ? startIdx - removedCount : 0;
+
     assert(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -411,9 +485,108 @@ void UndoStack::mergeCommands(size_t startIdx)
     for (size_t idx = startIdx + 1; idx < curIdx; ++idx) {
         startMacro->append(std::move(*list[idx]));
     }
+    memoryList[startIdx] = startMacro->memoryUsage();
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    approximate memory usage of the undo history
+//---------------------------------------------------------
+
+size_t UndoStack::memoryUsage() const
+{
+    size_t result = 0;
+    for (size_t m : memoryList) {
+        result += m;
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   setMemoryLimit
+//---------------------------------------------------------
+
+void UndoStack::setMemoryLimit(size_t bytes)
+{
+    memoryLimit = bytes;
+    applyMemoryLimit();
+}
+
+//---------------------------------------------------------
+//   applyMemoryLimit
+//    merges the old trivial macros first, then drops
+//    the oldest macros until the history fits the limit
+//---------------------------------------------------------
+
+void UndoStack::applyMemoryLimit()
+{
+    if (memoryLimit == 0 || curCmd || curIdx <= KEPT_MACROS_COUNT) {
+        return;
+    }
+
+    size_t usage = memoryUsage();
+    if (usage <= memoryLimit) {
+        return;
+    }
+
+    const size_t oldRemovedCount = removedCount;
+
+    for (size_t idx = 0; idx + 1 < curIdx - KEPT_MACROS_COUNT && usage > memoryLimit;) {
+        const size_t usageBefore = memoryList[idx] + memoryList[idx + 1];
+        if (mergeTrivialMacros(idx)) {
+            usage = usage - usageBefore + memoryList[idx];
+        } else {
+            ++idx;
+        }
+    }
+
+    while (usage > memoryLimit && curIdx > KEPT_MACROS_COUNT) {
+        UndoCommand* cmd = mu::takeFirst(list);
+        usage -= memoryList.front();
+        memoryList.erase(memoryList.begin());
+        stateList.erase(stateList.begin());     // the state after the dropped macro is the first one now
+        cmd->cleanup(true);
+        delete cmd;
+        --curIdx;
+        ++removedCount;
+        ++droppedCount;
+    }
+
+    if (removedCount != oldRemovedCount) {
+        LOGW() << "undo history is compacted, removed macros: " << removedCount - oldRemovedCount
+               << ", dropped in total: " << droppedCount << ", memory usage: " << usage;
+    }
+}
+
+//---------------------------------------------------------
+//   mergeTrivialMacros
+//    merges the macro at idx with the next one if both
+//    only change the same properties, e.g. nudges of an element
+//---------------------------------------------------------
+
+bool UndoStack::mergeTrivialMacros(size_t idx)
+{
+    UndoMacro* macro = list[idx];
+    UndoMacro* next = list[idx + 1];
+    if (!macro->changesSameProperties(*next)) {
+        return false;
+    }
+
+    macro->append(std::move(*next));
+    macro->compactPropertyChanges();
+    delete next;
+
+    list.erase(list.begin() + idx + 1);
+    memoryList.erase(memoryList.begin() + idx + 1);
+    memoryList[idx] = macro->memoryUsage();
+    stateList.erase(stateList.begin() + idx + 1);     // the state between the macros is gone
+    --curIdx;
+    ++removedCount;
+
+    return true;
+}
+
 //---------------------------------------------------------
 //   pop
 //---------------------------------------------------------
@@ -451,14 +624,18 @@ void UndoStack::endMacro(bool rollback)
         while (list.size() > curIdx) {
             UndoCommand* cmd = mu::takeLast(list);
             stateList.pop_back();
+            memoryList.pop_back();
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
         list.push_back(curCmd);
+        memoryList.push_back(curCmd->memoryUsage());
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+
+    applyMemoryLimit();
 }
 
 //---------------------------------------------------------
@@ -476,6 +653,7 @@ void UndoStack::reopen()
     assert(curIdx > 0);
     --curIdx;
     curCmd = mu::takeAt(list, curIdx);
+    memoryList.erase(memoryList.begin() + curIdx);
     stateList.erase(stateList.begin() + curIdx);
     for (auto i : curCmd->commands()) {
         LOG_UNDO() << "   " << i->name();
@@ -492,7 +670,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element).get());
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -611,6 +789,62 @@ void UndoMacro::append(UndoMacro&& other)
     }
 }
 
+using PropertyKey = std::pair<const EngravingObject*, Pid>;
+
+static std::set<PropertyKey> changedProperties(const UndoMacro& macro)
+{
+    std::set<PropertyKey> result;
+    for (const UndoCommand* command : macro.commands()) {
+        auto changeProperty = static_cast<const ChangeProperty*>(command);
+        result.insert(PropertyKey(changeProperty->getElement(), changeProperty->getId()));
+    }
+    return result;
+}
+
+bool UndoMacro::onlyChangesProperties() const
+{
+    if (empty()) {
+        return false;
+    }
+
+    for (const UndoCommand* command : commands()) {
+        if (command->type() != CommandType::ChangeProperty) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool UndoMacro::changesSameProperties(const UndoMacro& other) const
+{
+    if (m_score != other.m_score || !onlyChangesProperties() || !other.onlyChangesProperties()) {
+        return false;
+    }
+
+    return changedProperties(*this) == changedProperties(other);
+}
+
+//---------------------------------------------------------
+//   compactPropertyChanges
+//    only the first change of every property is kept:
+//    it restores the value from before the macro on undo
+//    and sets the value it got back on redo
+//---------------------------------------------------------
+
+void UndoMacro::compactPropertyChanges()
+{
+    std::set<PropertyKey> changed;
+    removeChildren([&changed](const UndoCommand* command) {
+        if (command->type() != CommandType::ChangeProperty) {
+            return false;
+        }
+
+        auto changeProperty = static_cast<const ChangeProperty*>(command);
+        return !changed.insert(PropertyKey(changeProperty->getElement(), changeProperty->getId())).second;
+    });
+}
+
 const InputState& UndoMacro::undoInputState() const
 {
     return m_undoInputState;
@@ -992,6 +1226,20 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryUsage
+//    the removed element is held by the command
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryUsage() const
+{
+    size_t result = UndoCommand::memoryUsage();
+    if (element) {
+        result += elementMemoryUsage(element);
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1110,6 +1358,16 @@ void InsertPart::redo(EditData*)
     part->score()->insertPart(part, idx);
 }
 
+//---------------------------------------------------------
+//   InsertPart::memoryUsage
+//    the part is held by the command after undo
+//---------------------------------------------------------
+
+size_t InsertPart::memoryUsage() const
+{
+    return UndoCommand::memoryUsage() + partMemoryUsage(part);
+}
+
 //---------------------------------------------------------
 //   RemovePart
 //---------------------------------------------------------
@@ -1130,6 +1388,16 @@ void RemovePart::redo(EditData*)
     part->score()->removePart(part);
 }
 
+//---------------------------------------------------------
+//   RemovePart::memoryUsage
+//    the removed part is held by the command
+//---------------------------------------------------------
+
+size_t RemovePart::memoryUsage() const
+{
+    return UndoCommand::memoryUsage() + partMemoryUsage(part);
+}
+
 //---------------------------------------------------------
 //   SetSoloist
 //---------------------------------------------------------
@@ -2247,6 +2515,20 @@ void AddExcerpt::redo(EditData*)
     excerpt->masterScore()->addExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   AddExcerpt::memoryUsage
+//    the excerpt is held by the command after undo
+//---------------------------------------------------------
+
+size_t AddExcerpt::memoryUsage() const
+{
+    size_t result = UndoCommand::memoryUsage() + sizeof(Excerpt);
+    if (excerpt->excerptScore()) {
+        result += scoreMemoryUsage(excerpt->excerptScore());
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   RemoveExcerpt
 //---------------------------------------------------------
@@ -2285,6 +2567,20 @@ void RemoveExcerpt::redo(EditData*)
     excerpt->masterScore()->removeExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   RemoveExcerpt::memoryUsage
+//    the removed excerpt is held by the command
+//---------------------------------------------------------
+
+size_t RemoveExcerpt::memoryUsage() const
+{
+    size_t result = UndoCommand::memoryUsage() + sizeof(Excerpt);
+    if (excerpt->excerptScore()) {
+        result += scoreMemoryUsage(excerpt->excerptScore());
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   SwapExcerpt::flip
 //---------------------------------------------------------
@@ -28,6 +28,7 @@
  Definition of undo-related classes and structs.
 */
 
+#include <functional>
 #include <map>
 
 #include "modularity/ioc.h"
@@ -104,6 +105,7 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    void removeChildren(const std::function<bool(const UndoCommand*)>& pred);
 
 public:
     enum class Filter {
@@ -126,6 +128,7 @@ public:
     const std::list<UndoCommand*>& commands() const { return childList; }
     virtual std::vector<const EngravingObject*> objectItems() const { return {}; }
     virtual void cleanup(bool undo);
+    virtual size_t memoryUsage() const;     // approximate, with the children and the removed elements held by the command
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -163,6 +166,10 @@ public:
     bool empty() const;
     void append(UndoMacro&& other);
 
+    bool onlyChangesProperties() const;
+    bool changesSameProperties(const UndoMacro& other) const;
+    void compactPropertyChanges();
+
     const InputState& undoInputState() const;
     const InputState& redoInputState() const;
     const SelectionInfo& undoSelectionInfo() const;
@@ -193,17 +200,31 @@ private:
     static void applySelectionInfo(const SelectionInfo&, Selection&);
 };
 
+//---------------------------------------------------------
+//   UndoStack
+//    With the memory limit set, the oldest history is compacted
+//    and then dropped when the macros take more memory than allowed.
+//    The indexes given out by getCurIdx() stay valid, they count
+//    the compacted macros too.
+//---------------------------------------------------------
+
 class UndoStack
 {
     UndoMacro* curCmd = nullptr;
     std::vector<UndoMacro*> list;
+    std::vector<size_t> memoryList;       // approximate memory usage of the macros in the list
     std::vector<int> stateList;
     int nextState = 0;
     int cleanState = 0;
     size_t curIdx = 0;
+    size_t removedCount = 0;              // macros merged or dropped at the beginning of the history
+    size_t droppedCount = 0;              // macros dropped with their changes, can't be undone anymore
+    size_t memoryLimit = 0;               // bytes, 0 - no limit
     bool isLocked = false;
 
     void remove(size_t idx);
+    void applyMemoryLimit();
+    bool mergeTrivialMacros(size_t idx);
 
 public:
     UndoStack();
@@ -220,7 +241,7 @@ public:
     bool canUndo() const { return curIdx > 0; }
     bool canRedo() const { return curIdx < list.size(); }
     bool isClean() const { return cleanState == stateList[curIdx]; }
-    size_t getCurIdx() const { return curIdx; }
+    size_t getCurIdx() const { return removedCount + curIdx; }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
     UndoMacro* prev() const { return curIdx > 1 ? list[curIdx - 2] : 0; }
@@ -230,6 +251,10 @@ public:
 
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t memoryUsage() const;
+    void setMemoryLimit(size_t bytes);
+    size_t droppedMacrosCount() const { return droppedCount; }
 };
 
 class InsertPart : public UndoCommand
@@ -243,6 +268,7 @@ public:
     InsertPart(Part* p, int i);
     void undo(EditData*) override;
     void redo(EditData*) override;
+    size_t memoryUsage() const override;
 
     UNDO_TYPE(CommandType::InsertPart)
     UNDO_NAME("InsertPart")
@@ -260,6 +286,7 @@ public:
     RemovePart(Part*, staff_idx_t idx);
     void undo(EditData*) override;
     void redo(EditData*) override;
+    size_t memoryUsage() const override;
 
     UNDO_TYPE(CommandType::RemovePart)
     UNDO_NAME("RemovePart")
@@ -649,6 +676,7 @@ public:
     void undo(EditData*) override;
     void redo(EditData*) override;
     void cleanup(bool) override;
+    size_t memoryUsage() const override;
     const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
@@ -934,6 +962,7 @@ public:
 
     void undo(EditData*) override;
     void redo(EditData*) override;
+    size_t memoryUsage() const override;
 
     UNDO_TYPE(CommandType::AddExcerpt)
     UNDO_NAME("AddExcerpt")
@@ -953,6 +982,7 @@ public:
 
     void undo(EditData*) override;
     void redo(EditData*) override;
+    size_t memoryUsage() const override;
 
     UNDO_TYPE(CommandType::RemoveExcerpt)
     UNDO_NAME("RemoveExcerpt")
@@ -97,9 +97,11 @@ void ChordArticulationsParser::parseSpanners(const Chord* chord, const Rendering
         return;
     }
 
-    auto intervals = spannerMap.findOverlapping(ctx.nominalPositionStartTick,
-                                                ctx.nominalPositionEndTick,
-                                                /*excludeCollisions*/ true);
+    SpannerMap::IntervalList intervals;
+    spannerMap.findOverlapping(ctx.nominalPositionStartTick,
+                               ctx.nominalPositionEndTick,
+                               intervals,
+                               /*excludeCollisions*/ true);
 
     for (const auto& interval : intervals) {
         Spanner* spanner = interval.value;
@@ -22,6 +22,8 @@
 
 #include "playbackcontext.h"
 
+#include <limits>
+
 #include "libmscore/dynamic.h"
 #include "libmscore/hairpin.h"
 #include "libmscore/measure.h"
@@ -39,6 +41,51 @@
 using namespace mu::engraving;
 using namespace mu::mpe;
 
+//! NOTE The value of a map applies from its tick till the next one
+template<typename Map>
+static void uniteChangedTicks(const Map& map1, const Map& map2, int& tickFrom, int& tickTo)
+{
+    auto it1 = map1.cbegin();
+    auto it2 = map2.cbegin();
+    const typename Map::mapped_type* value1 = nullptr;
+    const typename Map::mapped_type* value2 = nullptr;
+    bool differs = false;
+
+    while (it1 != map1.cend() || it2 != map2.cend()) {
+        int tick = std::numeric_limits<int>::max();
+        if (it1 != map1.cend()) {
+            tick = it1->first;
+        }
+
+        if (it2 != map2.cend()) {
+            tick = std::min(tick, it2->first);
+        }
+
+        if (differs) {
+            tickTo = std::max(tickTo, tick - 1);
+        }
+
+        if (it1 != map1.cend() && it1->first == tick) {
+            value1 = &it1->second;
+            ++it1;
+        }
+
+        if (it2 != map2.cend() && it2->first == tick) {
+            value2 = &it2->second;
+            ++it2;
+        }
+
+        differs = !value1 || !value2 ? value1 != value2 : *value1 != *value2;
+        if (differs) {
+            tickFrom = std::min(tickFrom, tick);
+        }
+    }
+
+    if (differs) {
+        tickTo = std::numeric_limits<int>::max();
+    }
+}
+
 dynamic_level_t PlaybackContext::appliableDynamicLevel(const int nominalPositionTick) const
 {
     auto it = findLessOrEqual(m_dynamicsMap, nominalPositionTick);
@@ -77,6 +124,12 @@ void PlaybackContext::update(const ID partId, const Score* score)
     }
 }
 
+void PlaybackContext::uniteChangedRange(const PlaybackContext& other, int& tickFrom, int& tickTo) const
+{
+    uniteChangedTicks(m_dynamicsMap, other.m_dynamicsMap, tickFrom, tickTo);
+    uniteChangedTicks(m_playTechniquesMap, other.m_playTechniquesMap, tickFrom, tickTo);
+}
+
 void PlaybackContext::clear()
 {
     m_dynamicsMap.clear();
@@ -47,6 +47,10 @@ public:
 
     mpe::DynamicLevelMap dynamicLevelMap(const Score* score) const;
 
+    //! NOTE Extends [tickFrom, tickTo] by the nominal position ticks, where the dynamic level
+    //! or the persistent articulation differ from the ones of the other context
+    void uniteChangedRange(const PlaybackContext& other, int& tickFrom, int& tickTo) const;
+
 private:
     mpe::dynamic_level_t nominalDynamicLevel(const int positionTick) const;
 
@@ -22,6 +22,10 @@
 
 #include "playbackmodel.h"
 
+#include <chrono>
+
+#include "concurrency/taskscheduler.h"
+
 #include "libmscore/fret.h"
 #include "libmscore/instrument.h"
 #include "libmscore/measure.h"
@@ -67,26 +71,18 @@ void PlaybackModel::load(Score* score)
     changesChannel.resetOnReceive(this);
 
     changesChannel.onReceive(this, [this](const ScoreChangesRange& range) {
-        TickBoundaries tickRange = tickBoundaries(range);
-        TrackBoundaries trackRange = trackBoundaries(range);
-
-        clearExpiredTracks();
-        clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
-        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo);
-
-        InstrumentTrackIdSet oldTracks = existingTrackIdSet();
-
-        ChangedTrackIdSet trackChanges;
-        update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
-
-        notifyAboutChanges(oldTracks, trackChanges);
+        onScoreChanged(range);
     });
 
     m_score->tempomap()->tempoMultiplierChanged().onNotify(this, [this]() {
         reload();
     });
 
-    update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks());
+    m_tempoEvents = std::map<int, TEvent>(m_score->tempomap()->cbegin(), m_score->tempomap()->cend());
+
+    updateSetupData();
+    updateContext(0, m_score->ntracks());
+    loadEvents();
 
     for (const auto& pair : m_playbackDataMap) {
         m_trackAdded.send(pair.first);
@@ -100,9 +96,6 @@ void PlaybackModel::reload()
     int trackFrom = 0;
     size_t trackTo = m_score->ntracks();
 
-    int tickFrom = 0;
-    int tickTo = m_score->lastMeasure()->endTick().ticks();
-
     clearExpiredTracks();
     clearExpiredContexts(trackFrom, trackTo);
 
@@ -110,7 +103,11 @@ void PlaybackModel::reload()
         pair.second.originEvents.clear();
     }
 
-    update(tickFrom, tickTo, trackFrom, trackTo);
+    m_tempoEvents = std::map<int, TEvent>(m_score->tempomap()->cbegin(), m_score->tempomap()->cend());
+
+    updateSetupData();
+    updateContext(trackFrom, trackTo);
+    loadEvents();
 
     for (auto& pair : m_playbackDataMap) {
         pair.second.mainStream.send(pair.second.originEvents);
@@ -241,6 +238,11 @@ void PlaybackModel::triggerMetronome(int tick)
     trackPlaybackData->second.offStream.send(std::move(result));
 }
 
+void PlaybackModel::setParallelLoading(bool parallel)
+{
+    m_parallelLoading = parallel;
+}
+
 InstrumentTrackIdSet PlaybackModel::existingTrackIdSet() const
 {
     InstrumentTrackIdSet result;
@@ -262,12 +264,49 @@ async::Channel<InstrumentTrackId> PlaybackModel::trackRemoved() const
     return m_trackRemoved;
 }
 
+//! NOTE Only the changed range is rendered again, plus the uticks depending on the change:
+//! the ones after a tempo change and the ones where the dynamics or the play techniques are changed.
+//! The consumers receive the difference between the old and the new events
+void PlaybackModel::onScoreChanged(const ScoreChangesRange& range)
+{
+    TRACEFUNC;
+
+    TickBoundaries tickRange = tickBoundaries(range);
+    TrackBoundaries trackRange = trackBoundaries(range);
+
+    clearExpiredTracks();
+
+    InstrumentTrackIdSet oldTracks = existingTrackIdSet();
+
+    PlaybackContextMap oldContexts;
+    if (hasDynamicsChanges(range.changedTypes)) {
+        oldContexts = m_playbackCtxMap;
+    }
+
+    updateSetupData();
+    clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
+    updateContext(trackRange.trackFrom, trackRange.trackTo);
+
+    UtickSpan dependentSpan = tempoChangesSpan();
+    if (!oldContexts.empty()) {
+        dependentSpan.unite(dynamicsChangesSpan(oldContexts, trackRange.trackFrom, trackRange.trackTo));
+    }
+
+    m_expiredEvents.clear();
+    clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, dependentSpan);
+
+    ChangedTrackIdSet trackChanges;
+    updateEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges, dependentSpan);
+
+    notifyAboutChanges(oldTracks, trackChanges);
+}
+
 void PlaybackModel::update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
                            ChangedTrackIdSet* trackChanges)
 {
     updateSetupData();
     updateContext(trackFrom, trackTo);
-    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges);
+    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges, UtickSpan());
 }
 
 void PlaybackModel::updateSetupData()
@@ -348,7 +387,7 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
 
         if (chordSymbol->play()) {
             m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profile,
-                                         m_playbackDataMap[trackId].originEvents);
+                                         m_playbackDataMap.at(trackId).originEvents);
         }
 
         collectChangesTracks(trackId, trackChanges);
@@ -389,24 +428,27 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
             }
         }
 
-        const PlaybackContext& ctx = m_playbackCtxMap[trackId];
-
         ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
         if (!profile) {
             LOGE() << "unsupported instrument family: " << item->part()->id();
             continue;
         }
 
+        //! NOTE Only the lookups here, the segments of the different parts are processed concurrently on load
+        static const PlaybackContext EMPTY_CONTEXT;
+        auto ctxIt = m_playbackCtxMap.find(trackId);
+        const PlaybackContext& ctx = ctxIt != m_playbackCtxMap.cend() ? ctxIt->second : EMPTY_CONTEXT;
+
         m_renderer.render(item, tickPositionOffset, ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
                           ctx.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
-                          m_playbackDataMap[trackId].originEvents);
+                          m_playbackDataMap.at(trackId).originEvents);
 
         collectChangesTracks(trackId, trackChanges);
     }
 }
 
 void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                                 ChangedTrackIdSet* trackChanges)
+                                 ChangedTrackIdSet* trackChanges, const UtickSpan& dependentSpan)
 {
     TRACEFUNC;
 
@@ -417,7 +459,10 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
         int repeatStartTick = repeatSegment->tick;
         int repeatEndTick = repeatStartTick + repeatSegment->len();
 
-        if (repeatStartTick > tickTo || repeatEndTick <= tickFrom) {
+        bool repeatInRange = !(repeatStartTick > tickTo || repeatEndTick <= tickFrom);
+        bool repeatInSpan = !(repeatSegment->utick > dependentSpan.utickTo || repeatEndTick + tickPositionOffset <= dependentSpan.utickFrom);
+
+        if (!repeatInRange && !repeatInSpan) {
             continue;
         }
 
@@ -425,7 +470,10 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
             int measureStartTick = measure->tick().ticks();
             int measureEndTick = measure->endTick().ticks();
 
-            if (measureStartTick > tickTo || measureEndTick <= tickFrom) {
+            bool measureInRange = !(measureStartTick > tickTo || measureEndTick <= tickFrom);
+            bool measureInSpan = dependentSpan.contains(measureStartTick + tickPositionOffset);
+
+            if (!measureInRange && !measureInSpan) {
                 continue;
             }
 
@@ -437,7 +485,7 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                 int segmentStartTick = segment->tick().ticks();
                 int segmentEndTick = segmentStartTick + segment->ticks().ticks();
 
-                if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+                if (!measureInSpan && (segmentStartTick > tickTo || segmentEndTick <= tickFrom)) {
                     continue;
                 }
 
@@ -451,15 +499,84 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
     }
 }
 
+//! NOTE The parts are rendered on their own threads: the tasks of TaskScheduler::instance() (ex. the soundfont presets
+//! decoded for the tracks being loaded) don't delay the rendering, and the rendering doesn't delay them
+static TaskScheduler* renderingScheduler()
+{
+    static TaskScheduler s;
+    return &s;
+}
+
+//! NOTE The parts don't share any rendering state, so the events of every part are rendered by a separate task.
+//! The data of the score built lazily (the repeat list, the lookup tree of the spanners, the articulation profiles)
+//! is resolved beforehand, so the tasks only read it
+void PlaybackModel::loadEvents()
+{
+    TRACEFUNC;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    const RepeatList& repeats = repeatList();
+    m_score->spannerMap().update();
+
+    for (const auto& pair : m_playbackDataMap) {
+        defaultActiculationProfile(pair.first);
+    }
+
+    auto renderPart = [this, &repeats](const std::set<staff_idx_t>& staffIdSet) {
+        for (const RepeatSegment* repeatSegment : repeats) {
+            int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+
+            for (const Measure* measure : repeatSegment->measureList()) {
+                for (Segment* segment = measure->first(); segment; segment = segment->next()) {
+                    if (segment->isChordRestType()) {
+                        processSegment(tickPositionOffset, segment, staffIdSet, nullptr);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::future<void> > tasks;
+
+    if (m_parallelLoading) {
+        tasks.reserve(m_score->parts().size());
+
+        for (const Part* part : m_score->parts()) {
+            tasks.push_back(renderingScheduler()->submit([renderPart, staffIdSet = part->staveIdxList()]() {
+                renderPart(staffIdSet);
+            }));
+        }
+    } else {
+        for (const Part* part : m_score->parts()) {
+            renderPart(part->staveIdxList());
+        }
+    }
+
+    //! NOTE The metronome track is common for all the parts
+    PlaybackEventsMap& metronomeEvents = m_playbackDataMap.at(METRONOME_TRACK_ID).originEvents;
+
+    for (const RepeatSegment* repeatSegment : repeats) {
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+
+        for (const Measure* measure : repeatSegment->measureList()) {
+            m_renderer.renderMetronome(m_score, measure->tick().ticks(), measure->endTick().ticks(), tickPositionOffset,
+                                       metronomeEvents);
+        }
+    }
+
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    LOGI() << "playback events of " << m_score->parts().size() << " parts rendered in " << duration.count() << " ms";
+}
+
 bool PlaybackModel::hasToReloadTracks(const ScoreChangesRange& changesRange) const
 {
     static const std::unordered_set<ElementType> REQUIRED_TYPES = {
-        ElementType::PLAYTECH_ANNOTATION,
-        ElementType::DYNAMIC,
-        ElementType::HAIRPIN,
-        ElementType::HAIRPIN_SEGMENT,
         ElementType::HARMONY,
-        ElementType::STAFF_TEXT,
         ElementType::MEASURE_REPEAT,
     };
 
@@ -494,11 +611,7 @@ bool PlaybackModel::hasToReloadScore(const std::unordered_set<ElementType>& chan
 {
     static const std::unordered_set<ElementType> REQUIRED_TYPES = {
         ElementType::SCORE,
-        ElementType::GRADUAL_TEMPO_CHANGE,
-        ElementType::GRADUAL_TEMPO_CHANGE_SEGMENT,
-        ElementType::TEMPO_TEXT,
         ElementType::LAYOUT_BREAK,
-        ElementType::FERMATA,
         ElementType::VOLTA,
         ElementType::VOLTA_SEGMENT,
         ElementType::SYSTEM_TEXT,
@@ -517,6 +630,141 @@ bool PlaybackModel::hasToReloadScore(const std::unordered_set<ElementType>& chan
     return false;
 }
 
+bool PlaybackModel::hasTempoChanges(const std::unordered_set<ElementType>& changedTypes) const
+{
+    static const std::unordered_set<ElementType> TEMPO_TYPES = {
+        ElementType::GRADUAL_TEMPO_CHANGE,
+        ElementType::GRADUAL_TEMPO_CHANGE_SEGMENT,
+        ElementType::TEMPO_TEXT,
+        ElementType::FERMATA,
+    };
+
+    for (const ElementType type : TEMPO_TYPES) {
+        if (changedTypes.find(type) != changedTypes.cend()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool PlaybackModel::hasDynamicsChanges(const std::unordered_set<ElementType>& changedTypes) const
+{
+    static const std::unordered_set<ElementType> DYNAMICS_TYPES = {
+        ElementType::PLAYTECH_ANNOTATION,
+        ElementType::DYNAMIC,
+        ElementType::HAIRPIN,
+        ElementType::HAIRPIN_SEGMENT,
+        ElementType::STAFF_TEXT,
+    };
+
+    for (const ElementType type : DYNAMICS_TYPES) {
+        if (changedTypes.find(type) != changedTypes.cend()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! NOTE The time of a tick depends only on the tempo events before it,
+//! so the events are shifted since the first tick, where the tempo map is changed
+PlaybackModel::UtickSpan PlaybackModel::tempoChangesSpan()
+{
+    const TempoMap* tempoMap = m_score->tempomap();
+
+    auto oldIt = m_tempoEvents.cbegin();
+    auto newIt = tempoMap->cbegin();
+
+    while (oldIt != m_tempoEvents.cend() && newIt != tempoMap->cend()
+           && oldIt->first == newIt->first && oldIt->second == newIt->second) {
+        ++oldIt;
+        ++newIt;
+    }
+
+    if (oldIt == m_tempoEvents.cend() && newIt == tempoMap->cend()) {
+        return UtickSpan();
+    }
+
+    int changedTick = UtickSpan::END;
+    if (oldIt != m_tempoEvents.cend()) {
+        changedTick = oldIt->first;
+    }
+
+    if (newIt != tempoMap->cend()) {
+        changedTick = std::min(changedTick, newIt->first);
+    }
+
+    m_tempoEvents = std::map<int, TEvent>(tempoMap->cbegin(), tempoMap->cend());
+
+    UtickSpan result;
+    for (const RepeatSegment* repeatSegment : repeatList()) {
+        if (repeatSegment->tick + repeatSegment->len() <= changedTick) {
+            continue;
+        }
+
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        result.utickFrom = std::min(result.utickFrom, std::max(changedTick, repeatSegment->tick) + tickPositionOffset);
+        result.utickTo = UtickSpan::END;
+    }
+
+    return alignToMeasures(result);
+}
+
+PlaybackModel::UtickSpan PlaybackModel::dynamicsChangesSpan(const PlaybackContextMap& oldContexts, const track_idx_t trackFrom,
+                                                            const track_idx_t trackTo) const
+{
+    UtickSpan result;
+
+    for (const auto& pair : m_playbackCtxMap) {
+        const Part* part = m_score->partById(pair.first.partId.toUint64());
+        if (!part || part->startTrack() > trackTo || part->endTrack() <= trackFrom) {
+            continue;
+        }
+
+        auto oldCtx = oldContexts.find(pair.first);
+        if (oldCtx == oldContexts.cend()) {
+            pair.second.uniteChangedRange(PlaybackContext(), result.utickFrom, result.utickTo);
+        } else {
+            pair.second.uniteChangedRange(oldCtx->second, result.utickFrom, result.utickTo);
+        }
+    }
+
+    return alignToMeasures(result);
+}
+
+PlaybackModel::UtickSpan PlaybackModel::alignToMeasures(const UtickSpan& span) const
+{
+    if (span.isEmpty()) {
+        return span;
+    }
+
+    UtickSpan result;
+    result.utickFrom = span.utickFrom;
+    result.utickTo = span.utickTo;
+
+    for (const RepeatSegment* repeatSegment : repeatList()) {
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        int repeatEndUtick = repeatSegment->utick + repeatSegment->len();
+
+        if (repeatSegment->utick <= span.utickFrom && span.utickFrom < repeatEndUtick) {
+            const Measure* measure = m_score->tick2measure(Fraction::fromTicks(span.utickFrom - tickPositionOffset));
+            if (measure) {
+                result.utickFrom = measure->tick().ticks() + tickPositionOffset;
+            }
+        }
+
+        if (span.utickTo != UtickSpan::END && repeatSegment->utick <= span.utickTo && span.utickTo < repeatEndUtick) {
+            const Measure* measure = m_score->tick2measure(Fraction::fromTicks(span.utickTo - tickPositionOffset));
+            if (measure) {
+                result.utickTo = measure->endTick().ticks() + tickPositionOffset - 1;
+            }
+        }
+    }
+
+    return result;
+}
+
 bool PlaybackModel::containsTrack(const InstrumentTrackId& trackId) const
 {
     return m_playbackDataMap.find(trackId) != m_playbackDataMap.cend();
@@ -594,7 +842,8 @@ void mu::engraving::PlaybackModel::removeEventsFromRange(const track_idx_t track
     removeTrackEvents(METRONOME_TRACK_ID, timestampFrom, timestampTo);
 }
 
-void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo)
+void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                                       const UtickSpan& dependentSpan)
 {
     TRACEFUNC;
 
@@ -621,6 +870,17 @@ void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, con
 
         removeEventsFromRange(trackFrom, trackTo, timestampFrom, timestampTo);
     }
+
+    if (!dependentSpan.isEmpty()) {
+        timestamp_t timestampFrom = timestampFromTicks(m_score, dependentSpan.utickFrom);
+        timestamp_t timestampTo = -1;
+
+        if (dependentSpan.utickTo != UtickSpan::END) {
+            timestampTo = timestampFromTicks(m_score, dependentSpan.utickTo);
+        }
+
+        removeEventsFromRange(trackFrom, trackTo, timestampFrom, timestampTo);
+    }
 }
 
 void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result)
@@ -634,28 +894,78 @@ void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, Chang
 
 void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks)
 {
-    for (const InstrumentTrackId& trackId : changedTracks) {
+    InstrumentTrackIdSet notifiedTracks = changedTracks;
+    for (const auto& pair : m_expiredEvents) {
+        notifiedTracks.insert(pair.first);
+    }
+
+    bool changed = false;
+
+    for (const InstrumentTrackId& trackId : notifiedTracks) {
         auto search = m_playbackDataMap.find(trackId);
 
         if (search == m_playbackDataMap.cend()) {
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents);
-        search->second.dynamicLevelChanges.send(search->second.dynamicLevelMap);
+        auto expired = m_expiredEvents.find(trackId);
+
+        if (expired == m_expiredEvents.cend()) {
+            search->second.mainStream.send(search->second.originEvents);
+            changed = true;
+        } else {
+            PlaybackEventsDiff diff = eventsDiff(expired->second, search->second.originEvents);
+            if (!diff.empty()) {
+                search->second.mainStreamDiff.send(diff);
+                changed = true;
+            }
+        }
+
+        if (mu::contains(changedTracks, trackId)) {
+            search->second.dynamicLevelChanges.send(search->second.dynamicLevelMap);
+        }
     }
 
+    m_expiredEvents.clear();
+
     for (auto it = m_playbackDataMap.cbegin(); it != m_playbackDataMap.cend(); ++it) {
         if (!mu::contains(oldTracks, it->first)) {
             m_trackAdded.send(it->first);
         }
     }
 
-    if (!changedTracks.empty()) {
+    if (changed || !changedTracks.empty()) {
         m_dataChanged.notify();
     }
 }
 
+PlaybackEventsDiff PlaybackModel::eventsDiff(const ExpiredEvents& expired, const PlaybackEventsMap& events) const
+{
+    PlaybackEventsDiff result;
+
+    for (const auto& pair : expired.events) {
+        auto search = events.find(pair.first);
+
+        if (search == events.cend()) {
+            result.removed.push_back(pair.first);
+        } else if (search->second != pair.second) {
+            result.added.emplace(search->first, search->second);
+        }
+    }
+
+    //! NOTE The events rendered at the new timestamps
+    auto lowerBound = expired.timestampFrom <= 0 ? events.cbegin() : events.lower_bound(expired.timestampFrom);
+    auto upperBound = events.upper_bound(expired.timestampTo);
+
+    for (auto it = lowerBound; it != upperBound; ++it) {
+        if (expired.events.find(it->first) == expired.events.cend()) {
+            result.added.emplace(it->first, it->second);
+        }
+    }
+
+    return result;
+}
+
 void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom,
                                       const mpe::timestamp_t timestampTo)
 {
@@ -666,9 +976,14 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mp
     }
 
     PlaybackData& trackPlaybackData = search->second;
+    ExpiredEvents& expired = m_expiredEvents[trackId];
 
     if (timestampFrom == -1 && timestampTo == -1) {
-        search->second.originEvents.clear();
+        expired.events.merge(trackPlaybackData.originEvents);
+        expired.timestampFrom = std::numeric_limits<timestamp_t>::min();
+        expired.timestampTo = std::numeric_limits<timestamp_t>::max();
+
+        trackPlaybackData.originEvents.clear();
         return;
     }
 
@@ -682,11 +997,22 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mp
         lowerBound = trackPlaybackData.originEvents.lower_bound(timestampFrom);
     }
 
-    auto upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
+    PlaybackEventsMap::const_iterator upperBound;
+
+    if (timestampTo == -1) {
+        upperBound = trackPlaybackData.originEvents.cend();
+    } else {
+        upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
+    }
 
     for (auto it = lowerBound; it != upperBound;) {
-        it = trackPlaybackData.originEvents.erase(it);
+        auto next = std::next(it);
+        expired.events.insert(trackPlaybackData.originEvents.extract(it));
+        it = next;
     }
+
+    expired.timestampFrom = std::min(expired.timestampFrom, timestampFrom == 0 ? std::numeric_limits<timestamp_t>::min() : timestampFrom);
+    expired.timestampTo = std::max(expired.timestampTo, timestampTo == -1 ? std::numeric_limits<timestamp_t>::max() : timestampTo);
 }
 
 PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const ScoreChangesRange& changesRange) const
@@ -696,7 +1022,9 @@ PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const ScoreChanges
     result.trackFrom = staff2track(changesRange.staffIdxFrom, 0);
     result.trackTo = staff2track(changesRange.staffIdxTo, VOICES);
 
-    if (hasToReloadScore(changesRange.changedTypes) || !changesRange.isValidBoundary()) {
+    if (hasToReloadScore(changesRange.changedTypes)
+        || hasTempoChanges(changesRange.changedTypes)
+        || !changesRange.isValidBoundary()) {
         result.trackFrom = 0;
         result.trackTo = m_score->ntracks();
     }
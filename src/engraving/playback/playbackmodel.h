@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <map>
 #include <functional>
+#include <limits>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -36,6 +37,7 @@
 #include "mpe/iarticulationprofilesrepository.h"
 
 #include "types/types.h"
+#include "libmscore/tempo.h"
 #include "playbackeventsrenderer.h"
 #include "playbacksetupdataresolver.h"
 #include "playbackcontext.h"
@@ -74,6 +76,9 @@ public:
 
     void triggerMetronome(int tick);
 
+    //! NOTE The parts are rendered in parallel on load, the serial rendering is for the comparison in the tests
+    void setParallelLoading(bool parallel);
+
     InstrumentTrackIdSet existingTrackIdSet() const;
     async::Channel<InstrumentTrackId> trackAdded() const;
     async::Channel<InstrumentTrackId> trackRemoved() const;
@@ -96,30 +101,70 @@ private:
         track_idx_t trackTo = mu::nidx;
     };
 
+    //! NOTE The uticks (boundaries included) affected by a change through the tempo map or the dynamics,
+    //! they are aligned to the measures
+    struct UtickSpan
+    {
+        static constexpr int END = std::numeric_limits<int>::max();
+
+        int utickFrom = END;
+        int utickTo = std::numeric_limits<int>::min();
+
+        bool isEmpty() const { return utickFrom > utickTo; }
+        bool contains(const int utick) const { return utickFrom <= utick && utick <= utickTo; }
+
+        void unite(const UtickSpan& other)
+        {
+            utickFrom = std::min(utickFrom, other.utickFrom);
+            utickTo = std::max(utickTo, other.utickTo);
+        }
+    };
+
+    //! NOTE The events removed before the rendering, to send only the difference to the consumers
+    struct ExpiredEvents
+    {
+        mpe::PlaybackEventsMap events;
+        mpe::timestamp_t timestampFrom = std::numeric_limits<mpe::timestamp_t>::max();
+        mpe::timestamp_t timestampTo = std::numeric_limits<mpe::timestamp_t>::min();
+    };
+
+    using PlaybackContextMap = std::unordered_map<InstrumentTrackId, PlaybackContext>;
+
     InstrumentTrackId idKey(const EngravingItem* item) const;
     InstrumentTrackId idKey(const std::vector<const EngravingItem*>& items) const;
     InstrumentTrackId idKey(const ID& partId, const std::string& instrumentId) const;
 
+    void onScoreChanged(const ScoreChangesRange& range);
+
     void update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
                 ChangedTrackIdSet* trackChanges = nullptr);
     void updateSetupData();
     void updateContext(const track_idx_t trackFrom, const track_idx_t trackTo);
     void updateContext(const InstrumentTrackId& trackId);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                      ChangedTrackIdSet* trackChanges = nullptr);
+                      ChangedTrackIdSet* trackChanges, const UtickSpan& dependentSpan);
+    void loadEvents();
 
     void processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& changedStaffIdSet,
                         ChangedTrackIdSet* trackChanges);
 
     bool hasToReloadTracks(const ScoreChangesRange& changesRange) const;
     bool hasToReloadScore(const std::unordered_set<ElementType>& changedTypes) const;
+    bool hasTempoChanges(const std::unordered_set<ElementType>& changedTypes) const;
+    bool hasDynamicsChanges(const std::unordered_set<ElementType>& changedTypes) const;
+
+    UtickSpan tempoChangesSpan();
+    UtickSpan dynamicsChangesSpan(const PlaybackContextMap& oldContexts, const track_idx_t trackFrom, const track_idx_t trackTo) const;
+    UtickSpan alignToMeasures(const UtickSpan& span) const;
 
     bool containsTrack(const InstrumentTrackId& trackId) const;
     void clearExpiredTracks();
     void clearExpiredContexts(const track_idx_t trackFrom, const track_idx_t trackTo);
-    void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
+    void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
+                            const UtickSpan& dependentSpan);
     void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
     void notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks);
+    mpe::PlaybackEventsDiff eventsDiff(const ExpiredEvents& expired, const mpe::PlaybackEventsMap& events) const;
 
     void removeEventsFromRange(const track_idx_t trackFrom, const track_idx_t trackTo, const mpe::timestamp_t timestampFrom = -1,
                                const mpe::timestamp_t timestampTo = -1);
@@ -138,12 +183,17 @@ private:
     Score* m_score = nullptr;
     bool m_expandRepeats = true;
     bool m_playChordSymbols = true;
+    bool m_parallelLoading = true;
 
     PlaybackEventsRenderer m_renderer;
     PlaybackSetupDataResolver m_setupResolver;
 
-    std::unordered_map<InstrumentTrackId, PlaybackContext> m_playbackCtxMap;
+    PlaybackContextMap m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, mpe::PlaybackData> m_playbackDataMap;
+    std::unordered_map<InstrumentTrackId, ExpiredEvents> m_expiredEvents;
+
+    //! NOTE The tempo map of the last rendering, to find the events shifted by a tempo change
+    std::map<int, TEvent> m_tempoEvents;
 
     async::Notification m_dataChanged;
     async::Channel<InstrumentTrackId> m_trackAdded;
@@ -83,7 +83,7 @@ void MeasureRW::readMeasure(Measure* measure, XmlReader& e, ReadContext& ctx, in
     if (e.hasAttribute("len")) {
         StringList sl = e.attribute("len").split(u'/');
         if (sl.size() == 2) {
-            measure->_len = Fraction(sl.at(0).toInt(), sl.at(1).toInt());
+            measure->setTicks(Fraction(sl.at(0).toInt(), sl.at(1).toInt()));
         } else {
             LOGD("illegal measure size <%s>", muPrintable(e.attribute("len")));
         }
@@ -396,7 +396,7 @@ void MeasureRW::readVoice(Measure* measure, XmlReader& e, ReadContext& ctx, int
                     ctx.sigmap()->add(measure->tick().ticks(), SigEvent(measure->_len, measure->m_timesig));
                     ctx.sigmap()->add((measure->tick() + measure->ticks()).ticks(), SigEvent(measure->m_timesig));
                 } else {
-                    measure->_len = measure->m_timesig;
+                    measure->setTicks(measure->m_timesig);
                     ctx.sigmap()->add(measure->tick().ticks(), SigEvent(measure->m_timesig));
                 }
             }
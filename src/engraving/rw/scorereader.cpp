@@ -21,6 +21,9 @@
  */
 #include "scorereader.h"
 
+#include <memory>
+
+#include "containers.h"
 #include "io/buffer.h"
 
 #include "compat/readstyle.h"
@@ -32,12 +35,104 @@
 #include "../libmscore/audio.h"
 #include "../libmscore/excerpt.h"
 #include "../libmscore/imageStore.h"
+#include "../libmscore/part.h"
+#include "../libmscore/staff.h"
 
 #include "log.h"
 
+using namespace mu;
 using namespace mu::io;
 using namespace mu::engraving;
 
+//---------------------------------------------------------
+//   readExcerpt
+//---------------------------------------------------------
+
+static void readExcerpt(Excerpt* excerpt, const ByteArray& data, const ReadContext& linksCtx)
+{
+    Score* partScore = excerpt->excerptScore();
+    const String name = excerpt->name();
+
+    ReadContext ctx(partScore);
+    ctx.initLinks(linksCtx);
+
+    XmlReader xml(data);
+    xml.setDocName(name);
+    xml.setContext(&ctx);
+
+    Read400::read400(partScore, xml, ctx);
+
+    partScore->linkMeasures(excerpt->masterScore());
+    excerpt->setTracksMapping(ctx.tracks());
+
+    //! NOTE The name of the excerpt is the name of its file
+    excerpt->setName(name);
+}
+
+//---------------------------------------------------------
+//   readExcerptPartStaves
+//    reads the master staves the staves of the part are linked to
+//---------------------------------------------------------
+
+static void readExcerptPartStaves(XmlReader& e, std::vector<staff_idx_t>& masterStaves)
+{
+    while (e.readNextStartElement()) {
+        if (e.name() != "Staff") {
+            e.skipCurrentElement();
+            continue;
+        }
+
+        while (e.readNextStartElement()) {
+            if (e.name() == "linkedTo") {
+                masterStaves.push_back(static_cast<staff_idx_t>(e.readInt() - 1));
+            } else {
+                e.skipCurrentElement();
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   readExcerptHeader
+//    reads only the properties needed before the excerpt is loaded,
+//    they are written before the staves with the music:
+//    the master parts of the excerpt are known by the linked staves
+//---------------------------------------------------------
+
+static void readExcerptHeader(Excerpt* excerpt, const ByteArray& data)
+{
+    XmlReader e(data);
+    std::vector<staff_idx_t> masterStaves;
+
+    while (e.readNextStartElement()) {
+        const AsciiStringView tag(e.name());
+
+        if (tag == "museScore" || tag == "Score") {
+            continue;
+        } else if (tag == "initialPartId") {
+            excerpt->setInitialPartId(ID(e.readInt()));
+        } else if (tag == "open") {
+            excerpt->excerptScore()->setIsOpen(e.readBool());
+        } else if (tag == "Part") {
+            readExcerptPartStaves(e, masterStaves);
+        } else if (tag == "Staff") {
+            break;
+        } else {
+            e.skipCurrentElement();
+        }
+    }
+
+    std::vector<Part*> parts;
+    for (staff_idx_t staffIdx : masterStaves) {
+        Staff* staff = excerpt->masterScore()->staff(staffIdx);
+        if (staff && !mu::contains(parts, staff->part())) {
+            parts.push_back(staff->part());
+        }
+    }
+
+    excerpt->setParts(parts);
+}
+
 Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, bool ignoreVersionError)
 {
     TRACEFUNC;
@@ -101,6 +196,12 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
 
     // Read excerpts
     if (masterScore->mscVersion() >= 400) {
+        std::shared_ptr<ReadContext> linksCtx;
+        if (m_deferExcerptsLoading) {
+            linksCtx = std::make_shared<ReadContext>(masterScore);
+            linksCtx->initLinks(masterScoreCtx);
+        }
+
         std::vector<String> excerptNames = mscReader.excerptNames();
         for (const String& excerptName : excerptNames) {
             Score* partScore = masterScore->createScore();
@@ -109,6 +210,7 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
 
             Excerpt* ex = new Excerpt(masterScore);
             ex->setExcerptScore(partScore);
+            ex->setName(excerptName);
 
             ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
             Buffer excerptStyleBuf(&excerptStyleData);
@@ -117,19 +219,22 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
 
             ByteArray excerptData = mscReader.readExcerptFile(excerptName);
 
-            ReadContext ctx(partScore);
-            ctx.initLinks(masterScoreCtx);
+            if (linksCtx) {
+                readExcerptHeader(ex, excerptData);
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptName);
-            xml.setContext(&ctx);
+                ex->setLoader([linksCtx, excerptData](Excerpt* excerpt) {
+                    ScoreLoad sl;
+                    readExcerpt(excerpt, excerptData, *linksCtx);
 
-            Read400::read400(partScore, xml, ctx);
-
-            partScore->linkMeasures(masterScore);
-            ex->setTracksMapping(xml.context()->tracks());
-
-            ex->setName(excerptName);
+                    Score* score = excerpt->excerptScore();
+                    score->setPlaylistDirty();
+                    score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
+                    score->setLayoutAll();
+                });
+            } else {
+                ObjectArena::Scope arenaScope(partScore->objectArena());
+                readExcerpt(ex, excerptData, masterScoreCtx);
+            }
 
             masterScore->addExcerpt(ex);
         }
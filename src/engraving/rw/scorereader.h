@@ -38,12 +38,17 @@ public:
 
     Err loadMscz(MasterScore* score, const MscReader& mscReader, bool ignoreVersionError);
 
+    //! NOTE If set, the excerpts are not parsed on loading, but on the first need (see Excerpt::load)
+    void setDeferExcerptsLoading(bool defer) { m_deferExcerptsLoading = defer; }
+
 private:
 
     friend class MasterScore;
 
     Err read(MasterScore* score, XmlReader&, ReadContext& ctx, compat::ReadStyleHook* styleHook = nullptr);
     Err doRead(MasterScore* score, XmlReader& e, ReadContext& ctx);
+
+    bool m_deferExcerptsLoading = false;
 };
 }
 
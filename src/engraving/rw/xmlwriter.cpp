@@ -22,6 +22,8 @@
 
 #include "xmlwriter.h"
 
+#include <charconv>
+
 #include "types/typesconv.h"
 #include "rw/writecontext.h"
 #include "libmscore/engravingitem.h"
@@ -309,7 +311,13 @@ void XmlWriter::tagFraction(const AsciiStringView& name, const Fraction& v, cons
         return;
     }
 
-    element(name, v.toString());
+    //! NOTE Formatted on the stack, v.toString() would allocate twice per fraction
+    char buf[32];
+    char* end = std::to_chars(buf, buf + sizeof(buf), v.numerator()).ptr;
+    *end++ = '/';
+    end = std::to_chars(end, buf + sizeof(buf), v.denominator()).ptr;
+
+    element(name, AsciiStringView(buf, end - buf));
 }
 
 void XmlWriter::writeXml(const String& name, String s)
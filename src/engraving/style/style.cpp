@@ -22,6 +22,8 @@
 
 #include "style.h"
 
+#include <atomic>
+
 #include "compat/pageformat.h"
 #include "rw/compat/readchordlisthook.h"
 #include "rw/xml.h"
@@ -69,6 +71,10 @@ void MStyle::set(const Sid t, const PropertyValue& val)
 
     const size_t idx = size_t(t);
     m_values[idx] = val;
+
+    static std::atomic<uint64_t> s_lastGeneration = 0;
+    m_generation = ++s_lastGeneration;
+
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
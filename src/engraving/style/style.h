@@ -25,6 +25,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstdint>
 
 #include "io/iodevice.h"
 
@@ -67,6 +68,9 @@ public:
 
     void set(Sid idx, const PropertyValue& v);
 
+    //! NOTE Changes on every modification of the values, copies of the style share the generation
+    uint64_t generation() const { return m_generation; }
+
     bool isDefault(Sid idx) const;
     void setDefaultStyleVersion(const int defaultsVersion);
     int defaultStyleVersion() const;
@@ -94,6 +98,7 @@ private:
 
     std::array<PropertyValue, size_t(Sid::STYLES)> m_values;
     std::array<Millimetre, size_t(Sid::STYLES)> m_precomputedValues;
+    uint64_t m_generation = 0;
 };
 } // namespace mu::engraving
 
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+
+#include "utils/layoutcomp.h"
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   Engraving_LayoutIncrementalTests
+//    The partial layout after an edit reuses the measures out of the edited range,
+//    the result must be the same as of the full relayout
+//---------------------------------------------------------
+
+class Engraving_LayoutIncrementalTests : public ::testing::Test
+{
+public:
+    static Chord* firstChord(Measure* measure)
+    {
+        for (Segment* s = measure->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (EngravingItem* e : s->elist()) {
+                if (e && e->isChord()) {
+                    return toChord(e);
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    //! NOTE A chord in the middle of the score, so there are measures to reuse on both sides
+    static Chord* chordToEdit(Score* score)
+    {
+        std::vector<Measure*> measures;
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            measures.push_back(m);
+        }
+
+        for (size_t i = measures.size() / 2; i < measures.size(); ++i) {
+            if (Chord* chord = firstChord(measures[i])) {
+                return chord;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+TEST_F(Engraving_LayoutIncrementalTests, VtestScores_EditsSameAsFullRelayout)
+{
+    io::paths_t files = ScoreRW::vtestScores();
+    if (files.empty()) {
+        GTEST_SKIP() << "vtest scores not found";
+    }
+
+    for (const io::path_t& path : files) {
+        //! GIVEN A laid out score
+        MasterScore* score = ScoreRW::readScore(path.toString(), true);
+        ASSERT_TRUE(score) << path.toStdString();
+
+        Chord* chord = chordToEdit(score);
+        if (!chord) {
+            delete score;
+            continue;
+        }
+
+        if (!LayoutComp::isLayoutStable(score)) {
+            delete score;
+            continue;
+        }
+
+        const DirectionV direction = chord->up() ? DirectionV::DOWN : DirectionV::UP;
+
+        std::vector<std::pair<std::string, std::function<void()> > > edits = {
+            { "stem direction", [score, chord, direction]() {
+                  score->startCmd();
+                  chord->undoChangeProperty(Pid::STEM_DIRECTION, PropertyValue::fromValue(direction));
+                  score->endCmd();
+              } },
+            { "small chord", [score, chord]() {
+                  score->startCmd();
+                  chord->undoChangeProperty(Pid::SMALL, true);
+                  score->endCmd();
+              } },
+            { "undo", [score]() {
+                  score->undoRedo(true, nullptr);
+              } },
+            { "redo", [score]() {
+                  score->undoRedo(false, nullptr);
+              } },
+        };
+
+        for (const auto& edit : edits) {
+            //! DO Edit the score, it is laid out partially
+            edit.second();
+            const LayoutComp::Geometry incremental = LayoutComp::geometry(score);
+
+            //! CHECK The full relayout gives the same result
+            score->doLayout();
+            EXPECT_EQ(LayoutComp::difference(incremental, LayoutComp::geometry(score)), std::string())
+                << path.toStdString() << ", edit: " << edit.first;
+        }
+
+        delete score;
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+
+#include "utils/layoutcomp.h"
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   Engraving_LayoutParallelTests
+//    The full layout lays out the elements of the measures on the TaskScheduler pool,
+//    the result must be the same as of the layout measure by measure
+//---------------------------------------------------------
+
+class Engraving_LayoutParallelTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_LayoutParallelTests, VtestScores_SameAsSerialLayout)
+{
+    io::paths_t files = ScoreRW::vtestScores();
+    if (files.empty()) {
+        GTEST_SKIP() << "vtest scores not found";
+    }
+
+    for (const io::path_t& path : files) {
+        //! GIVEN A score
+        MasterScore* score = ScoreRW::readScore(path.toString(), true);
+        ASSERT_TRUE(score) << path.toStdString();
+
+        if (!LayoutComp::isLayoutStable(score)) {
+            delete score;
+            continue;
+        }
+
+        //! DO Lay it out in parallel
+        score->setParallelMeasureLayout(true);
+        score->doLayout();
+        const LayoutComp::Geometry parallel = LayoutComp::geometry(score);
+
+        //! DO Lay it out measure by measure
+        score->setParallelMeasureLayout(false);
+        score->doLayout();
+        const LayoutComp::Geometry serial = LayoutComp::geometry(score);
+
+        //! CHECK The results are the same
+        EXPECT_EQ(LayoutComp::difference(parallel, serial), std::string()) << path.toStdString();
+
+        delete score;
+    }
+}
+
+TEST_F(Engraving_LayoutParallelTests, AllElements_SameAsSerialLayout)
+{
+    //! GIVEN A score with the lyrics, chord symbols, grace notes and the other elements
+    //! the layout of which was moved out of the parallel part
+    MasterScore* score = ScoreRW::readScore(u"all_elements_data/layout_elements.mscx");
+    ASSERT_TRUE(score);
+
+    //! DO Lay it out in parallel and measure by measure
+    score->setParallelMeasureLayout(true);
+    score->doLayout();
+    const LayoutComp::Geometry parallel = LayoutComp::geometry(score);
+
+    score->setParallelMeasureLayout(false);
+    score->doLayout();
+    const LayoutComp::Geometry serial = LayoutComp::geometry(score);
+
+    //! CHECK The results are the same
+    EXPECT_FALSE(parallel.empty());
+    EXPECT_EQ(LayoutComp::difference(parallel, serial), std::string());
+
+    delete score;
+}
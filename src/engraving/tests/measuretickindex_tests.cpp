@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String MEASURETICKINDEX_DATA_DIR("all_elements_data/");
+static const String MEASURE_DATA_DIR("measure_data/");
+
+class Engraving_MeasureTickIndexTests : public ::testing::Test
+{
+public:
+    //! NOTE The search by walking the measures, as tick2measure() did before the index
+    static Measure* linearTick2measure(const Score* score, const Fraction& tick, bool mm)
+    {
+        if (tick <= Fraction(0, 1)) {
+            return mm ? score->firstMeasureMM() : score->firstMeasure();
+        }
+
+        Measure* lm = nullptr;
+        for (Measure* m = mm ? score->firstMeasureMM() : score->firstMeasure(); m; m = mm ? m->nextMeasureMM() : m->nextMeasure()) {
+            if (tick < m->tick()) {
+                return lm;
+            }
+            lm = m;
+        }
+
+        if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+            return lm;
+        }
+
+        return nullptr;
+    }
+
+    static void checkAllTicks(const Score* score, bool mm)
+    {
+        for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+            const Fraction tick = s->tick();
+            Measure* found = mm ? score->tick2measureMM(tick) : score->tick2measure(tick);
+            EXPECT_EQ(found, linearTick2measure(score, tick, mm)) << "tick " << tick.ticks();
+        }
+
+        const Fraction endTick = score->lastMeasure()->endTick();
+        EXPECT_EQ(score->tick2measure(endTick), score->lastMeasure());
+    }
+};
+
+TEST_F(Engraving_MeasureTickIndexTests, SameAsLinearSearch)
+{
+    //! GIVEN Score
+    MasterScore* score = ScoreRW::readScore(MEASURETICKINDEX_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! CHECK The measures are the same as found by walking the measures
+    checkAllTicks(score, false);
+
+    //! DO Insert the measures in the middle and at the end
+    score->startCmd();
+    Measure* middle = score->crMeasure(static_cast<int>(score->nmeasures() / 2));
+    score->insertMeasure(ElementType::MEASURE, middle);
+    score->insertMeasure(ElementType::MEASURE, middle);
+    score->appendMeasures(3);
+    score->endCmd();
+
+    //! CHECK The index follows the changes
+    checkAllTicks(score, false);
+
+    //! DO Remove the inserted measures
+    score->undoRedo(true, 0);
+
+    //! CHECK The index follows the changes
+    checkAllTicks(score, false);
+
+    delete score;
+}
+
+TEST_F(Engraving_MeasureTickIndexTests, InsideCommand_Updated)
+{
+    //! GIVEN Score
+    MasterScore* score = ScoreRW::readScore(MEASURETICKINDEX_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! DO Insert a frame in the middle, the ticks aren't set up again for it
+    score->startCmd();
+    Measure* middle = score->crMeasure(static_cast<int>(score->nmeasures() / 2));
+    score->insertMeasure(ElementType::VBOX, middle);
+
+    //! CHECK The rest of the command looks up the measures by the index, not by walking them
+    EXPECT_TRUE(score->measures()->tickIndex().isValid());
+    checkAllTicks(score, false);
+
+    //! DO Finish the command
+    score->endCmd();
+
+    //! CHECK The index is still valid
+    EXPECT_TRUE(score->measures()->tickIndex().isValid());
+    checkAllTicks(score, false);
+
+    delete score;
+}
+
+TEST_F(Engraving_MeasureTickIndexTests, Invalidated_SameAsLinearSearch)
+{
+    //! GIVEN Score
+    MasterScore* score = ScoreRW::readScore(MEASURETICKINDEX_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    //! DO Change the length of a measure, the ticks of the next measures are not set up yet
+    Measure* measure = score->crMeasure(2);
+    measure->setTicks(measure->ticks() + measure->ticks());
+
+    //! CHECK The lookups walk the measures
+    checkAllTicks(score, false);
+
+    //! DO Set up the ticks
+    score->setUpTempoMap();
+
+    //! CHECK The index is rebuilt
+    checkAllTicks(score, false);
+
+    delete score;
+}
+
+TEST_F(Engraving_MeasureTickIndexTests, MMRests)
+{
+    //! GIVEN Score with empty measures
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"mmrest.mscx");
+    ASSERT_TRUE(score);
+
+    checkAllTicks(score, true);
+
+    //! DO Turn on the multimeasure rests
+    score->startCmd();
+    score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, true));
+    score->setLayoutAll();
+    score->endCmd();
+
+    //! CHECK The multimeasure rests are found
+    bool hasMMRests = false;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        hasMMRests |= m->hasMMRest();
+    }
+    EXPECT_TRUE(hasMMRests);
+
+    checkAllTicks(score, true);
+
+    //! DO Turn them off
+    score->undoRedo(true, 0);
+
+    //! CHECK The measures are found again
+    checkAllTicks(score, true);
+
+    delete score;
+}
@@ -72,6 +72,10 @@ public:
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
 
+    MOCK_METHOD(size_t, undoHistoryMemoryLimit, (), (const, override));
+    MOCK_METHOD(void, setUndoHistoryMemoryLimit, (size_t), (override));
+    MOCK_METHOD(async::Channel<size_t>, undoHistoryMemoryLimitChanged, (), (const, override));
+
     MOCK_METHOD(bool, guitarProImportExperimental, (), (const, override));
     MOCK_METHOD(bool, negativeFretsAllowed, (), (const, override));
     MOCK_METHOD(bool, tablatureParenthesesZIndexWorkaround, (), (const, override));
@@ -22,6 +22,14 @@
 
 #include <gtest/gtest.h>
 
+#include "io/buffer.h"
+
+#include "compat/mscxcompat.h"
+#include "engravingproject.h"
+#include "infrastructure/localfileinfoprovider.h"
+#include "infrastructure/mscreader.h"
+#include "infrastructure/mscwriter.h"
+
 #include "libmscore/breath.h"
 #include "libmscore/chord.h"
 #include "libmscore/chordline.h"
@@ -30,6 +38,7 @@
 #include "libmscore/factory.h"
 #include "libmscore/fingering.h"
 #include "libmscore/image.h"
+#include "libmscore/linkedobjects.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/measure.h"
 #include "libmscore/measurerepeat.h"
@@ -44,9 +53,11 @@
 #include "utils/scorecomp.h"
 
 using namespace mu;
+using namespace mu::io;
 using namespace mu::engraving;
 
 static const String PARTS_DATA_DIR("parts_data/");
+static const String MSCZ_FILE_PATH(u"parts-test.mscz");
 
 class Engraving_PartsTests : public ::testing::Test
 {
@@ -54,6 +65,9 @@ public:
     void createParts(MasterScore* score);
     void testPartCreation(const String& test);
 
+    ByteArray writeMscz(EngravingProjectPtr project);
+    EngravingProjectPtr readMscz(ByteArray& msczData, bool deferExcerptsLoading);
+
     MasterScore* doAddBreath();
     MasterScore* doRemoveBreath();
     MasterScore* doAddFingering();
@@ -1148,6 +1162,172 @@ TEST_F(Engraving_PartsTests, createPartStemless)
 }
 
 
+//---------------------------------------------------------
+//   writeMscz
+//---------------------------------------------------------
+
+ByteArray Engraving_PartsTests::writeMscz(EngravingProjectPtr project)
+{
+    ByteArray msczData;
+    Buffer buf(&msczData);
+
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = MSCZ_FILE_PATH;
+    params.mode = MscIoMode::Zip;
+
+    MscWriter writer(params);
+    writer.open();
+    EXPECT_TRUE(project->writeMscz(writer, false, false));
+    writer.close();
+
+    return msczData;
+}
+
+//---------------------------------------------------------
+//   readMscz
+//---------------------------------------------------------
+
+EngravingProjectPtr Engraving_PartsTests::readMscz(ByteArray& msczData, bool deferExcerptsLoading)
+{
+    EngravingProjectPtr project = EngravingProject::create();
+    project->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(MSCZ_FILE_PATH));
+
+    Buffer buf(&msczData);
+
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = MSCZ_FILE_PATH;
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+    EXPECT_EQ(project->loadMscz(reader, false, deferExcerptsLoading), Err::NoError);
+
+    return project;
+}
+
+//---------------------------------------------------------
+//   deferredExcerptsLoading
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, deferredExcerptsLoading)
+{
+    //! GIVEN Score with parts, saved to mscz
+    EngravingProjectPtr origin = EngravingProject::create();
+    ASSERT_EQ(compat::loadMsczOrMscx(origin, ScoreRW::rootPath() + u"/" + PARTS_DATA_DIR + u"part-all.mscx"), Err::NoError);
+    createParts(origin->masterScore());
+
+    ByteArray msczData = writeMscz(origin);
+
+    //! DO Read it with and without deferring of the excerpts loading
+    EngravingProjectPtr eager = readMscz(msczData, false);
+    EngravingProjectPtr deferred = readMscz(msczData, true);
+
+    //! CHECK The deferred excerpts are known, but not parsed
+    const std::vector<Excerpt*>& eagerExcerpts = eager->masterScore()->excerpts();
+    const std::vector<Excerpt*>& deferredExcerpts = deferred->masterScore()->excerpts();
+    ASSERT_EQ(deferredExcerpts.size(), 2);
+    ASSERT_EQ(deferredExcerpts.size(), eagerExcerpts.size());
+    EXPECT_TRUE(deferred->masterScore()->hasUnloadedExcerpts());
+
+    for (size_t i = 0; i < deferredExcerpts.size(); ++i) {
+        EXPECT_FALSE(deferredExcerpts[i]->isLoaded());
+        EXPECT_FALSE(deferredExcerpts[i]->isEmpty());
+        EXPECT_EQ(deferredExcerpts[i]->name(), eagerExcerpts[i]->name());
+        EXPECT_TRUE(deferredExcerpts[i]->excerptScore()->parts().empty());
+
+        //! CHECK The master parts of the excerpts are known
+        ASSERT_EQ(deferredExcerpts[i]->parts().size(), eagerExcerpts[i]->parts().size());
+        EXPECT_EQ(deferredExcerpts[i]->parts().front()->id(), eagerExcerpts[i]->parts().front()->id());
+    }
+
+    //! DO Load the first excerpt
+    deferredExcerpts[0]->load();
+
+    //! CHECK It is the same as the eagerly loaded one
+    EXPECT_TRUE(deferredExcerpts[0]->isLoaded());
+    EXPECT_FALSE(deferredExcerpts[1]->isLoaded());
+    EXPECT_EQ(deferredExcerpts[0]->parts().size(), eagerExcerpts[0]->parts().size());
+    EXPECT_EQ(deferredExcerpts[0]->nstaves(), eagerExcerpts[0]->nstaves());
+    EXPECT_EQ(deferredExcerpts[0]->excerptScore()->nmeasures(), eagerExcerpts[0]->excerptScore()->nmeasures());
+    EXPECT_EQ(deferredExcerpts[0]->excerptScore()->staff(0)->links()->size(), 2);
+
+    //! DO Save both scores
+    ByteArray eagerData = writeMscz(eager);
+    ByteArray deferredData = writeMscz(deferred);
+
+    //! CHECK The rest excerpts are loaded on saving, the saved files are the same
+    EXPECT_FALSE(deferred->masterScore()->hasUnloadedExcerpts());
+
+    Buffer eagerBuf(&eagerData);
+    MscReader::Params eagerParams;
+    eagerParams.device = &eagerBuf;
+    eagerParams.filePath = MSCZ_FILE_PATH;
+    eagerParams.mode = MscIoMode::Zip;
+    MscReader eagerReader(eagerParams);
+    eagerReader.open();
+
+    Buffer deferredBuf(&deferredData);
+    MscReader::Params deferredParams;
+    deferredParams.device = &deferredBuf;
+    deferredParams.filePath = MSCZ_FILE_PATH;
+    deferredParams.mode = MscIoMode::Zip;
+    MscReader deferredReader(deferredParams);
+    deferredReader.open();
+
+    EXPECT_EQ(deferredReader.readScoreFile(), eagerReader.readScoreFile());
+    EXPECT_EQ(deferredReader.excerptNames(), eagerReader.excerptNames());
+    for (const String& name : eagerReader.excerptNames()) {
+        EXPECT_EQ(deferredReader.readExcerptFile(name), eagerReader.readExcerptFile(name));
+    }
+}
+
+//---------------------------------------------------------
+//   deferredExcerptsLoadingOnEdit
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, deferredExcerptsLoadingOnEdit)
+{
+    //! GIVEN Score with a part per instrument, read with the deferred excerpts
+    EngravingProjectPtr origin = EngravingProject::create();
+    ASSERT_EQ(compat::loadMsczOrMscx(origin, ScoreRW::rootPath() + u"/" + PARTS_DATA_DIR + u"part-all.mscx"), Err::NoError);
+    createParts(origin->masterScore());
+
+    ByteArray msczData = writeMscz(origin);
+    EngravingProjectPtr deferred = readMscz(msczData, true);
+    MasterScore* score = deferred->masterScore();
+
+    Chord* chord = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s && !chord; s = s->next1(SegmentType::ChordRest)) {
+        EngravingItem* e = s->element(0);
+        if (e && e->isChord()) {
+            chord = toChord(e);
+        }
+    }
+    ASSERT_TRUE(chord);
+
+    //! DO Change the pitch of a note of the first instrument
+    Note* note = chord->upNote();
+    int pitch = note->pitch() + 1;
+
+    score->startCmd();
+    score->undoChangePitch(note, pitch, note->tpc1(), note->tpc2());
+    score->endCmd();
+
+    //! CHECK Only the part of the instrument is loaded, the change is propagated to it
+    const std::vector<Excerpt*>& excerpts = score->excerpts();
+    ASSERT_EQ(excerpts.size(), 2);
+    EXPECT_TRUE(excerpts[0]->isLoaded());
+    EXPECT_FALSE(excerpts[1]->isLoaded());
+
+    std::list<EngravingObject*> linkedNotes = note->linkList();
+    ASSERT_EQ(linkedNotes.size(), 2);
+    for (EngravingObject* linkedNote : linkedNotes) {
+        EXPECT_EQ(toNote(linkedNote)->pitch(), pitch);
+    }
+}
+
 //---------------------------------------------------------
 //   staffStyles
 //---------------------------------------------------------
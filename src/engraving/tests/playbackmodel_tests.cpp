@@ -33,6 +33,8 @@
 #include "libmscore/part.h"
 #include "libmscore/measure.h"
 #include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
 
 #include "playback/playbackmodel.h"
 
@@ -379,8 +381,8 @@ TEST_F(Engraving_PlaybackModelTests, Repeat_Last_Measure)
  * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 4 measures
  *          Additionally, there is a simple repeat from measure 2 up to measure 3. In total, we'll be playing 6 measures overall
  *
- *          When the model will be loaded we'll emulate a change notification on the 2-nd measure, so that there will be updated events
- *          on the main stream channel
+ *          When the model will be loaded we'll change the pitch of the first note on the 2-nd measure and emulate a change notification,
+ *          so that there will be the difference of the events on the main stream channel: the note is played twice because of the repeat
  */
 TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 {
@@ -397,8 +399,9 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
     ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
 
-    // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
+    // [GIVEN] Expected amount of events and of the changed ones
+    size_t expectedEventsCount = 24;
+    size_t expectedChangedEventsCount = 2;
 
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
@@ -406,13 +409,33 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     model.load(score);
 
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
+    PlaybackEventsMap events = result.originEvents;
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [THEN] Only the changed events are sent, not the whole map
+    int receivedDiffCount = 0;
+    result.mainStreamDiff.onReceive(this, [&](const PlaybackEventsDiff& diff) {
+        EXPECT_TRUE(diff.removed.empty());
+        EXPECT_EQ(diff.added.size(), expectedChangedEventsCount);
+
+        diff.applyTo(events);
+        ++receivedDiffCount;
+    });
+
+    result.mainStream.onReceive(this, [](const PlaybackEventsMap&) {
+        FAIL() << "the whole events map is not expected";
     });
 
-    // [WHEN] Notation has been changed on the 2-nd measure
+    // [WHEN] The first note on the 2-nd measure has been changed
+    Measure* secondMeasure = score->firstMeasure()->nextMeasure();
+    ASSERT_TRUE(secondMeasure);
+
+    Chord* chord = toChord(secondMeasure->first(SegmentType::ChordRest)->element(0));
+    ASSERT_TRUE(chord);
+
+    Note* note = chord->upNote();
+    note->setPitch(note->pitch() + 2);
+    note->setTpcFromPitch();
+
     ScoreChangesRange range;
     range.tickFrom = 1920;
     range.tickTo = 3840;
@@ -421,6 +444,14 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::NOTE };
 
     score->changesChannel().send(range);
+
+    // [THEN] The events with the applied difference match the events of the model
+    EXPECT_EQ(receivedDiffCount, 1);
+    EXPECT_EQ(events.size(), expectedEventsCount);
+    EXPECT_EQ(events, model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString()).originEvents);
+
+    result.mainStreamDiff.resetOnReceive(this);
+    result.mainStream.resetOnReceive(this);
 }
 
 /**
@@ -693,3 +724,53 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Parallel_Load_Same_As_Serial
+ * @details In this case we're loading a score with 12 instruments twice: once rendering the parts one by one,
+ *          once rendering them on separate threads. The events of every track must be the same
+ */
+TEST_F(Engraving_PlaybackModelTests, Parallel_Load_Same_As_Serial)
+{
+    // [GIVEN] Score with 12 instruments
+    Score* score = ScoreRW::readScore(
+        PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12);
+
+    // [GIVEN] The articulation profiles repository will be returning the default profile
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [WHEN] The score is loaded by a model rendering the parts one by one
+    PlaybackModel serialModel;
+    serialModel.setprofilesRepository(m_repositoryMock);
+    serialModel.setParallelLoading(false);
+    serialModel.load(score);
+
+    // [WHEN] The score is loaded by a model rendering the parts in parallel
+    PlaybackModel parallelModel;
+    parallelModel.setprofilesRepository(m_repositoryMock);
+    parallelModel.load(score);
+
+    // [THEN] Both models have the same tracks
+    InstrumentTrackIdSet trackIdSet = serialModel.existingTrackIdSet();
+    ASSERT_EQ(trackIdSet.size(), parallelModel.existingTrackIdSet().size());
+
+    // [THEN] The events of every track are the same
+    size_t eventCount = 0;
+
+    for (const InstrumentTrackId& trackId : trackIdSet) {
+        const PlaybackEventsMap& serialEvents = serialModel.resolveTrackPlaybackData(trackId).originEvents;
+        const PlaybackEventsMap& parallelEvents = parallelModel.resolveTrackPlaybackData(trackId).originEvents;
+
+        EXPECT_EQ(serialEvents, parallelEvents);
+
+        for (const auto& pair : serialEvents) {
+            eventCount += pair.second.size();
+        }
+    }
+
+    // [THEN] Something was rendered
+    EXPECT_GT(eventCount, 0u);
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "io/file.h"
+#include "serialization/xmldom.h"
+#include "serialization/xmlstreamreader.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_ScoreLoadTests : public ::testing::Test
+{
+public:
+    static std::vector<String> streamElements(const ByteArray& data)
+    {
+        std::vector<String> names;
+        XmlStreamReader xml(data);
+        while (xml.readNext() != XmlStreamReader::Invalid && !xml.atEnd()) {
+            if (xml.isStartElement()) {
+                names.push_back(String::fromAscii(xml.name().ascii(), xml.name().size()));
+            }
+        }
+        EXPECT_FALSE(xml.isError()) << xml.errorString().toStdString();
+        return names;
+    }
+
+    static void domElements(const XmlDomNode& node, std::vector<String>& names)
+    {
+        for (XmlDomNode child = node.firstChild(); !child.isNull(); child = child.nextSibling()) {
+            if (!child.toElement().isNull()) {
+                names.push_back(child.nodeName());
+                domElements(child, names);
+            }
+        }
+    }
+};
+
+//! NOTE The streaming reader is compared with the DOM, which the reader was built on before;
+//! the timings are in global_xml_benchmark
+TEST_F(Engraving_ScoreLoadTests, VtestCorpus_SameElementsAsDom)
+{
+    io::paths_t files = ScoreRW::vtestScores();
+    if (files.empty()) {
+        GTEST_SKIP() << "vtest scores not found";
+    }
+
+    for (const io::path_t& path : files) {
+        //! GIVEN A vtest score
+        RetVal<ByteArray> data = io::File::mapFile(path);
+        ASSERT_TRUE(data.ret);
+
+        //! DO Read it with the streaming reader and with the DOM
+        std::vector<String> streamNames = streamElements(data.val);
+
+        XmlDomDocument dom;
+        dom.setContent(data.val);
+        ASSERT_FALSE(dom.hasError()) << dom.errorString().toStdString();
+
+        std::vector<String> domNames;
+        XmlDomElement root = dom.rootElement();
+        domNames.push_back(root.nodeName());
+        domElements(root, domNames);
+
+        //! CHECK The same elements are read in the same order
+        EXPECT_EQ(streamNames, domNames) << path.toStdString();
+    }
+}
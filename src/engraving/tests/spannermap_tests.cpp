@@ -0,0 +1,382 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/part.h"
+#include "libmscore/spanner.h"
+#include "libmscore/spannerintervaltree.h"
+#include "libmscore/spannermap.h"
+#include "libmscore/staff.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String SPANNERMAP_DATA_DIR("all_elements_data/");
+
+using IntervalList = SpannerIntervalTree::IntervalList;
+
+class Engraving_SpannerMapTests : public ::testing::Test
+{
+public:
+    //! NOTE The tree doesn't dereference the values, so the fake pointers are enough
+    static Spanner* fakeSpanner(size_t i)
+    {
+        return reinterpret_cast<Spanner*>((i + 1) * sizeof(void*));
+    }
+
+    static IntervalList randomIntervals(size_t count, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> startDist(0, 10000);
+        std::uniform_int_distribution<int> lengthDist(0, 500);
+
+        IntervalList result;
+        for (size_t i = 0; i < count; ++i) {
+            int start = startDist(gen);
+            result.emplace_back(start, start + lengthDist(gen), fakeSpanner(i));
+        }
+
+        return result;
+    }
+
+    static IntervalList overlapping(const IntervalList& intervals, int start, int stop)
+    {
+        IntervalList result;
+        for (const auto& i : intervals) {
+            if (i.start <= stop && i.stop >= start) {
+                result.push_back(i);
+            }
+        }
+        return sorted(result);
+    }
+
+    static IntervalList contained(const IntervalList& intervals, int start, int stop)
+    {
+        IntervalList result;
+        for (const auto& i : intervals) {
+            if (i.start >= start && i.stop <= stop) {
+                result.push_back(i);
+            }
+        }
+        return sorted(result);
+    }
+
+    static IntervalList sorted(IntervalList list)
+    {
+        std::sort(list.begin(), list.end(), [](const auto& a, const auto& b) {
+            return std::tie(a.start, a.stop, a.value) < std::tie(b.start, b.stop, b.value);
+        });
+        return list;
+    }
+
+    static bool equal(const IntervalList& a, const IntervalList& b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& i1, const auto& i2) {
+            return i1.start == i2.start && i1.stop == i2.stop && i1.value == i2.value;
+        });
+    }
+
+    static std::vector<Spanner*> spanners(const SpannerMap& map)
+    {
+        std::vector<Spanner*> result;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            result.push_back(it->second);
+        }
+        return result;
+    }
+
+    static std::vector<IntervalList> queryAll(const SpannerMap& map, bool excludeCollisions)
+    {
+        int lastTick = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            lastTick = std::max(lastTick, it->second->tick2().ticks());
+        }
+
+        std::vector<IntervalList> result;
+        for (int tick = 0; tick <= lastTick; tick += 240) {
+            result.push_back(map.findOverlapping(tick, tick + 480, excludeCollisions));
+            result.push_back(map.findContained(tick, tick + 1920, excludeCollisions));
+        }
+        return result;
+    }
+
+    //! NOTE The current state of the lookup trees must be the same as after the full rebuild
+    static void expectSameAsRebuild(const SpannerMap& map)
+    {
+        std::vector<IntervalList> current = queryAll(map, false);
+        std::vector<IntervalList> currentCollisionFree = queryAll(map, true);
+
+        map.update();
+        std::vector<IntervalList> rebuilt = queryAll(map, false);
+        std::vector<IntervalList> rebuiltCollisionFree = queryAll(map, true);
+
+        ASSERT_EQ(current.size(), rebuilt.size());
+        for (size_t i = 0; i < current.size(); ++i) {
+            EXPECT_TRUE(equal(current[i], rebuilt[i]));
+            EXPECT_TRUE(equal(currentCollisionFree[i], rebuiltCollisionFree[i]));
+        }
+    }
+};
+
+TEST_F(Engraving_SpannerMapTests, Tree_SameAsLinearSearch)
+{
+    //! GIVEN Random intervals, half of them are added by build() and half by insert()
+    IntervalList intervals = randomIntervals(2000, 1);
+    IntervalList firstHalf(intervals.begin(), intervals.begin() + intervals.size() / 2);
+
+    SpannerIntervalTree tree;
+    tree.build(firstHalf);
+
+    for (size_t i = firstHalf.size(); i < intervals.size(); ++i) {
+        tree.insert(intervals[i], i);
+    }
+
+    //! DO Remove every third interval
+    IntervalList remaining;
+    for (size_t i = 0; i < intervals.size(); ++i) {
+        if (i % 3 == 0) {
+            EXPECT_TRUE(tree.remove(intervals[i].value));
+        } else {
+            remaining.push_back(intervals[i]);
+        }
+    }
+
+    //! CHECK The tree stays balanced and finds the same intervals as the linear search
+    EXPECT_TRUE(tree.isValid());
+    EXPECT_EQ(tree.size(), remaining.size());
+    EXPECT_FALSE(tree.remove(intervals[0].value));
+
+    for (int start = 0; start < 10500; start += 97) {
+        for (int length : { 0, 1, 50, 700, 3000 }) {
+            IntervalList found;
+            tree.findOverlapping(start, start + length, found);
+            EXPECT_TRUE(equal(sorted(found), overlapping(remaining, start, start + length)));
+
+            found.clear();
+            tree.findContained(start, start + length, found);
+            EXPECT_TRUE(equal(sorted(found), contained(remaining, start, start + length)));
+        }
+    }
+}
+
+TEST_F(Engraving_SpannerMapTests, Tree_OrderOfResults)
+{
+    //! GIVEN Intervals with the same start
+    SpannerIntervalTree tree;
+    tree.insert(SpannerIntervalTree::Interval(10, 20, fakeSpanner(0)), 2);
+    tree.insert(SpannerIntervalTree::Interval(10, 30, fakeSpanner(1)), 1);
+    tree.insert(SpannerIntervalTree::Interval(5, 15, fakeSpanner(2)), 3);
+
+    //! DO Find them
+    IntervalList found;
+    tree.findOverlapping(0, 100, found);
+
+    //! CHECK They are sorted by the start, then by the order
+    ASSERT_EQ(found.size(), 3);
+    EXPECT_EQ(found[0].value, fakeSpanner(2));
+    EXPECT_EQ(found[1].value, fakeSpanner(1));
+    EXPECT_EQ(found[2].value, fakeSpanner(0));
+}
+
+TEST_F(Engraving_SpannerMapTests, Map_IncrementalSameAsRebuild)
+{
+    //! GIVEN Score with a lot of spanners
+    MasterScore* score = ScoreRW::readScore(SPANNERMAP_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    SpannerMap& map = score->spannerMap();
+    std::vector<Spanner*> spanners = this->spanners(map);
+    ASSERT_FALSE(spanners.empty());
+
+    //! DO Remove every other spanner and add them back, querying the map after every change
+    map.update();
+    for (size_t i = 0; i < spanners.size(); i += 2) {
+        map.removeSpanner(spanners[i]);
+        map.findOverlapping(spanners[i]->tick().ticks(), spanners[i]->tick2().ticks());
+    }
+    for (size_t i = 0; i < spanners.size(); i += 2) {
+        map.addSpanner(spanners[i]);
+        map.findOverlapping(spanners[i]->tick().ticks(), spanners[i]->tick2().ticks(), true);
+    }
+
+    //! CHECK The results are the same as after the full rebuild
+    expectSameAsRebuild(map);
+
+    delete score;
+}
+
+TEST_F(Engraving_SpannerMapTests, Map_TickChangesSameAsRebuild)
+{
+    //! GIVEN Score with a lot of spanners, the lookup trees are built
+    MasterScore* score = ScoreRW::readScore(SPANNERMAP_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    SpannerMap& map = score->spannerMap();
+    std::vector<Spanner*> spanners = this->spanners(map);
+    ASSERT_FALSE(spanners.empty());
+
+    map.update();
+
+    //! DO Move the starts of some spanners and change the lengths of others, querying the map after every change
+    for (size_t i = 0; i < spanners.size(); i += 3) {
+        Spanner* s = spanners[i];
+        s->setTick(s->tick() + Fraction(1, 4));
+        map.findOverlapping(s->tick().ticks(), s->tick2().ticks(), true);
+    }
+    for (size_t i = 1; i < spanners.size(); i += 3) {
+        Spanner* s = spanners[i];
+        s->setTicks(s->ticks() + Fraction(3, 4));
+        map.findOverlapping(s->tick().ticks(), s->tick2().ticks(), true);
+    }
+
+    //! CHECK The results are the same as after the full rebuild
+    expectSameAsRebuild(map);
+
+    delete score;
+}
+
+TEST_F(Engraving_SpannerMapTests, Map_TrackChangesSameAsRebuild)
+{
+    //! GIVEN Score with two parts, the lookup trees are built
+    MasterScore* score = ScoreRW::readScore(u"remove_data/remove_staff.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GE(score->parts().size(), 2u);
+
+    SpannerMap& map = score->spannerMap();
+    std::vector<Spanner*> spanners = this->spanners(map);
+    ASSERT_FALSE(spanners.empty());
+
+    map.update();
+
+    //! DO Move the spanners of the first part to the last staff, it belongs to another part
+    const Part* firstPart = score->parts().front();
+    const track_idx_t lastStaffTrack = (score->nstaves() - 1) * VOICES;
+    size_t moved = 0;
+
+    for (Spanner* s : spanners) {
+        if (s->part() == firstPart) {
+            s->setTrack(lastStaffTrack + s->voice());
+            map.findOverlapping(s->tick().ticks(), s->tick2().ticks(), true);
+            ++moved;
+        }
+    }
+
+    //! CHECK Some spanners changed their part
+    EXPECT_GT(moved, 0u);
+    for (const Spanner* s : spanners) {
+        EXPECT_NE(s->part(), firstPart);
+    }
+
+    //! CHECK The results are the same as after the full rebuild
+    expectSameAsRebuild(map);
+
+    delete score;
+}
+
+TEST_F(Engraving_SpannerMapTests, Map_PartMovesSameAsRebuild)
+{
+    //! GIVEN Score with two parts, the lookup trees are built
+    MasterScore* score = ScoreRW::readScore(u"remove_data/remove_staff.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GE(score->parts().size(), 2u);
+
+    SpannerMap& map = score->spannerMap();
+    ASSERT_FALSE(map.empty());
+
+    map.update();
+    std::vector<IntervalList> before = queryAll(map, true);
+
+    //! DO Move the last part to the top
+    const Part* lastPart = score->parts().back();
+    std::vector<staff_idx_t> dst;
+    for (const Staff* staff : lastPart->staves()) {
+        dst.push_back(staff->idx());
+    }
+    for (staff_idx_t idx = 0; idx < score->nstaves(); ++idx) {
+        if (score->staff(idx)->part() != lastPart) {
+            dst.push_back(idx);
+        }
+    }
+
+    score->sortStaves(dst);
+
+    //! CHECK The parts are moved
+    EXPECT_EQ(score->parts().front(), lastPart);
+
+    //! CHECK The results are the same as after the full rebuild
+    expectSameAsRebuild(map);
+
+    //! CHECK The collision-free intervals are kept within the parts, so they are not changed by the move
+    std::vector<IntervalList> after = queryAll(map, true);
+    ASSERT_EQ(before.size(), after.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        EXPECT_TRUE(equal(sorted(before[i]), sorted(after[i])));
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_SpannerMapTests, Map_ConcurrentQueries)
+{
+    //! GIVEN Score with a lot of spanners, the lookup trees are not built yet
+    MasterScore* score = ScoreRW::readScore(SPANNERMAP_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    const SpannerMap& map = score->spannerMap();
+    map.setDirty();
+
+    //! DO Query the map from several threads, each into its own buffer
+    constexpr size_t THREADS_COUNT = 4;
+    std::vector<size_t> counts(THREADS_COUNT, 0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < THREADS_COUNT; ++t) {
+        threads.emplace_back([&map, &counts, t]() {
+            IntervalList result;
+            for (int tick = 0; tick < 100000; tick += 120) {
+                result.clear();
+                map.findOverlapping(tick, tick + 480, result);
+                counts[t] += result.size();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK All the threads found the same
+    for (size_t t = 1; t < THREADS_COUNT; ++t) {
+        EXPECT_EQ(counts[t], counts[0]);
+    }
+    EXPECT_GT(counts[0], 0);
+
+    delete score;
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+#include "libmscore/spatialindex.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String SPATIALINDEX_DATA_DIR("all_elements_data/");
+
+class Engraving_SpatialIndexTests : public ::testing::Test
+{
+public:
+    static void collectElement(void* data, EngravingItem* e)
+    {
+        static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+    }
+
+    static std::vector<EngravingItem*> pageElements(Page* page)
+    {
+        std::vector<EngravingItem*> elements;
+        page->scanElements(&elements, collectElement, false);
+        return elements;
+    }
+
+    //! NOTE The viewports moving through the page, like during scrolling
+    static std::vector<RectF> viewports(const Page* page, int count)
+    {
+        std::vector<RectF> result;
+        const RectF pageRect = page->abbox();
+        const double width = pageRect.width() / 2;
+        const double height = pageRect.height() / 4;
+
+        for (int i = 0; i < count; ++i) {
+            double x = pageRect.left() + (pageRect.width() - width) * (i % 7) / 6.0;
+            double y = pageRect.top() + (pageRect.height() - height) * (i % 13) / 12.0;
+            result.emplace_back(x, y, width, height);
+        }
+
+        return result;
+    }
+
+    static std::vector<EngravingItem*> expectedItems(const std::vector<EngravingItem*>& elements, const RectF& rect)
+    {
+        std::vector<EngravingItem*> result;
+        for (EngravingItem* e : elements) {
+            if (e->pageBoundingRect().intersects(rect)) {
+                result.push_back(e);
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(Engraving_SpatialIndexTests, Items_SameAsLinearSearch)
+{
+    //! GIVEN Laid out score
+    MasterScore* score = ScoreRW::readScore(SPATIALINDEX_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    for (Page* page : score->pages()) {
+        std::vector<EngravingItem*> elements = pageElements(page);
+
+        //! DO Build the index over the page
+        SpatialIndex index;
+        index.build(page->abbox(), elements);
+        EXPECT_EQ(index.size(), elements.size());
+
+        //! CHECK The found items are the same as the ones found by the linear search
+        std::vector<EngravingItem*> found;
+        for (const RectF& rect : viewports(page, 50)) {
+            found.clear();
+            index.items(rect, found);
+            std::sort(found.begin(), found.end());
+
+            EXPECT_EQ(found, expectedItems(elements, rect));
+        }
+    }
+
+    delete score;
+}
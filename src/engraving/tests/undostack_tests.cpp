@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/part.h"
+#include "libmscore/segment.h"
+#include "libmscore/staff.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String UNDOSTACK_DATA_DIR(u"all_elements_data/");
+
+class Engraving_UndoStackTests : public ::testing::Test
+{
+public:
+    static EngravingItem* firstChordRest(MasterScore* score)
+    {
+        Segment* segment = score->firstMeasure()->first(SegmentType::ChordRest);
+        return segment ? segment->element(0) : nullptr;
+    }
+
+    static void changeProperty(MasterScore* score, EngravingItem* item, Pid id, const PropertyValue& value)
+    {
+        score->startCmd();
+        item->undoChangeProperty(id, value);
+        score->endCmd();
+    }
+
+    static size_t undoAll(MasterScore* score)
+    {
+        size_t count = 0;
+        while (score->undoStack()->canUndo()) {
+            score->undoStack()->undo(nullptr);
+            ++count;
+        }
+        return count;
+    }
+};
+
+TEST_F(Engraving_UndoStackTests, MemoryLimit_MergeTrivialMacros)
+{
+    //! GIVEN Score with a chord nudged many times
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    EngravingItem* item = firstChordRest(score);
+    ASSERT_TRUE(item);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryLimit(0);
+
+    const PropertyValue originalOffset = item->getProperty(Pid::OFFSET);
+    constexpr size_t NUDGES_COUNT = 30;
+    for (size_t i = 1; i <= NUDGES_COUNT; ++i) {
+        changeProperty(score, item, Pid::OFFSET, PointF(double(i), 0.0));
+    }
+
+    const size_t curIdx = undoStack->getCurIdx();
+    const size_t macroMemoryUsage = undoStack->memoryUsage() / NUDGES_COUNT;
+
+    //! DO Set the limit, the old nudges don't fit in it
+    undoStack->setMemoryLimit(macroMemoryUsage * 12);
+
+    //! CHECK The old nudges are merged into one macro, the indexes stay the same
+    EXPECT_LE(undoStack->memoryUsage(), macroMemoryUsage * 12);
+    EXPECT_EQ(undoStack->getCurIdx(), curIdx);
+    EXPECT_EQ(undoStack->droppedMacrosCount(), 0u);
+    EXPECT_EQ(item->getProperty(Pid::OFFSET), PropertyValue(PointF(double(NUDGES_COUNT), 0.0)));
+
+    //! CHECK Undo still restores the original offset and the clean state
+    EXPECT_EQ(undoAll(score), 12u);
+    EXPECT_EQ(item->getProperty(Pid::OFFSET), originalOffset);
+    EXPECT_TRUE(undoStack->isClean());
+
+    //! CHECK Redo of the merged macro sets the latest offset of it
+    undoStack->redo(nullptr);
+    EXPECT_EQ(item->getProperty(Pid::OFFSET), PropertyValue(PointF(double(NUDGES_COUNT - 11), 0.0)));
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoStackTests, MemoryLimit_DropOldestMacros)
+{
+    //! GIVEN Score with different properties changed one after another
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    EngravingItem* item = firstChordRest(score);
+    ASSERT_TRUE(item);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryLimit(0);
+
+    constexpr size_t CHANGES_COUNT = 30;
+    for (size_t i = 1; i <= CHANGES_COUNT; ++i) {
+        if (i % 2) {
+            changeProperty(score, item, Pid::OFFSET, PointF(double(i), 0.0));
+        } else {
+            changeProperty(score, item, Pid::VISIBLE, !item->visible());
+        }
+    }
+
+    const size_t curIdx = undoStack->getCurIdx();
+
+    //! DO Set the limit nothing fits in
+    undoStack->setMemoryLimit(1);
+
+    //! CHECK Only the recent history is kept, the clean state can't be reached anymore
+    EXPECT_EQ(undoStack->getCurIdx(), curIdx);
+    EXPECT_EQ(undoStack->droppedMacrosCount(), CHANGES_COUNT - 10);
+
+    EXPECT_EQ(undoAll(score), 10u);
+    EXPECT_EQ(item->getProperty(Pid::OFFSET), PropertyValue(PointF(double(CHANGES_COUNT - 11), 0.0)));
+    EXPECT_FALSE(undoStack->isClean());
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoStackTests, MemoryUsage_Parts)
+{
+    //! GIVEN Score with a part
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->parts().empty());
+
+    Part* part = score->parts().front();
+    const size_t partMemoryUsage = sizeof(Part) + part->nstaves() * sizeof(Staff);
+
+    //! DO Create the commands that hold the part
+    InsertPart insertPart(part, 0);
+    RemovePart removePart(part, 0);
+
+    //! CHECK The part is counted, not only the command itself
+    EXPECT_GE(insertPart.memoryUsage(), sizeof(UndoCommand) + partMemoryUsage);
+    EXPECT_GE(removePart.memoryUsage(), sizeof(UndoCommand) + partMemoryUsage);
+
+    delete score;
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "layoutcomp.h"
+
+#include <cmath>
+
+#include "engraving/libmscore/page.h"
+
+using namespace mu::engraving;
+
+LayoutComp::Geometry LayoutComp::geometry(Score* score)
+{
+    Geometry result;
+    for (Page* page : score->pages()) {
+        page->scanElements(&result, [](void* data, EngravingItem* item) {
+            //! NOTE In hundredths of the unit, to skip the rounding noise
+            auto round = [](double v) { return std::lround(v * 100); };
+
+            const PointF pos = item->pagePos();
+            const RectF& bbox = item->bbox();
+
+            static_cast<Geometry*>(data)->push_back({ String::fromAscii(item->typeName()),
+                                                      round(pos.x() + bbox.x()), round(pos.y() + bbox.y()),
+                                                      round(bbox.width()), round(bbox.height()) });
+        }, true);
+    }
+
+    return result;
+}
+
+std::string LayoutComp::difference(const Geometry& actual, const Geometry& expected)
+{
+    if (actual.size() != expected.size()) {
+        return "items count: " + std::to_string(actual.size()) + " vs " + std::to_string(expected.size());
+    }
+
+    auto toString = [](const ItemGeometry& g) {
+        return "(" + std::to_string(g.x) + ", " + std::to_string(g.y) + ", "
+               + std::to_string(g.width) + ", " + std::to_string(g.height) + ")";
+    };
+
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (!(actual[i] == expected[i])) {
+            return actual[i].type.toStdString() + " #" + std::to_string(i) + ": "
+                   + toString(actual[i]) + " vs " + toString(expected[i]);
+        }
+    }
+
+    return std::string();
+}
+
+bool LayoutComp::isLayoutStable(Score* score)
+{
+    score->doLayout();
+    const Geometry first = geometry(score);
+    score->doLayout();
+
+    return difference(geometry(score), first).empty();
+}
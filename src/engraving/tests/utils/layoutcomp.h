@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_LAYOUTCOMP_H
+#define MU_ENGRAVING_LAYOUTCOMP_H
+
+#include <string>
+#include <vector>
+
+#include "engraving/libmscore/score.h"
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   LayoutComp
+//    compares the positions and sizes of all the laid out items of a score
+//---------------------------------------------------------
+
+class LayoutComp
+{
+public:
+    struct ItemGeometry {
+        String type;
+        long x = 0;
+        long y = 0;
+        long width = 0;
+        long height = 0;
+
+        bool operator==(const ItemGeometry& g) const
+        {
+            return type == g.type && x == g.x && y == g.y && width == g.width && height == g.height;
+        }
+    };
+
+    using Geometry = std::vector<ItemGeometry>;
+
+    static Geometry geometry(Score* score);
+
+    //! NOTE Returns the first difference, empty if the same
+    static std::string difference(const Geometry& actual, const Geometry& expected);
+
+    //! NOTE Some scores don't get the same layout from two full layouts in a row, they can't be compared
+    static bool isLayoutStable(Score* score);
+};
+}
+
+#endif // MU_ENGRAVING_LAYOUTCOMP_H
@@ -22,6 +22,7 @@
 
 #include "scorerw.h"
 
+#include "io/dir.h"
 #include "io/file.h"
 #include "io/buffer.h"
 
@@ -50,6 +51,13 @@ String ScoreRW::rootPath()
     return m_rootPath;
 }
 
+io::paths_t ScoreRW::vtestScores()
+{
+    RetVal<io::paths_t> files = io::Dir::scanFiles(rootPath() + u"/../../../vtest/scores", { "*.mscx" },
+                                                   io::ScanMode::FilesInCurrentDir);
+    return files.ret ? files.val : io::paths_t();
+}
+
 MasterScore* ScoreRW::readScore(const String& name, bool isAbsolutePath, ImportFunc importFunc)
 {
     io::path_t path = isAbsolutePath ? name : (rootPath() + u"/" + name);
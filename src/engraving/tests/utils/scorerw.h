@@ -25,6 +25,7 @@
 
 #include <functional>
 
+#include "io/path.h"
 #include "types/string.h"
 
 #include "engraving/engravingerrors.h"
@@ -39,6 +40,9 @@ public:
     static void setRootPath(const String& path);
     static String rootPath();
 
+    //! NOTE The scores of the visual tests (vtest/scores), empty if they are not in the source tree
+    static io::paths_t vtestScores();
+
     using ImportFunc = std::function<Err(MasterScore* score, const io::path_t& path)>;
 
     static MasterScore* readScore(const String& path, bool isAbsolutePath = false, ImportFunc importFunc = nullptr);
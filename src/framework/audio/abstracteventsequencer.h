@@ -23,8 +23,10 @@
 #ifndef MU_AUDIO_ABSTRACTEVENTSEQUENCER_H
 #define MU_AUDIO_ABSTRACTEVENTSEQUENCER_H
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -43,12 +45,40 @@ public:
     using EventSequence = std::set<EventType>;
     using EventSequenceMap = std::map<msecs_t, EventSequence>;
 
-    typedef typename EventSequenceMap::const_iterator SequenceIterator;
-    typedef typename EventSequence::const_iterator EventIterator;
+    struct TimedEvent {
+        msecs_t timestamp = 0;
+        EventType event;
+    };
+
+    //! NOTE Events sorted by timestamp, the events with the same timestamp keep the order of EventSequence
+    using EventTimeline = std::vector<TimedEvent>;
+
+    //! NOTE The events due within the processed block.
+    //! Points into the timeline of the sequencer, so it is valid until the events are updated
+    class EventSpan
+    {
+    public:
+        EventSpan() = default;
+        EventSpan(const TimedEvent* first, const TimedEvent* last, msecs_t blockStart)
+            : m_first(first), m_last(last), m_blockStart(blockStart) {}
+
+        const TimedEvent* begin() const { return m_first; }
+        const TimedEvent* end() const { return m_last; }
+        bool empty() const { return m_first == m_last; }
+
+        //! NOTE Time from the start of the block, the overdue events are due at its start
+        msecs_t offset(const TimedEvent& event) const { return std::max(event.timestamp - m_blockStart, msecs_t(0)); }
+
+    private:
+        const TimedEvent* m_first = nullptr;
+        const TimedEvent* m_last = nullptr;
+        msecs_t m_blockStart = 0;
+    };
 
     virtual ~AbstractEventSequencer()
     {
         m_mainStreamChanges.resetOnReceive(this);
+        m_mainStreamDiffChanges.resetOnReceive(this);
         m_offStreamChanges.resetOnReceive(this);
         m_dynamicLevelChanges.resetOnReceive(this);
     }
@@ -58,6 +88,7 @@ public:
         ONLY_AUDIO_WORKER_THREAD;
 
         m_mainStreamChanges = data.mainStream;
+        m_mainStreamDiffChanges = data.mainStreamDiff;
         m_offStreamChanges = data.offStream;
         m_dynamicLevelChanges = data.dynamicLevelChanges;
 
@@ -73,6 +104,11 @@ public:
             updateMainStreamEvents(changes);
         });
 
+        m_mainStreamDiffChanges.onReceive(this, [this](const mpe::PlaybackEventsDiff& diff) {
+            diff.applyTo(m_playbackEventsMap);
+            updateMainStreamEvents(m_playbackEventsMap);
+        });
+
         m_dynamicLevelChanges.onReceive(this, [this](const mpe::DynamicLevelMap& changes) {
             m_dynamicLevelMap = changes;
             updateDynamicChanges(changes);
@@ -111,7 +147,7 @@ public:
         ONLY_AUDIO_WORKER_THREAD;
 
         m_playbackPosition = newPlaybackPosition;
-        resetAllIterators();
+        seekMainTimeline();
     }
 
     msecs_t playbackPosition() const
@@ -139,105 +175,121 @@ public:
         return std::prev(upper)->second;
     }
 
-    EventSequence eventsToBePlayed(const msecs_t nextMsecs)
+    //! NOTE Called on the audio thread for every block, so it only moves the cursors and doesn't allocate.
+    //! The block is [position, position + nextMsecs), the position is advanced to its end
+    EventSpan eventsToBePlayed(const msecs_t nextMsecs)
     {
         ONLY_AUDIO_WORKER_THREAD;
 
-        EventSequence result;
-
-        result.clear();
-
         if (!m_isActive) {
-            handleOffStream(result, nextMsecs);
-            return result;
-        }
-
-        if (m_currentMainSequenceIt == m_mainStreamEvents.cend()) {
+            EventSpan result = takeDueEvents(m_offStreamTimeline, m_offCursor, m_offStreamPosition, nextMsecs);
+            m_offStreamPosition += nextMsecs;
             return result;
         }
 
+        EventSpan result = takeDueEvents(m_mainStreamTimeline, m_mainCursor, m_playbackPosition, nextMsecs);
         m_playbackPosition += nextMsecs;
-
-        handleMainStream(result);
-        handleDynamicChanges(result);
-
         return result;
     }
 
 protected:
-    void resetAllIterators()
+    //! NOTE Must be called after m_mainStreamEvents or m_dynamicEvents are changed
+    void updateMainStreamTimeline()
     {
-        updateMainSequenceIterator();
-        updateOffSequenceIterator();
-        updateDynamicChangesIterator();
-    }
+        m_mainStreamTimeline.clear();
 
-    void updateMainSequenceIterator()
-    {
-        m_currentMainSequenceIt = m_mainStreamEvents.lower_bound(m_playbackPosition);
-    }
+        auto mainIt = m_mainStreamEvents.cbegin();
+        auto dynamicIt = m_dynamicEvents.cbegin();
 
-    void updateOffSequenceIterator()
-    {
-        m_currentOffSequenceIt = m_offStreamEvents.cbegin();
-    }
+        while (mainIt != m_mainStreamEvents.cend() || dynamicIt != m_dynamicEvents.cend()) {
+            const bool takeMain = dynamicIt == m_dynamicEvents.cend()
+                                  || (mainIt != m_mainStreamEvents.cend() && mainIt->first <= dynamicIt->first);
+            const bool takeDynamic = mainIt == m_mainStreamEvents.cend()
+                                     || (dynamicIt != m_dynamicEvents.cend() && dynamicIt->first <= mainIt->first);
 
-    void updateDynamicChangesIterator()
-    {
-        m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
+            static const EventSequence EMPTY;
+            const msecs_t timestamp = takeMain ? mainIt->first : dynamicIt->first;
+            const EventSequence& main = takeMain ? mainIt->second : EMPTY;
+            const EventSequence& dynamic = takeDynamic ? dynamicIt->second : EMPTY;
+
+            appendMerged(m_mainStreamTimeline, timestamp, main, dynamic);
+
+            if (takeMain) {
+                ++mainIt;
+            }
+
+            if (takeDynamic) {
+                ++dynamicIt;
+            }
+        }
+
+        seekMainTimeline();
     }
 
-    void handleOffStream(EventSequence& result, const msecs_t nextMsecs)
+    //! NOTE Must be called after m_offStreamEvents are changed, the timestamps are counted from this moment
+    void updateOffStreamTimeline()
     {
-        if (m_offStreamEvents.empty() || m_currentOffSequenceIt == m_offStreamEvents.cend()) {
-            return;
-        }
+        m_offStreamTimeline.clear();
 
-        if (m_currentOffSequenceIt->first <= nextMsecs) {
-            result = m_currentOffSequenceIt->second;
-            m_currentOffSequenceIt = m_offStreamEvents.erase(m_currentOffSequenceIt);
-        } else {
-            auto node = m_offStreamEvents.extract(m_currentOffSequenceIt);
-            node.key() -= nextMsecs;
-            m_offStreamEvents.insert(std::move(node));
-            updateOffSequenceIterator();
+        for (const auto& pair : m_offStreamEvents) {
+            for (const EventType& event : pair.second) {
+                m_offStreamTimeline.push_back({ pair.first, event });
+            }
         }
+
+        m_offStreamPosition = 0;
+        m_offCursor = 0;
     }
 
-    void handleMainStream(EventSequence& result)
+    void seekMainTimeline()
     {
-        if (m_currentMainSequenceIt->first <= m_playbackPosition) {
-            result.insert(m_currentMainSequenceIt->second.cbegin(),
-                          m_currentMainSequenceIt->second.cend());
+        auto it = std::lower_bound(m_mainStreamTimeline.cbegin(), m_mainStreamTimeline.cend(), m_playbackPosition,
+                                   [](const TimedEvent& event, msecs_t position) {
+            return event.timestamp < position;
+        });
 
-            m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
-        }
+        m_mainCursor = static_cast<size_t>(std::distance(m_mainStreamTimeline.cbegin(), it));
     }
 
-    void handleDynamicChanges(EventSequence& result)
+    static EventSpan takeDueEvents(const EventTimeline& timeline, size_t& cursor, msecs_t blockStart, msecs_t blockDuration)
     {
-        if (m_dynamicEvents.empty() || m_currentDynamicsIt == m_dynamicEvents.cend()) {
-            return;
+        const size_t first = cursor;
+        const msecs_t blockEnd = blockStart + blockDuration;
+
+        while (cursor < timeline.size() && timeline[cursor].timestamp < blockEnd) {
+            ++cursor;
         }
 
-        if (m_currentDynamicsIt->first <= m_playbackPosition) {
-            result.insert(m_currentDynamicsIt->second.cbegin(),
-                          m_currentDynamicsIt->second.cend());
+        const TimedEvent* data = timeline.data();
+        return EventSpan(data + first, data + cursor, blockStart);
+    }
 
-            m_currentDynamicsIt = std::next(m_currentDynamicsIt);
+    static void appendMerged(EventTimeline& timeline, msecs_t timestamp, const EventSequence& first, const EventSequence& second)
+    {
+        auto firstIt = first.cbegin();
+        auto secondIt = second.cbegin();
+
+        while (firstIt != first.cend() || secondIt != second.cend()) {
+            if (secondIt == second.cend() || (firstIt != first.cend() && !(*secondIt < *firstIt))) {
+                timeline.push_back({ timestamp, *firstIt++ });
+            } else {
+                timeline.push_back({ timestamp, *secondIt++ });
+            }
         }
     }
 
     mutable msecs_t m_playbackPosition = 0;
 
-    SequenceIterator m_currentMainSequenceIt;
-    SequenceIterator m_currentOffSequenceIt;
-    SequenceIterator m_currentDynamicsIt;
-
     EventSequenceMap m_mainStreamEvents;
     EventSequenceMap m_offStreamEvents;
     EventSequenceMap m_dynamicEvents;
 
+    EventTimeline m_mainStreamTimeline;
+    EventTimeline m_offStreamTimeline;
+    size_t m_mainCursor = 0;
+    size_t m_offCursor = 0;
+    msecs_t m_offStreamPosition = 0;
+
     mpe::DynamicLevelMap m_dynamicLevelMap;
     mpe::PlaybackEventsMap m_playbackEventsMap;
 
@@ -247,6 +299,7 @@ protected:
     bool m_isActive = false;
 
     mpe::PlaybackEventsChanges m_mainStreamChanges;
+    mpe::PlaybackEventsDiffChanges m_mainStreamDiffChanges;
     mpe::PlaybackEventsChanges m_offStreamChanges;
     mpe::DynamicLevelChanges m_dynamicLevelChanges;
 };
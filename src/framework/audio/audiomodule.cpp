@@ -22,6 +22,7 @@
 #include "audiomodule.h"
 
 #include <QQmlEngine>
+#include <QTimer>
 
 #include "ui/iuiengine.h"
 #include "modularity/ioc.h"
@@ -33,6 +34,7 @@
 #include "internal/audiobuffer.h"
 #include "internal/audiothreadsecurer.h"
 #include "internal/audiooutputdevicecontroller.h"
+#include "internal/audiotelemetry.h"
 
 #include "internal/worker/audioengine.h"
 #include "internal/worker/playback.h"
@@ -69,6 +71,10 @@ static std::shared_ptr<Playback> s_playbackFacade = std::make_shared<Playback>()
 
 static std::shared_ptr<SoundFontRepository> s_soundFontRepository = std::make_shared<SoundFontRepository>();
 
+//! NOTE About the refresh rate of the screen, the meters and the playback cursor don't need more
+static constexpr int TELEMETRY_FLUSH_INTERVAL_MSECS = 16;
+static std::unique_ptr<QTimer> s_telemetryFlushTimer;
+
 #ifdef Q_OS_LINUX
 #include "internal/platform/lin/linuxaudiodriver.h"
 static std::shared_ptr<IAudioDriver> s_audioDriver = std::shared_ptr<IAudioDriver>(new LinuxAudioDriver());
@@ -160,6 +166,11 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
         Objects from different layers (threads) must interact only through:
             * Asynchronous API (@see thirdparty/deto) - controls and pass midi data
             * AudioBuffer - pass audio data from worker to driver for play
+            * AudioTelemetry - pass meters and playback state from worker to main without blocking the worker
+
+        The commands from main to worker (play, seek, volume...) go through the asynchronous API,
+        not through a lock-free queue: they are rare and are processed by the worker thread
+        between the buffer refills, never by the driver callback.
 
         AudioEngine is in the worker and operates only with the buffer,
         in fact, it knows nothing about the data consumer, about the audio driver.
@@ -173,11 +184,35 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
     s_audioBuffer->init(s_audioConfiguration->audioChannelsCount(),
                         s_audioConfiguration->renderStep());
 
+    //! NOTE Set before the driver is opened, pop() reads it in the driver callback without a lock.
+    //! It doesn't wake the worker up, the worker only skips the next wait if the buffer was read during the refill
+    s_audioBuffer->setOnRead([]() {
+        if (!s_audioWorker->isIdle()) {
+            s_audioWorker->wakeFromRealtime();
+        }
+    });
+
     s_audioOutputController->init();
 
     // Setup audio driver
     setupAudioDriver(mode);
 
+    // Deliver the state published by the worker, only while the playback or the metering is active.
+    // The timer is started and stopped only here, on the main thread, the worker doesn't notify about the published state
+    s_telemetryFlushTimer = std::make_unique<QTimer>();
+    s_telemetryFlushTimer->setInterval(TELEMETRY_FLUSH_INTERVAL_MSECS);
+    QObject::connect(s_telemetryFlushTimer.get(), &QTimer::timeout, []() {
+        if (!AudioTelemetry::instance()->flush()) {
+            s_telemetryFlushTimer->stop();
+        }
+    });
+
+    AudioTelemetry::instance()->activated().onNotify(nullptr, []() {
+        if (s_telemetryFlushTimer && !s_telemetryFlushTimer->isActive()) {
+            s_telemetryFlushTimer->start();
+        }
+    });
+
     //! --- Diagnostics ---
     auto pr = ioc()->resolve<diagnostics::IDiagnosticsPathsRegister>(moduleName());
     if (pr) {
@@ -190,6 +225,8 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
 
 void AudioModule::onDeinit()
 {
+    s_telemetryFlushTimer.reset();
+
     if (s_audioDriver->isOpened()) {
         s_audioDriver->close();
     }
@@ -253,7 +290,15 @@ void AudioModule::setupAudioWorker(const IAudioDriver::Spec& activeSpec)
     auto workerLoopBody = []() {
         ONLY_AUDIO_WORKER_THREAD;
         s_audioBuffer->forward();
+
+        MixerPtr mixer = AudioEngine::instance()->mixer();
+        s_audioWorker->setIdle(mixer && mixer->isIdle());
     };
 
+    //! NOTE While playing, the worker is driven by this timeout, it refills the buffer once per driver buffer
+    if (activeSpec.sampleRate > 0) {
+        s_audioWorker->setActiveWaitTimeout(std::chrono::microseconds(uint64_t(activeSpec.samples) * 1000000 / activeSpec.sampleRate));
+    }
+
     s_audioWorker->run(workerSetup, workerLoopBody);
 }
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "internal/dsp/audiokernels.h"
+
+using namespace mu::audio::dsp;
+
+//! NOTE Reports ns/sample of every DSP kernel for every instruction set supported by the CPU
+//! Usage: audio_dsp_benchmark [samplesPerChannel] [iterations]
+
+static double measure(size_t samplesCount, int iterations, const std::function<void()>& func)
+{
+    //! NOTE Warm-up
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(duration).count() / (static_cast<double>(samplesCount) * iterations);
+}
+
+int main(int argc, char** argv)
+{
+    size_t samplesPerChannel = argc > 1 ? std::stoul(argv[1]) : 512;
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 100000;
+
+    constexpr size_t AUDIO_CHANNELS_COUNT = 2;
+    const size_t samplesCount = samplesPerChannel * AUDIO_CHANNELS_COUNT;
+
+    std::vector<float> src(samplesCount);
+    std::vector<float> dst(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        src[i] = static_cast<float>(i % 200) / 100.f - 1.f;
+    }
+
+    //! NOTE Unity gains, so the repeatedly processed buffer never turns into denormals
+    const float gains[AUDIO_CHANNELS_COUNT] = { 1.f, 1.f };
+    float squaredSums[AUDIO_CHANNELS_COUNT] = { 0.f, 0.f };
+    volatile float sink = 0.f;
+
+    std::printf("samples per channel: %zu, audio channels: %zu, iterations: %d\n", samplesPerChannel, AUDIO_CHANNELS_COUNT,
+                iterations);
+    std::printf("%-8s %14s %14s %14s %14s %14s\n", "set", "accumulate", "multiply", "sumOfSquares", "peak", "gain+squares");
+
+    for (InstructionSet set : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON }) {
+        if (!isInstructionSetSupported(set)) {
+            continue;
+        }
+
+        selectInstructionSet(set);
+
+        double accumulateNs = measure(samplesCount, iterations, [&]() {
+            accumulate(dst.data(), src.data(), samplesCount);
+        });
+
+        double multiplyNs = measure(samplesCount, iterations, [&]() {
+            multiply(dst.data(), samplesCount, gains[0]);
+        });
+
+        double sumOfSquaresNs = measure(samplesCount, iterations, [&]() {
+            sink = sink + sumOfSquares(src.data(), samplesCount);
+        });
+
+        double peakNs = measure(samplesCount, iterations, [&]() {
+            sink = sink + peak(src.data(), samplesCount);
+        });
+
+        double gainNs = measure(samplesCount, iterations, [&]() {
+            applyGainAndSumOfSquares(dst.data(), AUDIO_CHANNELS_COUNT, samplesPerChannel, gains, squaredSums);
+        });
+
+        std::printf("%-8s %11.3f ns %11.3f ns %11.3f ns %11.3f ns %11.3f ns\n", instructionSetName(set),
+                    accumulateNs, multiplyNs, sumOfSquaresNs, peakNs, gainNs);
+    }
+
+    return 0;
+}
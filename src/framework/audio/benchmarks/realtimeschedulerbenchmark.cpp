@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "concurrency/realtimetaskscheduler.h"
+#include "concurrency/taskscheduler.h"
+
+using namespace mu;
+
+//! NOTE The mixer-like workload: every channel renders its block on the pool, then the blocks are mixed.
+//! Reports ms per block of RealtimeTaskScheduler::parallelFor compared with TaskScheduler::submit,
+//! the way Mixer::process() submitted the channels before
+//! Usage: audio_scheduler_benchmark [channels] [samplesPerChannel] [blocks]
+
+static constexpr size_t AUDIO_CHANNELS_COUNT = 2;
+
+static void processBlock(std::vector<float>& buffer, size_t channelIdx)
+{
+    for (size_t s = 0; s < buffer.size(); ++s) {
+        buffer[s] = std::sin(static_cast<float>(s + channelIdx) * 0.01f);
+    }
+}
+
+static double measure(int blocks, const std::function<void()>& func)
+{
+    //! NOTE Warm-up, starts the threads of the pools
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < blocks; ++i) {
+        func();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::milli>(duration).count() / blocks;
+}
+
+int main(int argc, char** argv)
+{
+    size_t channels = argc > 1 ? std::stoul(argv[1]) : 64;
+    size_t samplesPerChannel = argc > 2 ? std::stoul(argv[2]) : 128;
+    int blocks = argc > 3 ? std::stoi(argv[3]) : 2000;
+
+    const size_t blockSize = samplesPerChannel * AUDIO_CHANNELS_COUNT;
+
+    using Buffers = std::vector<std::vector<float> >;
+    Buffers submitBuffers(channels, std::vector<float>(blockSize, 0.f));
+    Buffers parallelForBuffers(channels, std::vector<float>(blockSize, 0.f));
+
+    double submitMs = measure(blocks, [&]() {
+        std::vector<std::future<std::vector<float> > > futures;
+
+        for (size_t idx = 0; idx < channels; ++idx) {
+            futures.emplace_back(TaskScheduler::instance()->submit([idx, blockSize]() -> std::vector<float> {
+                std::vector<float> buffer(blockSize, 0.f);
+                processBlock(buffer, idx);
+                return buffer;
+            }));
+        }
+
+        for (size_t idx = 0; idx < channels; ++idx) {
+            submitBuffers[idx] = futures[idx].get();
+        }
+    });
+
+    double parallelForMs = measure(blocks, [&]() {
+        RealtimeTaskScheduler::instance()->parallelFor(channels, [&parallelForBuffers](size_t idx) {
+            processBlock(parallelForBuffers[idx], idx);
+        });
+    });
+
+    std::printf("channels: %zu, samples per channel: %zu, blocks: %d, workers: %zu\n", channels, samplesPerChannel, blocks,
+                RealtimeTaskScheduler::instance()->workersCount());
+    std::printf("%-14s %11.4f ms per block\n", "submit", submitMs);
+    std::printf("%-14s %11.4f ms per block\n", "parallel_for", parallelForMs);
+
+    if (submitBuffers != parallelForBuffers) {
+        std::printf("the results differ\n");
+        return 1;
+    }
+
+    return 0;
+}
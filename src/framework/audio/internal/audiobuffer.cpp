@@ -149,6 +149,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
     if (currentReadIdx == currentWriteIdx) { // empty queue
         std::memcpy(dest, SILENT_FRAMES.data(), sampleCount * sizeof(float) * m_audioChannelsCount);
+
+        if (m_onRead) {
+            m_onRead();
+        }
         return;
     }
 
@@ -182,6 +186,15 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     }
 
     m_readIndex.store(newReadIdx, std::memory_order_release);
+
+    if (m_onRead) {
+        m_onRead();
+    }
+}
+
+void AudioBuffer::setOnRead(std::function<void()> onRead)
+{
+    m_onRead = std::move(onRead);
 }
 
 void AudioBuffer::setMinSamplesToReserve(size_t lag)
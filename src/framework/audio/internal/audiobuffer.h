@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
@@ -56,6 +57,10 @@ public:
     void pop(float* dest, size_t sampleCount);
     void setMinSamplesToReserve(size_t lag);
 
+    //! NOTE Called by pop() in the consumer thread, so it must be realtime-safe:
+    //! it can't lock or notify, e.g. to wake up the producer. Not synchronized with pop(), set it before the consumer starts
+    void setOnRead(std::function<void()> onRead);
+
     void reset();
 
 private:
@@ -74,6 +79,8 @@ private:
     samples_t m_renderStep = 0;
 
     std::shared_ptr<IAudioSource> m_source = nullptr;
+
+    std::function<void()> m_onRead = nullptr;
 };
 
 using AudioBufferPtr = std::shared_ptr<AudioBuffer>;
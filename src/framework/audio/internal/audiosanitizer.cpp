@@ -24,6 +24,7 @@
 #include <thread>
 
 #include "concurrency/taskscheduler.h"
+#include "concurrency/realtimetaskscheduler.h"
 
 using namespace mu::audio;
 
@@ -59,5 +60,7 @@ bool AudioSanitizer::isWorkerThread()
 {
     std::thread::id id = std::this_thread::get_id();
 
-    return TaskScheduler::instance()->containsThread(id) || id == s_as_workerThreadID;
+    return TaskScheduler::instance()->containsThread(id)
+           || RealtimeTaskScheduler::instance()->containsThread(id)
+           || id == s_as_workerThreadID;
 }
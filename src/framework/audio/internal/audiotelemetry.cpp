@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiotelemetry.h"
+
+#include <algorithm>
+
+#include "audiosanitizer.h"
+
+using namespace mu::audio;
+
+AudioTelemetry* AudioTelemetry::instance()
+{
+    static AudioTelemetry t;
+    return &t;
+}
+
+void AudioTelemetry::registerSource(const ISourcePtr& source)
+{
+    std::lock_guard lock(m_mutex);
+    m_sources.push_back(source);
+}
+
+void AudioTelemetry::markPending()
+{
+    m_pending.store(true);
+}
+
+void AudioTelemetry::activate()
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    m_activationFlushesLeft = ACTIVATION_FLUSHES;
+
+    if (!m_flushing) {
+        m_flushing = true;
+        m_activated.notify();
+    }
+}
+
+mu::async::Notification AudioTelemetry::activated() const
+{
+    return m_activated;
+}
+
+bool AudioTelemetry::flush()
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(), [this](const std::weak_ptr<ISource>& weak) {
+            ISourcePtr source = weak.lock();
+            if (!source) {
+                return true;
+            }
+
+            m_flushingSources.push_back(std::move(source));
+            return false;
+        }), m_sources.end());
+    }
+
+    bool pending = m_pending.exchange(false);
+    bool active = false;
+
+    //! NOTE Without the lock, so the subscribers may do anything, including registering new sources
+    for (const ISourcePtr& source : m_flushingSources) {
+        if (pending) {
+            source->flush();
+        }
+
+        active = active || source->isActive();
+    }
+
+    m_flushingSources.clear();
+
+    if (m_activationFlushesLeft > 0) {
+        --m_activationFlushesLeft;
+        active = true;
+    }
+
+    //! NOTE The data published after the stop stays pending until the next activate,
+    //! nobody waits for it, e.g. the meters aren't shown
+    m_flushing = active || pending;
+
+    return m_flushing;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOTELEMETRY_H
+#define MU_AUDIO_AUDIOTELEMETRY_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "async/notification.h"
+
+namespace mu::audio {
+//! NOTE Delivers the state published by the worker (meters, playback position and status) to the main thread.
+//! The worker writes it to the pre-allocated slots and queues of the sources and marks it as pending,
+//! that is just an atomic store, so the worker neither allocates memory nor takes locks and never notifies the main thread.
+//! The main thread periodically flushes the sources to the channels its subscribers listen to.
+//! The flushing is started and stopped by the main thread only: it's started by activate, e.g. on a playback command
+//! or a subscription to the meters, and runs while any source is active, e.g. the playback is running or the meters are shown
+class AudioTelemetry
+{
+public:
+    class ISource
+    {
+    public:
+        virtual ~ISource() = default;
+
+        //! NOTE Main thread
+        virtual void flush() = 0;
+
+        //! NOTE Main thread. Whether the main thread waits for the data from the source, the flushing runs while it's true
+        virtual bool isActive() const = 0;
+    };
+
+    using ISourcePtr = std::shared_ptr<ISource>;
+
+    static AudioTelemetry* instance();
+
+    //! NOTE The telemetry doesn't own the sources, the destroyed ones are just skipped
+    void registerSource(const ISourcePtr& source);
+
+    //! NOTE Any thread, neither allocates memory nor takes locks
+    void markPending();
+
+    //! NOTE Main thread. Starts the flushing, it runs at least ACTIVATION_FLUSHES flushes,
+    //! so the worker has time to respond to the command and the subscribers have time to connect
+    void activate();
+    async::Notification activated() const;
+
+    //! NOTE Main thread. Returns false if the flushing can be stopped until the next activate
+    bool flush();
+
+    static constexpr int ACTIVATION_FLUSHES = 30;
+
+private:
+    AudioTelemetry() = default;
+
+    std::atomic<bool> m_pending = false;
+
+    bool m_flushing = false;
+    int m_activationFlushesLeft = 0;
+    async::Notification m_activated;
+
+    std::mutex m_mutex;
+    std::vector<std::weak_ptr<ISource> > m_sources;
+    std::vector<ISourcePtr> m_flushingSources;
+};
+}
+
+#endif // MU_AUDIO_AUDIOTELEMETRY_H
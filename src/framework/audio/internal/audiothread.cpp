@@ -21,6 +21,9 @@
  */
 #include "audiothread.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "log.h"
 #include "runtime.h"
 #include "async/processevents.h"
@@ -31,8 +34,22 @@
 
 using namespace mu::audio;
 
+//! NOTE While playing, the worker refills the buffer once per timeout, nothing else wakes it up in time:
+//! the driver callback can't, so the timeout is the driver buffer duration, see setActiveWaitTimeout()
+static constexpr std::chrono::milliseconds DEFAULT_ACTIVE_WAIT_TIMEOUT(2);
+
+static int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 std::thread::id AudioThread::ID;
 
+AudioThread::AudioThread()
+    : m_activeWaitTimeout(DEFAULT_ACTIVE_WAIT_TIMEOUT)
+{
+}
+
 AudioThread::~AudioThread()
 {
     if (m_running) {
@@ -62,9 +79,16 @@ void AudioThread::stop(const Runnable& onFinished)
 {
     m_onFinished = onFinished;
     m_running = false;
+    wake();
+
     if (m_thread) {
         m_thread->join();
     }
+
+    LatencyStats stats = latencyStats();
+    if (stats.count > 0) {
+        LOGI() << "command latency, avg: " << stats.sumMs / stats.count << " ms, max: " << stats.maxMs << " ms, count: " << stats.count;
+    }
 }
 
 bool AudioThread::isRunning() const
@@ -72,27 +96,106 @@ bool AudioThread::isRunning() const
     return m_running;
 }
 
+void AudioThread::wake()
+{
+    int64_t expected = 0;
+    m_firstWakeTimeNs.compare_exchange_strong(expected, nowNs());
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeRequested = true;
+    }
+
+    m_wakeCv.notify_one();
+}
+
+//! NOTE Without the lock and the notification, a sleeping worker sees the flag only when the timeout expires
+void AudioThread::wakeFromRealtime()
+{
+    m_wakeRequested.store(true, std::memory_order_release);
+}
+
+void AudioThread::setActiveWaitTimeout(std::chrono::microseconds timeout)
+{
+    m_activeWaitTimeout = timeout;
+}
+
+void AudioThread::setIdle(bool idle)
+{
+    m_idle = idle;
+}
+
+bool AudioThread::isIdle() const
+{
+    return m_idle;
+}
+
+AudioThread::LatencyStats AudioThread::latencyStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_latencyStats;
+}
+
 void AudioThread::main()
 {
     mu::runtime::setThreadName("audio_worker");
 
     AudioThread::ID = std::this_thread::get_id();
 
+    mu::async::onInvoke(AudioThread::ID, [this]() {
+        wake();
+    });
+
     if (m_onStart) {
         m_onStart();
     }
 
     while (m_running) {
         mu::async::processEvents();
+        updateLatencyStats();
 
         if (m_mainLoopBody) {
             m_mainLoopBody();
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        waitForWake();
     }
 
+    mu::async::onInvoke(AudioThread::ID, nullptr);
+
     if (m_onFinished) {
         m_onFinished();
     }
 }
+
+void AudioThread::waitForWake()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+    auto woken = [this]() {
+        return m_wakeRequested.load() || !m_running;
+    };
+
+    if (m_idle) {
+        m_wakeCv.wait(lock, woken);
+    } else {
+        m_wakeCv.wait_for(lock, m_activeWaitTimeout, woken);
+    }
+
+    m_wakeRequested = false;
+}
+
+void AudioThread::updateLatencyStats()
+{
+    const int64_t wakeTimeNs = m_firstWakeTimeNs.exchange(0);
+    if (wakeTimeNs == 0) {
+        return;
+    }
+
+    const double latencyMs = (nowNs() - wakeTimeNs) / 1000000.0;
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_latencyStats.count++;
+    m_latencyStats.sumMs += latencyMs;
+    m_latencyStats.maxMs = std::max(m_latencyStats.maxMs, latencyMs);
+}
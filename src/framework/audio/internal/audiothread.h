@@ -26,13 +26,21 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
 
 namespace mu::audio {
+//! NOTE While playing, the worker is driven by the timer: it sleeps for the active wait timeout,
+//! the driver buffer duration, between the buffer refills. Only a call from another thread (see async::onInvoke)
+//! or stop() wake it up before the timeout. The driver callback can't make syscalls, so it doesn't wake the worker:
+//! wakeFromRealtime() only sets the flag, then the worker doesn't go to sleep after the current iteration.
+//! In the idle mode, when nothing is playing, there is no timeout, only the calls from other threads wake it up
 class AudioThread
 {
 public:
-    AudioThread() = default;
+    AudioThread();
     ~AudioThread();
 
     static std::thread::id ID;
@@ -43,8 +51,28 @@ public:
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    void wake();
+    void wakeFromRealtime();     // doesn't wake the worker up, only sets the flag checked before the next wait
+
+    //! NOTE Must be not longer than the driver buffer duration, set before run()
+    void setActiveWaitTimeout(std::chrono::microseconds timeout);
+
+    void setIdle(bool idle);     // only from the worker
+    bool isIdle() const;
+
+    struct LatencyStats {
+        uint64_t count = 0;
+        double sumMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    //! NOTE The time from the first wake() to the processing of the queued calls
+    LatencyStats latencyStats() const;
+
 private:
     void main();
+    void waitForWake();
+    void updateLatencyStats();
 
     Runnable m_onStart = nullptr;
     Runnable m_mainLoopBody = nullptr;
@@ -52,6 +80,16 @@ private:
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    std::atomic<bool> m_wakeRequested = false;
+    std::atomic<int64_t> m_firstWakeTimeNs = 0;
+    std::atomic<bool> m_idle = false;
+    std::chrono::microseconds m_activeWaitTimeout;
+
+    mutable std::mutex m_statsMutex;
+    LatencyStats m_latencyStats;
 };
 using AudioThreadPtr = std::shared_ptr<AudioThread>;
 }
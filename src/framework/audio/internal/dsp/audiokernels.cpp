@@ -0,0 +1,585 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiokernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MU_AUDIO_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define MU_AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(MU_AUDIO_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MU_TARGET_AVX2
+#endif
+
+using namespace mu::audio::dsp;
+
+namespace {
+struct Kernels {
+    void (*accumulate)(float* dst, const float* src, size_t count) = nullptr;
+    void (*multiply)(float* buffer, size_t count, float gain) = nullptr;
+    float (*sumOfSquares)(const float* buffer, size_t count) = nullptr;
+    float (*peak)(const float* buffer, size_t count) = nullptr;
+
+    //! NOTE Interleaved stereo: applies the gains and returns the sums of squares per channel
+    void (*stereoGainAndSumOfSquares)(float* buffer, size_t samplesPerChannel, float leftGain, float rightGain,
+                                      float* leftSquaredSum, float* rightSquaredSum) = nullptr;
+};
+
+// ================================================
+// Scalar
+// ================================================
+
+void accumulateScalar(float* dst, const float* src, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+void multiplyScalar(float* buffer, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+float sumOfSquaresScalar(const float* buffer, size_t count)
+{
+    float result = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        result += buffer[i] * buffer[i];
+    }
+
+    return result;
+}
+
+float peakScalar(const float* buffer, size_t count)
+{
+    float result = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        result = std::max(result, std::abs(buffer[i]));
+    }
+
+    return result;
+}
+
+void stereoGainAndSumOfSquaresScalar(float* buffer, size_t samplesPerChannel, float leftGain, float rightGain,
+                                     float* leftSquaredSum, float* rightSquaredSum)
+{
+    float left = 0.f;
+    float right = 0.f;
+
+    for (size_t s = 0; s < samplesPerChannel; ++s) {
+        float l = buffer[2 * s] * leftGain;
+        float r = buffer[2 * s + 1] * rightGain;
+
+        buffer[2 * s] = l;
+        buffer[2 * s + 1] = r;
+
+        left += l * l;
+        right += r * r;
+    }
+
+    *leftSquaredSum = left;
+    *rightSquaredSum = right;
+}
+
+// ================================================
+// SSE2
+// ================================================
+
+#ifdef MU_AUDIO_KERNELS_X86
+void accumulateSse2(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+
+    accumulateScalar(dst + i, src + i, count - i);
+}
+
+void multiplySse2(float* buffer, size_t count, float gain)
+{
+    const __m128 gainVec = _mm_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), gainVec));
+    }
+
+    multiplyScalar(buffer + i, count - i, gain);
+}
+
+float horizontalSumSse2(__m128 vec)
+{
+    __m128 shuffled = _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(vec, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+
+    return _mm_cvtss_f32(sums);
+}
+
+float sumOfSquaresSse2(const float* buffer, size_t count)
+{
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(buffer + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+    }
+
+    return horizontalSumSse2(acc) + sumOfSquaresScalar(buffer + i, count - i);
+}
+
+float peakSse2(const float* buffer, size_t count)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm_max_ps(acc, _mm_and_ps(_mm_loadu_ps(buffer + i), absMask));
+    }
+
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+
+    float result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+
+    return std::max(result, peakScalar(buffer + i, count - i));
+}
+
+void stereoGainAndSumOfSquaresSse2(float* buffer, size_t samplesPerChannel, float leftGain, float rightGain,
+                                   float* leftSquaredSum, float* rightSquaredSum)
+{
+    const __m128 gainVec = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+    const size_t count = samplesPerChannel * 2;
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(buffer + i), gainVec);
+        _mm_storeu_ps(buffer + i, v);
+        acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+    }
+
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+
+    stereoGainAndSumOfSquaresScalar(buffer + i, (count - i) / 2, leftGain, rightGain, leftSquaredSum, rightSquaredSum);
+
+    *leftSquaredSum += lanes[0] + lanes[2];
+    *rightSquaredSum += lanes[1] + lanes[3];
+}
+
+// ================================================
+// AVX2
+// ================================================
+
+MU_TARGET_AVX2 void accumulateAvx2(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+
+    accumulateScalar(dst + i, src + i, count - i);
+}
+
+MU_TARGET_AVX2 void multiplyAvx2(float* buffer, size_t count, float gain)
+{
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gainVec));
+    }
+
+    multiplyScalar(buffer + i, count - i, gain);
+}
+
+MU_TARGET_AVX2 float sumOfSquaresAvx2(const float* buffer, size_t count)
+{
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_loadu_ps(buffer + i);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+    }
+
+    __m128 sums = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+
+    return horizontalSumSse2(sums) + sumOfSquaresScalar(buffer + i, count - i);
+}
+
+MU_TARGET_AVX2 float peakAvx2(const float* buffer, size_t count)
+{
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        acc = _mm256_max_ps(acc, _mm256_and_ps(_mm256_loadu_ps(buffer + i), absMask));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+
+    float result = *std::max_element(lanes, lanes + 8);
+
+    return std::max(result, peakScalar(buffer + i, count - i));
+}
+
+MU_TARGET_AVX2 void stereoGainAndSumOfSquaresAvx2(float* buffer, size_t samplesPerChannel, float leftGain, float rightGain,
+                                                  float* leftSquaredSum, float* rightSquaredSum)
+{
+    const __m256 gainVec = _mm256_setr_ps(leftGain, rightGain, leftGain, rightGain, leftGain, rightGain, leftGain, rightGain);
+    const size_t count = samplesPerChannel * 2;
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gainVec);
+        _mm256_storeu_ps(buffer + i, v);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+
+    stereoGainAndSumOfSquaresScalar(buffer + i, (count - i) / 2, leftGain, rightGain, leftSquaredSum, rightSquaredSum);
+
+    *leftSquaredSum += lanes[0] + lanes[2] + lanes[4] + lanes[6];
+    *rightSquaredSum += lanes[1] + lanes[3] + lanes[5] + lanes[7];
+}
+
+bool isAvx2Supported()
+{
+#ifdef _MSC_VER
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    const bool osxsave = info[2] & (1 << 27);
+    const bool avx = info[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+// ================================================
+// NEON
+// ================================================
+
+#ifdef MU_AUDIO_KERNELS_NEON
+void accumulateNeon(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+
+    accumulateScalar(dst + i, src + i, count - i);
+}
+
+void multiplyNeon(float* buffer, size_t count, float gain)
+{
+    const float32x4_t gainVec = vdupq_n_f32(gain);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), gainVec));
+    }
+
+    multiplyScalar(buffer + i, count - i, gain);
+}
+
+float sumOfSquaresNeon(const float* buffer, size_t count)
+{
+    float32x4_t acc = vdupq_n_f32(0.f);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vld1q_f32(buffer + i);
+        acc = vmlaq_f32(acc, v, v);
+    }
+
+    float32x2_t sums = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sums = vpadd_f32(sums, sums);
+
+    return vget_lane_f32(sums, 0) + sumOfSquaresScalar(buffer + i, count - i);
+}
+
+float peakNeon(const float* buffer, size_t count)
+{
+    float32x4_t acc = vdupq_n_f32(0.f);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        acc = vmaxq_f32(acc, vabsq_f32(vld1q_f32(buffer + i)));
+    }
+
+    float32x2_t maxs = vmax_f32(vget_low_f32(acc), vget_high_f32(acc));
+    maxs = vpmax_f32(maxs, maxs);
+
+    return std::max(vget_lane_f32(maxs, 0), peakScalar(buffer + i, count - i));
+}
+
+void stereoGainAndSumOfSquaresNeon(float* buffer, size_t samplesPerChannel, float leftGain, float rightGain,
+                                   float* leftSquaredSum, float* rightSquaredSum)
+{
+    const float gains[4] = { leftGain, rightGain, leftGain, rightGain };
+    const float32x4_t gainVec = vld1q_f32(gains);
+    const size_t count = samplesPerChannel * 2;
+    float32x4_t acc = vdupq_n_f32(0.f);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vmulq_f32(vld1q_f32(buffer + i), gainVec);
+        vst1q_f32(buffer + i, v);
+        acc = vmlaq_f32(acc, v, v);
+    }
+
+    //! NOTE The even lanes belong to the left channel, the odd ones to the right one
+    float32x2_t sums = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+
+    stereoGainAndSumOfSquaresScalar(buffer + i, (count - i) / 2, leftGain, rightGain, leftSquaredSum, rightSquaredSum);
+
+    *leftSquaredSum += vget_lane_f32(sums, 0);
+    *rightSquaredSum += vget_lane_f32(sums, 1);
+}
+#endif
+
+Kernels makeKernels(InstructionSet set)
+{
+    Kernels k;
+    k.accumulate = accumulateScalar;
+    k.multiply = multiplyScalar;
+    k.sumOfSquares = sumOfSquaresScalar;
+    k.peak = peakScalar;
+    k.stereoGainAndSumOfSquares = stereoGainAndSumOfSquaresScalar;
+
+    switch (set) {
+    case InstructionSet::Scalar:
+        break;
+    case InstructionSet::SSE2:
+#ifdef MU_AUDIO_KERNELS_X86
+        k.accumulate = accumulateSse2;
+        k.multiply = multiplySse2;
+        k.sumOfSquares = sumOfSquaresSse2;
+        k.peak = peakSse2;
+        k.stereoGainAndSumOfSquares = stereoGainAndSumOfSquaresSse2;
+#endif
+        break;
+    case InstructionSet::AVX2:
+#ifdef MU_AUDIO_KERNELS_X86
+        k.accumulate = accumulateAvx2;
+        k.multiply = multiplyAvx2;
+        k.sumOfSquares = sumOfSquaresAvx2;
+        k.peak = peakAvx2;
+        k.stereoGainAndSumOfSquares = stereoGainAndSumOfSquaresAvx2;
+#endif
+        break;
+    case InstructionSet::NEON:
+#ifdef MU_AUDIO_KERNELS_NEON
+        k.accumulate = accumulateNeon;
+        k.multiply = multiplyNeon;
+        k.sumOfSquares = sumOfSquaresNeon;
+        k.peak = peakNeon;
+        k.stereoGainAndSumOfSquares = stereoGainAndSumOfSquaresNeon;
+#endif
+        break;
+    }
+
+    return k;
+}
+
+struct KernelsState {
+    InstructionSet set = InstructionSet::Scalar;
+    Kernels kernels;
+
+    KernelsState()
+        : set(bestSupportedInstructionSet()), kernels(makeKernels(set))
+    {
+    }
+};
+
+KernelsState& kernelsState()
+{
+    static KernelsState s;
+    return s;
+}
+
+const Kernels& kernels()
+{
+    return kernelsState().kernels;
+}
+}
+
+InstructionSet mu::audio::dsp::bestSupportedInstructionSet()
+{
+#if defined(MU_AUDIO_KERNELS_X86)
+    return isAvx2Supported() ? InstructionSet::AVX2 : InstructionSet::SSE2;
+#elif defined(MU_AUDIO_KERNELS_NEON)
+    return InstructionSet::NEON;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+bool mu::audio::dsp::isInstructionSetSupported(InstructionSet set)
+{
+    switch (set) {
+    case InstructionSet::Scalar:
+        return true;
+    case InstructionSet::SSE2:
+#ifdef MU_AUDIO_KERNELS_X86
+        return true;
+#else
+        return false;
+#endif
+    case InstructionSet::AVX2:
+#ifdef MU_AUDIO_KERNELS_X86
+        return isAvx2Supported();
+#else
+        return false;
+#endif
+    case InstructionSet::NEON:
+#ifdef MU_AUDIO_KERNELS_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+InstructionSet mu::audio::dsp::currentInstructionSet()
+{
+    return kernelsState().set;
+}
+
+void mu::audio::dsp::selectInstructionSet(InstructionSet set)
+{
+    if (!isInstructionSetSupported(set)) {
+        return;
+    }
+
+    KernelsState& state = kernelsState();
+    state.set = set;
+    state.kernels = makeKernels(set);
+}
+
+const char* mu::audio::dsp::instructionSetName(InstructionSet set)
+{
+    switch (set) {
+    case InstructionSet::Scalar: return "Scalar";
+    case InstructionSet::SSE2: return "SSE2";
+    case InstructionSet::AVX2: return "AVX2";
+    case InstructionSet::NEON: return "NEON";
+    }
+
+    return "";
+}
+
+void mu::audio::dsp::accumulate(float* dst, const float* src, size_t count)
+{
+    kernels().accumulate(dst, src, count);
+}
+
+void mu::audio::dsp::multiply(float* buffer, size_t count, float gain)
+{
+    kernels().multiply(buffer, count, gain);
+}
+
+float mu::audio::dsp::sumOfSquares(const float* buffer, size_t count)
+{
+    return kernels().sumOfSquares(buffer, count);
+}
+
+float mu::audio::dsp::peak(const float* buffer, size_t count)
+{
+    return kernels().peak(buffer, count);
+}
+
+void mu::audio::dsp::applyGainAndSumOfSquares(float* buffer, size_t audioChannelsCount, size_t samplesPerChannel,
+                                              const float* gains, float* squaredSums)
+{
+    if (audioChannelsCount == 2) {
+        kernels().stereoGainAndSumOfSquares(buffer, samplesPerChannel, gains[0], gains[1], &squaredSums[0], &squaredSums[1]);
+        return;
+    }
+
+    if (audioChannelsCount == 1) {
+        kernels().multiply(buffer, samplesPerChannel, gains[0]);
+        squaredSums[0] = kernels().sumOfSquares(buffer, samplesPerChannel);
+        return;
+    }
+
+    for (size_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        squaredSums[audioChNum] = 0.f;
+    }
+
+    for (size_t s = 0; s < samplesPerChannel; ++s) {
+        for (size_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+            size_t idx = s * audioChannelsCount + audioChNum;
+
+            float resultSample = buffer[idx] * gains[audioChNum];
+            buffer[idx] = resultSample;
+            squaredSums[audioChNum] += resultSample * resultSample;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOKERNELS_H
+#define MU_AUDIO_AUDIOKERNELS_H
+
+#include <cstddef>
+
+//! NOTE Vectorised kernels for the interleaved audio buffers.
+//! The implementation is selected at runtime by the instruction sets supported by the CPU
+
+namespace mu::audio::dsp {
+enum class InstructionSet {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+InstructionSet bestSupportedInstructionSet();
+bool isInstructionSetSupported(InstructionSet set);
+
+//! NOTE The best supported set is used by default, might be changed for testing purpose
+InstructionSet currentInstructionSet();
+void selectInstructionSet(InstructionSet set);
+
+const char* instructionSetName(InstructionSet set);
+
+//! dst[i] += src[i]
+void accumulate(float* dst, const float* src, size_t count);
+
+//! buffer[i] *= gain
+void multiply(float* buffer, size_t count, float gain);
+
+//! sum of buffer[i]^2
+float sumOfSquares(const float* buffer, size_t count);
+
+//! max of |buffer[i]|
+float peak(const float* buffer, size_t count);
+
+//! NOTE Multiplies every audio channel of the interleaved buffer by its own gain
+//! and writes the sums of squares of the resulting samples per channel into squaredSums
+void applyGainAndSumOfSquares(float* buffer, size_t audioChannelsCount, size_t samplesPerChannel,
+                              const float* gains, float* squaredSums);
+}
+
+#endif // MU_AUDIO_AUDIOKERNELS_H
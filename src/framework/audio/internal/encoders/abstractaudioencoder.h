@@ -44,7 +44,10 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    //! NOTE The audio is passed to encode() in chunks of up to maxChunkSamplesNumber samples per channel,
+    //! totalSamplesNumber is the expected number of samples per channel in the whole stream
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                      const samples_t maxChunkSamplesNumber)
     {
         if (!format.isValid()) {
             return false;
@@ -56,7 +59,7 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
+        prepareOutputBuffer(maxChunkSamplesNumber);
 
         return true;
     }
@@ -66,6 +69,8 @@ public:
         return m_format;
     }
 
+    //! NOTE The input is interleaved. Returns the number of the encoded frames, i.e. samples per channel,
+    //! the same unit as samplesPerChannel, 0 on failure. The encoder may buffer them before writing
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
@@ -75,7 +80,7 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t chunkSamplesNumber) const = 0;
 
     virtual void prepareWriting()
     {
@@ -106,9 +111,9 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t chunkSamplesNumber)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        m_outputBuffer.resize(requiredOutputBufferSize(chunkSamplesNumber));
     }
 
     virtual void closeDestination()
@@ -55,7 +55,8 @@ struct FlacHandler : public FLAC::Encoder::File
     ProgressCallBack m_callBack;
 };
 
-bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                       const samples_t maxChunkSamplesNumber)
 {
     if (!format.isValid()) {
         return false;
@@ -92,7 +93,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         return false;
     }
 
-    prepareOutputBuffer(totalSamplesNumber);
+    prepareOutputBuffer(maxChunkSamplesNumber);
 
     return true;
 }
@@ -103,30 +104,21 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
     size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
 
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
-
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    if (m_intermBuffer.size() < totalSamplesNumber) {
+        m_intermBuffer.resize(totalSamplesNumber);
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    for (size_t i = 0; i < totalSamplesNumber; ++i) {
+        m_intermBuffer[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    }
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    if (!m_flac->process_interleaved(m_intermBuffer.data(), static_cast<uint32_t>(samplesPerChannel))) {
+        return 0;
     }
 
-    return result;
+    return samplesPerChannel;
 }
 
 size_t FlacEncoder::flush()
@@ -135,9 +127,15 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t /*chunkSamplesNumber*/) const
+{
+    //! NOTE The encoder writes into the file by itself
+    return 0;
+}
+
+void FlacEncoder::prepareOutputBuffer(const samples_t chunkSamplesNumber)
 {
-    return totalSamplesNumber;
+    m_intermBuffer.resize(chunkSamplesNumber * m_format.audioChannelsNumber);
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -64,11 +64,12 @@ struct LameHandler
     lame_global_flags* flags = nullptr;
 };
 
-bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+                      const samples_t maxChunkSamplesNumber)
 {
     m_handler = new LameHandler();
 
-    if (!AbstractAudioEncoder::init(path, format, totalSamplesNumber)) {
+    if (!AbstractAudioEncoder::init(path, format, totalSamplesNumber, maxChunkSamplesNumber)) {
         return false;
     }
 
@@ -79,26 +80,28 @@ bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, co
     return true;
 }
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t chunkSamplesNumber) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, the worst case is 1.25 * samples + 7200 bytes
 
-    return totalSamplesNumber;
+    return chunkSamplesNumber + chunkSamplesNumber / 4 + 7200;
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    m_progress.progressChanged.send(0, 100, "");
-
     int encodedBytes = lame_encode_buffer_interleaved_ieee_float(m_handler->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
 
-    m_progress.progressChanged.send(50, 100, "");
-    size_t result = std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
-    m_progress.progressChanged.send(100, 100, "");
+    if (encodedBytes < 0) {
+        LOGE() << "Unable to encode mp3, error code: " << encodedBytes;
+        return 0;
+    }
+
+    std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
 
-    return result;
+    //! NOTE lame may buffer the whole chunk internally without producing any output
+    return samplesPerChannel;
 }
 
 size_t Mp3Encoder::flush()
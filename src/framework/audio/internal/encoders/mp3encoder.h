@@ -31,13 +31,14 @@ namespace mu::audio::encode {
 class Mp3Encoder : public AbstractAudioEncoder
 {
 public:
-    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber) override;
+    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber,
+              const samples_t maxChunkSamplesNumber) override;
 
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
 private:
-    size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const override;
+    size_t requiredOutputBufferSize(samples_t chunkSamplesNumber) const override;
     void closeDestination() override;
 
     LameHandler* m_handler = nullptr;
@@ -22,6 +22,8 @@
 
 #include "soundtrackwriter.h"
 
+#include <thread>
+
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
@@ -34,9 +36,9 @@ using namespace mu;
 using namespace mu::audio;
 using namespace mu::audio::soundtrack;
 
-static constexpr int WRITE_STEPS = 2;
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE The number of rendered blocks which may wait for encoding at the same time.
+//! It bounds the memory usage and lets the rendering run ahead of the encoding a bit
+static constexpr size_t ENCODE_BLOCKS_COUNT = 32;
 
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
                                    IAudioSourcePtr source)
@@ -46,9 +48,15 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
+
+    samples_t renderStep = config()->renderStep();
+
+    m_blocks.resize(ENCODE_BLOCKS_COUNT);
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        m_blocks[i].data.resize(renderStep * config()->audioChannelsCount());
+        m_freeBlocks.push(i);
+    }
 
     m_encoderPtr = createEncoder(format.type);
 
@@ -56,10 +64,7 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_encoderPtr->init(destination, format, m_totalSamplesPerChannel, renderStep);
 }
 
 bool SoundTrackWriter::write()
@@ -76,21 +81,18 @@ bool SoundTrackWriter::write()
     m_source->setIsActive(true);
 
     DEFER {
-        m_encoderPtr->flush();
-
         AudioEngine::instance()->setMode(RenderMode::RealTimeMode);
 
         m_source->setSampleRate(AudioEngine::instance()->sampleRate());
         m_source->setIsActive(false);
     };
 
-    if (!prepareInputBuffer()) {
+    if (!renderAndEncode()) {
         return false;
     }
 
-    if (m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data()) == 0) {
-        return false;
-    }
+    m_encoderPtr->flush();
+    sendProgress(m_totalSamplesPerChannel, m_totalSamplesPerChannel);
 
     return true;
 }
@@ -111,40 +113,112 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-bool SoundTrackWriter::prepareInputBuffer()
+bool SoundTrackWriter::renderAndEncode()
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return false;
+    }
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    std::thread encodeThread(&SoundTrackWriter::th_encodeLoop, this);
 
     samples_t renderStep = config()->renderStep();
+    samples_t renderedSamples = 0;
+
+    sendProgress(renderedSamples, m_totalSamplesPerChannel);
 
-    while (inputBufferOffset < inputBufferMaxOffset) {
-        m_source->process(m_intermBuffer.data(), renderStep);
+    while (renderedSamples < m_totalSamplesPerChannel && !m_encodingFailed) {
+        size_t blockIdx = acquireFreeBlock();
+        EncodeBlock& block = m_blocks[blockIdx];
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        m_source->process(block.data.data(), renderStep);
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        block.samplesPerChannel = std::min(renderStep, m_totalSamplesPerChannel - renderedSamples);
+        renderedSamples += block.samplesPerChannel;
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        pushFilledBlock(blockIdx);
+
+        sendProgress(renderedSamples, m_totalSamplesPerChannel);
     }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return false;
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_renderingFinished = true;
     }
 
-    return true;
+    m_blocksCv.notify_all();
+    encodeThread.join();
+
+    return !m_encodingFailed;
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::th_encodeLoop()
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    while (true) {
+        size_t blockIdx = 0;
+
+        {
+            std::unique_lock lock(m_blocksMutex);
+            m_blocksCv.wait(lock, [this] { return !m_filledBlocks.empty() || m_renderingFinished; });
+
+            if (m_filledBlocks.empty()) {
+                return;
+            }
+
+            blockIdx = m_filledBlocks.front();
+            m_filledBlocks.pop();
+        }
+
+        const EncodeBlock& block = m_blocks[blockIdx];
+
+        if (!m_encodingFailed && m_encoderPtr->encode(block.samplesPerChannel, block.data.data()) != block.samplesPerChannel) {
+            LOGE() << "Unable to encode the audio block";
+            m_encodingFailed = true;
+        }
+
+        releaseFreeBlock(blockIdx);
+    }
+}
+
+size_t SoundTrackWriter::acquireFreeBlock()
+{
+    std::unique_lock lock(m_blocksMutex);
+    m_blocksCv.wait(lock, [this] { return !m_freeBlocks.empty(); });
+
+    size_t blockIdx = m_freeBlocks.front();
+    m_freeBlocks.pop();
+
+    return blockIdx;
+}
+
+void SoundTrackWriter::releaseFreeBlock(size_t blockIdx)
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_freeBlocks.push(blockIdx);
+    }
+
+    m_blocksCv.notify_all();
+}
+
+void SoundTrackWriter::pushFilledBlock(size_t blockIdx)
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_filledBlocks.push(blockIdx);
+    }
+
+    m_blocksCv.notify_all();
+}
+
+void SoundTrackWriter::sendProgress(int64_t current, int64_t total)
+{
+    //! NOTE The last percent is reserved for flushing the encoder
+    int progress = current < total ? static_cast<int>((current * 99) / total) : 100;
+    if (progress == m_lastSentProgress) {
+        return;
+    }
+
+    m_lastSentProgress = progress;
+    m_progress.progressChanged.send(progress, 100, "");
 }
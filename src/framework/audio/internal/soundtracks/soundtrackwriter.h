@@ -24,7 +24,11 @@
 #define MU_AUDIO_SOUNDTRACKWRITER_H
 
 #include <vector>
+#include <queue>
 #include <cstdio>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
@@ -45,19 +49,40 @@ public:
     framework::Progress progress();
 
 private:
+    struct EncodeBlock {
+        std::vector<float> data;
+        samples_t samplesPerChannel = 0;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    bool prepareInputBuffer();
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    //! NOTE Renders the source block by block and hands every block over to the encoding thread,
+    //! so the memory usage doesn't depend on the score duration
+    bool renderAndEncode();
+    void th_encodeLoop();
+
+    size_t acquireFreeBlock();
+    void releaseFreeBlock(size_t blockIdx);
+    void pushFilledBlock(size_t blockIdx);
+
+    void sendProgress(int64_t current, int64_t total);
 
     IAudioSourcePtr m_source = nullptr;
+    samples_t m_totalSamplesPerChannel = 0;
+
+    std::vector<EncodeBlock> m_blocks;
+    std::queue<size_t> m_freeBlocks;
+    std::queue<size_t> m_filledBlocks;
+    bool m_renderingFinished = false;
+    std::atomic<bool> m_encodingFailed = false;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::mutex m_blocksMutex;
+    std::condition_variable m_blocksCv;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
 
     framework::Progress m_progress;
+    int m_lastSentProgress = -1;
 };
 }
 
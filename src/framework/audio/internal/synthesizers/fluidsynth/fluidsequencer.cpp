@@ -47,7 +47,7 @@ void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& changes
     m_offStreamEvents.clear();
     m_offStreamFlushed.notify();
     updatePlaybackEvents(m_offStreamEvents, changes);
-    updateOffSequenceIterator();
+    updateOffStreamTimeline();
 }
 
 void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
@@ -55,7 +55,7 @@ void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& change
     m_mainStreamEvents.clear();
     m_mainStreamFlushed.notify();
     updatePlaybackEvents(m_mainStreamEvents, changes);
-    updateMainSequenceIterator();
+    updateMainStreamTimeline();
 }
 
 void FluidSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
@@ -70,7 +70,7 @@ void FluidSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
         m_dynamicEvents[pair.first].emplace(std::move(event));
     }
 
-    updateDynamicChangesIterator();
+    updateMainStreamTimeline();
 }
 
 async::Channel<channel_t, Program> FluidSequencer::channelAdded() const
@@ -31,7 +31,7 @@
 #include "log.h"
 #include "realfn.h"
 
-#include "sfcachedloader.h"
+#include "soundfontpool.h"
 #include "audioerrors.h"
 #include "audiotypes.h"
 
@@ -153,7 +153,7 @@ void FluidSynth::createFluidInstance()
 {
     m_fluid->synth = new_fluid_synth(m_fluid->settings);
 
-    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+    fluid_sfloader_t* sfloader = new_fluid_sfloader(SoundFontPool::loadSoundFont, delete_fluid_sfloader);
 
     fluid_sfloader_set_data(sfloader, m_fluid->settings);
     fluid_synth_add_sfloader(m_fluid->synth, sfloader);
@@ -254,27 +254,83 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
 
     fluid_synth_activate_key_tuning(m_fluid->synth, 0, 0, "standard", NULL, true);
 
-    auto setupChannel = [this](const midi::channel_t channelIdx, const midi::Program& program) {
-        fluid_synth_set_interp_method(m_fluid->synth, channelIdx, FLUID_INTERP_DEFAULT);
-        fluid_synth_pitch_wheel_sens(m_fluid->synth, channelIdx, 24);
-        fluid_synth_bank_select(m_fluid->synth, channelIdx, program.bank);
-        fluid_synth_program_change(m_fluid->synth, channelIdx, program.program);
-        fluid_synth_cc(m_fluid->synth, channelIdx, 7, DEFAULT_MIDI_VOLUME);
-        fluid_synth_cc(m_fluid->synth, channelIdx, 74, 0);
-        fluid_synth_set_portamento_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
-        fluid_synth_set_legato_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
-        fluid_synth_activate_tuning(m_fluid->synth, channelIdx, 0, 0, 0);
-    };
+    m_pendingChannels.clear();
+
+    m_sequencer.channelAdded().onReceive(this, [this](const midi::channel_t channelIdx, const midi::Program& program) {
+        warmUpChannels({ { channelIdx, program } });
+    });
 
-    m_sequencer.channelAdded().onReceive(this, setupChannel);
     m_sequencer.init(setupData);
 
+    std::vector<ChannelSetup> channels;
     for (const auto& voice : m_sequencer.channels().data()) {
         for (const auto& pair : voice.second) {
-            const ChannelMap::ChannelMapping& channelMapping = pair.second;
-            setupChannel(channelMapping.first, channelMapping.second);
+            channels.push_back(pair.second);
+        }
+    }
+
+    warmUpChannels(channels);
+}
+
+void FluidSynth::setupChannel(const midi::channel_t channelIdx, const midi::Program& program)
+{
+    fluid_synth_set_interp_method(m_fluid->synth, channelIdx, FLUID_INTERP_DEFAULT);
+    fluid_synth_pitch_wheel_sens(m_fluid->synth, channelIdx, 24);
+    fluid_synth_bank_select(m_fluid->synth, channelIdx, program.bank);
+    fluid_synth_program_change(m_fluid->synth, channelIdx, program.program);
+    fluid_synth_cc(m_fluid->synth, channelIdx, 7, DEFAULT_MIDI_VOLUME);
+    fluid_synth_cc(m_fluid->synth, channelIdx, 74, 0);
+    fluid_synth_set_portamento_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
+    fluid_synth_set_legato_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
+    fluid_synth_activate_tuning(m_fluid->synth, channelIdx, 0, 0, 0);
+}
+
+//! NOTE Selecting a program decodes the samples of the preset (dynamic sample loading),
+//! it is done on the TaskScheduler threads, so the audio thread doesn't wait for it
+void FluidSynth::warmUpChannels(const std::vector<ChannelSetup>& channels)
+{
+    m_pendingChannels.insert(m_pendingChannels.end(), channels.cbegin(), channels.cend());
+
+    std::vector<midi::Program> programs;
+    programs.reserve(m_pendingChannels.size());
+    for (const ChannelSetup& channel : m_pendingChannels) {
+        programs.push_back(channel.second);
+    }
+
+    m_warmUp = SoundFontPool::instance()->warmUp(m_sfontPaths, programs);
+
+    setupWarmedUpChannels();
+}
+
+bool FluidSynth::setupWarmedUpChannels()
+{
+    if (m_pendingChannels.empty()) {
+        return true;
+    }
+
+    if (!m_warmUp->isReady()) {
+        if (currentRenderMode() != RenderMode::OfflineMode) {
+            return false;
         }
+
+        m_warmUp->waitUntilReady();
+    }
+
+    if (m_warmUp->presetsCount() > 0) {
+        LOGI() << "warm-up of " << m_warmUp->presetsCount() << " presets took "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(m_warmUp->duration()).count() << " ms";
     }
+
+    for (const ChannelSetup& channel : m_pendingChannels) {
+        setupChannel(channel.first, channel.second);
+    }
+
+    m_pendingChannels.clear();
+
+    //! NOTE The programs are selected, the pool may release their samples when they are unselected
+    m_warmUp.reset();
+
+    return true;
 }
 
 void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
@@ -310,17 +366,19 @@ bool FluidSynth::isActive() const
 
 void FluidSynth::setIsActive(const bool isActive)
 {
+    m_queuedMsecs = 0;
     m_sequencer.setActive(isActive);
     toggleExpressionController();
 }
 
 msecs_t FluidSynth::playbackPosition() const
 {
-    return m_sequencer.playbackPosition();
+    return m_sequencer.playbackPosition() + (isActive() ? m_queuedMsecs : 0);
 }
 
 void FluidSynth::setPlaybackPosition(const msecs_t newPosition)
 {
+    m_queuedMsecs = 0;
     m_sequencer.setPlaybackPosition(newPosition);
 
     if (isActive()) {
@@ -341,25 +399,64 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
 
     msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
 
-    const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    unsigned int channelCount = audioChannelsCount();
 
-    if (!sequence.empty()) {
-        m_tuning.reset();
+    //! NOTE The events stay queued till the track is ready,
+    //! then the overdue ones are played at the start of the block, so the first notes are not lost
+    if (!setupWarmedUpChannels()) {
+        m_queuedMsecs += nextMsecs;
+        std::fill(buffer, buffer + samplesPerChannel * channelCount, 0.f);
+        return samplesPerChannel;
     }
 
-    for (const FluidSequencer::EventType& event : sequence) {
-        handleEvent(std::get<midi::Event>(event));
+    if (m_queuedMsecs > 0) {
+        const FluidSequencer::EventSpan overdue = m_sequencer.eventsToBePlayed(m_queuedMsecs);
+        m_queuedMsecs = 0;
+
+        m_tuning.reset();
+        for (const FluidSequencer::TimedEvent& event : overdue) {
+            handleEvent(std::get<midi::Event>(event.event));
+        }
+        fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
     }
 
-    fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
+    const FluidSequencer::EventSpan events = m_sequencer.eventsToBePlayed(nextMsecs);
 
-    unsigned int channelCount = audioChannelsCount();
+    samples_t renderedSamples = 0;
 
-    int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
-                                         buffer, 0, channelCount,
-                                         buffer, 1, channelCount);
+    auto renderUntil = [this, buffer, channelCount, &renderedSamples](samples_t sample) {
+        if (sample <= renderedSamples) {
+            return true;
+        }
+
+        const int offset = static_cast<int>(renderedSamples * channelCount);
+        int result = fluid_synth_write_float(m_fluid->synth, static_cast<int>(sample - renderedSamples),
+                                             buffer, offset, channelCount,
+                                             buffer, offset + 1, channelCount);
+
+        renderedSamples = sample;
+        return result == FLUID_OK;
+    };
+
+    //! NOTE The block is rendered in parts between the events, so every event sounds at its own sample
+    const FluidSequencer::TimedEvent* it = events.begin();
+    while (it != events.end()) {
+        samples_t eventSample = std::min(microSecsToSamples(events.offset(*it), m_sampleRate), samplesPerChannel);
+        if (!renderUntil(eventSample)) {
+            return 0;
+        }
+
+        m_tuning.reset();
+
+        const msecs_t timestamp = it->timestamp;
+        for (; it != events.end() && it->timestamp == timestamp; ++it) {
+            handleEvent(std::get<midi::Event>(it->event));
+        }
+
+        fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
+    }
 
-    if (result != FLUID_OK) {
+    if (!renderUntil(samplesPerChannel)) {
         return 0;
     }
 
@@ -35,6 +35,7 @@
 
 #include "abstractsynthesizer.h"
 #include "fluidsequencer.h"
+#include "soundfontpool.h"
 #include "soundmapping.h"
 
 namespace mu::audio::synth {
@@ -74,6 +75,13 @@ private:
         std::vector<int> keys;
         std::vector<double> pitches;
 
+        //! NOTE Reserved up front, so that the audio thread doesn't allocate
+        KeyTuning()
+        {
+            keys.reserve(128);
+            pitches.reserve(128);
+        }
+
         void add(int key, double tuning)
         {
             keys.push_back(key);
@@ -100,6 +108,12 @@ private:
     Ret init();
     void createFluidInstance();
 
+    using ChannelSetup = std::pair<midi::channel_t, midi::Program>;
+
+    void setupChannel(const midi::channel_t channelIdx, const midi::Program& program);
+    void warmUpChannels(const std::vector<ChannelSetup>& channels);
+    bool setupWarmedUpChannels();
+
     bool handleEvent(const midi::Event& event);
 
     void toggleExpressionController();
@@ -115,6 +129,12 @@ private:
     std::set<io::path_t> m_sfontPaths;
 
     KeyTuning m_tuning;
+
+    //! NOTE The channels are set up when the samples of their programs are decoded,
+    //! till then the synth plays silence and its events stay queued
+    std::vector<ChannelSetup> m_pendingChannels;
+    SoundFontPool::WarmUpPtr m_warmUp;
+    msecs_t m_queuedMsecs = 0;
 };
 
 using FluidSynthPtr = std::shared_ptr<FluidSynth>;
@@ -0,0 +1,559 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "soundfontpool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <sfloader/fluid_sfont.h>
+#include <sfloader/fluid_defsfont.h>
+#include <utils/fluid_list.h>
+}
+
+#include "concurrency/taskscheduler.h"
+#include "io/file.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+
+static constexpr size_t DEFAULT_MEMORY_BUDGET = 512 * 1024 * 1024;
+
+//! NOTE The channel passed to Fluid for the pool's own selection of a preset, only used for logging
+static constexpr int POOL_CHANNEL = -1;
+
+fluid_file_callbacks_t SoundFontPool::FILE_CALLBACKS {
+    SoundFontPool::openFileCallback,
+    SoundFontPool::readFileCallback,
+    SoundFontPool::seekFileCallback,
+    SoundFontPool::closeFileCallback,
+    SoundFontPool::tellFileCallback
+};
+
+SoundFontPool* SoundFontPool::instance()
+{
+    static SoundFontPool s;
+    return &s;
+}
+
+SoundFontPool::~SoundFontPool()
+{
+    for (const auto& pair : m_soundFonts) {
+        if (!pair.second.sfont) {
+            continue;
+        }
+
+        fluid_defsfont_t* defsFont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(pair.second.sfont));
+
+        if (delete_fluid_defsfont(defsFont) != FLUID_OK) {
+            continue;
+        }
+
+        delete_fluid_sfont(pair.second.sfont);
+    }
+}
+
+fluid_sfont_t* SoundFontPool::loadSoundFont(fluid_sfloader_t* loader, const char* filename)
+{
+    return instance()->load(static_cast<fluid_settings_t*>(fluid_sfloader_get_data(loader)), filename);
+}
+
+size_t SoundFontPool::memoryBudget() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_memoryBudget ? m_memoryBudget : DEFAULT_MEMORY_BUDGET;
+}
+
+void SoundFontPool::setMemoryBudget(size_t bytes)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_memoryBudget = bytes;
+    }
+
+    releaseOverBudget();
+}
+
+size_t SoundFontPool::residentBytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_residentBytes;
+}
+
+bool SoundFontPool::useMappedFiles() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_useMappedFiles;
+}
+
+void SoundFontPool::setUseMappedFiles(bool use)
+{
+    std::lock_guard lock(m_mutex);
+    m_useMappedFiles = use;
+}
+
+fluid_sfont_t* SoundFontPool::load(fluid_settings_t* settings, const char* filename)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto search = m_soundFonts.find(filename);
+    if (search != m_soundFonts.end() && search->second.sfont) {
+        return search->second.sfont;
+    }
+
+    fluid_defsfont_t* defsfont = new_fluid_defsfont(settings);
+    if (!defsfont) {
+        return nullptr;
+    }
+
+    fluid_sfont_t* result = new_fluid_sfont(fluid_defsfont_sfont_get_name,
+                                            fluid_defsfont_sfont_get_preset,
+                                            fluid_defsfont_sfont_iteration_start,
+                                            fluid_defsfont_sfont_iteration_next,
+                                            deleteSoundFont);
+
+    if (!result) {
+        delete_fluid_defsfont(defsfont);
+        return nullptr;
+    }
+
+    fluid_sfont_set_data(result, defsfont);
+    defsfont->sfont = result;
+    defsfont->fcbs = &FILE_CALLBACKS;
+
+    if (fluid_defsfont_load(defsfont, &FILE_CALLBACKS, filename) == FLUID_FAILED) {
+        fluid_defsfont_sfont_delete(result);
+        return nullptr;
+    }
+
+    wrapPresetNotify(result);
+
+    m_soundFonts[filename].sfont = result;
+
+    return result;
+}
+
+//! NOTE Fluid loads and unloads the samples of a preset in its notify callback,
+//! the pool takes it over to keep the used presets resident
+void SoundFontPool::wrapPresetNotify(fluid_sfont_t* sfont)
+{
+    fluid_defsfont_t* defsfont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(sfont));
+
+    for (fluid_list_t* list = defsfont->preset; list; list = fluid_list_next(list)) {
+        fluid_preset_t* preset = static_cast<fluid_preset_t*>(fluid_list_get(list));
+        if (!preset->notify) {
+            continue;
+        }
+
+        IF_ASSERT_FAILED(!m_fluidPresetNotify || m_fluidPresetNotify == preset->notify) {
+            continue;
+        }
+
+        m_fluidPresetNotify = preset->notify;
+        preset->notify = presetNotify;
+    }
+}
+
+int SoundFontPool::presetNotify(fluid_preset_t* preset, int reason, int chan)
+{
+    return instance()->onPresetNotify(preset, reason, chan);
+}
+
+//! NOTE The selections on the channels are not passed to Fluid, the pool holds one selection of every resident preset.
+//! So the samples are decoded here, on the audio thread, only if the preset was not warmed up
+int SoundFontPool::onPresetNotify(fluid_preset_t* preset, int reason, int chan)
+{
+    if (reason != FLUID_PRESET_SELECTED && reason != FLUID_PRESET_UNSELECTED) {
+        return m_fluidPresetNotify(preset, reason, chan);
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        PresetState& state = m_presets[preset];
+
+        if (reason == FLUID_PRESET_UNSELECTED) {
+            state.selectedCount = std::max(state.selectedCount - 1, 0);
+            return FLUID_OK;
+        }
+
+        //! NOTE Counted before loading, so the preset isn't released meanwhile
+        ++state.selectedCount;
+    }
+
+    loadPreset(preset);
+
+    return FLUID_OK;
+}
+
+void SoundFontPool::loadPreset(fluid_preset_t* preset)
+{
+    auto touchIfResident = [this, preset]() {
+        std::lock_guard lock(m_mutex);
+        PresetState& state = m_presets[preset];
+        if (state.resident) {
+            m_lru.splice(m_lru.begin(), m_lru, state.lruIt);
+        }
+        return state.resident;
+    };
+
+    if (touchIfResident()) {
+        return;
+    }
+
+    //! NOTE Fluid's sample reference counts are not thread safe, so one preset is loaded or released at a time.
+    //! The pool's state is not locked meanwhile, the audio thread only waits if it selects a preset which is not loaded
+    std::lock_guard samplesLock(m_samplesMutex);
+
+    if (touchIfResident()) {
+        return;
+    }
+
+    m_fluidPresetNotify(preset, FLUID_PRESET_SELECTED, POOL_CHANNEL);
+    const size_t bytes = presetSamplesBytes(preset);
+
+    std::lock_guard lock(m_mutex);
+    PresetState& state = m_presets[preset];
+    state.resident = true;
+    state.bytes = bytes;
+    m_residentBytes += bytes;
+
+    m_lru.push_front(preset);
+    state.lruIt = m_lru.begin();
+}
+
+SoundFontPool::WarmUpPtr SoundFontPool::warmUp(const std::set<io::path_t>& soundFonts, const std::vector<midi::Program>& programs)
+{
+    WarmUpPtr result = std::make_shared<WarmUp>();
+    result->m_startTime = std::chrono::steady_clock::now();
+
+    std::vector<fluid_preset_t*> presets;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        for (const midi::Program& program : programs) {
+            for (const io::path_t& path : soundFonts) {
+                auto search = m_soundFonts.find(path.toStdString());
+                if (search == m_soundFonts.end() || !search->second.sfont) {
+                    continue;
+                }
+
+                fluid_preset_t* preset = fluid_sfont_get_preset(search->second.sfont, program.bank, program.program);
+                if (!preset) {
+                    continue;
+                }
+
+                if (std::find(result->m_pinnedPresets.cbegin(), result->m_pinnedPresets.cend(), preset)
+                    != result->m_pinnedPresets.cend()) {
+                    break;
+                }
+
+                PresetState& state = m_presets[preset];
+                ++state.pinCount;
+                result->m_pinnedPresets.push_back(preset);
+
+                if (state.resident) {
+                    m_lru.splice(m_lru.begin(), m_lru, state.lruIt);
+                } else {
+                    presets.push_back(preset);
+                }
+
+                break;
+            }
+        }
+    }
+
+    result->m_presetsCount = presets.size();
+    result->m_remaining = presets.size();
+
+    if (presets.empty()) {
+        result->m_durationUs = 0;
+        return result;
+    }
+
+    //! NOTE Fluid's sample cache decodes one preset at a time anyway,
+    //! the separate tasks let the presets of the other tracks go in between
+    for (fluid_preset_t* preset : presets) {
+        TaskScheduler::instance()->push([this, preset, result]() {
+            loadPreset(preset);
+            result->onPresetResident();
+            releaseOverBudget();
+        });
+    }
+
+    return result;
+}
+
+void SoundFontPool::unpin(const std::vector<fluid_preset_t*>& presets)
+{
+    std::lock_guard lock(m_mutex);
+
+    for (fluid_preset_t* preset : presets) {
+        PresetState& state = m_presets[preset];
+        state.pinCount = std::max(state.pinCount - 1, 0);
+    }
+}
+
+//! NOTE Must not be called with m_mutex locked, the samples are released under m_samplesMutex
+void SoundFontPool::releaseOverBudget()
+{
+    std::vector<fluid_preset_t*> released;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        const size_t budget = m_memoryBudget ? m_memoryBudget : DEFAULT_MEMORY_BUDGET;
+
+        auto it = m_lru.end();
+        while (m_residentBytes > budget && it != m_lru.begin()) {
+            --it;
+
+            fluid_preset_t* preset = *it;
+            PresetState& state = m_presets[preset];
+            if (state.selectedCount > 0 || state.pinCount > 0) {
+                continue;
+            }
+
+            m_residentBytes -= std::min(state.bytes, m_residentBytes);
+            state.resident = false;
+            state.bytes = 0;
+            it = m_lru.erase(it);
+
+            released.push_back(preset);
+        }
+    }
+
+    if (released.empty()) {
+        return;
+    }
+
+    //! NOTE If a released preset is loaded again meanwhile, it is selected once more before this,
+    //! so Fluid keeps its samples
+    std::lock_guard samplesLock(m_samplesMutex);
+    for (fluid_preset_t* preset : released) {
+        m_fluidPresetNotify(preset, FLUID_PRESET_UNSELECTED, POOL_CHANNEL);
+    }
+}
+
+size_t SoundFontPool::presetSamplesBytes(fluid_preset_t* preset)
+{
+    std::vector<const fluid_sample_t*> samples;
+
+    fluid_defpreset_t* defpreset = static_cast<fluid_defpreset_t*>(fluid_preset_get_data(preset));
+    for (fluid_preset_zone_t* presetZone = fluid_defpreset_get_zone(defpreset); presetZone;
+         presetZone = fluid_preset_zone_next(presetZone)) {
+        fluid_inst_t* inst = fluid_preset_zone_get_inst(presetZone);
+
+        for (fluid_inst_zone_t* instZone = fluid_inst_get_zone(inst); instZone; instZone = fluid_inst_zone_next(instZone)) {
+            const fluid_sample_t* sample = fluid_inst_zone_get_sample(instZone);
+            if (sample && sample->data && std::find(samples.cbegin(), samples.cend(), sample) == samples.cend()) {
+                samples.push_back(sample);
+            }
+        }
+    }
+
+    size_t bytes = 0;
+    for (const fluid_sample_t* sample : samples) {
+        const size_t frames = sample->end + 1;
+        bytes += frames * sizeof(short);
+        if (sample->data24) {
+            bytes += frames;
+        }
+    }
+
+    return bytes;
+}
+
+int SoundFontPool::deleteSoundFont(fluid_sfont_t* /*sfont*/)
+{
+    //!Note Prevent removal of sound-fonts by Fluid instances,
+    //!     instead the actual removal of cached sound-fonts will happen in the pool's destructor.
+    //!     However, we still need to provide "some" callback for Fluid's API
+
+    return FLUID_OK;
+}
+
+// ---------------------------------------------------------
+//   files
+//    every open gets its own handle over the mapping shared by all of them
+// ---------------------------------------------------------
+
+SoundFontPool::FileHandle* SoundFontPool::openFile(const char* filename)
+{
+    std::lock_guard lock(m_mutex);
+
+    FileHandle* handle = new FileHandle();
+
+    if (m_useMappedFiles) {
+        SoundFont& soundFont = m_soundFonts[filename];
+        if (soundFont.mappedFile.empty()) {
+            RetVal<ByteArray> mapped = io::File::mapFile(filename);
+            if (mapped.ret) {
+                soundFont.mappedFile = mapped.val;
+            } else {
+                LOGW() << "failed map soundfont: " << filename << ", " << mapped.ret.toString();
+            }
+        }
+
+        if (!soundFont.mappedFile.empty()) {
+            handle->data = soundFont.mappedFile.constData();
+            handle->size = soundFont.mappedFile.size();
+            return handle;
+        }
+    }
+
+    handle->file = std::fopen(filename, "rb");
+    if (!handle->file) {
+        delete handle;
+        return nullptr;
+    }
+
+    return handle;
+}
+
+void* SoundFontPool::openFileCallback(const char* filename)
+{
+    return instance()->openFile(filename);
+}
+
+int SoundFontPool::readFileCallback(void* buf, int count, void* handle)
+{
+    FileHandle* file = static_cast<FileHandle*>(handle);
+    if (count < 0) {
+        return FLUID_FAILED;
+    }
+
+    if (file->file) {
+        return std::fread(buf, count, 1, file->file) == 1 ? FLUID_OK : FLUID_FAILED;
+    }
+
+    if (file->pos + size_t(count) > file->size) {
+        return FLUID_FAILED;
+    }
+
+    std::memcpy(buf, file->data + file->pos, count);
+    file->pos += count;
+
+    return FLUID_OK;
+}
+
+int SoundFontPool::seekFileCallback(void* handle, long offset, int origin)
+{
+    FileHandle* file = static_cast<FileHandle*>(handle);
+
+    if (file->file) {
+        return std::fseek(file->file, offset, origin) == 0 ? FLUID_OK : FLUID_FAILED;
+    }
+
+    long base = 0;
+    switch (origin) {
+    case SEEK_SET: base = 0;
+        break;
+    case SEEK_CUR: base = static_cast<long>(file->pos);
+        break;
+    case SEEK_END: base = static_cast<long>(file->size);
+        break;
+    default:
+        return FLUID_FAILED;
+    }
+
+    const long pos = base + offset;
+    if (pos < 0 || size_t(pos) > file->size) {
+        return FLUID_FAILED;
+    }
+
+    file->pos = size_t(pos);
+    return FLUID_OK;
+}
+
+int SoundFontPool::closeFileCallback(void* handle)
+{
+    FileHandle* file = static_cast<FileHandle*>(handle);
+
+    int ret = FLUID_OK;
+    if (file->file && std::fclose(file->file) != 0) {
+        ret = FLUID_FAILED;
+    }
+
+    delete file;
+    return ret;
+}
+
+long SoundFontPool::tellFileCallback(void* handle)
+{
+    FileHandle* file = static_cast<FileHandle*>(handle);
+
+    if (file->file) {
+        return std::ftell(file->file);
+    }
+
+    return static_cast<long>(file->pos);
+}
+
+// ---------------------------------------------------------
+//   WarmUp
+// ---------------------------------------------------------
+
+SoundFontPool::WarmUp::~WarmUp()
+{
+    SoundFontPool::instance()->unpin(m_pinnedPresets);
+}
+
+bool SoundFontPool::WarmUp::isReady() const
+{
+    return m_durationUs >= 0;
+}
+
+void SoundFontPool::WarmUp::waitUntilReady() const
+{
+    std::unique_lock lock(m_mutex);
+    m_readyCv.wait(lock, [this]() { return isReady(); });
+}
+
+size_t SoundFontPool::WarmUp::presetsCount() const
+{
+    return m_presetsCount;
+}
+
+std::chrono::microseconds SoundFontPool::WarmUp::duration() const
+{
+    return std::chrono::microseconds(m_durationUs);
+}
+
+void SoundFontPool::WarmUp::onPresetResident()
+{
+    if (--m_remaining > 0) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_durationUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+    }
+
+    m_readyCv.notify_all();
+}
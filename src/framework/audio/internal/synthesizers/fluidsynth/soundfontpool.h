@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_SOUNDFONTPOOL_H
+#define MU_AUDIO_SOUNDFONTPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fluidsynth.h>
+
+#include "types/bytearray.h"
+#include "io/path.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio::synth {
+//! NOTE The soundfonts shared by all FluidSynth instances of the process.
+//! Every file is parsed once, the samples of a preset are decoded once,
+//! when the preset is selected on a channel of any synth (synth.dynamic-sample-loading).
+//!
+//! The pool keeps the samples of the used presets resident after they are unselected,
+//! so recreating the synths or switching the instruments back doesn't decode them again.
+//! When the resident samples exceed the memory budget, the presets not selected on any channel
+//! are released, least recently used first.
+//!
+//! The samples might be decoded in advance (warmUp), so that selecting the presets
+//! on the audio thread doesn't decode anything. The warmed up presets are not released
+//! while the WarmUp exists, so they are kept till the synth has selected them
+class SoundFontPool
+{
+public:
+    static SoundFontPool* instance();
+
+    class WarmUp
+    {
+    public:
+        ~WarmUp();
+
+        bool isReady() const;
+        void waitUntilReady() const;
+
+        size_t presetsCount() const;
+
+        //! NOTE From the request till the last preset is resident
+        std::chrono::microseconds duration() const;
+
+    private:
+        friend class SoundFontPool;
+
+        void onPresetResident();
+
+        std::vector<fluid_preset_t*> m_pinnedPresets;
+        size_t m_presetsCount = 0;
+        std::atomic<size_t> m_remaining = 0;
+        std::chrono::steady_clock::time_point m_startTime;
+        std::atomic<int64_t> m_durationUs = -1;
+
+        mutable std::mutex m_mutex;
+        mutable std::condition_variable m_readyCv;
+    };
+
+    using WarmUpPtr = std::shared_ptr<WarmUp>;
+
+    //! NOTE Decodes the samples of the programs found in the soundfonts on the TaskScheduler threads.
+    //! The soundfonts must be loaded already, the programs which are not found are skipped
+    WarmUpPtr warmUp(const std::set<io::path_t>& soundFonts, const std::vector<midi::Program>& programs);
+
+    //! NOTE The loader callback for new_fluid_sfloader(), the loader data is fluid_settings_t*
+    static fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename);
+
+    size_t memoryBudget() const;
+    void setMemoryBudget(size_t bytes);
+
+    size_t residentBytes() const;
+
+    //! NOTE The files are read through the memory mapping, stdio is the fallback
+    bool useMappedFiles() const;
+    void setUseMappedFiles(bool use);
+
+private:
+    SoundFontPool() = default;
+    ~SoundFontPool();
+
+    struct SoundFont {
+        fluid_sfont_t* sfont = nullptr;
+        ByteArray mappedFile;
+    };
+
+    struct PresetState {
+        size_t bytes = 0;
+        int selectedCount = 0;
+        int pinCount = 0;
+        bool resident = false;
+        std::list<fluid_preset_t*>::iterator lruIt;
+    };
+
+    struct FileHandle {
+        std::FILE* file = nullptr;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t pos = 0;
+    };
+
+    fluid_sfont_t* load(fluid_settings_t* settings, const char* filename);
+    void wrapPresetNotify(fluid_sfont_t* sfont);
+
+    int onPresetNotify(fluid_preset_t* preset, int reason, int chan);
+    void loadPreset(fluid_preset_t* preset);
+    void unpin(const std::vector<fluid_preset_t*>& presets);
+    void releaseOverBudget();
+
+    FileHandle* openFile(const char* filename);
+
+    static size_t presetSamplesBytes(fluid_preset_t* preset);
+
+    static int presetNotify(fluid_preset_t* preset, int reason, int chan);
+    static int deleteSoundFont(fluid_sfont_t* sfont);
+
+    static void* openFileCallback(const char* filename);
+    static int readFileCallback(void* buf, int count, void* handle);
+    static int seekFileCallback(void* handle, long offset, int origin);
+    static int closeFileCallback(void* handle);
+    static long tellFileCallback(void* handle);
+
+    static fluid_file_callbacks_t FILE_CALLBACKS;
+
+    //! NOTE The presets are notified from the audio thread, the soundfonts may be loaded from the others
+    mutable std::recursive_mutex m_mutex;
+
+    //! NOTE Serializes the calls of Fluid's preset notify, which decodes and frees the samples
+    std::mutex m_samplesMutex;
+
+    std::map<std::string, SoundFont> m_soundFonts;
+
+    using PresetNotify = int (*)(fluid_preset_t* preset, int reason, int chan);
+    PresetNotify m_fluidPresetNotify = nullptr;
+
+    std::unordered_map<fluid_preset_t*, PresetState> m_presets;
+    std::list<fluid_preset_t*> m_lru;
+    size_t m_residentBytes = 0;
+    size_t m_memoryBudget = 0;
+    bool m_useMappedFiles = true;
+};
+}
+
+#endif // MU_AUDIO_SOUNDFONTPOOL_H
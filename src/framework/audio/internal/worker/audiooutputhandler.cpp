@@ -28,6 +28,7 @@
 #include "async/async.h"
 
 #include "internal/audiosanitizer.h"
+#include "internal/audiotelemetry.h"
 #include "internal/audiothread.h"
 #include "internal/worker/audioengine.h"
 #include "audioerrors.h"
@@ -151,6 +152,9 @@ Promise<AudioResourceMetaList> AudioOutputHandler::availableOutputResources() co
 
 Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const
 {
+    //! NOTE The meters are delivered by the telemetry while anybody is subscribed to them
+    AudioTelemetry::instance()->activate();
+
     return Promise<AudioSignalChanges>([this, sequenceId, trackId](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -170,6 +174,8 @@ Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenc
 
 Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
 {
+    AudioTelemetry::instance()->activate();
+
     return Promise<AudioSignalChanges>([this](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
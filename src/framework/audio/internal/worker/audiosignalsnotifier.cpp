@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiosignalsnotifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "realfn.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+void AudioSignalsNotifier::updateSignalValues(const audioch_t audioChNumber, const float newAmplitude, const volume_dbfs_t newPressure)
+{
+    if (audioChNumber >= MAX_AUDIO_CHANNELS_COUNT) {
+        return;
+    }
+
+    Signal& signal = m_signals[audioChNumber];
+
+    volume_dbfs_t validatedPressure = std::max(newPressure, MINIMUM_OPERABLE_DBFS_LEVEL);
+
+    if (RealIsEqual(signal.lastPressure, validatedPressure)) {
+        return;
+    }
+
+    if (std::abs(signal.lastPressure - validatedPressure) < PRESSURE_MINIMAL_VALUABLE_DIFF) {
+        return;
+    }
+
+    signal.lastPressure = validatedPressure;
+    signal.amplitude.store(newAmplitude, std::memory_order_relaxed);
+    signal.pressure.store(validatedPressure, std::memory_order_relaxed);
+
+    m_changedChannelsMask.fetch_or(1u << audioChNumber, std::memory_order_release);
+    AudioTelemetry::instance()->markPending();
+}
+
+AudioSignalChanges AudioSignalsNotifier::audioSignalChanges() const
+{
+    return m_audioSignalChanges;
+}
+
+void AudioSignalsNotifier::flush()
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    uint32_t changedChannelsMask = m_changedChannelsMask.exchange(0, std::memory_order_acquire);
+
+    for (audioch_t audioChNumber = 0; changedChannelsMask != 0; ++audioChNumber, changedChannelsMask >>= 1) {
+        if (!(changedChannelsMask & 1u)) {
+            continue;
+        }
+
+        const Signal& signal = m_signals[audioChNumber];
+
+        AudioSignalVal signalVal;
+        signalVal.amplitude = signal.amplitude.load(std::memory_order_relaxed);
+        signalVal.pressure = signal.pressure.load(std::memory_order_relaxed);
+
+        m_audioSignalChanges.send(audioChNumber, signalVal);
+    }
+}
+
+bool AudioSignalsNotifier::isActive() const
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    return m_audioSignalChanges.isConnected();
+}
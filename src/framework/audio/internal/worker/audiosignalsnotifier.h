@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOSIGNALSNOTIFIER_H
+#define MU_AUDIO_AUDIOSIGNALSNOTIFIER_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "internal/audiotelemetry.h"
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE The signal values are published by the audio processing and coalesced,
+//! the main thread gets only the latest value of every changed audio channel (see AudioTelemetry).
+//! Every MixerChannel and the Mixer own their notifier, so there is one producer per notifier.
+//! The slots are used instead of a queue because only the latest value matters to the meters
+class AudioSignalsNotifier : public AudioTelemetry::ISource
+{
+public:
+    AudioSignalsNotifier() = default;
+
+    //! NOTE Audio processing, neither allocates memory nor takes locks
+    void updateSignalValues(const audioch_t audioChNumber, const float newAmplitude, const volume_dbfs_t newPressure);
+
+    AudioSignalChanges audioSignalChanges() const;
+
+    void flush() override;
+
+    //! NOTE Active while anybody is subscribed to the signal changes, e.g. the meters are shown
+    bool isActive() const override;
+
+private:
+    static constexpr audioch_t MAX_AUDIO_CHANNELS_COUNT = 32;
+    static constexpr volume_dbfs_t PRESSURE_MINIMAL_VALUABLE_DIFF = 2.5f;
+    static constexpr volume_dbfs_t MINIMUM_OPERABLE_DBFS_LEVEL = -100.f;
+
+    struct Signal {
+        volume_dbfs_t lastPressure = 0.f;
+        std::atomic<float> amplitude = 0.f;
+        std::atomic<volume_dbfs_t> pressure = 0.f;
+    };
+
+    std::array<Signal, MAX_AUDIO_CHANNELS_COUNT> m_signals;
+    std::atomic<uint32_t> m_changedChannelsMask = 0;
+
+    mutable AudioSignalChanges m_audioSignalChanges;
+};
+
+using AudioSignalsNotifierPtr = std::shared_ptr<AudioSignalsNotifier>;
+}
+
+#endif // MU_AUDIO_AUDIOSIGNALSNOTIFIER_H
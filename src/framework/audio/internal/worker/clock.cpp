@@ -68,12 +68,24 @@ void Clock::setCurrentTime(msecs_t time)
     }
 
     m_currentTime = time;
-    m_timeChangedInMilliSecs.send(m_currentTime / 1000);
+
+    if (m_stateNotifier) {
+        m_stateNotifier->publishPositionMsecs(m_currentTime / 1000);
+    }
+}
+
+void Clock::setStatus(PlaybackStatus status)
+{
+    m_status.set(status);
+
+    if (m_stateNotifier) {
+        m_stateNotifier->publishStatus(status);
+    }
 }
 
 void Clock::start()
 {
-    m_status.set(PlaybackStatus::Running);
+    setStatus(PlaybackStatus::Running);
 }
 
 void Clock::reset()
@@ -84,18 +96,18 @@ void Clock::reset()
 
 void Clock::stop()
 {
-    m_status.set(PlaybackStatus::Stopped);
+    setStatus(PlaybackStatus::Stopped);
     seek(0);
 }
 
 void Clock::pause()
 {
-    m_status.set(PlaybackStatus::Paused);
+    setStatus(PlaybackStatus::Paused);
 }
 
 void Clock::resume()
 {
-    m_status.set(PlaybackStatus::Running);
+    setStatus(PlaybackStatus::Running);
     seek(m_currentTime);
 }
 
@@ -142,11 +154,6 @@ bool Clock::isRunning() const
     return m_status.val == PlaybackStatus::Running;
 }
 
-async::Channel<msecs_t> Clock::timeChanged() const
-{
-    return m_timeChangedInMilliSecs;
-}
-
 async::Notification Clock::seekOccurred() const
 {
     return m_seekOccurred;
@@ -156,3 +163,13 @@ async::Channel<PlaybackStatus> Clock::statusChanged() const
 {
     return m_status.ch;
 }
+
+PlaybackStateNotifierPtr Clock::stateNotifier() const
+{
+    return m_stateNotifier;
+}
+
+void Clock::setStateNotifier(PlaybackStateNotifierPtr notifier)
+{
+    m_stateNotifier = notifier;
+}
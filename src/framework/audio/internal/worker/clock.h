@@ -50,12 +50,15 @@ public:
 
     bool isRunning() const override;
 
-    async::Channel<msecs_t> timeChanged() const override;
     async::Notification seekOccurred() const override;
     async::Channel<PlaybackStatus> statusChanged() const override;
 
+    PlaybackStateNotifierPtr stateNotifier() const override;
+    void setStateNotifier(PlaybackStateNotifierPtr notifier) override;
+
 private:
     void setCurrentTime(msecs_t time);
+    void setStatus(PlaybackStatus status);
 
     ValCh<PlaybackStatus> m_status;
     msecs_t m_currentTime = 0;
@@ -63,8 +66,8 @@ private:
     msecs_t m_timeLoopStart = 0;
     msecs_t m_timeLoopEnd = 0;
 
-    async::Channel<msecs_t> m_timeChangedInMilliSecs;
     async::Notification m_seekOccurred;
+    PlaybackStateNotifierPtr m_stateNotifier = nullptr;
 };
 }
 
@@ -40,6 +40,10 @@ EventAudioSource::EventAudioSource(const TrackId trackId, const mpe::PlaybackDat
         m_playbackData.originEvents = events;
     });
 
+    m_playbackData.mainStreamDiff.onReceive(this, [this](const PlaybackEventsDiff& diff) {
+        diff.applyTo(m_playbackData.originEvents);
+    });
+
     m_playbackData.dynamicLevelChanges.onReceive(this, [this](const DynamicLevelMap& changes) {
         m_playbackData.dynamicLevelMap = changes;
     });
@@ -48,6 +52,7 @@ EventAudioSource::EventAudioSource(const TrackId trackId, const mpe::PlaybackDat
 EventAudioSource::~EventAudioSource()
 {
     m_playbackData.mainStream.resetOnReceive(this);
+    m_playbackData.mainStreamDiff.resetOnReceive(this);
 }
 
 bool EventAudioSource::isActive() const
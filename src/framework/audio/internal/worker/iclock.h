@@ -30,6 +30,7 @@
 #include "async/notification.h"
 
 #include "audiotypes.h"
+#include "playbackstatenotifier.h"
 
 namespace mu::audio {
 class IClock
@@ -55,9 +56,12 @@ public:
 
     virtual bool isRunning() const = 0;
 
-    virtual async::Channel<msecs_t> timeChanged() const = 0;
     virtual async::Notification seekOccurred() const = 0;
     virtual async::Channel<PlaybackStatus> statusChanged() const = 0;
+
+    //! NOTE The time and the status changes are published to it for the main thread
+    virtual PlaybackStateNotifierPtr stateNotifier() const = 0;
+    virtual void setStateNotifier(PlaybackStateNotifierPtr notifier) = 0;
 };
 
 using IClockPtr = std::shared_ptr<IClock>;
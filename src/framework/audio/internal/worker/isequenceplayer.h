@@ -24,9 +24,9 @@
 #define MU_AUDIO_ISEQUENCEPLAYER_H
 
 #include "types/ret.h"
-#include "async/channel.h"
 
 #include "audiotypes.h"
+#include "playbackstatenotifier.h"
 
 namespace mu::audio {
 class ISequencePlayer
@@ -45,8 +45,8 @@ public:
     virtual Ret setLoop(const msecs_t fromMsec, const msecs_t toMsec) = 0;
     virtual void resetLoop() = 0;
 
-    virtual async::Channel<msecs_t> playbackPositionMSecs() const = 0;
-    virtual async::Channel<PlaybackStatus> playbackStatusChanged() const = 0;
+    virtual PlaybackStateNotifierPtr stateNotifier() const = 0;
+    virtual void setStateNotifier(PlaybackStateNotifierPtr notifier) = 0;
 };
 using ISequencePlayerPtr = std::shared_ptr<ISequencePlayer>;
 }
@@ -26,20 +26,30 @@
 
 #include <limits>
 
-#include "concurrency/taskscheduler.h"
+#include "concurrency/realtimetaskscheduler.h"
 
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/audiokernels.h"
 #include "audioerrors.h"
 
 using namespace mu;
 using namespace mu::audio;
 using namespace mu::async;
 
+//! NOTE About -100 dBFS
+static constexpr float SILENCE_THRESHOLD = 0.00001f;
+
+//! NOTE Longer than the data reserved in the audio buffer, so the buffer has only silence when the mixer becomes idle
+static constexpr samples_t SILENT_SAMPLES_BEFORE_IDLE = 8192;
+
 Mixer::Mixer()
+    : m_audioSignalNotifier(std::make_shared<AudioSignalsNotifier>())
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    AudioTelemetry::instance()->registerSource(m_audioSignalNotifier);
 }
 
 Mixer::~Mixer()
@@ -66,6 +76,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     }
 
     m_mixerChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    updateChannelsList();
 
     result.val = m_mixerChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -81,6 +92,7 @@ Ret Mixer::removeChannel(const TrackId id)
 
     if (search != m_mixerChannels.end() && search->second) {
         m_mixerChannels.erase(id);
+        updateChannelsList();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -124,35 +136,19 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 
     std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
 
-    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
-        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
-    }
+    prepareChannelBuffers(samplesPerChannel);
 
-    samples_t masterChannelSampleCount = 0;
-
-    std::vector<std::future<std::vector<float> > > futureList;
+    RealtimeTaskScheduler::instance()->parallelFor(m_channelsList.size(), [this, samplesPerChannel](size_t idx) {
+        std::vector<float>& buffer = m_channelBuffers[idx];
+        std::fill(buffer.begin(), buffer.end(), 0.f);
 
-    for (const auto& pair : m_mixerChannels) {
-        MixerChannelPtr channel = pair.second;
-        std::future<std::vector<float> > future = TaskScheduler::instance()->submit([this, samplesPerChannel,
-                                                                                     channel]() -> std::vector<float> {
-            thread_local std::vector<float> buffer(samplesPerChannel * audioChannelsCount(), 0.f);
-            thread_local std::vector<float> silent_buffer(samplesPerChannel * audioChannelsCount(), 0.f);
+        m_channelsList[idx]->process(buffer.data(), samplesPerChannel);
+    });
 
-            buffer = silent_buffer;
-
-            if (channel) {
-                channel->process(buffer.data(), samplesPerChannel);
-            }
-
-            return buffer;
-        });
-
-        futureList.emplace_back(std::move(future));
-    }
+    samples_t masterChannelSampleCount = 0;
 
-    for (size_t i = 0; i < futureList.size(); ++i) {
-        mixOutputFromChannel(outBuffer, futureList[i].get().data(), samplesPerChannel);
+    for (std::vector<float>& buffer : m_channelBuffers) {
+        mixOutputFromChannel(outBuffer, buffer.data(), samplesPerChannel);
 
         masterChannelSampleCount = std::max(samplesPerChannel, masterChannelSampleCount);
     }
@@ -161,6 +157,7 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
             notifyAboutAudioSignalChanges(audioChNum, 0);
         }
+        m_silentSamplesInARow += samplesPerChannel;
         return 0;
     }
 
@@ -172,9 +169,29 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         }
     }
 
+    if (dsp::peak(outBuffer, samplesPerChannel * audioChannelsCount()) <= SILENCE_THRESHOLD) {
+        m_silentSamplesInARow += samplesPerChannel;
+    } else {
+        m_silentSamplesInARow = 0;
+    }
+
     return masterChannelSampleCount;
 }
 
+//! NOTE Nothing is playing and the tails of the sounds are over, so there is nothing to render until the next command
+bool Mixer::isIdle() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (const IClockPtr& clock : m_clocks) {
+        if (clock->isRunning()) {
+            return false;
+        }
+    }
+
+    return m_silentSamplesInARow >= SILENT_SAMPLES_BEFORE_IDLE;
+}
+
 void Mixer::setIsActive(bool arg)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -263,7 +280,32 @@ Channel<AudioOutputParams> Mixer::masterOutputParamsChanged() const
 
 async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_audioSignalNotifier->audioSignalChanges();
+}
+
+void Mixer::updateChannelsList()
+{
+    m_channelsList.clear();
+
+    for (const auto& pair : m_mixerChannels) {
+        if (pair.second) {
+            m_channelsList.push_back(pair.second.get());
+        }
+    }
+
+    m_channelBuffers.resize(m_channelsList.size());
+}
+
+void Mixer::prepareChannelBuffers(const samples_t samplesPerChannel)
+{
+    //! NOTE The buffers are reallocated only when the channels list or the block size has been changed
+    size_t bufferSize = samplesPerChannel * audioChannelsCount();
+
+    for (std::vector<float>& buffer : m_channelBuffers) {
+        if (buffer.size() != bufferSize) {
+            buffer.resize(bufferSize, 0.f);
+        }
+    }
 }
 
 void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount)
@@ -276,13 +318,7 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            outBuffer[idx] += inBuffer[idx];
-        }
-    }
+    dsp::accumulate(outBuffer, inBuffer, samplesCount * audioChannelsCount());
 }
 
 void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
@@ -291,23 +327,22 @@ void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
         return;
     }
 
-    float totalSquaredSum = 0.f;
+    if (m_channelGains.size() != audioChannelsCount()) {
+        m_channelGains.resize(audioChannelsCount());
+        m_channelSquaredSums.resize(audioChannelsCount());
+    }
 
     for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
+        m_channelGains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
+    }
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    dsp::applyGainAndSumOfSquares(buffer, audioChannelsCount(), samplesPerChannel, m_channelGains.data(), m_channelSquaredSums.data());
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    float totalSquaredSum = 0.f;
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
+        float singleChannelSquaredSum = m_channelSquaredSums[audioChNum];
+        totalSquaredSum += singleChannelSquaredSum;
 
         float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
         notifyAboutAudioSignalChanges(audioChNum, rms);
@@ -323,5 +358,5 @@ void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
 
 void Mixer::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    m_audioSignalNotifier->updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
 }
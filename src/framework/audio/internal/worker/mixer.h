@@ -30,6 +30,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "audiosignalsnotifier.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iclock.h"
@@ -59,6 +60,8 @@ public:
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
 
+    bool isIdle() const;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -66,11 +69,18 @@ public:
     void setIsActive(bool arg) override;
 
 private:
+    void updateChannelsList();
+    void prepareChannelBuffers(const samples_t samplesPerChannel);
+
     void mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount);
     void completeOutput(float* buffer, const samples_t& samplesPerChannel);
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
-    std::vector<float> m_writeCacheBuff;
+    std::vector<MixerChannel*> m_channelsList;
+    std::vector<std::vector<float> > m_channelBuffers;
+
+    std::vector<float> m_channelGains;
+    std::vector<float> m_channelSquaredSums;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
@@ -82,7 +92,9 @@ private:
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
 
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    samples_t m_silentSamplesInARow = 0;
+
+    AudioSignalsNotifierPtr m_audioSignalNotifier = nullptr;
 };
 
 using MixerPtr = std::shared_ptr<Mixer>;
@@ -26,6 +26,7 @@
 #include "log.h"
 
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/audiokernels.h"
 #include "internal/audiosanitizer.h"
 
 using namespace mu;
@@ -36,11 +37,14 @@ MixerChannel::MixerChannel(const TrackId trackId, IAudioSourcePtr source, const
     : m_trackId(trackId),
     m_sampleRate(sampleRate),
     m_audioSource(std::move(source)),
-    m_compressor(std::make_unique<dsp::Compressor>(sampleRate))
+    m_compressor(std::make_unique<dsp::Compressor>(sampleRate)),
+    m_audioSignalNotifier(std::make_shared<AudioSignalsNotifier>())
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     setSampleRate(sampleRate);
+
+    AudioTelemetry::instance()->registerSource(m_audioSignalNotifier);
 }
 
 const AudioOutputParams& MixerChannel::outputParams() const
@@ -104,7 +108,7 @@ async::Channel<AudioOutputParams> MixerChannel::outputParamsChanged() const
 
 async::Channel<audioch_t, AudioSignalVal> MixerChannel::audioSignalChanges() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_audioSignalNotifier->audioSignalChanges();
 }
 
 bool MixerChannel::isActive() const
@@ -198,25 +202,26 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
 {
-    float totalSquaredSum = 0.f;
+    audioch_t channelsCount = audioChannelsCount();
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
+    if (m_channelGains.size() != channelsCount) {
+        m_channelGains.resize(channelsCount);
+        m_channelSquaredSums.resize(channelsCount);
+    }
 
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * dsp::linearFromDecibels(m_params.volume);
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_channelGains[audioChNum] = dsp::balanceGain(m_params.balance, audioChNum) * dsp::linearFromDecibels(m_params.volume);
+    }
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    dsp::applyGainAndSumOfSquares(buffer, channelsCount, samplesCount, m_channelGains.data(), m_channelSquaredSums.data());
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    float totalSquaredSum = 0.f;
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        float singleChannelSquaredSum = m_channelSquaredSums[audioChNum];
+        totalSquaredSum += singleChannelSquaredSum;
 
         float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
 
@@ -233,5 +238,5 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
 
 void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    m_audioSignalNotifier->updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
 }
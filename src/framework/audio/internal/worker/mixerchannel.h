@@ -29,6 +29,7 @@
 #include "ifxresolver.h"
 #include "ifxprocessor.h"
 #include "track.h"
+#include "audiosignalsnotifier.h"
 #include "internal/dsp/compressor.h"
 
 namespace mu::audio {
@@ -54,7 +55,7 @@ public:
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
+    void completeOutput(float* buffer, unsigned int samplesCount);
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
     TrackId m_trackId = -1;
@@ -67,8 +68,11 @@ private:
 
     dsp::CompressorPtr m_compressor = nullptr;
 
+    std::vector<float> m_channelGains;
+    std::vector<float> m_channelSquaredSums;
+
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    AudioSignalsNotifierPtr m_audioSignalNotifier = nullptr;
 };
 
 using MixerChannelPtr = std::shared_ptr<MixerChannel>;
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "playbackstatenotifier.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+PlaybackStateNotifier::PlaybackStateNotifier(const TrackSequenceId sequenceId,
+                                             async::Channel<TrackSequenceId, msecs_t> positionMsecsChanged,
+                                             async::Channel<TrackSequenceId, PlaybackStatus> statusChanged)
+    : m_sequenceId(sequenceId), m_positionMsecsChanged(positionMsecsChanged), m_statusChanged(statusChanged)
+{
+}
+
+void PlaybackStateNotifier::publishPositionMsecs(const msecs_t msecs)
+{
+    m_positionMsecs.store(msecs, std::memory_order_relaxed);
+    m_positionChanged.store(true, std::memory_order_release);
+    AudioTelemetry::instance()->markPending();
+}
+
+void PlaybackStateNotifier::publishStatus(const PlaybackStatus status)
+{
+    //! NOTE Can't wait for the main thread, the status changes are rare, so the queue is full only if the main thread hangs
+    m_statuses.push(status);
+    AudioTelemetry::instance()->markPending();
+}
+
+void PlaybackStateNotifier::flush()
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    //! NOTE The position first, so the subscribers know the position the playback was stopped or paused at
+    if (m_positionChanged.exchange(false, std::memory_order_acquire)) {
+        m_positionMsecsChanged.send(m_sequenceId, m_positionMsecs.load(std::memory_order_relaxed));
+    }
+
+    PlaybackStatus status = PlaybackStatus::Stopped;
+    while (m_statuses.pop(status)) {
+        m_running = status == PlaybackStatus::Running;
+        m_statusChanged.send(m_sequenceId, status);
+    }
+}
+
+bool PlaybackStateNotifier::isActive() const
+{
+    ONLY_AUDIO_MAIN_THREAD;
+
+    return m_running;
+}
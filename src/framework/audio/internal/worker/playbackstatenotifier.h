@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_PLAYBACKSTATENOTIFIER_H
+#define MU_AUDIO_PLAYBACKSTATENOTIFIER_H
+
+#include <atomic>
+#include <memory>
+
+#include "async/channel.h"
+#include "concurrency/spscqueue.h"
+
+#include "internal/audiotelemetry.h"
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE The playback position and status of a sequence, published by its clock.
+//! The positions are coalesced, the main thread gets only the latest one,
+//! the statuses are queued, so none of them is lost (see AudioTelemetry)
+class PlaybackStateNotifier : public AudioTelemetry::ISource
+{
+public:
+    PlaybackStateNotifier(const TrackSequenceId sequenceId, async::Channel<TrackSequenceId, msecs_t> positionMsecsChanged,
+                          async::Channel<TrackSequenceId, PlaybackStatus> statusChanged);
+
+    //! NOTE Worker thread, neither allocate memory nor take locks
+    void publishPositionMsecs(const msecs_t msecs);
+    void publishStatus(const PlaybackStatus status);
+
+    void flush() override;
+
+    //! NOTE Active while the last delivered status is Running
+    bool isActive() const override;
+
+private:
+    static constexpr size_t STATUS_QUEUE_CAPACITY = 32;
+
+    TrackSequenceId m_sequenceId = -1;
+
+    async::Channel<TrackSequenceId, msecs_t> m_positionMsecsChanged;
+    async::Channel<TrackSequenceId, PlaybackStatus> m_statusChanged;
+
+    std::atomic<msecs_t> m_positionMsecs = 0;
+    std::atomic<bool> m_positionChanged = false;
+    SpscQueue<PlaybackStatus, STATUS_QUEUE_CAPACITY> m_statuses;
+
+    bool m_running = false;
+};
+
+using PlaybackStateNotifierPtr = std::shared_ptr<PlaybackStateNotifier>;
+}
+
+#endif // MU_AUDIO_PLAYBACKSTATENOTIFIER_H
@@ -26,6 +26,7 @@
 #include "async/async.h"
 
 #include "internal/audiosanitizer.h"
+#include "internal/audiotelemetry.h"
 #include "internal/audiothread.h"
 #include "audioerrors.h"
 
@@ -44,6 +45,9 @@ PlayerHandler::~PlayerHandler()
 
 void PlayerHandler::play(const TrackSequenceId sequenceId)
 {
+    //! NOTE The main thread waits for the new status and position, the telemetry delivers them while the playback runs
+    AudioTelemetry::instance()->activate();
+
     Async::call(this, [this, sequenceId]() {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -56,6 +60,8 @@ void PlayerHandler::play(const TrackSequenceId sequenceId)
 
 void PlayerHandler::seek(const TrackSequenceId sequenceId, const msecs_t newPositionMsecs)
 {
+    AudioTelemetry::instance()->activate();
+
     Async::call(this, [this, sequenceId, newPositionMsecs]() {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -68,6 +74,8 @@ void PlayerHandler::seek(const TrackSequenceId sequenceId, const msecs_t newPosi
 
 void PlayerHandler::stop(const TrackSequenceId sequenceId)
 {
+    AudioTelemetry::instance()->activate();
+
     Async::call(this, [this, sequenceId]() {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -80,6 +88,8 @@ void PlayerHandler::stop(const TrackSequenceId sequenceId)
 
 void PlayerHandler::pause(const TrackSequenceId sequenceId)
 {
+    AudioTelemetry::instance()->activate();
+
     Async::call(this, [this, sequenceId]() {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -92,6 +102,8 @@ void PlayerHandler::pause(const TrackSequenceId sequenceId)
 
 void PlayerHandler::resume(const TrackSequenceId sequenceId)
 {
+    AudioTelemetry::instance()->activate();
+
     Async::call(this, [this, sequenceId]() {
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -179,17 +191,14 @@ void PlayerHandler::ensureSubscriptions(const ITrackSequencePtr s) const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    if (!s || s->player()->playbackPositionMSecs().isConnected()) {
+    if (!s || s->player()->stateNotifier()) {
         return;
     }
 
-    TrackSequenceId sequenceId = s->id();
-
-    s->player()->playbackPositionMSecs().onReceive(this, [this, sequenceId](const msecs_t newPosMsecs) {
-        m_playbackPositionMsecsChanged.send(sequenceId, newPosMsecs);
-    });
+    //! NOTE The player publishes its state to the notifier right from the audio processing,
+    //! the main thread gets it by the next flush of the telemetry
+    auto notifier = std::make_shared<PlaybackStateNotifier>(s->id(), m_playbackPositionMsecsChanged, m_playbackStatusChanged);
+    AudioTelemetry::instance()->registerSource(notifier);
 
-    s->player()->playbackStatusChanged().onReceive(this, [this, sequenceId](const PlaybackStatus newStatus) {
-        m_playbackStatusChanged.send(sequenceId, newStatus);
-    });
+    s->player()->setStateNotifier(notifier);
 }
@@ -133,18 +133,18 @@ void SequencePlayer::resetLoop()
     m_clock->resetTimeLoop();
 }
 
-Channel<msecs_t> SequencePlayer::playbackPositionMSecs() const
+PlaybackStateNotifierPtr SequencePlayer::stateNotifier() const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    return m_clock->timeChanged();
+    return m_clock->stateNotifier();
 }
 
-Channel<PlaybackStatus> SequencePlayer::playbackStatusChanged() const
+void SequencePlayer::setStateNotifier(PlaybackStateNotifierPtr notifier)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    return m_clock->statusChanged();
+    m_clock->setStateNotifier(std::move(notifier));
 }
 
 TracksMap SequencePlayer::tracks() const
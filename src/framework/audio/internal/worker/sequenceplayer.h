@@ -46,8 +46,8 @@ public:
     Ret setLoop(const msecs_t fromMsec, const msecs_t toMsec) override;
     void resetLoop() override;
 
-    async::Channel<msecs_t> playbackPositionMSecs() const override;
-    async::Channel<PlaybackStatus> playbackStatusChanged() const override;
+    PlaybackStateNotifierPtr stateNotifier() const override;
+    void setStateNotifier(PlaybackStateNotifierPtr notifier) override;
 
 private:
     TracksMap tracks() const;
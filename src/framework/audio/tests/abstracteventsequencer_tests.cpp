@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "abstracteventsequencer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class TestEventSequencer : public AbstractEventSequencer<int>
+{
+public:
+    void setMainStream(const EventSequenceMap& events)
+    {
+        m_mainStreamEvents = events;
+        updateMainStreamTimeline();
+    }
+
+    void setDynamics(const EventSequenceMap& events)
+    {
+        m_dynamicEvents = events;
+        updateMainStreamTimeline();
+    }
+
+    void setOffStream(const EventSequenceMap& events)
+    {
+        m_offStreamEvents = events;
+        updateOffStreamTimeline();
+    }
+
+    void updateOffStreamEvents(const mpe::PlaybackEventsMap&) override {}
+    void updateMainStreamEvents(const mpe::PlaybackEventsMap&) override {}
+    void updateDynamicChanges(const mpe::DynamicLevelMap&) override {}
+};
+
+class Audio_AbstractEventSequencerTests : public ::testing::Test
+{
+public:
+    using Played = std::vector<std::pair<msecs_t, int> >;
+
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    //! NOTE The events of the block with their offsets from the start of the block
+    static Played play(TestEventSequencer& sequencer, msecs_t blockDuration)
+    {
+        Played played;
+        auto span = sequencer.eventsToBePlayed(blockDuration);
+        for (const auto& event : span) {
+            played.push_back({ span.offset(event), std::get<int>(event.event) });
+        }
+
+        return played;
+    }
+};
+
+TEST_F(Audio_AbstractEventSequencerTests, EventsAtTheirOffsetWithinTheBlock)
+{
+    //! GIVEN Events at 0, 5, 12 and 25 ms
+    TestEventSequencer sequencer;
+    sequencer.setMainStream({ { 0, { 1 } }, { 5, { 2 } }, { 12, { 3 } }, { 25, { 4 } } });
+    sequencer.setActive(true);
+
+    //! CHECK Each block of 10 ms gives the events due within it, at their offset from the block start
+    EXPECT_EQ(play(sequencer, 10), Played({ { 0, 1 }, { 5, 2 } }));
+    EXPECT_EQ(play(sequencer, 10), Played({ { 2, 3 } }));
+    EXPECT_EQ(play(sequencer, 10), Played({ { 5, 4 } }));
+    EXPECT_EQ(play(sequencer, 10), Played());
+    EXPECT_EQ(sequencer.playbackPosition(), 40);
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, AllTimestampsOfTheBlock)
+{
+    //! GIVEN A dense passage: several timestamps within one block
+    TestEventSequencer sequencer;
+    sequencer.setMainStream({ { 1, { 1, 2 } }, { 2, { 3 } }, { 3, { 4 } }, { 4, { 5 } } });
+    sequencer.setActive(true);
+
+    //! CHECK All of them are played in the block, not one timestamp per block
+    EXPECT_EQ(play(sequencer, 10), Played({ { 1, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 } }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, DynamicsMergedWithTheMainStream)
+{
+    //! GIVEN Main stream and dynamics events, some of them at the same timestamp
+    TestEventSequencer sequencer;
+    sequencer.setMainStream({ { 0, { 10, 30 } }, { 8, { 50 } } });
+    sequencer.setDynamics({ { 0, { 20 } }, { 4, { 40 } } });
+    sequencer.setActive(true);
+
+    //! CHECK They are played in one timeline, in the order of EventSequence within a timestamp
+    EXPECT_EQ(play(sequencer, 10), Played({ { 0, 10 }, { 0, 20 }, { 0, 30 }, { 4, 40 }, { 8, 50 } }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, Seek)
+{
+    //! GIVEN Events every 10 ms
+    TestEventSequencer sequencer;
+    sequencer.setMainStream({ { 0, { 1 } }, { 10, { 2 } }, { 20, { 3 } }, { 30, { 4 } } });
+    sequencer.setActive(true);
+
+    //! DO Seek into the middle
+    sequencer.setPlaybackPosition(15);
+
+    //! CHECK The events before the position are skipped
+    EXPECT_EQ(play(sequencer, 10), Played({ { 5, 3 } }));
+
+    //! DO Seek back
+    sequencer.setPlaybackPosition(0);
+
+    //! CHECK The events are played again
+    EXPECT_EQ(play(sequencer, 5), Played({ { 0, 1 } }));
+    EXPECT_EQ(play(sequencer, 10), Played({ { 5, 2 } }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, OffStreamWhenInactive)
+{
+    //! GIVEN Main stream and off stream events
+    TestEventSequencer sequencer;
+    sequencer.setMainStream({ { 0, { 1 } } });
+    sequencer.setOffStream({ { 0, { 2 } }, { 3, { 3 } } });
+
+    //! CHECK The inactive sequencer plays the off stream, counted from its update
+    EXPECT_EQ(play(sequencer, 10), Played({ { 0, 2 }, { 3, 3 } }));
+
+    //! DO Activate
+    sequencer.setActive(true);
+
+    //! CHECK The main stream is played from the playback position
+    EXPECT_EQ(play(sequencer, 10), Played({ { 0, 1 } }));
+}
@@ -0,0 +1,221 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "internal/dsp/audiokernels.h"
+
+using namespace mu::audio::dsp;
+
+class Audio_AudioKernelsTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        selectInstructionSet(bestSupportedInstructionSet());
+    }
+
+    static std::vector<InstructionSet> vectorisedSets()
+    {
+        std::vector<InstructionSet> result;
+        for (InstructionSet set : { InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON }) {
+            if (isInstructionSetSupported(set)) {
+                result.push_back(set);
+            }
+        }
+
+        return result;
+    }
+
+    //! NOTE All the lengths up to a few vectors, so every remainder after the vector loop is covered
+    static std::vector<size_t> lengths()
+    {
+        std::vector<size_t> result;
+        for (size_t length = 0; length <= 40; ++length) {
+            result.push_back(length);
+        }
+
+        for (size_t length : { 255, 256, 257, 1021, 1024 }) {
+            result.push_back(length);
+        }
+
+        return result;
+    }
+
+    static std::vector<float> signal(size_t count, float phase = 0.f)
+    {
+        std::vector<float> result(count);
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = std::sin(static_cast<float>(i) * 0.37f + phase) * (i % 3 == 0 ? -0.9f : 0.6f);
+        }
+
+        return result;
+    }
+
+    //! NOTE The vectorised sums add the samples in a different order
+    static float sumTolerance(float expected, size_t count)
+    {
+        return std::abs(expected) * 1e-5f + 1e-6f * count;
+    }
+};
+
+TEST_F(Audio_AudioKernelsTests, Accumulate_SameAsScalar)
+{
+    for (InstructionSet set : vectorisedSets()) {
+        for (size_t count : lengths()) {
+            //! GIVEN Two signals
+            const std::vector<float> src = signal(count, 1.f);
+            std::vector<float> expected = signal(count);
+            std::vector<float> actual = expected;
+
+            //! DO Accumulate them by the scalar and the vectorised kernels
+            selectInstructionSet(InstructionSet::Scalar);
+            accumulate(expected.data(), src.data(), count);
+
+            selectInstructionSet(set);
+            accumulate(actual.data(), src.data(), count);
+
+            //! CHECK The results are exactly the same
+            EXPECT_EQ(actual, expected) << instructionSetName(set) << ", count: " << count;
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, Multiply_SameAsScalar)
+{
+    for (InstructionSet set : vectorisedSets()) {
+        for (size_t count : lengths()) {
+            //! GIVEN Signal
+            std::vector<float> expected = signal(count);
+            std::vector<float> actual = expected;
+
+            //! DO Apply the gain by the scalar and the vectorised kernels
+            selectInstructionSet(InstructionSet::Scalar);
+            multiply(expected.data(), count, 0.7f);
+
+            selectInstructionSet(set);
+            multiply(actual.data(), count, 0.7f);
+
+            //! CHECK The results are exactly the same
+            EXPECT_EQ(actual, expected) << instructionSetName(set) << ", count: " << count;
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, SumOfSquares_SameAsScalar)
+{
+    for (InstructionSet set : vectorisedSets()) {
+        for (size_t count : lengths()) {
+            //! GIVEN Signal
+            const std::vector<float> buffer = signal(count);
+
+            //! DO Sum the squares by the scalar and the vectorised kernels
+            selectInstructionSet(InstructionSet::Scalar);
+            const float expected = sumOfSquares(buffer.data(), count);
+
+            selectInstructionSet(set);
+            const float actual = sumOfSquares(buffer.data(), count);
+
+            //! CHECK The sums are the same up to the rounding
+            EXPECT_NEAR(actual, expected, sumTolerance(expected, count)) << instructionSetName(set) << ", count: " << count;
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, Peak_SameAsScalar)
+{
+    for (InstructionSet set : vectorisedSets()) {
+        for (size_t count : lengths()) {
+            //! GIVEN Signal with the negative peak in the last sample, which is out of the vector loop for most of the lengths
+            std::vector<float> buffer = signal(count);
+            if (count > 0) {
+                buffer.back() = -1.5f;
+            }
+
+            //! DO Find the peak by the scalar and the vectorised kernels
+            selectInstructionSet(InstructionSet::Scalar);
+            const float expected = peak(buffer.data(), count);
+
+            selectInstructionSet(set);
+            const float actual = peak(buffer.data(), count);
+
+            //! CHECK The peaks are exactly the same
+            EXPECT_EQ(actual, expected) << instructionSetName(set) << ", count: " << count;
+            EXPECT_EQ(actual, count > 0 ? 1.5f : 0.f);
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, ApplyGainAndSumOfSquares_SameAsScalar)
+{
+    for (InstructionSet set : vectorisedSets()) {
+        for (size_t audioChannelsCount : { 1, 2, 3 }) {
+            for (size_t samplesPerChannel : lengths()) {
+                //! GIVEN Interleaved signal and a gain per audio channel
+                const size_t count = samplesPerChannel * audioChannelsCount;
+                const float gains[3] = { 0.5f, 1.25f, 0.8f };
+
+                std::vector<float> expected = signal(count);
+                std::vector<float> actual = expected;
+                float expectedSums[3] = { -1.f, -1.f, -1.f };
+                float actualSums[3] = { -1.f, -1.f, -1.f };
+
+                //! DO Apply the gains by the scalar and the vectorised kernels
+                selectInstructionSet(InstructionSet::Scalar);
+                applyGainAndSumOfSquares(expected.data(), audioChannelsCount, samplesPerChannel, gains, expectedSums);
+
+                selectInstructionSet(set);
+                applyGainAndSumOfSquares(actual.data(), audioChannelsCount, samplesPerChannel, gains, actualSums);
+
+                //! CHECK The samples are exactly the same, the sums are the same up to the rounding
+                EXPECT_EQ(actual, expected) << instructionSetName(set) << ", samples: " << samplesPerChannel;
+
+                for (size_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+                    EXPECT_NEAR(actualSums[audioChNum], expectedSums[audioChNum], sumTolerance(expectedSums[audioChNum], count))
+                        << instructionSetName(set) << ", audio channels: " << audioChannelsCount
+                        << ", samples: " << samplesPerChannel << ", audio channel: " << audioChNum;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, SelectInstructionSet)
+{
+    //! CHECK The best set is supported and selected by default
+    EXPECT_TRUE(isInstructionSetSupported(bestSupportedInstructionSet()));
+    EXPECT_EQ(currentInstructionSet(), bestSupportedInstructionSet());
+
+    //! CHECK The scalar set is always supported
+    selectInstructionSet(InstructionSet::Scalar);
+    EXPECT_EQ(currentInstructionSet(), InstructionSet::Scalar);
+
+    //! CHECK An unsupported set is not selected
+    for (InstructionSet set : { InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON }) {
+        if (!isInstructionSetSupported(set)) {
+            selectInstructionSet(set);
+            EXPECT_EQ(currentInstructionSet(), InstructionSet::Scalar);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "async/asyncable.h"
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/audiosignalsnotifier.h"
+
+using namespace mu::audio;
+
+class Audio_AudioSignalsNotifierTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupMainThread();
+
+        m_notifier.audioSignalChanges().onReceive(nullptr, [this](const audioch_t audioChNumber, const AudioSignalVal& val) {
+            m_received[audioChNumber].push_back(val);
+        });
+    }
+
+    //! NOTE The values the main thread gets on the next flush
+    std::map<audioch_t, std::vector<AudioSignalVal> > flush()
+    {
+        m_received.clear();
+        m_notifier.flush();
+        return m_received;
+    }
+
+    AudioSignalsNotifier m_notifier;
+    std::map<audioch_t, std::vector<AudioSignalVal> > m_received;
+};
+
+TEST_F(Audio_AudioSignalsNotifierTests, Threshold)
+{
+    //! GIVEN The value of the channel is delivered
+    m_notifier.updateSignalValues(0, 0.1f, -20.f);
+    ASSERT_EQ(flush()[0].size(), 1u);
+
+    //! DO Change it less than the threshold
+    m_notifier.updateSignalValues(0, 0.11f, -19.f);
+
+    //! CHECK Nothing is delivered
+    EXPECT_TRUE(flush().empty());
+
+    //! DO Change it more than the threshold, compared with the last published value
+    m_notifier.updateSignalValues(0, 0.2f, -17.f);
+
+    //! CHECK The new value is delivered
+    std::map<audioch_t, std::vector<AudioSignalVal> > received = flush();
+    ASSERT_EQ(received[0].size(), 1u);
+    EXPECT_FLOAT_EQ(received[0].front().amplitude, 0.2f);
+    EXPECT_FLOAT_EQ(received[0].front().pressure, -17.f);
+
+    //! DO Go below the minimal operable level
+    m_notifier.updateSignalValues(0, 0.f, -300.f);
+
+    //! CHECK The value is clamped
+    received = flush();
+    ASSERT_EQ(received[0].size(), 1u);
+    EXPECT_FLOAT_EQ(received[0].front().pressure, -100.f);
+
+    //! CHECK Staying below the level isn't a change
+    m_notifier.updateSignalValues(0, 0.f, -200.f);
+    EXPECT_TRUE(flush().empty());
+}
+
+TEST_F(Audio_AudioSignalsNotifierTests, Coalescing)
+{
+    //! DO Change two channels several times between the flushes
+    m_notifier.updateSignalValues(0, 0.1f, -20.f);
+    m_notifier.updateSignalValues(1, 0.5f, -6.f);
+    m_notifier.updateSignalValues(0, 0.3f, -10.f);
+    m_notifier.updateSignalValues(0, 0.9f, -1.f);
+
+    //! CHECK Only the latest value of every changed channel is delivered
+    std::map<audioch_t, std::vector<AudioSignalVal> > received = flush();
+    ASSERT_EQ(received.size(), 2u);
+
+    ASSERT_EQ(received[0].size(), 1u);
+    EXPECT_FLOAT_EQ(received[0].front().amplitude, 0.9f);
+    EXPECT_FLOAT_EQ(received[0].front().pressure, -1.f);
+
+    ASSERT_EQ(received[1].size(), 1u);
+    EXPECT_FLOAT_EQ(received[1].front().amplitude, 0.5f);
+    EXPECT_FLOAT_EQ(received[1].front().pressure, -6.f);
+
+    //! CHECK Nothing is delivered twice
+    EXPECT_TRUE(flush().empty());
+}
+
+TEST_F(Audio_AudioSignalsNotifierTests, ActiveWhileSubscribed)
+{
+    //! GIVEN The notifier nobody is subscribed to
+    AudioSignalsNotifier notifier;
+    EXPECT_FALSE(notifier.isActive());
+
+    {
+        //! DO Subscribe, e.g. the meters are shown
+        mu::async::Asyncable receiver;
+        notifier.audioSignalChanges().onReceive(&receiver, [](const audioch_t, const AudioSignalVal&) {});
+
+        //! CHECK The telemetry keeps flushing it
+        EXPECT_TRUE(notifier.isActive());
+    }
+
+    //! CHECK It isn't active once the subscriber is gone
+    EXPECT_FALSE(notifier.isActive());
+}
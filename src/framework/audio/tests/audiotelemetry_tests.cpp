@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include "async/asyncable.h"
+
+#include "internal/audiosanitizer.h"
+#include "internal/audiotelemetry.h"
+
+using namespace mu::audio;
+
+class Audio_AudioTelemetryTests : public ::testing::Test
+{
+public:
+    class Source : public AudioTelemetry::ISource
+    {
+    public:
+        void flush() override
+        {
+            flushes++;
+        }
+
+        bool isActive() const override
+        {
+            return active;
+        }
+
+        int flushes = 0;
+        bool active = false;
+    };
+
+    void SetUp() override
+    {
+        AudioSanitizer::setupMainThread();
+
+        //! NOTE The telemetry is a singleton, so stop the flushing the previous tests may have left running
+        while (telemetry()->flush()) {
+        }
+
+        m_source = std::make_shared<Source>();
+        telemetry()->registerSource(m_source);
+
+        telemetry()->activated().onNotify(&m_receiver, [this]() {
+            m_activations++;
+        });
+    }
+
+    static AudioTelemetry* telemetry()
+    {
+        return AudioTelemetry::instance();
+    }
+
+    //! NOTE Flushes as the timer of the main thread does, returns the number of the flushes until it's stopped
+    static int flushUntilStopped()
+    {
+        int flushes = 1;
+        while (telemetry()->flush()) {
+            flushes++;
+        }
+
+        return flushes;
+    }
+
+    mu::async::Asyncable m_receiver;
+    std::shared_ptr<Source> m_source;
+    int m_activations = 0;
+};
+
+TEST_F(Audio_AudioTelemetryTests, Activate_NotifiesOnce)
+{
+    //! DO Activate several times, e.g. the play and seek commands
+    telemetry()->activate();
+    telemetry()->activate();
+
+    //! CHECK The timer is started once
+    EXPECT_EQ(m_activations, 1);
+
+    //! CHECK The flushing runs until the worker responds or the activation is over
+    EXPECT_EQ(flushUntilStopped(), AudioTelemetry::ACTIVATION_FLUSHES + 1);
+
+    //! CHECK The next activation starts it again
+    telemetry()->activate();
+    EXPECT_EQ(m_activations, 2);
+}
+
+TEST_F(Audio_AudioTelemetryTests, Worker_DoesntStartFlushing)
+{
+    //! DO Publish from another thread while the flushing is stopped
+    std::thread worker([]() {
+        telemetry()->markPending();
+    });
+    worker.join();
+
+    //! CHECK The main thread isn't notified
+    EXPECT_EQ(m_activations, 0);
+    EXPECT_EQ(m_source->flushes, 0);
+
+    //! CHECK The published data is delivered once the main thread starts the flushing
+    telemetry()->activate();
+    EXPECT_TRUE(telemetry()->flush());
+    EXPECT_EQ(m_source->flushes, 1);
+}
+
+TEST_F(Audio_AudioTelemetryTests, ActiveSource_KeepsFlushing)
+{
+    //! GIVEN The source is active, e.g. the playback is running
+    m_source->active = true;
+    telemetry()->activate();
+
+    //! CHECK The flushing runs after the activation is over
+    for (int i = 0; i < AudioTelemetry::ACTIVATION_FLUSHES * 2; ++i) {
+        telemetry()->markPending();
+        EXPECT_TRUE(telemetry()->flush());
+    }
+
+    EXPECT_EQ(m_source->flushes, AudioTelemetry::ACTIVATION_FLUSHES * 2);
+
+    //! DO The playback is stopped, the last data is published
+    m_source->active = false;
+    telemetry()->markPending();
+
+    //! CHECK The last data is delivered, then the flushing is stopped
+    EXPECT_EQ(flushUntilStopped(), 2);
+    EXPECT_EQ(m_source->flushes, AudioTelemetry::ACTIVATION_FLUSHES * 2 + 1);
+}
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "internal/audiothread.h"
+
+using namespace mu::audio;
+
+class Audio_AudioThreadTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        if (m_thread.isRunning()) {
+            m_thread.stop();
+        }
+    }
+
+    //! NOTE The loop body counts the iterations and switches the idle mode as the test requires
+    void run()
+    {
+        m_thread.setActiveWaitTimeout(ACTIVE_WAIT_TIMEOUT);
+        m_thread.run(nullptr, [this]() {
+            m_iterations++;
+            m_thread.setIdle(m_idle);
+        });
+    }
+
+    //! NOTE Waits until the worker goes to sleep after the last iteration
+    size_t settledIterations()
+    {
+        size_t iterations = m_iterations;
+        for (;;) {
+            std::this_thread::sleep_for(SETTLE_TIME);
+            size_t current = m_iterations;
+            if (current == iterations) {
+                return current;
+            }
+            iterations = current;
+        }
+    }
+
+    static bool waitFor(const std::function<bool()>& condition)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+
+    static constexpr std::chrono::milliseconds ACTIVE_WAIT_TIMEOUT { 5 };
+    static constexpr std::chrono::milliseconds SETTLE_TIME { 50 };
+
+    AudioThread m_thread;
+    std::atomic<size_t> m_iterations = 0;
+    std::atomic<bool> m_idle = true;
+};
+
+TEST_F(Audio_AudioThreadTests, Idle_SleepsUntilWake)
+{
+    //! GIVEN The worker in the idle mode
+    run();
+    size_t iterations = settledIterations();
+    EXPECT_TRUE(m_thread.isIdle());
+
+    //! CHECK It doesn't wake up by itself
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(m_iterations, iterations);
+
+    //! DO Wake it up
+    m_thread.wake();
+
+    //! CHECK It makes one iteration and sleeps again
+    EXPECT_TRUE(waitFor([&]() { return m_iterations > iterations; }));
+    EXPECT_EQ(settledIterations(), iterations + 1);
+}
+
+TEST_F(Audio_AudioThreadTests, Idle_IgnoresRealtimeWake)
+{
+    //! GIVEN The worker in the idle mode
+    run();
+    size_t iterations = settledIterations();
+
+    //! DO Mark the wake-up as requested from the driver callback
+    m_thread.wakeFromRealtime();
+
+    //! CHECK The worker isn't woken up, only the flag is set
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(m_iterations, iterations);
+
+    //! CHECK The flag doesn't add an iteration to the next wake-up
+    m_thread.wake();
+    EXPECT_TRUE(waitFor([&]() { return m_iterations > iterations; }));
+    EXPECT_EQ(settledIterations(), iterations + 1);
+}
+
+TEST_F(Audio_AudioThreadTests, Active_WakesUpByTimeout)
+{
+    //! GIVEN The worker in the idle mode
+    run();
+    size_t iterations = settledIterations();
+
+    //! DO Leave the idle mode, e.g. the playback is started
+    m_idle = false;
+    m_thread.wake();
+
+    //! CHECK The worker refills the buffer by timeout without any wake-ups
+    EXPECT_TRUE(waitFor([&]() { return !m_thread.isIdle(); }));
+    EXPECT_TRUE(waitFor([&]() { return m_iterations > iterations + 5; }));
+
+    //! DO Go back to the idle mode
+    m_idle = true;
+
+    //! CHECK The worker stops waking up
+    EXPECT_TRUE(waitFor([&]() { return m_thread.isIdle(); }));
+    iterations = settledIterations();
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(m_iterations, iterations);
+}
+
+TEST_F(Audio_AudioThreadTests, Stop_WakesIdleWorker)
+{
+    //! GIVEN The worker sleeping in the idle mode
+    run();
+    settledIterations();
+
+    //! DO Stop it
+    std::atomic<bool> finished = false;
+    m_thread.stop([&finished]() {
+        finished = true;
+    });
+
+    //! CHECK The worker is woken up and finished
+    EXPECT_TRUE(finished);
+    EXPECT_FALSE(m_thread.isRunning());
+}
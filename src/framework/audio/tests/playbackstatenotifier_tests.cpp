@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/playbackstatenotifier.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_PlaybackStateNotifierTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupMainThread();
+
+        m_notifier = std::make_shared<PlaybackStateNotifier>(SEQUENCE_ID, m_positionMsecsChanged, m_statusChanged);
+
+        m_positionMsecsChanged.onReceive(nullptr, [this](const TrackSequenceId id, const msecs_t msecs) {
+            EXPECT_EQ(id, SEQUENCE_ID);
+            m_received.push_back("position " + std::to_string(msecs));
+        });
+
+        m_statusChanged.onReceive(nullptr, [this](const TrackSequenceId id, const PlaybackStatus status) {
+            EXPECT_EQ(id, SEQUENCE_ID);
+            m_received.push_back("status " + std::to_string(static_cast<int>(status)));
+        });
+    }
+
+    //! NOTE What the main thread gets on the next flush, in order
+    std::vector<std::string> flush()
+    {
+        m_received.clear();
+        m_notifier->flush();
+        return m_received;
+    }
+
+    static constexpr TrackSequenceId SEQUENCE_ID = 3;
+
+    async::Channel<TrackSequenceId, msecs_t> m_positionMsecsChanged;
+    async::Channel<TrackSequenceId, PlaybackStatus> m_statusChanged;
+    PlaybackStateNotifierPtr m_notifier;
+    std::vector<std::string> m_received;
+};
+
+TEST_F(Audio_PlaybackStateNotifierTests, PositionBeforeStatuses)
+{
+    //! DO The playback runs and is stopped between the flushes
+    m_notifier->publishStatus(PlaybackStatus::Running);
+    m_notifier->publishPositionMsecs(100);
+    m_notifier->publishPositionMsecs(200);
+    m_notifier->publishStatus(PlaybackStatus::Stopped);
+    m_notifier->publishPositionMsecs(250);
+
+    //! CHECK The latest position goes out first, then the statuses
+    std::vector<std::string> expected = { "position 250", "status 2", "status 0" };
+    EXPECT_EQ(flush(), expected);
+
+    //! CHECK Nothing is delivered twice
+    EXPECT_TRUE(flush().empty());
+}
+
+TEST_F(Audio_PlaybackStateNotifierTests, NoStatusLost)
+{
+    //! DO Change the status many times between the flushes, e.g. the main thread is busy
+    std::vector<std::string> expected;
+    for (int i = 0; i < 30; ++i) {
+        PlaybackStatus status = static_cast<PlaybackStatus>(i % 3);
+        m_notifier->publishStatus(status);
+        expected.push_back("status " + std::to_string(static_cast<int>(status)));
+    }
+
+    //! CHECK All the statuses are delivered in order
+    EXPECT_EQ(flush(), expected);
+
+    //! DO Publish more after the flush
+    m_notifier->publishStatus(PlaybackStatus::Paused);
+
+    //! CHECK It's delivered on the next flush
+    expected = { "status 1" };
+    EXPECT_EQ(flush(), expected);
+}
+
+TEST_F(Audio_PlaybackStateNotifierTests, ActiveWhileRunning)
+{
+    //! GIVEN The playback isn't started
+    EXPECT_FALSE(m_notifier->isActive());
+
+    //! DO Start it
+    m_notifier->publishStatus(PlaybackStatus::Running);
+
+    //! CHECK It's active only once the main thread gets the status
+    EXPECT_FALSE(m_notifier->isActive());
+    flush();
+    EXPECT_TRUE(m_notifier->isActive());
+
+    //! DO The playback reaches the end and is paused by the clock
+    m_notifier->publishPositionMsecs(1000);
+    m_notifier->publishStatus(PlaybackStatus::Paused);
+
+    //! CHECK It's not active after the last status is delivered
+    std::vector<std::string> expected = { "position 1000", "status 1" };
+    EXPECT_EQ(flush(), expected);
+    EXPECT_FALSE(m_notifier->isActive());
+}
@@ -21,8 +21,11 @@
  */
 #include "allocator.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <shared_mutex>
 #include <sstream>
 
 #include "stringutils.h"
@@ -32,6 +35,11 @@ using namespace mu;
 
 int ObjectAllocator::used = 0;
 size_t ObjectAllocator::DEFAULT_BLOCK_SIZE(1024 * 256); // 256 kB
+size_t ObjectArena::BLOCK_SIZE(1024 * 1024); // 1 MB
+
+static constexpr size_t ARENA_BATCH_SIZE = 32; // chunks moved between the arena and the cache of a thread at once
+
+static std::atomic<size_t> s_allocatorsCount = 0;
 
 static inline size_t align(size_t n)
 {
@@ -42,7 +50,7 @@ static inline size_t align(size_t n)
 // ObjectAllocator
 // ============================================
 ObjectAllocator::ObjectAllocator(const char* module, const char* name, destroyer_t dtor)
-    : m_module(module), m_name(name), m_dtor(dtor)
+    : m_module(module), m_name(name), m_index(s_allocatorsCount++), m_dtor(dtor)
 {
     AllocatorsRegister::instance()->reg(this);
 }
@@ -62,10 +70,21 @@ const char* ObjectAllocator::name() const
     return m_name;
 }
 
+size_t ObjectAllocator::index() const
+{
+    return m_index;
+}
+
 void* ObjectAllocator::alloc(size_t size)
 {
+    if (ObjectArena* arena = ObjectArena::current()) {
+        return arena->alloc(*this, size);
+    }
+
     size = align(size);
 
+    const std::lock_guard lock(m_mutex);
+
     if (!m_chunkSize) {
         m_chunkSize = size;
     }
@@ -74,7 +93,9 @@ void* ObjectAllocator::alloc(size_t size)
 
     if (!m_free) {
         Block b = allocateBlock(m_chunkSize);
-        m_blocks.push_back(b);
+        m_blocks.insert(std::upper_bound(m_blocks.begin(), m_blocks.end(), b.begin, [](const Chunk* begin, const Block& block) {
+            return begin < block.begin;
+        }), b);
         m_free = b.begin;
     }
 
@@ -98,21 +119,54 @@ void ObjectAllocator::free(void* chunk, size_t size)
 #ifdef NDEBUG
     UNUSED(size);
 #endif
-    assert(m_chunkSize == size);
+    if (ObjectArena::freeCurrent(*this, chunk, size)) {
+        return;
+    }
+
+    {
+        const std::lock_guard lock(m_mutex);
+
+        if (ownsChunk(chunk)) {
+            assert(m_chunkSize == size);
+
+            // The freed chunk's next pointer points to the
+            // current allocation pointer:
+            reinterpret_cast<Chunk*>(chunk)->next = m_free;
+
+            // And the allocation pointer is now set
+            // to the returned (free) chunk:
+            m_free = reinterpret_cast<Chunk*>(chunk);
+
+            m_statistic.totalFreeCount++;
+            return;
+        }
+    }
 
-    // The freed chunk's next pointer points to the
-    // current allocation pointer:
-    reinterpret_cast<Chunk*>(chunk)->next = m_free;
+    //! NOTE The chunk of an arena that isn't current
+    bool freed = ObjectArena::freeOwned(*this, chunk, size);
+    assert(freed);
+    UNUSED(freed);
+}
 
-    // And the allocation pointer is now set
-    // to the returned (free) chunk:
-    m_free = reinterpret_cast<Chunk*>(chunk);
+bool ObjectAllocator::ownsChunk(const void* ptr) const
+{
+    const Chunk* chunk = reinterpret_cast<const Chunk*>(ptr);
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), chunk, [](const Chunk* c, const Block& block) {
+        return c < block.begin;
+    });
 
-    m_statistic.totalFreeCount++;
+    if (it == m_blocks.begin()) {
+        return false;
+    }
+
+    --it;
+    return reinterpret_cast<const uint8_t*>(chunk) < reinterpret_cast<const uint8_t*>(it->begin) + it->chunkCount * it->chunkSize;
 }
 
 void ObjectAllocator::cleanup()
 {
+    const std::lock_guard lock(m_mutex);
+
     if (m_blocks.empty()) {
         return;
     }
@@ -187,6 +241,8 @@ void* ObjectAllocator::not_supported(const char* info)
 
 ObjectAllocator::Info ObjectAllocator::stateInfo() const
 {
+    const std::lock_guard lock(m_mutex);
+
     Info info;
     info.module = m_module;
     info.name = m_name;
@@ -208,21 +264,518 @@ ObjectAllocator::Info ObjectAllocator::stateInfo() const
     return info;
 }
 
+// ============================================
+// ObjectArena
+// ============================================
+
+//! NOTE The blocks of all the arenas, to find the owner of a chunk on free.
+//! The blocks of a destroyed arena with the objects still alive stay here without the arena,
+//! they count their used chunks and are released by the free of the last one
+struct ArenaBlock
+{
+    uintptr_t end = 0;
+    ObjectArena* arena = nullptr;
+    size_t orphanedChunks = 0;
+};
+
+struct ArenaBlocks
+{
+    std::shared_mutex mutex;
+    std::map<uintptr_t, ArenaBlock> blocks; // by begin
+    std::atomic<size_t> blocksCount = 0;
+    size_t orphanedBytes = 0;
+};
+
+static ArenaBlocks& arenaBlocks()
+{
+    static ArenaBlocks b;
+    return b;
+}
+
+static std::map<uintptr_t, ArenaBlock>::iterator findArenaBlock(ArenaBlocks& registry, uintptr_t address)
+{
+    auto it = registry.blocks.upper_bound(address);
+    if (it == registry.blocks.begin()) {
+        return registry.blocks.end();
+    }
+
+    --it;
+    return address < it->second.end ? it : registry.blocks.end();
+}
+
+static thread_local ObjectArena::Scope* s_currentScope = nullptr;
+
+ObjectArena::ObjectArena(const std::string& name)
+    : m_name(name)
+{
+    AllocatorsRegister::instance()->reg(this);
+}
+
+//! NOTE The blocks without the used chunks are released, the others are left to the objects still alive
+ObjectArena::~ObjectArena()
+{
+    AllocatorsRegister::instance()->unreg(this);
+
+    std::vector<Block> blocks = m_blocks;
+    std::sort(blocks.begin(), blocks.end(), [](const Block& b1, const Block& b2) {
+        return b1.begin < b2.begin;
+    });
+
+    std::vector<size_t> freeChunks(blocks.size(), 0);
+    for (const Pool& p : m_pools) {
+        for (const Chunk* chunk = p.free; chunk; chunk = chunk->next) {
+            auto it = std::upper_bound(blocks.begin(), blocks.end(), reinterpret_cast<const uint8_t*>(chunk),
+                                       [](const uint8_t* address, const Block& b) {
+                return address < b.begin;
+            });
+
+            assert(it != blocks.begin());
+            ++freeChunks[std::distance(blocks.begin(), it) - 1];
+        }
+    }
+
+    ArenaBlocks& registry = arenaBlocks();
+    const std::unique_lock lock(registry.mutex);
+
+    size_t keptBlocks = 0;
+    uint64_t keptChunks = 0;
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const Block& b = blocks[i];
+        auto it = registry.blocks.find(reinterpret_cast<uintptr_t>(b.begin));
+        assert(it != registry.blocks.end());
+
+        size_t usedChunks = b.chunkCount - freeChunks[i];
+        if (usedChunks == 0) {
+            registry.blocks.erase(it);
+            registry.blocksCount--;
+            std::free(b.begin);
+            continue;
+        }
+
+        it->second.arena = nullptr;
+        it->second.orphanedChunks = usedChunks;
+        registry.orphanedBytes += b.size;
+
+        ++keptBlocks;
+        keptChunks += usedChunks;
+    }
+
+    if (keptBlocks > 0) {
+        LOGW() << "arena " << m_name << ": " << keptChunks << " objects are still alive, "
+               << keptBlocks << " of " << blocks.size() << " blocks are kept for them";
+    }
+}
+
+const std::string& ObjectArena::name() const
+{
+    return m_name;
+}
+
+ObjectArena* ObjectArena::current()
+{
+    return s_currentScope ? s_currentScope->m_arena : nullptr;
+}
+
+ObjectArena* ObjectArena::owner(const void* ptr)
+{
+    ArenaBlocks& registry = arenaBlocks();
+    if (registry.blocksCount == 0) {
+        return nullptr;
+    }
+
+    const std::shared_lock lock(registry.mutex);
+    auto it = findArenaBlock(registry, reinterpret_cast<uintptr_t>(ptr));
+
+    return it != registry.blocks.end() ? it->second.arena : nullptr;
+}
+
+bool ObjectArena::freeCurrent(const ObjectAllocator& allocator, void* ptr, size_t size)
+{
+    Scope* scope = s_currentScope;
+    if (!scope || !scope->m_arena || !scope->owns(ptr)) {
+        return false;
+    }
+
+    scope->m_arena->free(allocator, ptr, size);
+    return true;
+}
+
+bool ObjectArena::freeOwned(const ObjectAllocator& allocator, void* ptr, size_t size)
+{
+    ArenaBlocks& registry = arenaBlocks();
+    if (registry.blocksCount == 0) {
+        return false;
+    }
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+
+    ObjectArena* arena = nullptr;
+    {
+        const std::shared_lock lock(registry.mutex);
+        auto it = findArenaBlock(registry, address);
+        if (it == registry.blocks.end()) {
+            return false;
+        }
+
+        arena = it->second.arena;
+    }
+
+    if (arena) {
+        arena->free(allocator, ptr, size);
+        return true;
+    }
+
+    //! NOTE The arena is destroyed, the block is released with its last chunk
+    const std::unique_lock lock(registry.mutex);
+    auto it = findArenaBlock(registry, address);
+    assert(it != registry.blocks.end() && it->second.orphanedChunks > 0);
+
+    if (--it->second.orphanedChunks == 0) {
+        registry.orphanedBytes -= it->second.end - it->first;
+        std::free(reinterpret_cast<void*>(it->first));
+        registry.blocks.erase(it);
+        registry.blocksCount--;
+    }
+
+    return true;
+}
+
+size_t ObjectArena::orphanedBytes()
+{
+    ArenaBlocks& registry = arenaBlocks();
+    const std::shared_lock lock(registry.mutex);
+
+    return registry.orphanedBytes;
+}
+
+void* ObjectArena::alloc(const ObjectAllocator& allocator, size_t size)
+{
+    size = align(size);
+
+    Scope* scope = s_currentScope;
+    if (scope && scope->m_arena == this) {
+        Scope::Cache& cache = scope->cache(allocator.index());
+        if (!cache.free) {
+            refill(cache, allocator, size);
+        }
+
+        Chunk* chunk = cache.free;
+        cache.free = chunk->next;
+        cache.count--;
+        cache.allocatedCount++;
+
+        return chunk;
+    }
+
+    const std::lock_guard lock(m_mutex);
+
+    Pool& p = pool(allocator, size);
+    Chunk* chunk = take(p, 1);
+    p.totalAllocatedCount++;
+
+    return chunk;
+}
+
+void ObjectArena::free(const ObjectAllocator& allocator, void* ptr, size_t size)
+{
+#ifdef NDEBUG
+    UNUSED(size);
+#endif
+
+    Chunk* chunk = reinterpret_cast<Chunk*>(ptr);
+
+    Scope* scope = s_currentScope;
+    if (scope && scope->m_arena == this) {
+        Scope::Cache& cache = scope->cache(allocator.index());
+        chunk->next = cache.free;
+        cache.free = chunk;
+        cache.count++;
+        cache.freeCount++;
+
+        if (cache.count >= 2 * ARENA_BATCH_SIZE) {
+            flush(cache, allocator.index(), ARENA_BATCH_SIZE);
+        }
+
+        return;
+    }
+
+    const std::lock_guard lock(m_mutex);
+
+    Pool& p = m_pools.at(allocator.index());
+    assert(p.chunkSize == align(size));
+
+    chunk->next = p.free;
+    p.free = chunk;
+    p.totalFreeCount++;
+}
+
+ObjectArena::Pool& ObjectArena::pool(const ObjectAllocator& allocator, size_t size)
+{
+    if (m_pools.size() <= allocator.index()) {
+        m_pools.resize(allocator.index() + 1);
+    }
+
+    Pool& p = m_pools[allocator.index()];
+    if (!p.allocator) {
+        p.allocator = &allocator;
+        p.chunkSize = size;
+    }
+
+    assert(p.chunkSize == size);
+
+    return p;
+}
+
+//! NOTE Takes the free chunks of the pool first, then carves the new ones from the current block
+ObjectArena::Chunk* ObjectArena::take(Pool& pool, size_t count)
+{
+    Chunk* result = nullptr;
+
+    for (size_t i = 0; i < count; ++i) {
+        Chunk* chunk = pool.free;
+        if (chunk) {
+            pool.free = chunk->next;
+        } else {
+            chunk = reinterpret_cast<Chunk*>(carve(pool.chunkSize));
+            pool.totalChunks++;
+        }
+
+        chunk->next = result;
+        result = chunk;
+    }
+
+    return result;
+}
+
+void* ObjectArena::carve(size_t size)
+{
+    if (m_blockPos + size > m_blockEnd) {
+        size_t blockSize = std::max(BLOCK_SIZE, size);
+        uint8_t* block = reinterpret_cast<uint8_t*>(malloc(blockSize));
+
+        m_blocks.push_back({ block, blockSize, 0 });
+        m_blocksCount.store(m_blocks.size(), std::memory_order_release);
+        m_blockPos = block;
+        m_blockEnd = block + blockSize;
+
+        ArenaBlocks& registry = arenaBlocks();
+        const std::unique_lock lock(registry.mutex);
+        registry.blocks[reinterpret_cast<uintptr_t>(block)] = { reinterpret_cast<uintptr_t>(m_blockEnd), this, 0 };
+        registry.blocksCount++;
+    }
+
+    void* result = m_blockPos;
+    m_blockPos += size;
+    m_blocks.back().chunkCount++;
+
+    return result;
+}
+
+void ObjectArena::refill(Scope::Cache& cache, const ObjectAllocator& allocator, size_t size)
+{
+    const std::lock_guard lock(m_mutex);
+
+    Pool& p = pool(allocator, size);
+    cache.free = take(p, ARENA_BATCH_SIZE);
+    cache.count = ARENA_BATCH_SIZE;
+}
+
+void ObjectArena::flush(Scope::Cache& cache, size_t index, size_t count)
+{
+    const std::lock_guard lock(m_mutex);
+
+    Pool& p = m_pools.at(index);
+
+    for (size_t i = 0; i < count && cache.free; ++i) {
+        Chunk* chunk = cache.free;
+        cache.free = chunk->next;
+        cache.count--;
+
+        chunk->next = p.free;
+        p.free = chunk;
+    }
+
+    p.totalAllocatedCount += cache.allocatedCount;
+    p.totalFreeCount += cache.freeCount;
+    cache.allocatedCount = 0;
+    cache.freeCount = 0;
+}
+
+std::vector<std::pair<uintptr_t, uintptr_t> > ObjectArena::blockRanges() const
+{
+    const std::lock_guard lock(m_mutex);
+
+    std::vector<std::pair<uintptr_t, uintptr_t> > result;
+    result.reserve(m_blocks.size());
+    for (const Block& b : m_blocks) {
+        result.emplace_back(reinterpret_cast<uintptr_t>(b.begin), reinterpret_cast<uintptr_t>(b.begin + b.size));
+    }
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+std::vector<ObjectAllocator::Info> ObjectArena::stateInfo() const
+{
+    const std::lock_guard lock(m_mutex);
+
+    std::vector<ObjectAllocator::Info> result;
+
+    for (const Pool& p : m_pools) {
+        if (!p.allocator) {
+            continue;
+        }
+
+        ObjectAllocator::Info info;
+        info.module = p.allocator->module();
+        info.name = p.allocator->name();
+        info.chunkSize = p.chunkSize;
+        info.totalChunks = p.totalChunks;
+        info.totalAllocatedCount = p.totalAllocatedCount;
+        info.totalFreeCount = p.totalFreeCount;
+        info.freeChunks = p.totalChunks - (p.totalAllocatedCount - p.totalFreeCount);
+
+        result.push_back(std::move(info));
+    }
+
+    return result;
+}
+
+size_t ObjectArena::allocatedBytes() const
+{
+    const std::lock_guard lock(m_mutex);
+
+    size_t result = 0;
+    for (const Block& block : m_blocks) {
+        result += block.size;
+    }
+
+    return result;
+}
+
+uint64_t ObjectArena::usedChunks() const
+{
+    const std::lock_guard lock(m_mutex);
+
+    uint64_t result = 0;
+    for (const Pool& p : m_pools) {
+        result += p.totalAllocatedCount - p.totalFreeCount;
+    }
+
+    return result;
+}
+
+// ============================================
+// ObjectArena::Scope
+// ============================================
+ObjectArena::Scope::Scope(ObjectArena* arena)
+    : m_arena(arena), m_previous(s_currentScope)
+{
+    s_currentScope = this;
+}
+
+//! NOTE The cached chunks and the statistic go back to the arena
+ObjectArena::Scope::~Scope()
+{
+    if (s_currentScope == this) {
+        s_currentScope = m_previous;
+    } else {
+        //! NOTE A scope created after this one is still alive, it is linked to the previous one now
+        for (Scope* scope = s_currentScope; scope; scope = scope->m_previous) {
+            if (scope->m_previous == this) {
+                scope->m_previous = m_previous;
+                break;
+            }
+        }
+    }
+
+    if (!m_arena) {
+        return;
+    }
+
+    for (size_t index = 0; index < m_caches.size(); ++index) {
+        Cache& cache = m_caches[index];
+        if (cache.count > 0 || cache.allocatedCount > 0 || cache.freeCount > 0) {
+            m_arena->flush(cache, index, cache.count);
+        }
+    }
+}
+
+ObjectArena* ObjectArena::Scope::arena() const
+{
+    return m_arena;
+}
+
+//! NOTE The blocks are only added while the arena lives, the copy is taken again when their count changes
+bool ObjectArena::Scope::owns(const void* ptr)
+{
+    if (m_blocks.size() != m_arena->m_blocksCount.load(std::memory_order_acquire)) {
+        m_blocks = m_arena->blockRanges();
+    }
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), address, [](uintptr_t a, const std::pair<uintptr_t, uintptr_t>& block) {
+        return a < block.first;
+    });
+
+    return it != m_blocks.begin() && address < std::prev(it)->second;
+}
+
+ObjectArena::Scope::Cache& ObjectArena::Scope::cache(size_t index)
+{
+    if (m_caches.size() <= index) {
+        m_caches.resize(s_allocatorsCount);
+    }
+
+    return m_caches[index];
+}
+
 // ============================================
 // AllocatorsRegister
 // ============================================
 void AllocatorsRegister::reg(ObjectAllocator* a)
 {
+    const std::lock_guard lock(m_mutex);
     m_allocators.push_back(a);
 }
 
 void AllocatorsRegister::unreg(ObjectAllocator* a)
 {
+    const std::lock_guard lock(m_mutex);
     m_allocators.remove(a);
 }
 
+void AllocatorsRegister::reg(ObjectArena* a)
+{
+    const std::lock_guard lock(m_mutex);
+    m_arenas.push_back(a);
+}
+
+void AllocatorsRegister::unreg(ObjectArena* a)
+{
+    const std::lock_guard lock(m_mutex);
+    m_arenas.remove(a);
+}
+
+std::vector<ObjectAllocator::Info> AllocatorsRegister::arenaStateInfo(const std::string& arenaName) const
+{
+    const std::lock_guard lock(m_mutex);
+
+    for (const ObjectArena* a : m_arenas) {
+        if (a->name() == arenaName) {
+            return a->stateInfo();
+        }
+    }
+
+    return {};
+}
+
 void AllocatorsRegister::cleanupAll(const std::string& module)
 {
+    const std::lock_guard lock(m_mutex);
+
     for (ObjectAllocator* a : m_allocators) {
         if (a->module() == module) {
             a->cleanup();
@@ -234,20 +787,14 @@ void AllocatorsRegister::cleanupAll(const std::string& module)
 #define TITLE(str) FORMAT(std::string(str), 20)
 #define VALUE(val) FORMAT(std::to_string(val), 20)
 
-void AllocatorsRegister::printStatistic(const std::string& title)
+static void printStatisticTable(std::stringstream& stream, const std::vector<ObjectAllocator::Info>& infos)
 {
-    std::stringstream stream;
-    stream << "\n\n";
-    stream << title << "\n";
-    stream << "allocators: " << m_allocators.size() << '\n';
     stream << TITLE("Object") << TITLE("Total alloc") << TITLE("Total free") << TITLE("Used (leak?)") << TITLE("Object size") << "\n";
 
-    uint64_t totalBytes = 0;
     uint64_t totalAllocatedCount = 0;
     uint64_t totalFreeCount = 0;
     uint64_t totalUsedCount = 0;
-    for (ObjectAllocator* a : m_allocators) {
-        ObjectAllocator::Info info = a->stateInfo();
+    for (const ObjectAllocator::Info& info : infos) {
         stream << FORMAT(info.name, 20)
                << VALUE(info.totalAllocatedCount)
                << VALUE(info.totalFreeCount)
@@ -258,18 +805,48 @@ void AllocatorsRegister::printStatistic(const std::string& title)
         totalAllocatedCount += info.totalAllocatedCount;
         totalFreeCount += info.totalFreeCount;
         totalUsedCount += info.usedChunks();
-        totalBytes += info.allocatedBytes();
     }
 
     stream << "--------------------------------------------------------------------------------------------\n";
     stream << FORMAT("Total", 20) << VALUE(totalAllocatedCount) << VALUE(totalFreeCount) << VALUE(totalUsedCount) << "\n";
+}
+
+void AllocatorsRegister::printStatistic(const std::string& title)
+{
+    const std::lock_guard lock(m_mutex);
+
+    std::stringstream stream;
+    stream << "\n\n";
+    stream << title << "\n";
+    stream << "allocators: " << m_allocators.size() << '\n';
+
+    std::vector<ObjectAllocator::Info> infos;
+    uint64_t totalBytes = 0;
+    for (ObjectAllocator* a : m_allocators) {
+        infos.push_back(a->stateInfo());
+        totalBytes += infos.back().allocatedBytes();
+    }
+
+    printStatisticTable(stream, infos);
     stream << "Total allocated: " << totalBytes << " bytes\n";
 
+    for (const ObjectArena* a : m_arenas) {
+        stream << "\narena: " << a->name() << '\n';
+        printStatisticTable(stream, a->stateInfo());
+        stream << "Total allocated: " << a->allocatedBytes() << " bytes\n";
+    }
+
+    if (size_t orphanedBytes = ObjectArena::orphanedBytes()) {
+        stream << "\nkept for the objects of the destroyed arenas: " << orphanedBytes << " bytes\n";
+    }
+
     LOGD() << stream.str() << '\n';
 }
 
 void AllocatorsRegister::printState(const std::string& title)
 {
+    const std::lock_guard lock(m_mutex);
+
     std::stringstream stream;
     stream << "\n\n";
     stream << title << "\n";
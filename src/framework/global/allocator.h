@@ -22,9 +22,11 @@
 #ifndef MU_GLOBAL_ALLOCATOR_H
 #define MU_GLOBAL_ALLOCATOR_H
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <string>
 
 namespace mu {
@@ -73,6 +75,9 @@ public:
     const char* module() const;
     const char* name() const;
 
+    //! NOTE The number of the allocator, the arenas keep the pools of the classes by it
+    size_t index() const;
+
     void* alloc(size_t size);
     void free(void* ptr, size_t size);
     void cleanup();
@@ -134,13 +139,16 @@ private:
     };
 
     Block allocateBlock(size_t chunkSize) const;
+    bool ownsChunk(const void* ptr) const;
 
     const char* m_module = nullptr;
     const char* m_name = nullptr;
+    size_t m_index = 0;
+    mutable std::mutex m_mutex;
     size_t m_chunkSize = 0;
     destroyer_t m_dtor = nullptr;
     Chunk* m_free = nullptr;
-    std::vector<Block> m_blocks;
+    std::vector<Block> m_blocks; // by address
 
     struct Statistic
     {
@@ -151,6 +159,123 @@ private:
     Statistic m_statistic;
 };
 
+//! NOTE The memory of the objects owned by one document (e.g. a score).
+//! While an arena is current for the thread (see Scope), the OBJECT_ALLOCATOR classes allocate from it
+//! instead of their global free lists; out of the scopes they allocate as before.
+//! The chunks are carved from the big blocks shared by all the classes,
+//! the blocks are released at once when the arena is destroyed, except the ones of the objects still alive:
+//! such a block is released when the last of its objects is deleted.
+//! The objects might be deleted on any thread. The free of a chunk of the current arena
+//! takes no lock, the global allocator checks its own blocks under its own lock,
+//! only the chunks of the other arenas are looked up in the register of all the arena blocks.
+//! Like the allocators, the arenas work only if the custom allocator is built (BUILD_ALLOCATOR,
+//! off by default, see ObjectAllocator::enabled())
+class ObjectArena
+{
+    struct Chunk {
+        Chunk* next = nullptr;
+    };
+
+public:
+    explicit ObjectArena(const std::string& name);
+    ~ObjectArena();
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    static size_t BLOCK_SIZE;
+
+    //! NOTE Makes the arena current for the calling thread until the end of the scope.
+    //! The scope keeps a cache of the free chunks, so the threads (e.g. the tasks of a parallel layout)
+    //! don't lock the arena on every allocation. The nullptr arena means the global allocators.
+    //! The scopes may be held across the calls (e.g. from the start to the end of a command),
+    //! so a scope may be destroyed before the ones created after it on the same thread
+    class Scope
+    {
+    public:
+        explicit Scope(ObjectArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ObjectArena* arena() const;
+
+    private:
+        friend class ObjectArena;
+
+        bool owns(const void* ptr);
+
+        struct Cache {
+            Chunk* free = nullptr;
+            size_t count = 0;
+            uint64_t allocatedCount = 0;
+            uint64_t freeCount = 0;
+        };
+
+        Cache& cache(size_t index);
+
+        ObjectArena* m_arena = nullptr;
+        Scope* m_previous = nullptr;
+        std::vector<Cache> m_caches;
+        std::vector<std::pair<uintptr_t, uintptr_t> > m_blocks; // the copy of the blocks of the arena, by address
+    };
+
+    static ObjectArena* current();
+
+    //! NOTE The arena of the chunk, nullptr if the chunk is not in an arena or its arena is destroyed
+    static ObjectArena* owner(const void* ptr);
+
+    //! NOTE Frees the chunk if it was allocated in the current arena, without any lock, returns false otherwise
+    static bool freeCurrent(const ObjectAllocator& allocator, void* ptr, size_t size);
+
+    //! NOTE Frees the chunk if it was allocated in an arena, returns false otherwise
+    static bool freeOwned(const ObjectAllocator& allocator, void* ptr, size_t size);
+
+    //! NOTE The memory of the destroyed arenas kept for their objects still alive
+    static size_t orphanedBytes();
+
+    const std::string& name() const;
+
+    void* alloc(const ObjectAllocator& allocator, size_t size);
+    void free(const ObjectAllocator& allocator, void* ptr, size_t size);
+
+    std::vector<ObjectAllocator::Info> stateInfo() const;
+    size_t allocatedBytes() const;
+    uint64_t usedChunks() const;
+
+private:
+    struct Pool {
+        const ObjectAllocator* allocator = nullptr;
+        size_t chunkSize = 0;
+        Chunk* free = nullptr;
+        size_t totalChunks = 0;
+        uint64_t totalAllocatedCount = 0;
+        uint64_t totalFreeCount = 0;
+    };
+
+    Pool& pool(const ObjectAllocator& allocator, size_t size);
+    Chunk* take(Pool& pool, size_t count);
+    void* carve(size_t size);
+    void refill(Scope::Cache& cache, const ObjectAllocator& allocator, size_t size);
+    void flush(Scope::Cache& cache, size_t index, size_t count);
+    std::vector<std::pair<uintptr_t, uintptr_t> > blockRanges() const;
+
+    std::string m_name;
+    mutable std::mutex m_mutex;
+    std::vector<Pool> m_pools; // by ObjectAllocator::index()
+    struct Block {
+        uint8_t* begin = nullptr;
+        size_t size = 0;
+        size_t chunkCount = 0;
+    };
+
+    std::vector<Block> m_blocks;
+    std::atomic<size_t> m_blocksCount = 0;
+    uint8_t* m_blockPos = nullptr;
+    uint8_t* m_blockEnd = nullptr;
+};
+
 class AllocatorsRegister
 {
 public:
@@ -164,13 +289,21 @@ public:
     void reg(ObjectAllocator* a);
     void unreg(ObjectAllocator* a);
 
+    void reg(ObjectArena* a);
+    void unreg(ObjectArena* a);
+
+    std::vector<ObjectAllocator::Info> arenaStateInfo(const std::string& arenaName) const;
+
     void cleanupAll(const std::string& module);
 
+    //! NOTE Prints the global allocators and every arena (per score)
     void printStatistic(const std::string& title);
     void printState(const std::string& title);
 
 private:
+    mutable std::mutex m_mutex;
     std::list<ObjectAllocator*> m_allocators;
+    std::list<ObjectArena*> m_arenas;
 };
 }
 
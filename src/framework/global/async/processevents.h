@@ -33,6 +33,12 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     deto::async::onMainThreadInvoke(f);
 }
+
+//! NOTE Called after a call is queued for the thread, e.g. to wake the thread up
+inline void onInvoke(const std::thread::id& th, const std::function<void()>& f)
+{
+    deto::async::onInvoke(th, f);
+}
 }
 
 #endif // MU_ASYNC_PROCESSEVENTS_H
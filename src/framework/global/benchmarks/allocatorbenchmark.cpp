@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocator.h"
+
+using namespace mu;
+
+//! NOTE The free of the chunks of an OBJECT_ALLOCATOR class: of the global allocator,
+//! of the global allocator while an arena exists, of the current arena and of an arena that isn't current;
+//! and the lookup of the arena of a chunk on one thread and on several threads at once
+//! (the register of the arena blocks is behind a shared lock).
+//! Reports ms per round of the chunks
+//! Usage: global_allocator_benchmark [chunks] [rounds]
+
+static constexpr size_t CHUNK_SIZE = 64;
+static constexpr size_t THREADS = 4;
+
+static double measure(int rounds, const std::function<void()>& func)
+{
+    //! NOTE Warm-up, allocates the blocks
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        func();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::milli>(duration).count() / rounds;
+}
+
+int main(int argc, char** argv)
+{
+    size_t chunksCount = argc > 1 ? std::stoul(argv[1]) : 1000;
+    int rounds = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    ObjectAllocator allocator("benchmarks", "Chunk", [](void*) {});
+
+    std::vector<void*> chunks(chunksCount, nullptr);
+
+    auto alloc = [&allocator, &chunks]() {
+        for (void*& chunk : chunks) {
+            chunk = allocator.alloc(CHUNK_SIZE);
+        }
+    };
+
+    auto free = [&allocator, &chunks]() {
+        for (void* chunk : chunks) {
+            allocator.free(chunk, CHUNK_SIZE);
+        }
+    };
+
+    double globalMs = measure(rounds, [&]() {
+        alloc();
+        free();
+    });
+
+    //! NOTE The chunks of the arena stay alive, so its blocks are in the register
+    ObjectArena arena("benchmarks");
+    std::vector<void*> arenaChunks;
+    {
+        ObjectArena::Scope scope(&arena);
+        for (size_t i = 0; i < chunksCount; ++i) {
+            arenaChunks.push_back(allocator.alloc(CHUNK_SIZE));
+        }
+    }
+
+    double globalWithArenaMs = measure(rounds, [&]() {
+        alloc();
+        free();
+    });
+
+    double currentArenaMs = measure(rounds, [&]() {
+        ObjectArena::Scope scope(&arena);
+        alloc();
+        free();
+    });
+
+    double otherArenaMs = measure(rounds, [&]() {
+        {
+            ObjectArena::Scope scope(&arena);
+            alloc();
+        }
+        free();
+    });
+
+    std::atomic<bool> ok = true;
+
+    auto lookup = [&arenaChunks, &arena, &ok]() {
+        bool found = true;
+        for (const void* chunk : arenaChunks) {
+            found = ObjectArena::owner(chunk) == &arena && found;
+        }
+        if (!found) {
+            ok = false;
+        }
+    };
+
+    double owner1Ms = measure(rounds, lookup);
+
+    //! NOTE Every thread does the same lookups as the single one, without the contention the time is the same
+    double owner4Ms = measure(rounds, [&lookup]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back(lookup);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    });
+
+    for (void* chunk : arenaChunks) {
+        allocator.free(chunk, CHUNK_SIZE);
+    }
+
+    std::printf("chunks: %zu, rounds: %d\n", chunksCount, rounds);
+    std::printf("%-24s %11.4f ms per round\n", "global", globalMs);
+    std::printf("%-24s %11.4f ms per round\n", "global_with_arena", globalWithArenaMs);
+    std::printf("%-24s %11.4f ms per round\n", "current_arena", currentArenaMs);
+    std::printf("%-24s %11.4f ms per round\n", "other_arena", otherArenaMs);
+    std::printf("%-24s %11.4f ms per round\n", "owner_1_thread", owner1Ms);
+    std::printf("%-24s %11.4f ms per round\n", "owner_4_threads", owner4Ms);
+
+    if (!ok || arena.usedChunks() != 0) {
+        std::printf("the chunks of the arena are lost\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "io/buffer.h"
+#include "serialization/xmldom.h"
+#include "serialization/xmlstreamreader.h"
+#include "serialization/xmlstreamwriter.h"
+#include "types/bytearray.h"
+
+using namespace mu;
+
+//! NOTE The files, e.g. the vtest scores, tokenized by XmlStreamReader,
+//! compared with parsing them into XmlDomDocument (tinyxml2), which XmlStreamReader was built on before,
+//! and the same documents written back by XmlStreamWriter, the writes of a document must be identical.
+//! Reports ms per round over all the files
+//! Usage: global_xml_benchmark <rounds> <file.mscx>...
+
+static double measure(int rounds, const std::function<void()>& func)
+{
+    //! NOTE Warm-up
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        func();
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::milli>(duration).count() / rounds;
+}
+
+//! NOTE The elements of a document read in advance, so that only the writer is measured.
+//! The elements with a text or without children are written in one go, as the engraving writes them;
+//! the texts mixed with the child elements aren't written, XmlStreamWriter has no API for them
+struct XmlEvent
+{
+    enum class Type {
+        StartElement,
+        EndElement,
+        Element
+    };
+
+    Type type = Type::Element;
+    AsciiStringView name;
+    XmlStreamWriter::Attributes attributes;
+    String text;
+};
+
+using XmlEvents = std::vector<XmlEvent>;
+
+//! NOTE The names refer to the pool, the deque doesn't move its strings when it grows
+static XmlEvents readEvents(const ByteArray& data, std::deque<std::string>& names)
+{
+    XmlEvents events;
+    XmlEvent pending;
+    bool hasPending = false;
+
+    auto flushPending = [&events, &pending, &hasPending]() {
+        if (hasPending) {
+            pending.type = XmlEvent::Type::StartElement;
+            events.push_back(pending);
+            hasPending = false;
+        }
+    };
+
+    XmlStreamReader xml(data);
+    while (xml.readNext() != XmlStreamReader::Invalid && !xml.atEnd()) {
+        if (xml.isStartElement()) {
+            flushPending();
+
+            names.emplace_back(xml.name().ascii(), xml.name().size());
+            pending = XmlEvent();
+            pending.name = AsciiStringView(names.back());
+
+            for (const XmlStreamReader::Attribute& attribute : xml.attributes()) {
+                names.emplace_back(attribute.name.ascii(), attribute.name.size());
+                pending.attributes.emplace_back(AsciiStringView(names.back()), attribute.value);
+            }
+
+            hasPending = true;
+        } else if (xml.isCharacters()) {
+            if (hasPending) {
+                pending.text = xml.text();
+            }
+        } else if (xml.isEndElement()) {
+            if (hasPending) {
+                events.push_back(pending);
+                hasPending = false;
+            } else {
+                XmlEvent event;
+                event.type = XmlEvent::Type::EndElement;
+                events.push_back(event);
+            }
+        }
+    }
+
+    return events;
+}
+
+static ByteArray writeEvents(const XmlEvents& events)
+{
+    io::Buffer buffer;
+    buffer.open(io::IODevice::WriteOnly);
+
+    XmlStreamWriter xml(&buffer);
+    xml.startDocument();
+
+    for (const XmlEvent& event : events) {
+        switch (event.type) {
+        case XmlEvent::Type::StartElement:
+            xml.startElement(event.name, event.attributes);
+            break;
+        case XmlEvent::Type::EndElement:
+            xml.endElement();
+            break;
+        case XmlEvent::Type::Element:
+            if (event.text.isEmpty()) {
+                xml.element(event.name, event.attributes);
+            } else {
+                xml.element(event.name, event.attributes, event.text);
+            }
+            break;
+        }
+    }
+
+    xml.flush();
+
+    return buffer.data();
+}
+
+static bool readFile(const char* path, ByteArray& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    data = ByteArray(content.data(), content.size());
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::printf("Usage: global_xml_benchmark <rounds> <file.mscx>...\n");
+        return 1;
+    }
+
+    int rounds = std::stoi(argv[1]);
+
+    std::vector<ByteArray> datas;
+    size_t totalSize = 0;
+    for (int i = 2; i < argc; ++i) {
+        ByteArray data;
+        if (!readFile(argv[i], data)) {
+            std::printf("failed to read %s\n", argv[i]);
+            return 1;
+        }
+        totalSize += data.size();
+        datas.push_back(data);
+    }
+
+    bool ok = true;
+
+    double streamMs = measure(rounds, [&datas, &ok]() {
+        for (const ByteArray& data : datas) {
+            XmlStreamReader xml(data);
+            while (xml.readNext() != XmlStreamReader::Invalid && !xml.atEnd()) {
+                if (xml.isStartElement()) {
+                    xml.attributes();
+                }
+            }
+            ok = ok && !xml.isError();
+        }
+    });
+
+    double domMs = measure(rounds, [&datas, &ok]() {
+        for (const ByteArray& data : datas) {
+            XmlDomDocument dom;
+            dom.setContent(data);
+            ok = ok && !dom.hasError();
+        }
+    });
+
+    std::deque<std::string> names;
+    std::vector<XmlEvents> documents;
+    for (const ByteArray& data : datas) {
+        documents.push_back(readEvents(data, names));
+    }
+
+    std::vector<ByteArray> written(documents.size());
+    for (size_t i = 0; i < documents.size(); ++i) {
+        written[i] = writeEvents(documents[i]);
+    }
+
+    double writeMs = measure(rounds, [&documents, &written, &ok]() {
+        for (size_t i = 0; i < documents.size(); ++i) {
+            ok = ok && writeEvents(documents[i]) == written[i];
+        }
+    });
+
+    std::printf("files: %zu, size: %zu KB, rounds: %d\n", datas.size(), totalSize / 1024, rounds);
+    std::printf("%-14s %11.4f ms per round\n", "read_stream", streamMs);
+    std::printf("%-14s %11.4f ms per round\n", "read_dom", domMs);
+    std::printf("%-14s %11.4f ms per round\n", "write", writeMs);
+
+    if (!ok) {
+        std::printf("failed to parse the files or the writes differ\n");
+        return 1;
+    }
+
+    return 0;
+}
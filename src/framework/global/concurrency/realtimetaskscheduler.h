@@ -0,0 +1,316 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_GLOBAL_REALTIMETASKSCHEDULER_H
+#define MU_GLOBAL_REALTIMETASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "log.h"
+
+namespace mu {
+//! NOTE Fork/join scheduler for realtime threads (e.g. the audio worker).
+//! Every worker owns a pre-allocated deque of task indices, an idle worker steals tasks from the others.
+//! The calling thread takes part in the processing, so the job completes even if all the workers are asleep.
+//! parallelFor() neither allocates memory nor takes locks.
+class RealtimeTaskScheduler
+{
+public:
+    static RealtimeTaskScheduler* instance()
+    {
+        static RealtimeTaskScheduler s;
+        return &s;
+    }
+
+    explicit RealtimeTaskScheduler(const size_t desiredThreadCount = 0)
+        : m_workersCount(validateWorkersCount(desiredThreadCount)),
+        m_deques(std::make_unique<TaskDeque[]>(m_workersCount + 1)),
+        m_threadPool(std::make_unique<std::thread[]>(m_workersCount))
+    {
+        setupThreads();
+    }
+
+    ~RealtimeTaskScheduler()
+    {
+        terminateThreads();
+    }
+
+    RealtimeTaskScheduler(const RealtimeTaskScheduler&) = delete;
+    RealtimeTaskScheduler& operator=(const RealtimeTaskScheduler&) = delete;
+
+    size_t workersCount() const
+    {
+        return m_workersCount;
+    }
+
+    //! NOTE Calls func(idx) for every idx in [0, count) and returns when all the calls are complete.
+    //! Must not be called from several threads at the same time
+    template<typename FuncT>
+    void parallelFor(const size_t count, const FuncT& func)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        if (count == 1 || m_workersCount == 0) {
+            for (size_t idx = 0; idx < count; ++idx) {
+                func(idx);
+            }
+            return;
+        }
+
+        IF_ASSERT_FAILED(count <= MAX_TASKS_COUNT) {
+            return;
+        }
+
+        m_job.store(&invokeTask<FuncT>, std::memory_order_relaxed);
+        m_jobContext.store(const_cast<void*>(static_cast<const void*>(&func)), std::memory_order_relaxed);
+        m_pendingTasks.store(count, std::memory_order_relaxed);
+
+        const size_t participantsCount = m_workersCount + 1;
+        const size_t tasksPerDeque = count / participantsCount;
+        size_t remainder = count % participantsCount;
+        size_t begin = 0;
+
+        for (size_t i = 0; i < participantsCount; ++i) {
+            size_t end = begin + tasksPerDeque + (remainder > 0 ? 1 : 0);
+            if (remainder > 0) {
+                --remainder;
+            }
+
+            m_deques[i].range.store(packRange(begin, end), std::memory_order_release);
+            begin = end;
+        }
+
+        m_jobEpoch.fetch_add(1);
+
+        if (m_sleepingWorkers.load() > 0) {
+            m_newJobCv.notify_all();
+        }
+
+        //! NOTE The calling thread owns the last deque
+        processTasks(m_workersCount);
+
+        while (m_pendingTasks.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool containsThread(const std::thread::id& id) const
+    {
+        for (size_t i = 0; i < m_workersCount; ++i) {
+            if (m_threadPool[i].get_id() == id) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    using TaskFunc = void (*)(void* context, size_t idx);
+
+    //! NOTE [begin, end) of the task indices packed into one word,
+    //! so the owner (takes from the front) and the thieves (take from the back) synchronize by a single CAS
+    struct alignas(64) TaskDeque {
+        std::atomic<uint64_t> range = 0;
+    };
+
+    static constexpr size_t MAX_TASKS_COUNT = UINT32_MAX;
+    static constexpr int SPIN_ITERATIONS_BEFORE_SLEEP = 2000;
+
+    static uint64_t packRange(uint64_t begin, uint64_t end)
+    {
+        return (begin << 32) | end;
+    }
+
+    static size_t rangeBegin(uint64_t range)
+    {
+        return static_cast<size_t>(range >> 32);
+    }
+
+    static size_t rangeEnd(uint64_t range)
+    {
+        return static_cast<size_t>(range & UINT32_MAX);
+    }
+
+    template<typename FuncT>
+    static void invokeTask(void* context, size_t idx)
+    {
+        (*static_cast<const FuncT*>(context))(idx);
+    }
+
+    static size_t validateWorkersCount(const size_t desiredThreadCount)
+    {
+        if (desiredThreadCount > 0) {
+            return desiredThreadCount;
+        }
+
+        size_t maxCapacity = std::thread::hardware_concurrency();
+        if (maxCapacity <= 2) {
+            return 1;
+        }
+
+        //! NOTE The calling thread is a participant as well
+        return maxCapacity / 2 - 1;
+    }
+
+    bool popOwnTask(TaskDeque& deque, size_t& idx)
+    {
+        uint64_t range = deque.range.load(std::memory_order_acquire);
+
+        while (rangeBegin(range) < rangeEnd(range)) {
+            uint64_t newRange = packRange(rangeBegin(range) + 1, rangeEnd(range));
+            if (deque.range.compare_exchange_weak(range, newRange, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                idx = rangeBegin(range);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool stealTask(TaskDeque& deque, size_t& idx)
+    {
+        uint64_t range = deque.range.load(std::memory_order_acquire);
+
+        while (rangeBegin(range) < rangeEnd(range)) {
+            uint64_t newRange = packRange(rangeBegin(range), rangeEnd(range) - 1);
+            if (deque.range.compare_exchange_weak(range, newRange, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                idx = rangeEnd(range) - 1;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void runTask(size_t idx)
+    {
+        TaskFunc job = m_job.load(std::memory_order_relaxed);
+        void* context = m_jobContext.load(std::memory_order_relaxed);
+
+        job(context, idx);
+
+        m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void processTasks(size_t ownDequeIdx)
+    {
+        const size_t dequesCount = m_workersCount + 1;
+        size_t idx = 0;
+
+        while (popOwnTask(m_deques[ownDequeIdx], idx)) {
+            runTask(idx);
+        }
+
+        bool hasStolen = true;
+        while (hasStolen) {
+            hasStolen = false;
+
+            for (size_t offset = 1; offset < dequesCount; ++offset) {
+                TaskDeque& victim = m_deques[(ownDequeIdx + offset) % dequesCount];
+
+                if (stealTask(victim, idx)) {
+                    runTask(idx);
+                    hasStolen = true;
+                }
+            }
+        }
+    }
+
+    void setupThreads()
+    {
+        m_isActive = true;
+        for (size_t i = 0; i < m_workersCount; ++i) {
+            m_threadPool[i] = std::thread(&RealtimeTaskScheduler::th_workerLoop, this, i);
+        }
+    }
+
+    void terminateThreads()
+    {
+        {
+            std::lock_guard lock(m_sleepMutex);
+            m_isActive = false;
+        }
+
+        m_newJobCv.notify_all();
+
+        for (size_t i = 0; i < m_workersCount; ++i) {
+            m_threadPool[i].join();
+        }
+    }
+
+    void th_workerLoop(size_t dequeIdx)
+    {
+        uint64_t lastEpoch = m_jobEpoch.load(std::memory_order_acquire);
+        int idleIterations = 0;
+
+        while (m_isActive) {
+            uint64_t epoch = m_jobEpoch.load(std::memory_order_acquire);
+
+            if (epoch != lastEpoch) {
+                lastEpoch = epoch;
+                idleIterations = 0;
+                processTasks(dequeIdx);
+                continue;
+            }
+
+            if (idleIterations < SPIN_ITERATIONS_BEFORE_SLEEP) {
+                ++idleIterations;
+                std::this_thread::yield();
+                continue;
+            }
+
+            //! NOTE The notification is sent without locking the mutex, so the wake-up may be missed
+            //! if a job is published right before the wait. It's fine, the calling thread processes the job by itself in this case
+            std::unique_lock lock(m_sleepMutex);
+            m_sleepingWorkers.fetch_add(1);
+            m_newJobCv.wait(lock, [this, lastEpoch] {
+                return !m_isActive || m_jobEpoch.load() != lastEpoch;
+            });
+            m_sleepingWorkers.fetch_sub(1);
+        }
+    }
+
+    const size_t m_workersCount = 0;
+    std::unique_ptr<TaskDeque[]> m_deques = nullptr;
+    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+
+    std::atomic<TaskFunc> m_job = nullptr;
+    std::atomic<void*> m_jobContext = nullptr;
+    std::atomic<size_t> m_pendingTasks = 0;
+    std::atomic<uint64_t> m_jobEpoch = 0;
+
+    std::atomic<bool> m_isActive = false;
+    std::atomic<int> m_sleepingWorkers = 0;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_newJobCv;
+};
+}
+
+#endif // MU_GLOBAL_REALTIMETASKSCHEDULER_H
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_GLOBAL_SPSCQUEUE_H
+#define MU_GLOBAL_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace mu {
+//! NOTE Bounded wait-free queue for one producer thread and one consumer thread (e.g. the audio worker and the main thread).
+//! The storage is allocated with the queue, push() and pop() neither allocate memory nor take locks,
+//! push() fails if the queue is full, so the producer never waits for the consumer.
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+    //! NOTE Producer thread only
+    bool push(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity) {
+                return false;
+            }
+        }
+
+        m_items[tail & MASK] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! NOTE Consumer thread only
+    bool pop(T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+
+        value = m_items[head & MASK];
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! NOTE Approximate if called while the other thread works with the queue
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::array<T, Capacity> m_items {};
+
+    //! NOTE The indices only grow, the producer and the consumer data are on different cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail = 0;
+    size_t m_cachedHead = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head = 0;
+    size_t m_cachedTail = 0;
+};
+}
+
+#endif // MU_GLOBAL_SPSCQUEUE_H
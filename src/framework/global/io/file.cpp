@@ -62,6 +62,11 @@ mu::Ret File::writeFile(const io::path_t& filePath, const ByteArray& data)
     return fileSystem()->writeFile(filePath, data);
 }
 
+mu::RetVal<mu::ByteArray> File::mapFile(const io::path_t& filePath)
+{
+    return fileSystem()->mapFile(filePath);
+}
+
 bool File::setPermissionsAllowedForAll(const path_t& filePath)
 {
     return fileSystem()->setPermissionsAllowedForAll(filePath);
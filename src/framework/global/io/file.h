@@ -55,6 +55,7 @@ public:
     static bool exists(const path_t& filePath);
     static bool remove(const path_t& filePath);
     static Ret writeFile(const io::path_t& filePath, const ByteArray& data);
+    static RetVal<ByteArray> mapFile(const io::path_t& filePath);
     static bool setPermissionsAllowedForAll(const path_t& filePath);
 
 protected:
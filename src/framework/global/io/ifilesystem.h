@@ -59,6 +59,9 @@ public:
 
     virtual RetVal<ByteArray> readFile(const io::path_t& filePath) const = 0;
     virtual bool readFile(const io::path_t& filePath, ByteArray& data) const = 0;
+    //! NOTE The file is mapped into memory, if possible (else it is read).
+    //! The mapping is kept while the returned data or its copies (see ByteArray::view) exist
+    virtual RetVal<ByteArray> mapFile(const io::path_t& filePath) const = 0;
     virtual Ret writeFile(const io::path_t& filePath, const ByteArray& data) const = 0;
 
     //! NOTE File info
@@ -21,6 +21,7 @@
  */
 #include "filesystem.h"
 
+#include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QDirIterator>
@@ -157,6 +158,33 @@ bool FileSystem::readFile(const io::path_t& filePath, ByteArray& data) const
     return make_ret(Err::NoError);
 }
 
+RetVal<ByteArray> FileSystem::mapFile(const io::path_t& filePath) const
+{
+    RetVal<ByteArray> result;
+    Ret ret = exists(filePath);
+    if (!ret) {
+        result.ret = ret;
+        return result;
+    }
+
+    //! NOTE The mapping is removed when the file is closed, so the file is the owner of the data
+    std::shared_ptr<QFile> file = std::make_shared<QFile>(filePath.toQString());
+    if (!file->open(QIODevice::ReadOnly)) {
+        result.ret = make_ret(Err::FSReadError);
+        return result;
+    }
+
+    qint64 size = file->size();
+    uchar* data = size > 0 ? file->map(0, size) : nullptr;
+    if (!data) {
+        return readFile(filePath);
+    }
+
+    result.val = ByteArray::fromRawData(data, static_cast<size_t>(size), file);
+    result.ret = make_ret(Err::NoError);
+    return result;
+}
+
 Ret FileSystem::writeFile(const io::path_t& filePath, const ByteArray& data) const
 {
     QFile file(filePath.toQString());
@@ -21,10 +21,13 @@
  */
 #include "zipcontainer.h"
 
+#include <algorithm>
 #include <ctime>
 #include <cstring>
+#include <unordered_map>
 #include <zlib.h>
 
+#include "io/buffer.h"
 #include "io/dir.h"
 
 #include "log.h"
@@ -374,6 +377,7 @@ struct ZipContainer::Impl {
 
     bool dirtyFileTree = true;
     std::vector<FileHeader> fileHeaders;
+    std::unordered_map<std::string, size_t> fileHeaderIndexByName;
     ByteArray comment;
     uint start_of_directory = 0;
     ZipContainer::Status status = ZipContainer::NoError;
@@ -480,6 +484,7 @@ void ZipContainer::Impl::scanFiles()
         }
 
         ZDEBUG("found file '%s'", header.file_name.data());
+        fileHeaderIndexByName.emplace(std::string(header.file_name.constChar(), header.file_name.size()), fileHeaders.size());
         fileHeaders.push_back(header);
     }
 }
@@ -687,18 +692,12 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
     p->scanFiles();
 
-    size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == ByteArray::fromRawData(fileName.c_str(), fileName.size())) {
-            break;
-        }
-    }
-
-    if (i == p->fileHeaders.size()) {
+    auto it = p->fileHeaderIndexByName.find(fileName);
+    if (it == p->fileHeaderIndexByName.end()) {
         return ByteArray();
     }
 
-    FileHeader header = p->fileHeaders.at(i);
+    const FileHeader& header = p->fileHeaders.at(it->second);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
@@ -707,39 +706,54 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
+    size_t compressed_size = readUInt(header.h.compressed_size);
+    size_t uncompressed_size = readUInt(header.h.uncompressed_size);
+    size_t start = readUInt(header.h.offset_local_header);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
         return ByteArray();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
+    //! NOTE The entries are read directly from the device data, without the intermediate copies
+    const uint8_t* deviceData = p->device->readData();
+    const size_t deviceSize = p->device->size();
+    if (!deviceData || start + sizeof(LocalFileHeader) > deviceSize) {
+        LOGW("Zip: Local header is out of the file");
+        return ByteArray();
+    }
+
+    LocalFileHeader lh;
+    std::memcpy(&lh, deviceData + start, sizeof(LocalFileHeader));
+    size_t dataStart = start + sizeof(LocalFileHeader) + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    if (dataStart + compressed_size > deviceSize) {
+        LOGW("Zip: File data is out of the file");
+        return ByteArray();
+    }
+
+    const uint8_t* compressed = deviceData + dataStart;
+    int compression_method = readUShort(lh.compression_method);
+
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        size_t size = std::min(compressed_size, uncompressed_size);
+
+        //! NOTE The entry of a buffer refers to its data and keeps it (e.g. the mapping of the file) alive
+        //! after the reader is closed, the entries of other devices are copied
+        if (const io::Buffer* buffer = dynamic_cast<const io::Buffer*>(p->device)) {
+            return buffer->data().view(dataStart, size);
+        }
+
+        return ByteArray(compressed, size);
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
+        //! NOTE The uncompressed size is known, so usually it is inflated in one pass
         ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
+        ulong len = std::max(uncompressed_size, size_t(1));
         int res;
         do {
             baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+            res = inflate((uint8_t*)baunzip.data(), &len, compressed, (ulong)compressed_size);
 
             switch (res) {
             case Z_OK:
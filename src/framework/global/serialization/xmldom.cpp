@@ -179,7 +179,7 @@ XmlDomElement XmlDomDocument::rootElement() const
 
 bool XmlDomDocument::hasError() const
 {
-    return m_xml->err == tinyxml2::XML_SUCCESS;
+    return m_xml->err != tinyxml2::XML_SUCCESS;
 }
 
 String XmlDomDocument::errorString() const
@@ -21,33 +21,600 @@
  */
 #include "xmlstreamreader.h"
 
+#include <algorithm>
 #include <cstring>
-
-#include "thirdparty/tinyxml/tinyxml2.h"
+#include <string_view>
 
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
+
+static constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
+
+//! NOTE The longest one is &#x10FFFF;
+static constexpr size_t MAX_CHAR_REF_LENGTH = 10;
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static inline bool isNameStartChar(char c)
+{
+    const unsigned char uc = static_cast<unsigned char>(c);
+    return uc >= 0x80 || (uc >= 'a' && uc <= 'z') || (uc >= 'A' && uc <= 'Z') || uc == '_' || uc == ':';
+}
+
+static inline bool isNameChar(char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static char* writeUtf8(char32_t code, char* out)
+{
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+//! NOTE The predefined entities and the character references,
+//! the result is never longer than the reference, so it can be written in place
+static bool unescapeEntity(const char*& p, const char* end, char*& out)
+{
+    const size_t maxLength = std::min(MAX_CHAR_REF_LENGTH, static_cast<size_t>(end - p));
+    const char* semicolon = static_cast<const char*>(std::memchr(p, ';', maxLength));
+    if (!semicolon) {
+        return false;
+    }
+
+    const std::string_view ref(p + 1, semicolon - p - 1);
+    if (ref.empty()) {
+        return false;
+    }
+
+    if (ref.front() == '#') {
+        const bool hex = ref.size() > 1 && ref[1] == 'x';
+        const size_t first = hex ? 2 : 1;
+        if (first == ref.size()) {
+            return false;
+        }
+
+        char32_t code = 0;
+        for (size_t i = first; i < ref.size(); ++i) {
+            const char c = ref[i];
+            int digit = -1;
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (hex && c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (hex && c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            }
+
+            if (digit < 0) {
+                return false;
+            }
+
+            code = code * (hex ? 16 : 10) + static_cast<char32_t>(digit);
+        }
+
+        if (code == 0 || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            return false;
+        }
+
+        out = writeUtf8(code, out);
+    } else if (ref == "amp") {
+        *out++ = '&';
+    } else if (ref == "lt") {
+        *out++ = '<';
+    } else if (ref == "gt") {
+        *out++ = '>';
+    } else if (ref == "quot") {
+        *out++ = '"';
+    } else if (ref == "apos") {
+        *out++ = '\'';
+    } else {
+        return false;
+    }
+
+    p = semicolon + 1;
+    return true;
+}
+
+//! NOTE Normalizes the line ends (CR LF and CR become LF) and, if needed, replaces the entities.
+//! Unknown entities are left as is. Returns the new end of the text.
+static char* unescape(char* begin, char* end, bool entities)
+{
+    const char* p = begin;
+    char* out = begin;
+
+    while (p < end) {
+        const char c = *p;
+        if (c == '\r') {
+            *out++ = '\n';
+            p += (p + 1 < end && p[1] == '\n') ? 2 : 1;
+        } else if (c == '&' && entities && unescapeEntity(p, end, out)) {
+            continue;
+        } else {
+            *out++ = c;
+            ++p;
+        }
+    }
+
+    return out;
+}
+
+//---------------------------------------------------------
+//   Xml
+//    Pull tokenizer over the own copy of the UTF-8 data.
+//    The data is tokenized in place: the names, the attribute values
+//    and the texts are unescaped and zero-terminated right in the buffer,
+//    so the views to them stay valid until the data is changed.
+//---------------------------------------------------------
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    struct Attr {
+        AsciiStringView name;
+        AsciiStringView value;
+    };
+
+    std::vector<char> buffer;
+    char* pos = nullptr;
+    char* end = nullptr;
+
+    //! NOTE '<' of the next tag is already consumed, it might be overwritten by the terminator of the text before it
+    bool tagOpened = false;
+    //! NOTE The current start element is <name/>, its end element goes next
+    bool emptyElement = false;
+    bool hasElements = false;
+
+    // current token
+    AsciiStringView name;
+    AsciiStringView value;
+    std::vector<Attr> attributes;
+
+    std::vector<AsciiStringView> openElements;
+
+    int64_t line = 1;
+    const char* lineStart = nullptr;
+    int64_t tokenLine = 0;
+    int64_t tokenColumn = 0;
+
+    Error err = NoError;
+    String errorMessage;
     String customErr;
+
+    void setData(const char* data, size_t size)
+    {
+        buffer.resize(size + 1);
+        if (size > 0) {
+            std::memcpy(buffer.data(), data, size);
+        }
+        buffer[size] = '\0';
+
+        reset();
+    }
+
+    void reset()
+    {
+        if (buffer.empty()) {
+            buffer.push_back('\0');
+        }
+
+        pos = buffer.data();
+        end = pos + buffer.size() - 1;
+
+        if (static_cast<size_t>(end - pos) >= UTF8_BOM.size() && std::string_view(pos, UTF8_BOM.size()) == UTF8_BOM) {
+            pos += UTF8_BOM.size();
+        }
+
+        tagOpened = false;
+        emptyElement = false;
+        hasElements = false;
+
+        name = AsciiStringView();
+        value = AsciiStringView();
+        attributes.clear();
+        openElements.clear();
+
+        line = 1;
+        lineStart = pos;
+        tokenLine = 0;
+        tokenColumn = 0;
+
+        err = NoError;
+        errorMessage.clear();
+        customErr.clear();
+    }
+
+    TokenType readToken()
+    {
+        if (emptyElement) {
+            emptyElement = false;
+            attributes.clear();
+            return TokenType::EndElement;
+        }
+
+        name = AsciiStringView();
+        value = AsciiStringView();
+        attributes.clear();
+
+        if (tagOpened) {
+            tagOpened = false;
+            markToken(pos - 1);
+        } else {
+            char* textStart = pos;
+            bool hasCR = false;
+            while (isSpace(*pos)) {
+                countLine(pos, hasCR);
+                ++pos;
+            }
+
+            markToken(pos);
+
+            if (pos == end) {
+                if (!openElements.empty() || !hasElements) {
+                    return setError(PrematureEndOfDocumentError, u"Premature end of document");
+                }
+                return TokenType::EndDocument;
+            }
+
+            //! NOTE The whitespaces between the tags are skipped
+            if (*pos != '<') {
+                return readText(textStart, hasCR);
+            }
+
+            ++pos;
+        }
+
+        switch (*pos) {
+        case '/':
+            return readEndElement();
+        case '?':
+            return readProcessingInstruction();
+        case '!':
+            if (startsWith("!--")) {
+                return readComment();
+            }
+            if (startsWith("![CDATA[")) {
+                return readCData();
+            }
+            return readDtd();
+        default:
+            break;
+        }
+
+        if (isNameStartChar(*pos)) {
+            return readStartElement();
+        }
+
+        return unexpected(u"Invalid tag name");
+    }
+
+    TokenType readStartElement()
+    {
+        char* nameStart = pos;
+        while (isNameChar(*pos)) {
+            ++pos;
+        }
+        char* nameEnd = pos;
+
+        while (true) {
+            skipSpaces();
+
+            if (*pos == '>') {
+                ++pos;
+                break;
+            }
+
+            if (*pos == '/' && pos[1] == '>') {
+                pos += 2;
+                emptyElement = true;
+                break;
+            }
+
+            if (!isNameStartChar(*pos)) {
+                return unexpected(u"Expected an attribute or the end of the tag");
+            }
+
+            char* attrName = pos;
+            while (isNameChar(*pos)) {
+                ++pos;
+            }
+            char* attrNameEnd = pos;
+
+            skipSpaces();
+            if (*pos != '=') {
+                return unexpected(u"Expected '=' after the attribute name");
+            }
+
+            ++pos;
+            skipSpaces();
+
+            const char quote = *pos;
+            if (quote != '"' && quote != '\'') {
+                return unexpected(u"Expected a quoted attribute value");
+            }
+
+            char* valueStart = ++pos;
+            bool needsUnescape = false;
+            while (pos < end && *pos != quote) {
+                countLine(pos, needsUnescape);
+                needsUnescape = needsUnescape || *pos == '&';
+                ++pos;
+            }
+
+            if (pos == end) {
+                return unexpected(u"Unterminated attribute value");
+            }
+
+            char* valueEnd = needsUnescape ? unescape(valueStart, pos, true) : pos;
+            *valueEnd = '\0';
+            ++pos;
+
+            *attrNameEnd = '\0';
+            attributes.push_back({ AsciiStringView(attrName, attrNameEnd - attrName),
+                                   AsciiStringView(valueStart, valueEnd - valueStart) });
+        }
+
+        *nameEnd = '\0';
+        name = AsciiStringView(nameStart, nameEnd - nameStart);
+        hasElements = true;
+
+        if (!emptyElement) {
+            openElements.push_back(name);
+        }
+
+        return TokenType::StartElement;
+    }
+
+    TokenType readEndElement()
+    {
+        ++pos; // '/'
+
+        char* nameStart = pos;
+        if (!isNameStartChar(*pos)) {
+            return unexpected(u"Invalid tag name");
+        }
+
+        while (isNameChar(*pos)) {
+            ++pos;
+        }
+        char* nameEnd = pos;
+
+        skipSpaces();
+        if (*pos != '>') {
+            return unexpected(u"Expected '>' at the end of the tag");
+        }
+
+        ++pos;
+        *nameEnd = '\0';
+        name = AsciiStringView(nameStart, nameEnd - nameStart);
+
+        if (openElements.empty() || openElements.back() != name) {
+            return setError(NotWellFormedError, u"Opening and ending tag mismatch");
+        }
+
+        openElements.pop_back();
+        return TokenType::EndElement;
+    }
+
+    TokenType readText(char* textStart, bool needsUnescape)
+    {
+        while (pos < end && *pos != '<') {
+            countLine(pos, needsUnescape);
+            needsUnescape = needsUnescape || *pos == '&';
+            ++pos;
+        }
+
+        char* textEnd = needsUnescape ? unescape(textStart, pos, true) : pos;
+        if (pos < end) {
+            tagOpened = true;
+            ++pos;
+        }
+
+        *textEnd = '\0';
+        value = AsciiStringView(textStart, textEnd - textStart);
+        return TokenType::Characters;
+    }
+
+    TokenType readComment()
+    {
+        pos += 3; // !--
+        if (!readUntil("-->")) {
+            return unexpected(u"Unterminated comment");
+        }
+        return TokenType::Comment;
+    }
+
+    TokenType readCData()
+    {
+        pos += 8; // ![CDATA[
+        if (!readUntil("]]>")) {
+            return unexpected(u"Unterminated CDATA section");
+        }
+        return TokenType::Characters;
+    }
+
+    TokenType readProcessingInstruction()
+    {
+        ++pos; // ?
+        if (!readUntil("?>")) {
+            return unexpected(u"Unterminated processing instruction");
+        }
+
+        const bool isDeclaration = value.size() >= 3 && std::strncmp(value.ascii(), "xml", 3) == 0
+                                   && (value.size() == 3 || isSpace(value.ascii()[3]));
+
+        return isDeclaration ? TokenType::StartDocument : TokenType::Unknown;
+    }
+
+    //! NOTE Goes through the internal subset of DOCTYPE (the entities are declared there)
+    TokenType readDtd()
+    {
+        ++pos; // !
+
+        char* valueStart = pos;
+        bool inSubset = false;
+        bool hasCR = false;
+
+        while (pos < end) {
+            const char c = *pos;
+            if (c == '>' && !inSubset) {
+                break;
+            }
+
+            if (c == '"' || c == '\'') {
+                ++pos;
+                while (pos < end && *pos != c) {
+                    countLine(pos, hasCR);
+                    ++pos;
+                }
+            } else if (inSubset && startsWith("<!--")) {
+                pos += 4;
+                while (pos < end && !startsWith("-->")) {
+                    countLine(pos, hasCR);
+                    ++pos;
+                }
+                pos += 2;
+            } else if (c == '[') {
+                inSubset = true;
+            } else if (c == ']') {
+                inSubset = false;
+            } else {
+                countLine(pos, hasCR);
+            }
+
+            if (pos < end) {
+                ++pos;
+            }
+        }
+
+        if (pos >= end) {
+            pos = end;
+            return unexpected(u"Unterminated DOCTYPE");
+        }
+
+        char* valueEnd = hasCR ? unescape(valueStart, pos, false) : pos;
+        *valueEnd = '\0';
+        ++pos;
+
+        value = AsciiStringView(valueStart, valueEnd - valueStart);
+        return TokenType::DTD;
+    }
+
+    //! NOTE Reads the value until the terminator, line ends are normalized
+    bool readUntil(std::string_view terminator)
+    {
+        char* valueStart = pos;
+        bool hasCR = false;
+
+        while (pos < end && !startsWith(terminator)) {
+            countLine(pos, hasCR);
+            ++pos;
+        }
+
+        if (pos == end) {
+            return false;
+        }
+
+        char* valueEnd = hasCR ? unescape(valueStart, pos, false) : pos;
+        pos += terminator.size();
+        *valueEnd = '\0';
+
+        value = AsciiStringView(valueStart, valueEnd - valueStart);
+        return true;
+    }
+
+    inline bool startsWith(std::string_view str) const
+    {
+        return static_cast<size_t>(end - pos) >= str.size() && std::memcmp(pos, str.data(), str.size()) == 0;
+    }
+
+    inline void skipSpaces()
+    {
+        bool hasCR = false;
+        while (isSpace(*pos)) {
+            countLine(pos, hasCR);
+            ++pos;
+        }
+    }
+
+    inline void countLine(const char* p, bool& hasCR)
+    {
+        if (*p == '\n') {
+            ++line;
+            lineStart = p + 1;
+        } else if (*p == '\r') {
+            hasCR = true;
+        }
+    }
+
+    inline void markToken(const char* p)
+    {
+        tokenLine = line;
+        tokenColumn = p - lineStart + 1;
+    }
+
+    TokenType unexpected(const String& message)
+    {
+        markToken(pos);
+        return setError(pos == end ? PrematureEndOfDocumentError : NotWellFormedError, message);
+    }
+
+    TokenType setError(Error error, const String& message)
+    {
+        err = error;
+        errorMessage = message;
+        name = AsciiStringView();
+        value = AsciiStringView();
+        attributes.clear();
+        return TokenType::Invalid;
+    }
+
+    const Attr* findAttribute(const char* attrName) const
+    {
+        for (const Attr& a : attributes) {
+            if (a.name == attrName) {
+                return &a;
+            }
+        }
+        return nullptr;
+    }
 };
 
 XmlStreamReader::XmlStreamReader()
 {
     m_xml = new Xml();
+    m_xml->reset();
 }
 
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+
+    //! NOTE Read straight into the buffer, which is tokenized
+    std::vector<char>& buffer = m_xml->buffer;
+    buffer.resize(device->size() + 1);
+    size_t size = device->read(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size() - 1);
+    buffer.resize(size + 1);
+    buffer[size] = '\0';
+
+    m_xml->reset();
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -60,8 +627,7 @@ XmlStreamReader::XmlStreamReader(const ByteArray& data)
 XmlStreamReader::XmlStreamReader(const QByteArray& data)
 {
     m_xml = new Xml();
-    ByteArray ba = ByteArray::fromQByteArrayNoCopy(data);
-    setData(ba);
+    m_xml->setData(data.constData(), data.size());
 }
 
 #endif
@@ -73,14 +639,9 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
-    m_xml->customErr.clear();
-
-    if (m_xml->err != XML_SUCCESS) {
-        LOGE() << errorString();
-    }
+    m_xml->setData(data.constChar(), data.size());
+    m_token = TokenType::NoToken;
+    m_entities.clear();
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -100,102 +661,71 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_xml->err != NoError || m_token == EndDocument) {
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
-    }
-
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
+    m_token = m_xml->readToken();
 
-    m_xml->node = p.first;
-    m_token = p.second;
-
-    if (m_token == XmlStreamReader::TokenType::DTD) {
+    if (m_token == TokenType::DTD) {
         tryParseEntity(m_xml);
+    } else if (m_token == TokenType::Invalid) {
+        LOGE() << errorString() << ", line: " << lineNumber() << ", column: " << columnNumber();
     }
 
     return m_token;
 }
 
+//! NOTE The entities might be declared one by one or in the internal subset of DOCTYPE
 void XmlStreamReader::tryParseEntity(Xml* xml)
 {
-    static const char* ENTITY = { "ENTITY" };
+    static constexpr std::string_view ENTITY = "ENTITY";
+    static constexpr std::string_view ENTITY_DECL = "<!ENTITY";
 
-    const char* str = xml->node->Value();
-    if (std::strncmp(str, ENTITY, 6) == 0) {
-        String val = String::fromUtf8(str);
-        StringList list = val.split(' ');
-        if (list.size() == 3) {
-            String name = list.at(1);
-            String val = list.at(2);
-            m_entities[u'&' + name + u';'] = val.mid(1, val.size() - 2);
-        } else {
-            LOGW() << "unknown ENTITY: " << val;
+    const std::string_view dtd(xml->value.ascii(), xml->value.size());
+
+    auto findEntity = [&dtd](size_t from) {
+        size_t p = dtd.find(ENTITY_DECL, from);
+        return p == std::string_view::npos ? p : p + ENTITY_DECL.size();
+    };
+
+    size_t p = dtd.substr(0, ENTITY.size()) == ENTITY ? ENTITY.size() : findEntity(0);
+    while (p != std::string_view::npos) {
+
+        size_t nameStart = dtd.find_first_not_of(" \t\n", p);
+        size_t nameEnd = dtd.find_first_of(" \t\n", nameStart);
+        size_t valueStart = dtd.find_first_not_of(" \t\n", nameEnd);
+
+        if (valueStart == std::string_view::npos || (dtd[valueStart] != '"' && dtd[valueStart] != '\'')) {
+            LOGW() << "unknown ENTITY: " << std::string(dtd.substr(p, 32));
+            p = findEntity(p);
+            continue;
         }
+
+        size_t valueEnd = dtd.find(dtd[valueStart], valueStart + 1);
+        if (valueEnd == std::string_view::npos) {
+            LOGW() << "unknown ENTITY: " << std::string(dtd.substr(p, 32));
+            break;
+        }
+
+        String name = String::fromStdString(std::string(dtd.substr(nameStart, nameEnd - nameStart)));
+        String val = String::fromStdString(std::string(dtd.substr(valueStart + 1, valueEnd - valueStart - 1)));
+        m_entities[u'&' + name + u';'] = val;
+
+        p = findEntity(valueEnd);
     }
 }
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->value.ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -226,6 +756,7 @@ AsciiStringView XmlStreamReader::tokenString() const
     return AsciiStringView();
 }
 
+//! NOTE The whitespaces between the tags are not reported
 bool XmlStreamReader::isWhitespace() const
 {
     return false;
@@ -245,7 +776,7 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return m_xml->name;
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -254,24 +785,12 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
-    }
-    return e->FindAttribute(name) != nullptr;
+    return m_xml->findAttribute(name) != nullptr;
 }
 
 String XmlStreamReader::attribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return String();
-    }
-
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return String();
-    }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(asciiAttribute(name).ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -285,11 +804,8 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return AsciiStringView();
-    }
-    return e->Attribute(name);
+    const Xml::Attr* a = m_xml->findAttribute(name);
+    return a ? a->value : AsciiStringView();
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -324,15 +840,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attributes.size());
+    for (const Xml::Attr& xa : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = xa.name;
+        a.value = String::fromUtf8(xa.value.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -340,7 +852,7 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -348,8 +860,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->value;
     }
     return AsciiStringView();
 }
@@ -365,10 +877,8 @@ String XmlStreamReader::readText()
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
+            case Invalid:
+                return String();
             default:
                 break;
             }
@@ -384,14 +894,12 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->value;
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
+            case Invalid:
+                return AsciiStringView();
             default:
                 break;
             }
@@ -414,12 +922,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->tokenLine;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->tokenColumn;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -428,12 +936,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -446,7 +949,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->errorMessage;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -35,6 +35,9 @@
 #endif
 
 namespace mu {
+//! NOTE Pull parser over the UTF-8 data.
+//! The names, the attribute values and the texts returned as AsciiStringView (UTF-8 in fact)
+//! refer to the reader's own buffer, so they stay valid until the data is changed
 class XmlStreamReader
 {
 public:
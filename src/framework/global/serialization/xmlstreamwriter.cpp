@@ -21,24 +21,214 @@
  */
 #include "xmlstreamwriter.h"
 
-#include "containers.h"
-#include "textstream.h"
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+#include <sstream>
+#endif
 
 #include "log.h"
 
 using namespace mu;
 
+//! NOTE The output is collected in the buffer and written to the device by big chunks
+static constexpr size_t BUFFER_SIZE = 64 * 1024;
+static constexpr std::string_view INDENT = "                                                                ";
+
 struct XmlStreamWriter::Impl {
-    std::list<std::string> stack;
-    TextStream stream;
+    io::IODevice* device = nullptr;
+    std::vector<char> buffer;
+
+    //! NOTE The names of the open elements.
+    //! They are interned, so opening an element doesn't allocate
+    std::vector<AsciiStringView> stack;
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, AsciiStringView> namesIndex;
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+    std::ostringstream doubleStream;
+#endif
+
+    Impl()
+    {
+        buffer.reserve(BUFFER_SIZE);
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+        doubleStream.imbue(std::locale::classic());
+#endif
+    }
+
+    void flush()
+    {
+        if (device && device->isOpen() && !buffer.empty()) {
+            device->write(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    inline void flushIfFull()
+    {
+        if (buffer.size() >= BUFFER_SIZE) {
+            flush();
+        }
+    }
+
+    inline void write(char c)
+    {
+        buffer.push_back(c);
+    }
+
+    inline void write(const char* s, size_t len)
+    {
+        buffer.insert(buffer.end(), s, s + len);
+    }
+
+    inline void write(const std::string_view& s)
+    {
+        write(s.data(), s.size());
+    }
+
+    inline void writeAscii(const AsciiStringView& s)
+    {
+        write(s.ascii(), s.size());
+    }
 
     void putLevel()
     {
-        size_t level = stack.size();
-        for (size_t i = 0; i < level * 2; ++i) {
-            stream << ' ';
+        size_t count = stack.size() * 2;
+        while (count > 0) {
+            size_t chunk = std::min(count, INDENT.size());
+            write(INDENT.data(), chunk);
+            count -= chunk;
+        }
+    }
+
+    AsciiStringView intern(const std::string_view& name)
+    {
+        auto it = namesIndex.find(name);
+        if (it != namesIndex.end()) {
+            return it->second;
         }
+
+        const std::string& stored = names.emplace_back(name);
+        AsciiStringView interned(stored.c_str(), stored.size());
+        namesIndex.emplace(std::string_view(stored), interned);
+        return interned;
+    }
+
+    template<typename T>
+    void writeInt(T val)
+    {
+        char buf[24];
+        std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val);
+        write(buf, res.ptr - buf);
     }
+
+    //! NOTE Same as std::ostream does by default (%g with the precision 6), but without the locale
+    void writeDouble(double val)
+    {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        char buf[32];
+        std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::general, 6);
+        write(buf, res.ptr - buf);
+#else
+        doubleStream.str(std::string());
+        doubleStream << val;
+        write(doubleStream.str());
+#endif
+    }
+
+    static inline std::string_view escaped(uint32_t c, bool& skip)
+    {
+        switch (c) {
+        case '<': return "&lt;";
+        case '>': return "&gt;";
+        case '&': return "&amp;";
+        case '\"': return "&quot;";
+        default:
+            break;
+        }
+
+        // ignore invalid characters in xml 1.0
+        skip = c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D;
+        return std::string_view();
+    }
+
+    //! NOTE UTF-8 is written as is, only the special characters are replaced
+    void writeEscaped(const char* s, size_t len)
+    {
+        const char* run = s;
+        const char* end = s + len;
+
+        for (const char* p = s; p < end; ++p) {
+            bool skip = false;
+            std::string_view replacement = escaped(static_cast<unsigned char>(*p), skip);
+            if (replacement.empty() && !skip) {
+                continue;
+            }
+
+            write(run, p - run);
+            write(replacement);
+            run = p + 1;
+        }
+
+        write(run, end - run);
+    }
+
+    //! NOTE Encodes UTF-16 to UTF-8 straight into the buffer
+    void writeString(const String& s, bool escape)
+    {
+        const size_t startSize = buffer.size();
+        const size_t size = s.size();
+
+        for (size_t i = 0; i < size; ++i) {
+            uint32_t c = s[i];
+
+            if (c < 0x80) {
+                if (escape) {
+                    bool skip = false;
+                    std::string_view replacement = escaped(c, skip);
+                    if (!replacement.empty()) {
+                        write(replacement);
+                        continue;
+                    } else if (skip) {
+                        continue;
+                    }
+                }
+                write(static_cast<char>(c));
+            } else if (c < 0x800) {
+                write(static_cast<char>(0xC0 | (c >> 6)));
+                write(static_cast<char>(0x80 | (c & 0x3F)));
+            } else if (c < 0xD800 || c > 0xDFFF) {
+                write(static_cast<char>(0xE0 | (c >> 12)));
+                write(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                write(static_cast<char>(0x80 | (c & 0x3F)));
+            } else {
+                uint32_t low = (i + 1 < size) ? s[i + 1] : 0;
+                if (c > 0xDBFF || low < 0xDC00 || low > 0xDFFF) {
+                    //! NOTE Broken surrogate pair, let the generic conversion deal with it
+                    buffer.resize(startSize);
+                    ByteArray ba = escape ? String::toXmlEscaped(s).toUtf8() : s.toUtf8();
+                    write(ba.constChar(), ba.size());
+                    return;
+                }
+
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+
+                write(static_cast<char>(0xF0 | (c >> 18)));
+                write(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+                write(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                write(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+        }
+    }
+
+    void writeAttributes(const Attributes& attrs);
+    void writeValue(const Value& v);
 };
 
 XmlStreamWriter::XmlStreamWriter()
@@ -49,7 +239,7 @@ XmlStreamWriter::XmlStreamWriter()
 XmlStreamWriter::XmlStreamWriter(io::IODevice* dev)
 {
     m_impl = new Impl();
-    m_impl->stream.setDevice(dev);
+    m_impl->device = dev;
 }
 
 XmlStreamWriter::~XmlStreamWriter()
@@ -60,22 +250,24 @@ XmlStreamWriter::~XmlStreamWriter()
 
 void XmlStreamWriter::setDevice(io::IODevice* dev)
 {
-    m_impl->stream.setDevice(dev);
+    m_impl->device = dev;
 }
 
 void XmlStreamWriter::flush()
 {
-    m_impl->stream.flush();
+    m_impl->flush();
 }
 
 void XmlStreamWriter::startDocument()
 {
-    m_impl->stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    m_impl->write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 }
 
 void XmlStreamWriter::writeDoctype(const String& type)
 {
-    m_impl->stream << "<!DOCTYPE " << type << '>' << '\n';
+    m_impl->write("<!DOCTYPE ");
+    m_impl->writeString(type, false);
+    m_impl->write(">\n");
 }
 
 String XmlStreamWriter::escapeSymbol(char16_t c)
@@ -94,31 +286,42 @@ String XmlStreamWriter::escapeString(const AsciiStringView& s)
 }
 
 void XmlStreamWriter::writeValue(const Value& v)
+{
+    m_impl->writeValue(v);
+}
+
+void XmlStreamWriter::Impl::writeValue(const Value& v)
 {
     // std::monostate, int, unsigned int, signed long int, unsigned long int, signed long long, unsigned long long,
     // double, const char*, AsciiStringView, String
     switch (v.index()) {
     case 0:
         break;
-    case 1: m_impl->stream << std::get<int>(v);
-        break;
-    case 2: m_impl->stream << std::get<unsigned int>(v);
-        break;
-    case 3: m_impl->stream << std::get<signed long int>(v);
+    case 1: writeInt(std::get<int>(v));
         break;
-    case 4: m_impl->stream << std::get<unsigned long int>(v);
+    case 2: writeInt(std::get<unsigned int>(v));
         break;
-    case 5: m_impl->stream << std::get<signed long long>(v);
+    case 3: writeInt(std::get<signed long int>(v));
         break;
-    case 6: m_impl->stream << std::get<unsigned long long>(v);
+    case 4: writeInt(std::get<unsigned long int>(v));
         break;
-    case 7: m_impl->stream << std::get<double>(v);
+    case 5: writeInt(std::get<signed long long>(v));
         break;
-    case 8: m_impl->stream << escapeString(AsciiStringView(std::get<const char*>(v)));
+    case 6: writeInt(std::get<unsigned long long>(v));
         break;
-    case 9: m_impl->stream << escapeString(std::get<AsciiStringView>(v));
+    case 7: writeDouble(std::get<double>(v));
         break;
-    case 10: m_impl->stream << escapeString(std::get<String>(v));
+    case 8: {
+        const char* s = std::get<const char*>(v);
+        if (s) {
+            writeEscaped(s, std::strlen(s));
+        }
+    } break;
+    case 9: {
+        const AsciiStringView& s = std::get<AsciiStringView>(v);
+        writeEscaped(s.ascii(), s.size());
+    } break;
+    case 10: writeString(std::get<String>(v), true);
         break;
     default:
         LOGI() << "index: " << v.index();
@@ -127,20 +330,29 @@ void XmlStreamWriter::writeValue(const Value& v)
     }
 }
 
+void XmlStreamWriter::Impl::writeAttributes(const Attributes& attrs)
+{
+    for (const Attribute& a : attrs) {
+        write(' ');
+        writeAscii(a.first);
+        write("=\"");
+        writeValue(a.second);
+        write('\"');
+    }
+}
+
 void XmlStreamWriter::startElement(const AsciiStringView& name, const Attributes& attrs)
 {
     IF_ASSERT_FAILED(!name.contains(' ')) {
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << '>' << '\n';
-    m_impl->stack.push_back(name.ascii());
+    m_impl->write('<');
+    m_impl->writeAscii(name);
+    m_impl->writeAttributes(attrs);
+    m_impl->write(">\n");
+    m_impl->stack.push_back(m_impl->intern(std::string_view(name.ascii(), name.size())));
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::startElement(const String& name, const Attributes& attrs)
@@ -152,15 +364,33 @@ void XmlStreamWriter::startElement(const String& name, const Attributes& attrs)
 void XmlStreamWriter::startElementRaw(const String& name)
 {
     m_impl->putLevel();
-    m_impl->stream << '<' << name << '>' << '\n';
-    m_impl->stack.push_back(name.split(' ')[0].toStdString());
+    m_impl->write('<');
+    m_impl->writeString(name, false);
+    m_impl->write(">\n");
+
+    ByteArray ba = name.left(name.indexOf(u' ')).toUtf8();
+    m_impl->stack.push_back(m_impl->intern(std::string_view(ba.constChar(), ba.size())));
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::endElement()
 {
+    IF_ASSERT_FAILED(!m_impl->stack.empty()) {
+        return;
+    }
+
     m_impl->putLevel();
-    m_impl->stream << "</" << mu::takeLast(m_impl->stack) << '>' << '\n';
-    flush();
+    m_impl->write("</");
+    m_impl->writeAscii(m_impl->stack.back());
+    m_impl->write(">\n");
+    m_impl->stack.pop_back();
+
+    //! NOTE The document is written out, when its root is closed
+    if (m_impl->stack.empty()) {
+        flush();
+    } else {
+        m_impl->flushIfFull();
+    }
 }
 
 // <element attr="value" />
@@ -170,13 +400,11 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& att
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << "/>\n";
+    m_impl->write('<');
+    m_impl->writeAscii(name);
+    m_impl->writeAttributes(attrs);
+    m_impl->write("/>\n");
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::element(const AsciiStringView& name, const Value& body)
@@ -185,9 +413,14 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Value& body)
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name << '>';
-    writeValue(body);
-    m_impl->stream << "</" << name << '>' << '\n';
+    m_impl->write('<');
+    m_impl->writeAscii(name);
+    m_impl->write('>');
+    m_impl->writeValue(body);
+    m_impl->write("</");
+    m_impl->writeAscii(name);
+    m_impl->write(">\n");
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& attrs, const Value& body)
@@ -196,45 +429,60 @@ void XmlStreamWriter::element(const AsciiStringView& name, const Attributes& att
     }
 
     m_impl->putLevel();
-    m_impl->stream << '<' << name;
-    for (const Attribute& a : attrs) {
-        m_impl->stream << ' ' << a.first << '=' << '\"';
-        writeValue(a.second);
-        m_impl->stream << '\"';
-    }
-    m_impl->stream << ">";
-    writeValue(body);
-    m_impl->stream << "</" << name << '>' << '\n';
+    m_impl->write('<');
+    m_impl->writeAscii(name);
+    m_impl->writeAttributes(attrs);
+    m_impl->write('>');
+    m_impl->writeValue(body);
+    m_impl->write("</");
+    m_impl->writeAscii(name);
+    m_impl->write(">\n");
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::elementRaw(const String& nameWithAttributes, const Value& body)
 {
     m_impl->putLevel();
+    m_impl->write('<');
+    m_impl->writeString(nameWithAttributes, false);
+
     if (body.index() == 0) {
-        m_impl->stream << '<' << nameWithAttributes << "/>\n";
+        m_impl->write("/>\n");
     } else {
-        String ename(String(nameWithAttributes).split(' ')[0]);
-        m_impl->stream << '<' << nameWithAttributes << '>';
-        writeValue(body);
-        m_impl->stream << "</" << ename << '>' << '\n';
+        m_impl->write('>');
+        m_impl->writeValue(body);
+        m_impl->write("</");
+        m_impl->writeString(nameWithAttributes.left(nameWithAttributes.indexOf(u' ')), false);
+        m_impl->write(">\n");
     }
+
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::elementStringRaw(const String& nameWithAttributes, const String& body)
 {
     m_impl->putLevel();
+    m_impl->write('<');
+    m_impl->writeString(nameWithAttributes, false);
+
     if (body.isEmpty()) {
-        m_impl->stream << '<' << nameWithAttributes << "/>\n";
+        m_impl->write("/>\n");
     } else {
-        String ename(String(nameWithAttributes).split(' ')[0]);
-        m_impl->stream << '<' << nameWithAttributes << '>';
-        m_impl->stream << body;
-        m_impl->stream << "</" << ename << '>' << '\n';
+        m_impl->write('>');
+        m_impl->writeString(body, false);
+        m_impl->write("</");
+        m_impl->writeString(nameWithAttributes.left(nameWithAttributes.indexOf(u' ')), false);
+        m_impl->write(">\n");
     }
+
+    m_impl->flushIfFull();
 }
 
 void XmlStreamWriter::comment(const String& text)
 {
     m_impl->putLevel();
-    m_impl->stream << "<!-- " << text << " -->\n";
+    m_impl->write("<!-- ");
+    m_impl->writeString(text, false);
+    m_impl->write(" -->\n");
+    m_impl->flushIfFull();
 }
@@ -22,7 +22,6 @@
 #ifndef MU_GLOBAL_XMLSTREAMWRITER_H
 #define MU_GLOBAL_XMLSTREAMWRITER_H
 
-#include <list>
 #include <variant>
 
 #include "types/string.h"
@@ -21,6 +21,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "types/string.h"
 
 #ifdef CUSTOM_ALLOCATOR_DISABLED
@@ -202,3 +204,222 @@ TEST_F(Global_AllocatorTests, Many_NewCleanup)
     EXPECT_EQ(info.totalChunks, 12); // DEFAULT_BLOCK_SIZE * 3
     EXPECT_EQ(info.freeChunks, 12);
 }
+
+TEST_F(Global_AllocatorTests, Arena_ScopeNewDelete)
+{
+    //! GIVEN An arena
+    ObjectArena arena("score");
+
+    //! DO Create Items in the scope of the arena
+    std::vector<ItemBase*> items;
+    {
+        ObjectArena::Scope scope(&arena);
+        for (size_t i = 0; i < 100; ++i) {
+            items.push_back(new Item13(static_cast<uint8_t>(i)));
+        }
+    }
+
+    //! CHECK The items belong to the arena
+    for (ItemBase* item : items) {
+        EXPECT_TRUE(item->alive());
+        EXPECT_EQ(ObjectArena::owner(item), &arena);
+    }
+
+    EXPECT_EQ(arena.usedChunks(), 100);
+
+    //! DO Destroy Items out of the scope
+    for (ItemBase* item : items) {
+        delete item;
+    }
+
+    //! CHECK All the chunks are free
+    EXPECT_EQ(arena.usedChunks(), 0);
+
+    //! CHECK The items created out of the scope don't belong to the arena
+    ItemBase* item = new Item13(101);
+    EXPECT_EQ(ObjectArena::owner(item), nullptr);
+    delete item;
+}
+
+TEST_F(Global_AllocatorTests, Arena_ParallelNewDelete)
+{
+    //! GIVEN An arena
+    ObjectArena arena("parallel");
+
+    constexpr size_t THREADS = 4;
+    constexpr size_t ITEMS_PER_THREAD = 200;
+
+    //! DO Create Items on several threads, each one deletes the half of its items
+    std::vector<std::vector<ItemBase*> > items(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&arena, &result = items[t]]() {
+            ObjectArena::Scope scope(&arena);
+            for (size_t i = 0; i < ITEMS_PER_THREAD; ++i) {
+                result.push_back(new Item8(static_cast<uint8_t>(i)));
+            }
+
+            for (size_t i = 0; i < ITEMS_PER_THREAD; i += 2) {
+                delete result[i];
+                result[i] = nullptr;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK The statistic of the arena is available through the register
+    std::vector<ObjectAllocator::Info> infos = AllocatorsRegister::instance()->arenaStateInfo("parallel");
+    ASSERT_EQ(infos.size(), 1);
+    EXPECT_EQ(infos.front().name, "Item8");
+    EXPECT_EQ(infos.front().totalAllocatedCount, THREADS * ITEMS_PER_THREAD);
+    EXPECT_EQ(infos.front().totalFreeCount, THREADS * ITEMS_PER_THREAD / 2);
+    EXPECT_EQ(infos.front().usedChunks(), THREADS * ITEMS_PER_THREAD / 2);
+
+    //! DO Destroy the rest Items on this thread
+    for (const std::vector<ItemBase*>& threadItems : items) {
+        for (ItemBase* item : threadItems) {
+            EXPECT_TRUE(!item || item->alive());
+            delete item;
+        }
+    }
+
+    //! CHECK All the chunks are free
+    EXPECT_EQ(arena.usedChunks(), 0);
+}
+
+TEST_F(Global_AllocatorTests, Arena_Release)
+{
+    //! GIVEN An arena with the destroyed items
+    std::unique_ptr<ObjectArena> arena = std::make_unique<ObjectArena>("release");
+
+    ItemBase* item = nullptr;
+    {
+        ObjectArena::Scope scope(arena.get());
+        item = new Item3(1);
+        delete item;
+    }
+
+    EXPECT_GT(arena->allocatedBytes(), 0);
+
+    //! DO Destroy the arena
+    arena.reset();
+
+    //! CHECK The arena is unregistered
+    EXPECT_EQ(ObjectArena::owner(item), nullptr);
+    EXPECT_TRUE(AllocatorsRegister::instance()->arenaStateInfo("release").empty());
+}
+
+TEST_F(Global_AllocatorTests, Arena_ReleaseWithAliveItems)
+{
+    //! GIVEN The small blocks of the arena
+    const size_t blockSize = ObjectArena::BLOCK_SIZE;
+    ObjectArena::BLOCK_SIZE = sizeof(Item13) * 4;
+
+    const ObjectAllocator::Info globalInfo = Item13::allocator().stateInfo();
+
+    //! GIVEN An arena with the items in several blocks
+    std::unique_ptr<ObjectArena> arena = std::make_unique<ObjectArena>("alive");
+
+    std::vector<ItemBase*> items;
+    {
+        ObjectArena::Scope scope(arena.get());
+        for (size_t i = 0; i < 12; ++i) {
+            items.push_back(new Item13(static_cast<uint8_t>(i)));
+        }
+    }
+
+    EXPECT_GT(arena->allocatedBytes(), ObjectArena::BLOCK_SIZE);
+
+    //! GIVEN All the items are destroyed except one
+    ItemBase* alive = items.back();
+    items.pop_back();
+    for (ItemBase* item : items) {
+        delete item;
+    }
+
+    //! DO Destroy the arena
+    arena.reset();
+
+    //! CHECK Only the block of the alive item is kept
+    EXPECT_EQ(ObjectArena::orphanedBytes(), ObjectArena::BLOCK_SIZE);
+    EXPECT_EQ(ObjectArena::owner(alive), nullptr);
+    EXPECT_TRUE(alive->alive());
+
+    //! DO Destroy the alive item
+    delete alive;
+
+    //! CHECK The block is released, the global allocator is not involved
+    EXPECT_EQ(ObjectArena::orphanedBytes(), 0);
+
+    const ObjectAllocator::Info info = Item13::allocator().stateInfo();
+    EXPECT_EQ(info.totalAllocatedCount, globalInfo.totalAllocatedCount);
+    EXPECT_EQ(info.totalFreeCount, globalInfo.totalFreeCount);
+
+    ObjectArena::BLOCK_SIZE = blockSize;
+}
+
+TEST_F(Global_AllocatorTests, Arena_ScopesDestroyedOutOfOrder)
+{
+    //! GIVEN Two arenas
+    ObjectArena commandArena("command");
+    ObjectArena layoutArena("layout");
+
+    //! GIVEN The scope held across the calls, e.g. from the start to the end of a command
+    std::unique_ptr<ObjectArena::Scope> commandScope = std::make_unique<ObjectArena::Scope>(&commandArena);
+    EXPECT_EQ(ObjectArena::current(), &commandArena);
+
+    ItemBase* commandItem = new Item8(1);
+
+    //! DO Create the scope of the other arena, then destroy the held one
+    std::unique_ptr<ObjectArena::Scope> layoutScope = std::make_unique<ObjectArena::Scope>(&layoutArena);
+    commandScope.reset();
+
+    //! CHECK The later scope is still current
+    EXPECT_EQ(ObjectArena::current(), &layoutArena);
+
+    ItemBase* layoutItem = new Item8(2);
+    EXPECT_EQ(ObjectArena::owner(layoutItem), &layoutArena);
+
+    //! DO Destroy the later scope
+    layoutScope.reset();
+
+    //! CHECK No arena is current
+    EXPECT_EQ(ObjectArena::current(), nullptr);
+
+    //! DO Destroy the items out of the scopes
+    delete commandItem;
+    delete layoutItem;
+
+    //! CHECK All the chunks are free
+    EXPECT_EQ(commandArena.usedChunks(), 0);
+    EXPECT_EQ(layoutArena.usedChunks(), 0);
+}
+
+TEST_F(Global_AllocatorTests, Arena_GlobalItemsDeletedInScope)
+{
+    //! GIVEN Items created out of any arena
+    const ObjectAllocator::Info globalInfo = Item3::allocator().stateInfo();
+
+    std::vector<ItemBase*> items;
+    for (size_t i = 0; i < 10; ++i) {
+        items.push_back(new Item3(static_cast<uint8_t>(i)));
+    }
+
+    //! DO Destroy them in the scope of an arena
+    ObjectArena arena("global");
+    {
+        ObjectArena::Scope scope(&arena);
+        for (ItemBase* item : items) {
+            delete item;
+        }
+    }
+
+    //! CHECK The chunks go back to the global allocator, not to the arena
+    const ObjectAllocator::Info info = Item3::allocator().stateInfo();
+    EXPECT_EQ(info.totalAllocatedCount, globalInfo.totalAllocatedCount + items.size());
+    EXPECT_EQ(info.totalFreeCount, globalInfo.totalFreeCount + items.size());
+    EXPECT_TRUE(arena.stateInfo().empty());
+}
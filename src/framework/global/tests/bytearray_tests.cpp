@@ -197,3 +197,62 @@ TEST_F(Global_Types_ByteArrayTests, Modification)
     EXPECT_EQ(ba10.size(), 0);
     EXPECT_TRUE(ba10.empty());
 }
+
+TEST_F(Global_Types_ByteArrayTests, View)
+{
+    std::vector<uint8_t> ref = { 1, 2, 3, 4, 5, 6 };
+
+    //! GIVEN The view of the ByteArray data
+    ByteArray view;
+    {
+        ByteArray ba = ByteArray(&ref[0], ref.size());
+        view = ba.view(2, 3);
+
+        //! CHECK The view refers to the data of the ByteArray
+        EXPECT_EQ(view.size(), 3);
+        EXPECT_EQ(view.constData(), ba.constData() + 2);
+
+        //! DO Modify the ByteArray
+        ba[2] = 42;
+    }
+
+    //! CHECK The view isn't changed and is valid after the ByteArray is destroyed
+    std::vector<uint8_t> ref2 = { 3, 4, 5 };
+    EXPECT_EQ(std::memcmp(view.constData(), &ref2[0], ref2.size()), 0);
+
+    //! GIVEN The raw data with the owner
+    std::shared_ptr<std::vector<uint8_t> > owner = std::make_shared<std::vector<uint8_t> >(ref);
+    std::weak_ptr<std::vector<uint8_t> > weakOwner = owner;
+    ByteArray raw = ByteArray::fromRawData(owner->data(), owner->size(), owner);
+    owner.reset();
+
+    //! DO Make the view and release the raw data
+    view = raw.view(1, 2);
+    raw = ByteArray();
+
+    //! CHECK The owner is alive while the view exists
+    EXPECT_FALSE(weakOwner.expired());
+    EXPECT_EQ(view[0], 2);
+    EXPECT_EQ(view[1], 3);
+
+    //! DO Modify the view (detach)
+    view.push_back(7);
+
+    //! CHECK The data is copied, the owner is released
+    EXPECT_TRUE(weakOwner.expired());
+    std::vector<uint8_t> ref3 = { 2, 3, 7 };
+    EXPECT_EQ(view.size(), ref3.size());
+    EXPECT_EQ(std::memcmp(view.constData(), &ref3[0], ref3.size()), 0);
+
+    //! GIVEN The raw data without the owner
+    ByteArray rawNoOwner = ByteArray::fromRawData(&ref[0], ref.size());
+
+    //! DO Make the view
+    view = rawNoOwner.view(3, 2);
+
+    //! CHECK The data is copied, it can't be kept alive by the view
+    EXPECT_NE(view.constData(), &ref[3]);
+    EXPECT_EQ(view.size(), 2);
+    EXPECT_EQ(view[0], 4);
+    EXPECT_EQ(view[1], 5);
+}
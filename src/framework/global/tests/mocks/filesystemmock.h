@@ -40,6 +40,7 @@ public:
 
     MOCK_METHOD(RetVal<ByteArray>, readFile, (const io::path_t&), (const, override));
     MOCK_METHOD(bool, readFile, (const io::path_t& filePath, ByteArray & data), (const, override));
+    MOCK_METHOD(RetVal<ByteArray>, mapFile, (const io::path_t& filePath), (const, override));
     MOCK_METHOD(Ret, writeFile, (const io::path_t& filePath, const ByteArray& data), (const, override));
 
     MOCK_METHOD(Ret, makePath, (const io::path_t&), (const, override));
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "concurrency/realtimetaskscheduler.h"
+
+using namespace mu;
+
+class Global_RealtimeTaskSchedulerTests : public ::testing::Test
+{
+public:
+    static void processBlock(std::vector<float>& buffer, size_t channelIdx)
+    {
+        for (size_t s = 0; s < buffer.size(); ++s) {
+            buffer[s] = std::sin(static_cast<float>(s + channelIdx) * 0.01f);
+        }
+    }
+};
+
+TEST_F(Global_RealtimeTaskSchedulerTests, ParallelFor_CallsEveryIndexOnce)
+{
+    //! GIVEN Scheduler with several workers
+    RealtimeTaskScheduler scheduler(3);
+
+    constexpr size_t MAX_COUNT = 97;
+    std::vector<std::atomic<int> > calls(MAX_COUNT);
+
+    //! DO Run jobs of different sizes, including the ones smaller than the number of workers
+    for (size_t count = 0; count <= MAX_COUNT; ++count) {
+        for (std::atomic<int>& c : calls) {
+            c = 0;
+        }
+
+        scheduler.parallelFor(count, [&calls](size_t idx) {
+            calls[idx]++;
+        });
+
+        //! CHECK Every index in range is processed exactly once, the others are untouched
+        for (size_t idx = 0; idx < MAX_COUNT; ++idx) {
+            EXPECT_EQ(calls[idx], idx < count ? 1 : 0);
+        }
+    }
+}
+
+TEST_F(Global_RealtimeTaskSchedulerTests, ParallelFor_ReturnsWhenAllTasksAreComplete)
+{
+    //! GIVEN Scheduler and a set of tasks of different duration
+    RealtimeTaskScheduler scheduler(2);
+
+    constexpr size_t COUNT = 16;
+    std::vector<std::vector<float> > buffers(COUNT, std::vector<float>(256 * (1 + COUNT), 0.f));
+
+    //! DO Process the tasks many times in a row
+    for (int block = 0; block < 200; ++block) {
+        scheduler.parallelFor(COUNT, [&buffers](size_t idx) {
+            processBlock(buffers[idx], idx);
+        });
+
+        //! CHECK All the buffers are filled when parallelFor returns
+        for (size_t idx = 0; idx < COUNT; ++idx) {
+            EXPECT_FLOAT_EQ(buffers[idx].back(), std::sin(static_cast<float>(buffers[idx].size() - 1 + idx) * 0.01f));
+            buffers[idx].back() = 0.f;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "concurrency/spscqueue.h"
+
+using namespace mu;
+
+class Global_SpscQueueTests : public ::testing::Test
+{
+public:
+    struct Event {
+        int id = 0;
+        double value = 0.0;
+    };
+};
+
+TEST_F(Global_SpscQueueTests, PushPop_FifoUntilFull)
+{
+    //! GIVEN Empty queue
+    SpscQueue<Event, 8> queue;
+    Event event;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(event));
+
+    //! DO Push more than fits
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.push({ i, i * 0.5 }));
+    }
+
+    //! CHECK The extra item is rejected, the others go out in the same order
+    EXPECT_FALSE(queue.push({ 8, 4.0 }));
+    EXPECT_EQ(queue.size(), 8);
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.id, i);
+        EXPECT_DOUBLE_EQ(event.value, i * 0.5);
+    }
+
+    EXPECT_FALSE(queue.pop(event));
+
+    //! CHECK The freed space is reused, the indices wrap around
+    for (int round = 0; round < 100; ++round) {
+        EXPECT_TRUE(queue.push({ round, 0.0 }));
+        EXPECT_TRUE(queue.push({ round + 1, 0.0 }));
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.id, round);
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.id, round + 1);
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(Global_SpscQueueTests, PushPop_TwoThreads)
+{
+    //! GIVEN Small queue, so the producer often finds it full
+    SpscQueue<Event, 16> queue;
+    constexpr int COUNT = 200000;
+
+    //! DO Push the sequence from one thread and pop it from another
+    std::thread producer([&queue]() {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!queue.push({ i, static_cast<double>(i) })) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    //! CHECK Nothing is lost, duplicated or reordered
+    int expected = 0;
+    Event event;
+    while (expected < COUNT) {
+        if (!queue.pop(event)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ASSERT_EQ(event.id, expected);
+        ASSERT_DOUBLE_EQ(event.value, static_cast<double>(expected));
+        ++expected;
+    }
+
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,209 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "serialization/xmlstreamreader.h"
+
+using namespace mu;
+
+class Global_Ser_XmlStreamReader : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamReader, Tokens)
+{
+    //! GIVEN Document with all kinds of tokens
+    ByteArray data("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<!DOCTYPE museScore>\n"
+                   "<museScore version=\"4.00\">\n"
+                   "  <!-- comment -->\n"
+                   "  <Score>\n"
+                   "    <Division>480</Division>\n"
+                   "    <Empty/>\n"
+                   "    <Text><![CDATA[a < b]]></Text>\n"
+                   "  </Score>\n"
+                   "</museScore>\n");
+
+    //! DO Read all tokens
+    XmlStreamReader xml(data);
+
+    std::vector<std::pair<XmlStreamReader::TokenType, std::string> > tokens;
+    while (!xml.atEnd()) {
+        XmlStreamReader::TokenType token = xml.readNext();
+        if (token == XmlStreamReader::StartElement || token == XmlStreamReader::EndElement) {
+            tokens.push_back({ token, xml.name().ascii() });
+        } else if (token == XmlStreamReader::Characters || token == XmlStreamReader::Comment) {
+            tokens.push_back({ token, xml.asciiText().ascii() });
+        } else {
+            tokens.push_back({ token, std::string() });
+        }
+    }
+
+    //! CHECK The whitespaces between the tags are skipped, empty element gives start and end
+    std::vector<std::pair<XmlStreamReader::TokenType, std::string> > expected = {
+        { XmlStreamReader::StartDocument, "" },
+        { XmlStreamReader::DTD, "" },
+        { XmlStreamReader::StartElement, "museScore" },
+        { XmlStreamReader::Comment, " comment " },
+        { XmlStreamReader::StartElement, "Score" },
+        { XmlStreamReader::StartElement, "Division" },
+        { XmlStreamReader::Characters, "480" },
+        { XmlStreamReader::EndElement, "Division" },
+        { XmlStreamReader::StartElement, "Empty" },
+        { XmlStreamReader::EndElement, "Empty" },
+        { XmlStreamReader::StartElement, "Text" },
+        { XmlStreamReader::Characters, "a < b" },
+        { XmlStreamReader::EndElement, "Text" },
+        { XmlStreamReader::EndElement, "Score" },
+        { XmlStreamReader::EndElement, "museScore" },
+        { XmlStreamReader::EndDocument, "" },
+    };
+
+    EXPECT_EQ(tokens, expected);
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReader, AttributesAndText)
+{
+    //! GIVEN Element with attributes and text with entities
+    ByteArray data("<Note pitch=\"60\" tpc='14' velo = \"0.5\" name=\"a &amp; b &#x41;&#66;\">\r\n"
+                   "  <text>x &lt; y&gt;z &unknown; \xD0\xB0</text>\n"
+                   "</Note>");
+
+    XmlStreamReader xml(data);
+
+    //! DO Read the start element
+    ASSERT_TRUE(xml.readNextStartElement());
+
+    //! CHECK Attributes are unescaped
+    EXPECT_EQ(xml.name(), "Note");
+    EXPECT_TRUE(xml.hasAttribute("pitch"));
+    EXPECT_FALSE(xml.hasAttribute("pit"));
+    EXPECT_EQ(xml.intAttribute("pitch"), 60);
+    EXPECT_EQ(xml.intAttribute("tpc"), 14);
+    EXPECT_EQ(xml.intAttribute("track", -1), -1);
+    EXPECT_DOUBLE_EQ(xml.doubleAttribute("velo"), 0.5);
+    EXPECT_EQ(xml.asciiAttribute("name"), "a & b AB");
+    EXPECT_EQ(xml.attribute("name"), u"a & b AB");
+    EXPECT_EQ(xml.attributes().size(), 4);
+
+    //! CHECK The view to the element name stays valid after reading further
+    AsciiStringView tag = xml.name();
+
+    //! DO Read the text
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "text");
+    EXPECT_EQ(xml.lineNumber(), 2);
+    EXPECT_EQ(xml.columnNumber(), 3);
+
+    String text = xml.readText();
+
+    //! CHECK Known entities are replaced, the unknown ones are kept
+    EXPECT_EQ(text, String(u"x < y>z &unknown; а"));
+    EXPECT_EQ(tag, "Note");
+
+    //! CHECK End of the elements
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "Note");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_TRUE(xml.atEnd());
+}
+
+TEST_F(Global_Ser_XmlStreamReader, Entities)
+{
+    //! GIVEN Document with the entities declared in the internal subset of DOCTYPE
+    ByteArray data("<!DOCTYPE museScore [\n"
+                   "<!-- the entities > -->\n"
+                   "  <!ENTITY ext \"2.5\">\n"
+                   "  <!ENTITY mod '4.5'>\n"
+                   "  ]>\n"
+                   "<museScore><render>m:0:-&mod; m:&ext;</render></museScore>");
+
+    XmlStreamReader xml(data);
+
+    //! DO Read the text
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "render");
+
+    //! CHECK The entities are replaced
+    EXPECT_EQ(xml.readText(), String(u"m:0:-4.5 m:2.5"));
+}
+
+TEST_F(Global_Ser_XmlStreamReader, SkipCurrentElement)
+{
+    //! GIVEN Nested elements
+    ByteArray data("<a><b><c>1</c><c/></b><d>2</d></a>");
+
+    XmlStreamReader xml(data);
+
+    //! DO Skip the element with children
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "b");
+    xml.skipCurrentElement();
+
+    //! CHECK The next one is its sibling
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "d");
+    EXPECT_EQ(xml.readInt(), 2);
+}
+
+TEST_F(Global_Ser_XmlStreamReader, Errors)
+{
+    {
+        //! GIVEN Tags mismatch
+        XmlStreamReader xml(ByteArray("<a>\n<b></a></b>"));
+
+        //! DO Read all
+        while (xml.readNext() != XmlStreamReader::Invalid) {
+        }
+
+        //! CHECK Error with position
+        EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+        EXPECT_EQ(xml.lineNumber(), 2);
+        EXPECT_TRUE(xml.atEnd());
+    }
+
+    {
+        //! GIVEN Not closed element
+        XmlStreamReader xml(ByteArray("<a><b>text</b>"));
+
+        //! DO Read all
+        while (xml.readNext() != XmlStreamReader::Invalid) {
+        }
+
+        //! CHECK Premature end
+        EXPECT_EQ(xml.error(), XmlStreamReader::PrematureEndOfDocumentError);
+    }
+
+    {
+        //! GIVEN Broken attribute
+        XmlStreamReader xml(ByteArray("<a b=\"1></a>"));
+
+        //! CHECK Not read, the text is not waited forever
+        EXPECT_FALSE(xml.readNextStartElement());
+        EXPECT_TRUE(xml.isError());
+        EXPECT_TRUE(xml.readText().isEmpty());
+    }
+}
@@ -16,8 +16,20 @@ void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isA
         }
     }
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[th].push(f);
+    Functor onInvoke;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        m_queues[th].push(f);
+
+        auto it = m_onInvoke.find(th);
+        if (it != m_onInvoke.end()) {
+            onInvoke = it->second;
+        }
+    }
+
+    if (onInvoke) {
+        onInvoke();
+    }
 }
 
 void QueuedInvoker::processEvents()
@@ -39,6 +51,16 @@ void QueuedInvoker::processEvents()
     }
 }
 
+void QueuedInvoker::onInvoke(const std::thread::id& th, const Functor& f)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (f) {
+        m_onInvoke[th] = f;
+    } else {
+        m_onInvoke.erase(th);
+    }
+}
+
 void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f)
 {
     m_onMainThreadInvoke = f;
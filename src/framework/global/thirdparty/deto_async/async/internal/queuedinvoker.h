@@ -21,6 +21,9 @@ public:
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
 
+    // called after a functor is queued for the thread, e.g. to wake the thread up
+    void onInvoke(const std::thread::id& th, const Functor& f);
+
 private:
 
     QueuedInvoker() = default;
@@ -29,6 +32,7 @@ private:
 
     std::recursive_mutex m_mutex;
     std::map<std::thread::id, Queue > m_queues;
+    std::map<std::thread::id, Functor> m_onInvoke;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
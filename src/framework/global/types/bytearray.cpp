@@ -70,6 +70,13 @@ ByteArray ByteArray::fromRawData(const char* data, size_t size)
     return fromRawData(reinterpret_cast<const uint8_t*>(data), size);
 }
 
+ByteArray ByteArray::fromRawData(const uint8_t* data, size_t size, const std::shared_ptr<const void>& owner)
+{
+    ByteArray ba = fromRawData(data, size);
+    ba.m_rawOwner = owner;
+    return ba;
+}
+
 uint8_t* ByteArray::data()
 {
     detach();
@@ -110,6 +117,7 @@ void ByteArray::detach()
         m_data->operator [](m_raw.size) = 0;
         std::memcpy(m_data->data(), m_raw.data, m_raw.size);
         m_raw.data = nullptr;
+        m_rawOwner.reset();
         return;
     }
 
@@ -237,3 +245,21 @@ ByteArray ByteArray::right(size_t len) const
 {
     return ByteArray(&(constData()[size() - len]), len);
 }
+
+ByteArray ByteArray::view(size_t pos, size_t len) const
+{
+    assert(pos + len <= size());
+    if (pos + len > size()) {
+        return ByteArray();
+    }
+
+    if (m_raw.data) {
+        if (!m_rawOwner) {
+            return ByteArray(m_raw.data + pos, len);
+        }
+
+        return fromRawData(m_raw.data + pos, len, m_rawOwner);
+    }
+
+    return fromRawData(m_data->data() + pos, len, m_data);
+}
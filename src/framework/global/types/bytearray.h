@@ -45,6 +45,9 @@ public:
     static ByteArray fromRawData(const uint8_t* data, size_t size);
     static ByteArray fromRawData(const char* data, size_t size);
 
+    //! NOTE Not copied, the owner keeps the data alive while the byte array or its copies exist
+    static ByteArray fromRawData(const uint8_t* data, size_t size, const std::shared_ptr<const void>& owner);
+
     bool operator==(const ByteArray& other) const;
     bool operator!=(const ByteArray& other) const { return !operator==(other); }
 
@@ -71,6 +74,10 @@ public:
     ByteArray left(size_t len) const;
     ByteArray right(size_t len) const;
 
+    //! NOTE Not copied, the result refers to the data of this byte array and keeps it alive.
+    //! The raw data without an owner can't be kept alive, so it's copied
+    ByteArray view(size_t pos, size_t len) const;
+
 #ifndef NO_QT_SUPPORT
     static ByteArray fromQByteArray(const QByteArray& ba)
     {
@@ -105,6 +112,7 @@ private:
 
     std::shared_ptr<Data> m_data;
     RawData m_raw;
+    std::shared_ptr<const void> m_rawOwner;
 };
 }
 
@@ -369,10 +369,36 @@ static const PlaybackSetupData GENERIC_SETUP_DATA = {
 
 static const String GENERIC_SETUP_DATA_STRING = GENERIC_SETUP_DATA.toString();
 
+//! NOTE The changes of the events map after an edit:
+//! the events at the removed timestamps are dropped, the added ones replace the events at their timestamps
+struct PlaybackEventsDiff {
+    std::vector<timestamp_t> removed;
+    PlaybackEventsMap added;
+
+    bool empty() const
+    {
+        return removed.empty() && added.empty();
+    }
+
+    void applyTo(PlaybackEventsMap& events) const
+    {
+        for (const timestamp_t timestamp : removed) {
+            events.erase(timestamp);
+        }
+
+        for (const auto& pair : added) {
+            events.insert_or_assign(pair.first, pair.second);
+        }
+    }
+};
+
+using PlaybackEventsDiffChanges = async::Channel<PlaybackEventsDiff>;
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
     PlaybackEventsChanges mainStream;
+    PlaybackEventsDiffChanges mainStreamDiff;
     PlaybackEventsChanges offStream;
     DynamicLevelMap dynamicLevelMap;
     DynamicLevelChanges dynamicLevelChanges;
@@ -112,7 +112,7 @@ void MuseSamplerSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& c
         }
     }
 
-    updateOffSequenceIterator();
+    updateOffStreamTimeline();
 }
 
 void MuseSamplerSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
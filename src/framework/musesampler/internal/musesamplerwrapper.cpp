@@ -106,9 +106,9 @@ samples_t MuseSamplerWrapper::process(float* buffer, audio::samples_t samplesPer
     if (!isActive()) {
         msecs_t nextMicros = samplesToMsecs(samplesPerChannel, m_sampleRate);
 
-        const MuseSamplerSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMicros);
-        for (const MuseSamplerSequencer::EventType& event : sequence) {
-            handleAuditionEvents(event);
+        const MuseSamplerSequencer::EventSpan events = m_sequencer.eventsToBePlayed(nextMicros);
+        for (const MuseSamplerSequencer::TimedEvent& event : events) {
+            handleAuditionEvents(event.event);
         }
     }
 
@@ -46,7 +46,7 @@ void VstSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& changes)
     m_offStreamEvents.clear();
     m_offStreamFlushed.notify();
     updatePlaybackEvents(m_offStreamEvents, changes);
-    updateOffSequenceIterator();
+    updateOffStreamTimeline();
 }
 
 void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
@@ -54,7 +54,7 @@ void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
     m_mainStreamEvents.clear();
     m_mainStreamFlushed.notify();
     updatePlaybackEvents(m_mainStreamEvents, changes);
-    updateMainSequenceIterator();
+    updateMainStreamTimeline();
 }
 
 void VstSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
@@ -65,7 +65,7 @@ void VstSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
         m_dynamicEvents[pair.first].emplace(expressionLevel(pair.second));
     }
 
-    updateDynamicChangesIterator();
+    updateMainStreamTimeline();
 }
 
 audio::gain_t VstSequencer::currentGain() const
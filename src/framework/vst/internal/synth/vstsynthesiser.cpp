@@ -21,6 +21,8 @@
  */
 #include "vstsynthesiser.h"
 
+#include <algorithm>
+
 #include "log.h"
 
 #include "internal/vstplugin.h"
@@ -183,13 +185,17 @@ audio::samples_t VstSynthesiser::process(float* buffer, audio::samples_t samples
 
     audio::msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
 
-    const VstSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    const VstSequencer::EventSpan events = m_sequencer.eventsToBePlayed(nextMsecs);
+
+    //! NOTE The plugin gets the position of every event within the block
+    for (const VstSequencer::TimedEvent& timedEvent : events) {
+        const VstSequencer::EventType& event = timedEvent.event;
+        audio::samples_t sampleOffset = std::min(microSecsToSamples(events.offset(timedEvent), m_sampleRate), samplesPerChannel - 1);
 
-    for (const VstSequencer::EventType& event : sequence) {
         if (std::holds_alternative<VstEvent>(event)) {
-            m_vstAudioClient->handleEvent(std::get<VstEvent>(event));
+            m_vstAudioClient->handleEvent(std::get<VstEvent>(event), sampleOffset);
         } else if (std::holds_alternative<PluginParamInfo>(event)) {
-            m_vstAudioClient->handleParamChange(std::get<PluginParamInfo>(event));
+            m_vstAudioClient->handleParamChange(std::get<PluginParamInfo>(event), sampleOffset);
         } else {
             audio::gain_t newGain = std::get<audio::gain_t>(event);
             m_vstAudioClient->setVolumeGain(newGain);
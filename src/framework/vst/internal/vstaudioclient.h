@@ -37,8 +37,8 @@ public:
 
     void init(VstPluginType&& type, VstPluginPtr plugin, audio::audioch_t&& audioChannelsCount = 2);
 
-    bool handleEvent(const VstEvent& event);
-    bool handleParamChange(const PluginParamInfo& param);
+    bool handleEvent(const VstEvent& event, const audio::samples_t sampleOffset = 0);
+    bool handleParamChange(const PluginParamInfo& param, const audio::samples_t sampleOffset = 0);
     void setVolumeGain(const audio::gain_t newVolumeGain);
 
     audio::samples_t process(float* output, audio::samples_t samplesPerChannel);
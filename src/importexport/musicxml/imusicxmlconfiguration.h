@@ -39,6 +39,10 @@ public:
     virtual bool musicxmlImportLayout() const = 0;
     virtual void setMusicxmlImportLayout(bool value) = 0;
 
+    //! NOTE Validation against the MusicXML schema, might be turned off for the trusted sources
+    virtual bool musicxmlImportValidation() const = 0;
+    virtual void setMusicxmlImportValidation(bool value) = 0;
+
     virtual bool musicxmlExportLayout() const = 0;
     virtual void setMusicxmlExportLayout(bool value) = 0;
 
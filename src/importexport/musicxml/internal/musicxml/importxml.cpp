@@ -30,12 +30,20 @@
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
 
+#include <future>
+#include <memory>
+#include <mutex>
+
 #include "importmxml.h"
 #include "musicxmlsupport.h"
 
 #include "translation.h"
 
+#include "concurrency/taskscheduler.h"
 #include "global/deprecated/qzipreader_p.h"
+#include "modularity/ioc.h"
+
+#include "importexport/musicxml/imusicxmlconfiguration.h"
 
 #include "engraving/types/types.h"
 
@@ -43,6 +51,17 @@
 
 #include "log.h"
 
+static std::shared_ptr<mu::iex::musicxml::IMusicXmlConfiguration> configuration()
+{
+    return mu::modularity::ioc()->resolve<mu::iex::musicxml::IMusicXmlConfiguration>("iex_musicxml");
+}
+
+static bool musicxmlImportValidation()
+{
+    auto conf = configuration();
+    return conf ? conf->musicxmlImportValidation() : true;
+}
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   check assertions for tuplet handling
@@ -104,6 +123,69 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     return true;
 }
 
+//---------------------------------------------------------
+//   validationThread
+//    QXmlSchema owns a QNetworkAccessManager bound to the thread
+//    that created it, so the schema is compiled, used and destroyed
+//    on one thread kept for the validations.
+//    The thread is stopped by deinitMusicXmlValidation(),
+//    on the deinit of the module, before the application exits
+//---------------------------------------------------------
+
+static std::mutex s_validationThreadMutex;
+static std::unique_ptr<TaskScheduler> s_validationThread;
+
+static TaskScheduler* validationThread()
+{
+    std::lock_guard<std::mutex> lock(s_validationThreadMutex);
+    if (!s_validationThread) {
+        s_validationThread = std::make_unique<TaskScheduler>(1);
+    }
+
+    return s_validationThread.get();
+}
+
+void deinitMusicXmlValidation()
+{
+    std::unique_ptr<TaskScheduler> thread;
+    {
+        std::lock_guard<std::mutex> lock(s_validationThreadMutex);
+        thread = std::move(s_validationThread);
+    }
+
+    // waits for the validations and destroys the schema on its thread
+    thread.reset();
+}
+
+//---------------------------------------------------------
+//   musicXmlSchema
+//    the schema compiled on the first validation,
+//    nullptr on error
+//---------------------------------------------------------
+
+struct MusicXmlSchema {
+    ValidatorMessageHandler messageHandler;     // the errors of the schema itself
+    QXmlSchema schema;
+};
+
+static const QXmlSchema* musicXmlSchema()
+{
+    thread_local std::unique_ptr<MusicXmlSchema> s_schema;
+
+    if (!s_schema) {
+        std::unique_ptr<MusicXmlSchema> schema = std::make_unique<MusicXmlSchema>();
+        schema->schema.setMessageHandler(&schema->messageHandler);
+        if (!initMusicXmlSchema(schema->schema)) {
+            LOGE() << "MusicXML schema errors: " << schema->messageHandler.getErrors();
+            return nullptr;
+        }
+
+        s_schema = std::move(schema);
+    }
+
+    return &s_schema->schema;
+}
+
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
 //---------------------------------------------------------
@@ -181,43 +263,66 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
     return true;
 }
 
+//---------------------------------------------------------
+//   MusicXmlValidation
+//---------------------------------------------------------
+
+struct MusicXmlValidation {
+    Err err = Err::NoError;
+    bool valid = true;
+    QString errors;
+};
+
 //---------------------------------------------------------
 //   doValidate
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML \a data from file \a name.
+ Must be called on the validation thread, see validationThread().
  */
 
-static Err doValidate(const QString& name, QIODevice* dev)
+static MusicXmlValidation doValidate(const QString& name, const QByteArray& data)
 {
-    //QElapsedTimer t;
-    //t.start();
+    MusicXmlValidation result;
 
-    // initialize the schema
-    ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
-        return Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
+    const QXmlSchema* schema = musicXmlSchema();
+    if (!schema) {
+        result.err = Err::FileBadFormat;      // appropriate error message has been printed by musicXmlSchema
+        return result;
     }
+
     // validate the data
-    QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-    //LOGD("Validation time elapsed: %d ms", t.elapsed());
+    ValidatorMessageHandler messageHandler;
+    QXmlSchemaValidator validator(*schema);
+    validator.setMessageHandler(&messageHandler);
+    result.valid = validator.validate(data, QUrl::fromLocalFile(name));
+    result.errors = messageHandler.getErrors();
 
-    if (!valid) {
-        LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
-        QString strErr = qtrc("iex_musicxml", "File '%1' is not a valid MusicXML file.").arg(name);
-        if (MScore::noGui) {
-            return Err::NoError;         // might as well try anyhow in converter mode
-        }
-        if (musicXMLValidationErrorDialog(strErr, messageHandler.getErrors()) != QMessageBox::Yes) {
-            return Err::UserAbort;
-        }
-    }
+    return result;
+}
+
+static std::future<MusicXmlValidation> startValidation(const QString& name, const QByteArray& data)
+{
+    return validationThread()->submit([name, data]() {
+        return doValidate(name, data);
+    });
+}
+
+//---------------------------------------------------------
+//   validateMusicXml
+//    return true if valid
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML \a data from file \a name, the errors are returned in \a errors.
+ */
 
-    return Err::NoError;
+bool validateMusicXml(const QString& name, const QByteArray& data, QString& errors)
+{
+    const MusicXmlValidation result = startValidation(name, data).get();
+    errors = result.errors;
+    return result.err == Err::NoError && result.valid;
 }
 
 //---------------------------------------------------------
@@ -230,15 +335,40 @@ static Err doValidate(const QString& name, QIODevice* dev)
 
 static Err doValidateAndImport(Score* score, const QString& name, QIODevice* dev)
 {
-    // validate the file
-    Err res = doValidate(name, dev);
-    if (res != Err::NoError) {
-        return res;
+    if (!musicxmlImportValidation()) {
+        return importMusicXMLfromBuffer(score, name, dev);
     }
 
+    //! NOTE The validation doesn't affect the import, so it runs on the validation thread
+    //! at the same time as the parser passes and its result is checked at the end
+    dev->seek(0);
+    const QByteArray data = dev->readAll();
+    std::future<MusicXmlValidation> validation = startValidation(name, data);
+
     // actually do the import
-    res = importMusicXMLfromBuffer(score, name, dev);
+    Err res = importMusicXMLfromBuffer(score, name, dev);
     //LOGD("res %d", static_cast<int>(res));
+
+    const MusicXmlValidation result = validation.get();
+    if (result.err != Err::NoError) {
+        return result.err;
+    }
+
+    if (res != Err::NoError) {
+        return res;
+    }
+
+    if (!result.valid) {
+        LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
+        QString strErr = qtrc("iex_musicxml", "File '%1' is not a valid MusicXML file.").arg(name);
+        if (MScore::noGui) {
+            return Err::NoError;         // might as well try anyhow in converter mode
+        }
+        if (musicXMLValidationErrorDialog(strErr, result.errors) != QMessageBox::Yes) {
+            return Err::UserAbort;
+        }
+    }
+
     return res;
 }
 
@@ -66,6 +66,16 @@ void MusicXmlConfiguration::setMusicxmlImportLayout(bool value)
     settings()->setSharedValue(MUSICXML_IMPORT_LAYOUT_KEY, Val(value));
 }
 
+bool MusicXmlConfiguration::musicxmlImportValidation() const
+{
+    return m_importValidation;
+}
+
+void MusicXmlConfiguration::setMusicxmlImportValidation(bool value)
+{
+    m_importValidation = value;
+}
+
 bool MusicXmlConfiguration::musicxmlExportLayout() const
 {
     return settings()->value(MUSICXML_EXPORT_LAYOUT_KEY).toBool();
@@ -36,6 +36,9 @@ public:
     bool musicxmlImportLayout() const override;
     void setMusicxmlImportLayout(bool value) override;
 
+    bool musicxmlImportValidation() const override;
+    void setMusicxmlImportValidation(bool value) override;
+
     bool musicxmlExportLayout() const override;
     void setMusicxmlExportLayout(bool value) override;
 
@@ -50,6 +53,9 @@ public:
 
     bool needAskAboutApplyingNewStyle() const override;
     void setNeedAskAboutApplyingNewStyle(bool value) override;
+
+private:
+    bool m_importValidation = true;
 };
 }
 
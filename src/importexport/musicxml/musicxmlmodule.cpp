@@ -34,6 +34,10 @@
 
 #include "internal/musicxmlconfiguration.h"
 
+namespace mu::engraving {
+extern void deinitMusicXmlValidation();
+}
+
 using namespace mu::iex::musicxml;
 using namespace mu::project;
 
@@ -74,3 +78,8 @@ void MusicXmlModule::resolveImports()
         writers->reg({ "mxl" }, std::make_shared<MxlWriter>());
     }
 }
+
+void MusicXmlModule::onDeinit()
+{
+    engraving::deinitMusicXmlValidation();
+}
@@ -33,6 +33,7 @@ public:
     void registerResources() override;
     void registerExports() override;
     void resolveImports() override;
+    void onDeinit() override;
 };
 }
 
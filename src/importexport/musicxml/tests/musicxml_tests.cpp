@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <QFile>
+
 #include "engraving/engravingerrors.h"
 #include "engraving/libmscore/masterscore.h"
 
@@ -33,6 +35,7 @@
 #include "engraving/tests/utils/scorecomp.h"
 
 #include "io/fileinfo.h"
+#include "modularity/ioc.h"
 
 using namespace mu;
 using namespace mu::framework;
@@ -43,6 +46,7 @@ namespace mu::engraving {
 extern bool saveMxl(Score*, const QString&);
 extern engraving::Err importMusicXml(MasterScore*, const QString&);
 extern engraving::Err importCompressedMusicXml(MasterScore*, const QString&);
+extern bool validateMusicXml(const QString&, const QByteArray&, QString&);
 }
 
 static const String XML_IO_DATA_DIR("data/");
@@ -898,6 +902,28 @@ TEST_F(Musicxml_Tests, unnecessaryBarlines) {
 TEST_F(Musicxml_Tests, unusualDurations) {
     mxmlIoTestRef("testUnusualDurations");
 }
+TEST_F(Musicxml_Tests, validation) {
+    //! GIVEN the validation is on
+    auto configuration = modularity::ioc()->resolve<IMusicXmlConfiguration>("tests");
+    ASSERT_TRUE(configuration);
+    configuration->setMusicxmlImportValidation(true);
+
+    //! CHECK a valid file passes the validation
+    QFile file((ScoreRW::rootPath() + u"/" + XML_IO_DATA_DIR + u"testHello.xml").toQString());
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QString errors;
+    EXPECT_TRUE(validateMusicXml(file.fileName(), file.readAll(), errors));
+    EXPECT_TRUE(errors.isEmpty());
+
+    //! CHECK a file without the part list doesn't pass
+    const QByteArray invalid = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                               "<score-partwise version=\"3.1\"><part id=\"P1\"/></score-partwise>\n";
+    EXPECT_FALSE(validateMusicXml("invalid.xml", invalid, errors));
+    EXPECT_FALSE(errors.isEmpty());
+
+    //! CHECK the validated import gives the same score
+    mxmlIoTest("testHello");
+}
 TEST_F(Musicxml_Tests, virtualInstruments) {
     mxmlIoTestRef("testVirtualInstruments");
 }
@@ -37,6 +37,11 @@ public:
     virtual bool isCustom() const = 0;
     virtual bool isEmpty() const = 0;
 
+    //! NOTE The excerpts read from the file might stay unloaded until they are opened, exported or painted,
+    //! the score of an unloaded excerpt is an empty placeholder
+    virtual bool isLoaded() const = 0;
+    virtual void ensureLoaded() = 0;
+
     virtual QString name() const = 0;
     virtual void setName(const QString& name) = 0;
     virtual async::Notification nameChanged() const = 0;
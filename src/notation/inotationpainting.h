@@ -43,6 +43,19 @@ public:
     virtual SizeF pageSizeInch() const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+
+    //! NOTE The parts of paintView() for the cached painting of the view (tiles).
+    //! paintViewElements() is called for every missing tile after prepareViewElements(), on the main thread
+    virtual void paintViewPageSheets(draw::Painter* painter, const RectF& frameRect) = 0;
+    virtual void prepareViewElements() = 0;
+    virtual void paintViewElements(draw::Painter* painter, const RectF& frameRect) = 0;
+    virtual void paintViewOverlays(draw::Painter* painter) = 0;
+
+    //! NOTE The area changed by the last update of the notation, only its tiles are painted again.
+    //! Everything is changed if the systems are moved, e.g. after the full relayout
+    virtual RectF changedArea() const = 0;
+    virtual bool isAllChanged() const = 0;
+
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
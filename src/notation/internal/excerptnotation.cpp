@@ -23,6 +23,7 @@
 #include "excerptnotation.h"
 
 #include "libmscore/excerpt.h"
+#include "libmscore/score.h"
 #include "libmscore/text.h"
 
 #include "log.h"
@@ -63,7 +64,43 @@ bool ExcerptNotation::isCustom() const
 
 bool ExcerptNotation::isEmpty() const
 {
-    return m_excerpt->parts().empty();
+    return m_excerpt->isLoaded() && m_excerpt->parts().empty();
+}
+
+bool ExcerptNotation::isLoaded() const
+{
+    return m_excerpt->isLoaded();
+}
+
+void ExcerptNotation::ensureLoaded()
+{
+    if (m_excerpt->isLoaded()) {
+        return;
+    }
+
+    m_excerpt->load();
+
+    //! NOTE The open parts are laid out together with the master score,
+    //! the others on their opening (see MasterNotation::setExcerptIsOpen)
+    mu::engraving::Score* score = m_excerpt->excerptScore();
+    if (score->isOpen()) {
+        score->doLayout();
+    }
+}
+
+bool ExcerptNotation::isOpen() const
+{
+    //! NOTE Is known before the excerpt is loaded
+    return m_excerpt->excerptScore()->isOpen();
+}
+
+void ExcerptNotation::setIsOpen(bool open)
+{
+    if (open) {
+        ensureLoaded();
+    }
+
+    Notation::setIsOpen(open);
 }
 
 void ExcerptNotation::fillWithDefaultInfo()
@@ -140,6 +177,9 @@ INotationPtr ExcerptNotation::notation()
 
 IExcerptNotationPtr ExcerptNotation::clone() const
 {
+    //! NOTE The score of an unloaded excerpt is only a placeholder
+    m_excerpt->load();
+
     mu::engraving::Excerpt* copy = new mu::engraving::Excerpt(*m_excerpt);
     return std::make_shared<ExcerptNotation>(copy);
 }
@@ -41,6 +41,12 @@ public:
     bool isCustom() const override;
     bool isEmpty() const override;
 
+    bool isLoaded() const override;
+    void ensureLoaded() override;
+
+    bool isOpen() const override;
+    void setIsOpen(bool open) override;
+
     QString name() const override;
     void setName(const QString& name) override;
     async::Notification nameChanged() const override;
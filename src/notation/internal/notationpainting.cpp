@@ -180,7 +180,7 @@ void NotationPainting::paintPageSheet(Painter* painter, const RectF& pageRect, c
     }
 }
 
-void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+NotationPainting::Options NotationPainting::viewOptions(const RectF& frameRect, bool isPrinting) const
 {
     Options opt;
     opt.isSetViewport = false;
@@ -188,7 +188,90 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.frameRect = frameRect;
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
-    doPaint(painter, opt);
+    return opt;
+}
+
+void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+{
+    doPaint(painter, viewOptions(frameRect, isPrinting));
+}
+
+void NotationPainting::paintViewPageSheets(Painter* painter, const RectF& frameRect)
+{
+    if (!score()) {
+        return;
+    }
+
+    for (const mu::engraving::Page* page : score()->pages()) {
+        const PointF pagePos = page->pos();
+        const RectF pageRect = page->bbox();
+        if (!pageRect.translated(pagePos).intersects(frameRect)) {
+            continue;
+        }
+
+        const RectF pageContentRect = pageRect.adjusted(page->lm(), page->tm(), -page->rm(), -page->bm());
+
+        painter->translate(pagePos);
+        paintPageSheet(painter, pageRect, pageContentRect, page->isOdd(), true);
+        painter->translate(-pagePos);
+    }
+}
+
+void NotationPainting::prepareViewElements()
+{
+    if (!score()) {
+        return;
+    }
+
+    Options opt = viewOptions(RectF(), false);
+    engraving::Paint::prepareScore(score(), opt);
+    m_viewElementsDpi = opt.deviceDpi;
+}
+
+void NotationPainting::paintViewElements(Painter* painter, const RectF& frameRect)
+{
+    if (!score()) {
+        return;
+    }
+
+    IF_ASSERT_FAILED(m_viewElementsDpi > 0) {
+        return;
+    }
+
+    //! NOTE Same as viewOptions(), but the configuration is read once for all the tiles
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = true;
+    opt.frameRect = frameRect;
+    opt.deviceDpi = m_viewElementsDpi;
+
+    //! NOTE The page sheets are painted by paintViewPageSheets()
+    opt.onPaintPageSheet = [](draw::Painter*, const RectF&, const RectF&, bool) {};
+
+    engraving::Paint::paintScore(painter, score(), opt);
+}
+
+void NotationPainting::paintViewOverlays(Painter* painter)
+{
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+}
+
+RectF NotationPainting::changedArea() const
+{
+    if (!score()) {
+        return RectF();
+    }
+
+    return score()->changedArea();
+}
+
+bool NotationPainting::isAllChanged() const
+{
+    if (!score()) {
+        return true;
+    }
+
+    return score()->isAllChanged();
 }
 
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
@@ -53,6 +53,12 @@ public:
     SizeF pageSizeInch() const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewPageSheets(draw::Painter* painter, const RectF& frameRect) override;
+    void prepareViewElements() override;
+    void paintViewElements(draw::Painter* painter, const RectF& frameRect) override;
+    void paintViewOverlays(draw::Painter* painter) override;
+    RectF changedArea() const override;
+    bool isAllChanged() const override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
@@ -60,6 +66,8 @@ public:
 private:
     mu::engraving::Score* score() const;
 
+    Options viewOptions(const RectF& frameRect, bool isPrinting) const;
+
     bool isPaintPageBorder() const;
     void doPaint(draw::Painter* painter, const Options& opt);
     void paintPageBorder(draw::Painter* painter, const mu::engraving::Page* page) const;
@@ -67,6 +75,7 @@ private:
                         bool printPageBackground) const;
 
     Notation* m_notation = nullptr;
+    int m_viewElementsDpi = -1;
 };
 }
 
@@ -22,6 +22,8 @@
 
 #include "notationundostack.h"
 
+#include "async/async.h"
+#include "translation.h"
 #include "log.h"
 
 #include "libmscore/masterscore.h"
@@ -29,10 +31,22 @@
 
 using namespace mu::notation;
 using namespace mu::async;
+using namespace mu::framework;
+
+static const std::string UNDO_HISTORY_DROPPED_KEY("UNDO_HISTORY_DROPPED");
 
 NotationUndoStack::NotationUndoStack(IGetScore* getScore, Notification notationChanged)
     : m_getScore(getScore), m_notationChanged(notationChanged)
 {
+    if (!engravingConfiguration()) {
+        return;
+    }
+
+    engravingConfiguration()->undoHistoryMemoryLimitChanged().onReceive(this, [this](size_t bytes) {
+        if (undoStack()) {
+            undoStack()->setMemoryLimit(bytes);
+        }
+    });
 }
 
 bool NotationUndoStack::canUndo() const
@@ -128,9 +142,15 @@ void NotationUndoStack::commitChanges()
         return;
     }
 
+    const size_t droppedCount = undoStack()->droppedMacrosCount();
+
     score()->endCmd();
     masterScore()->setSaved(isStackClean());
 
+    if (undoStack()->droppedMacrosCount() != droppedCount) {
+        showHistoryDroppedMessage();
+    }
+
     notifyAboutStateChanged();
 }
 
@@ -202,6 +222,29 @@ void NotationUndoStack::notifyAboutRedo()
     m_redoNotification.notify();
 }
 
+void NotationUndoStack::showHistoryDroppedMessage()
+{
+    //! NOTE Shown once per score, the oldest history keeps being dropped while the score is edited
+    if (m_historyDroppedShown || !configuration() || !configuration()->needToShowMScoreError(UNDO_HISTORY_DROPPED_KEY)) {
+        return;
+    }
+
+    m_historyDroppedShown = true;
+
+    //! NOTE Not from inside the command, the dialog runs its own event loop
+    Async::call(this, [this]() {
+        std::string title = trc("notation", "The oldest changes can no longer be undone");
+        std::string message = trc("notation", "The undo history has reached its memory limit, "
+                                              "so the oldest changes were removed from it.");
+
+        IInteractive::Result result
+            = interactive()->info(title, message, {}, 0, IInteractive::Option::WithIcon | IInteractive::Option::WithDontShowAgainCheckBox);
+        if (!result.showAgain()) {
+            configuration()->setNeedToShowMScoreError(UNDO_HISTORY_DROPPED_KEY, false);
+        }
+    });
+}
+
 bool NotationUndoStack::isStackClean() const
 {
     IF_ASSERT_FAILED(undoStack()) {
@@ -23,8 +23,14 @@
 #ifndef MU_NOTATION_UNDOSTACK
 #define MU_NOTATION_UNDOSTACK
 
+#include "async/asyncable.h"
+#include "modularity/ioc.h"
+#include "iinteractive.h"
+#include "iengravingconfiguration.h"
+
 #include "inotationundostack.h"
 #include "igetscore.h"
+#include "../inotationconfiguration.h"
 
 namespace mu::engraving {
 class Score;
@@ -34,8 +40,12 @@ class EditData;
 }
 
 namespace mu::notation {
-class NotationUndoStack : public INotationUndoStack
+class NotationUndoStack : public INotationUndoStack, public async::Asyncable
 {
+    INJECT(notation, INotationConfiguration, configuration)
+    INJECT(notation, engraving::IEngravingConfiguration, engravingConfiguration)
+    INJECT(notation, framework::IInteractive, interactive)
+
 public:
     NotationUndoStack(IGetScore* getScore, async::Notification notationChanged);
 
@@ -65,12 +75,14 @@ private:
     void notifyAboutRedo();
 
     bool isStackClean() const;
+    void showHistoryDroppedMessage();
 
     mu::engraving::Score* score() const;
     mu::engraving::MasterScore* masterScore() const;
     mu::engraving::UndoStack* undoStack() const;
 
     IGetScore* m_getScore = nullptr;
+    bool m_historyDroppedShown = false;
 
     async::Notification m_notationChanged;
     async::Notification m_stackStateChanged;
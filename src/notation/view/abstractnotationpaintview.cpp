@@ -232,6 +232,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
+        invalidateTileCacheByChangedArea();
         update();
     });
 
@@ -241,9 +242,19 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        invalidateTileCacheBySelection();
         update();
     });
 
+    //! NOTE The dragged and the edited elements are changed without notationChanged
+    interaction->dragChanged().onNotify(this, [this]() {
+        clearTileCache();
+    });
+
+    interaction->textEditingChanged().onNotify(this, [this]() {
+        clearTileCache();
+    });
+
     interaction->showItemRequested().onReceive(this, [this](const INotationInteraction::ShowItemRequest& request) {
         onShowItemRequested(request);
     });
@@ -255,6 +266,8 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->dropChanged().onNotify(this, [this]() {
+        clearTileCache();
+
         if (!hasActiveFocus()) {
             forceFocusIn(); // grab keyboard focus after element added from palette
         }
@@ -302,6 +315,11 @@ void AbstractNotationPaintView::onUnloadNotation(INotationPtr)
     INotationInteractionPtr interaction = m_notation->interaction();
     interaction->noteInput()->stateChanged().resetOnNotify(this);
     interaction->selectionChanged().resetOnNotify(this);
+    interaction->dragChanged().resetOnNotify(this);
+    interaction->textEditingChanged().resetOnNotify(this);
+    interaction->dropChanged().resetOnNotify(this);
+
+    clearTileCache();
 
     if (isMainView()) {
         m_notation->accessibility()->setMapToScreenFunc(nullptr);
@@ -511,7 +529,12 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     painter->setWorldTransform(m_matrix * guiScalingCompensation);
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    if (canPaintWithTileCache(painter, isPrinting)) {
+        paintWithTileCache(qp, painter, rect);
+    } else {
+        clearTileCache();
+        notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -547,18 +570,99 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        clearTileCache();
         update();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        clearTileCache();
         update();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        clearTileCache();
         update();
     });
 }
 
+bool AbstractNotationPaintView::canPaintWithTileCache(const draw::Painter* painter, bool isPrinting) const
+{
+    if (isPrinting) {
+        return false;
+    }
+
+    if (!NotationTileCache::isTransformSupported(painter->worldTransform())) {
+        return false;
+    }
+
+    //! NOTE The elements are changed on every frame, the tiles would be repainted anyway
+    INotationInteractionPtr interaction = notationInteraction();
+    if (interaction->isDragStarted() || interaction->isElementEditStarted() || interaction->isTextEditingStarted()) {
+        return false;
+    }
+
+    return true;
+}
+
+void AbstractNotationPaintView::paintWithTileCache(QPainter* qp, draw::Painter* painter, const RectF& rect)
+{
+    TRACEFUNC;
+
+    INotationPaintingPtr painting = notation()->painting();
+    const RectF logicalRect = toLogical(rect);
+
+    painting->paintViewPageSheets(painter, logicalRect);
+    painting->prepareViewElements();
+
+    m_tileCache.paint(qp, painter->worldTransform(), rect, [painting](draw::Painter* tilePainter, const RectF& tileRect) {
+        painting->paintViewElements(tilePainter, tileRect);
+    });
+
+    painting->paintViewOverlays(painter);
+}
+
+void AbstractNotationPaintView::invalidateTileCacheBySelection()
+{
+    //! NOTE The selected elements are painted by another color,
+    //! so the tiles of both the previous and the new selection are repainted
+    for (const RectF& rect : m_selectionRects) {
+        m_tileCache.invalidate(rect);
+    }
+
+    m_selectionRects.clear();
+
+    INotationSelectionPtr selection = notationSelection();
+    if (!selection) {
+        return;
+    }
+
+    for (const EngravingItem* element : selection->elements()) {
+        const RectF rect = element->canvasBoundingRect();
+        m_tileCache.invalidate(rect);
+        m_selectionRects.push_back(rect);
+    }
+}
+
+void AbstractNotationPaintView::invalidateTileCacheByChangedArea()
+{
+    INotationPaintingPtr painting = m_notation->painting();
+    if (painting->isAllChanged()) {
+        clearTileCache();
+        return;
+    }
+
+    m_tileCache.invalidate(painting->changedArea());
+
+    //! NOTE The selection may be changed by the same command
+    invalidateTileCacheBySelection();
+}
+
+void AbstractNotationPaintView::clearTileCache()
+{
+    m_tileCache.clear();
+    m_selectionRects.clear();
+}
+
 void AbstractNotationPaintView::paintBackground(const RectF& rect, draw::Painter* painter)
 {
     TRACEFUNC;
@@ -45,6 +45,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class AbstractNotationPaintView : public uicomponents::QuickPaintedView, public IControlledView, public async::Asyncable,
@@ -231,6 +232,12 @@ private:
 
     void paintBackground(const RectF& rect, draw::Painter* painter);
 
+    bool canPaintWithTileCache(const draw::Painter* painter, bool isPrinting) const;
+    void paintWithTileCache(QPainter* qp, draw::Painter* painter, const RectF& rect);
+    void invalidateTileCacheBySelection();
+    void invalidateTileCacheByChangedArea();
+    void clearTileCache();
+
     PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
 
@@ -244,6 +251,9 @@ private:
     std::unique_ptr<LoopMarker> m_loopOutMarker;
     std::unique_ptr<ContinuousPanel> m_continuousPanel;
 
+    NotationTileCache m_tileCache;
+    std::vector<RectF> m_selectionRects;
+
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
 
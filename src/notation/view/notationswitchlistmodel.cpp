@@ -238,6 +238,14 @@ void NotationSwitchListModel::setCurrentNotation(int index)
         return;
     }
 
+    //! NOTE The open parts read from the file are loaded when they are painted for the first time
+    for (IExcerptNotationPtr excerpt : currentMasterNotation()->excerpts().val) {
+        if (excerpt->notation() == m_notations[index]) {
+            excerpt->ensureLoaded();
+            break;
+        }
+    }
+
     context()->setCurrentNotation(m_notations[index]);
 }
 
@@ -254,7 +262,7 @@ void NotationSwitchListModel::closeNotation(int index)
     } else {
         if (notation == currentNotation()) {
             // Set new current notation
-            context()->setCurrentNotation(m_notations[std::max(0, index - 1)]);
+            setCurrentNotation(std::max(0, index - 1));
         }
         currentMasterNotation()->setExcerptIsOpen(notation, false);
     }
@@ -267,7 +275,7 @@ void NotationSwitchListModel::closeOtherNotations(int index)
     }
 
     INotationPtr notationToKeepOpen = m_notations[index];
-    context()->setCurrentNotation(notationToKeepOpen);
+    setCurrentNotation(index);
 
     for (INotationPtr notation : m_notations) {
         if (!isMasterNotation(notation) && notation != notationToKeepOpen) {
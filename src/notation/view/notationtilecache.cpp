@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QPainter>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::notation;
+
+bool NotationTileCache::isTransformSupported(const Transform& transform)
+{
+    return transform.m12() == 0.0 && transform.m21() == 0.0
+           && transform.m11() > 0.0 && transform.m11() == transform.m22();
+}
+
+void NotationTileCache::paint(QPainter* painter, const Transform& transform, const RectF& viewRect, const PaintFunc& paintFunc)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(isTransformSupported(transform)) {
+        return;
+    }
+
+    ++m_frame;
+
+    const double devicePixelRatio = painter->device()->devicePixelRatioF();
+    const double deviceScale = transform.m11() * devicePixelRatio;
+    const double tileLogicalSize = TILE_SIZE / deviceScale;
+
+    const RectF logicalRect = transform.inverted().map(viewRect);
+    const int column1 = static_cast<int>(std::floor(logicalRect.left() / tileLogicalSize));
+    const int column2 = static_cast<int>(std::floor(logicalRect.right() / tileLogicalSize));
+    const int row1 = static_cast<int>(std::floor(logicalRect.top() / tileLogicalSize));
+    const int row2 = static_cast<int>(std::floor(logicalRect.bottom() / tileLogicalSize));
+
+    std::vector<TileKey> visibleKeys;
+    std::vector<TileKey> missingKeys;
+
+    for (int row = row1; row <= row2; ++row) {
+        for (int column = column1; column <= column2; ++column) {
+            TileKey key { deviceScale, column, row };
+            visibleKeys.push_back(key);
+
+            if (m_tiles.find(key) == m_tiles.end()) {
+                missingKeys.push_back(key);
+            }
+        }
+    }
+
+    // Paint missing tiles
+    for (const TileKey& key : missingKeys) {
+        Tile& tile = m_tiles[key];
+        tile.image = paintTile(key, devicePixelRatio, paintFunc);
+        tile.logicalRect = tileLogicalRect(key);
+    }
+
+    // Blit
+    //! NOTE The tiles are placed on the device pixel grid,
+    //! the neighbours are exactly TILE_SIZE device pixels apart, so there are no gaps between them
+    painter->save();
+    painter->resetTransform();
+
+    for (const TileKey& key : visibleKeys) {
+        Tile& tile = m_tiles[key];
+        tile.lastUsedFrame = m_frame;
+
+        const PointF pos = transform.map(tile.logicalRect.topLeft());
+        const QPointF devicePos(std::round(pos.x() * devicePixelRatio) / devicePixelRatio,
+                                std::round(pos.y() * devicePixelRatio) / devicePixelRatio);
+
+        painter->drawImage(devicePos, tile.image);
+    }
+
+    painter->restore();
+
+    removeLeastRecentlyUsed();
+}
+
+void NotationTileCache::invalidate(const RectF& logicalRect)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->second.logicalRect.intersects(logicalRect)) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::clear()
+{
+    m_tiles.clear();
+}
+
+RectF NotationTileCache::tileLogicalRect(const TileKey& key)
+{
+    const double tileLogicalSize = TILE_SIZE / key.deviceScale;
+    return RectF(key.column * tileLogicalSize, key.row * tileLogicalSize, tileLogicalSize, tileLogicalSize);
+}
+
+QImage NotationTileCache::paintTile(const TileKey& key, double devicePixelRatio, const PaintFunc& paintFunc)
+{
+    QImage image(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    const RectF logicalRect = tileLogicalRect(key);
+    const double scale = key.deviceScale / devicePixelRatio;
+
+    Painter painter(&image, "notationtile");
+    painter.setWorldTransform(Transform(scale, 0.0, 0.0, scale, -logicalRect.left() * scale, -logicalRect.top() * scale));
+    paintFunc(&painter, logicalRect);
+    painter.endDraw();
+
+    return image;
+}
+
+//! NOTE Keeps the tiles of the last frame even if there are more of them than MAX_TILES_COUNT
+void NotationTileCache::removeLeastRecentlyUsed()
+{
+    if (m_tiles.size() <= MAX_TILES_COUNT) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, TileKey> > usage;
+    usage.reserve(m_tiles.size());
+    for (const auto& pair : m_tiles) {
+        if (pair.second.lastUsedFrame != m_frame) {
+            usage.emplace_back(pair.second.lastUsedFrame, pair.first);
+        }
+    }
+
+    const size_t removeCount = std::min(usage.size(), m_tiles.size() - MAX_TILES_COUNT);
+    std::partial_sort(usage.begin(), usage.begin() + removeCount, usage.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (size_t i = 0; i < removeCount; ++i) {
+        m_tiles.erase(usage[i].second);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+#include <map>
+
+#include <QImage>
+
+#include "draw/painter.h"
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Cache of the rasterised score for the notation view.
+//! The canvas is split into the square tiles of TILE_SIZE device pixels for every zoom level,
+//! so scrolling and the playback cursor moving only blit the tiles, which are already painted.
+//! The tiles are transparent outside of the painted elements, the page sheets are painted separately.
+class NotationTileCache
+{
+public:
+    using PaintFunc = std::function<void (draw::Painter* painter, const RectF& logicalRect)>;
+
+    static constexpr int TILE_SIZE = 256;
+    static constexpr size_t MAX_TILES_COUNT = 192;
+
+    //! NOTE Only the scaling and the translation are supported
+    static bool isTransformSupported(const draw::Transform& transform);
+
+    //! NOTE Paints the viewRect (view coordinates) with the tiles.
+    //! transform maps the logical (canvas) coordinates to the view coordinates.
+    //! The missing tiles are painted with paintFunc on the calling (main) thread:
+    //! EngravingItem::draw() is not thread-safe
+    void paint(QPainter* painter, const draw::Transform& transform, const RectF& viewRect, const PaintFunc& paintFunc);
+
+    //! NOTE Removes the tiles intersecting the rect (logical coordinates)
+    void invalidate(const RectF& logicalRect);
+    void clear();
+
+    size_t tilesCount() const { return m_tiles.size(); }
+
+private:
+    struct TileKey {
+        double deviceScale = 0.0;
+        int column = 0;
+        int row = 0;
+
+        bool operator<(const TileKey& other) const
+        {
+            if (deviceScale != other.deviceScale) {
+                return deviceScale < other.deviceScale;
+            }
+
+            if (row != other.row) {
+                return row < other.row;
+            }
+
+            return column < other.column;
+        }
+    };
+
+    struct Tile {
+        QImage image;
+        RectF logicalRect;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static RectF tileLogicalRect(const TileKey& key);
+    static QImage paintTile(const TileKey& key, double devicePixelRatio, const PaintFunc& paintFunc);
+
+    void removeLeastRecentlyUsed();
+
+    std::map<TileKey, Tile> m_tiles;
+    uint64_t m_frame = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -70,6 +70,8 @@ void PlaybackController::init()
     });
 
     globalContext()->currentProjectChanged().onNotify(this, [this]() {
+        m_loadingStartTime = std::chrono::steady_clock::now();
+
         if (m_currentSequenceId != -1) {
             resetCurrentSequence();
             return;
@@ -785,6 +787,19 @@ void PlaybackController::doAddTrack(const InstrumentTrackId& instrumentTrackId,
     m_loadingTracks.push_back(instrumentTrackId);
 }
 
+void PlaybackController::logTimeToPlayable()
+{
+    //! NOTE Only the first loading after opening a project is measured, not the tracks added later
+    if (m_loadingStartTime == std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_loadingStartTime);
+    m_loadingStartTime = std::chrono::steady_clock::time_point();
+
+    LOGI() << "time to playable: " << duration.count() << " ms";
+}
+
 void PlaybackController::setTrackActivity(const engraving::InstrumentTrackId& instrumentTrackId, const bool isActive)
 {
     IF_ASSERT_FAILED(audioSettings() && playback()) {
@@ -953,6 +968,8 @@ void PlaybackController::setupSequenceTracks()
         m_loadingProgress.progressChanged.send(current, trackCount, title);
 
         if (m_loadingTracks.empty()) {
+            logTimeToPlayable();
+
             m_loadingProgress.finished.send(make_ok());
             m_isPlayAllowedChanged.notify();
         }
@@ -26,6 +26,7 @@
 #include <QFile>
 
 #include "io/buffer.h"
+#include "async/async.h"
 
 #include "engraving/engravingproject.h"
 #include "engraving/compat/scoreaccess.h"
@@ -184,7 +185,8 @@ mu::Ret NotationProject::doLoad(engraving::MscReader& reader, const io::path_t&
     // Load engraving project
     m_engravingProject->setFileInfoProvider(std::make_shared<ProjectFileInfoProvider>(this));
 
-    engraving::Err err = m_engravingProject->loadMscz(reader, forceMode);
+    //! NOTE The parts are loaded on the first need, so the opening time doesn't depend on their count
+    engraving::Err err = m_engravingProject->loadMscz(reader, forceMode, true /*deferExcerptsLoading*/);
     if (err != engraving::Err::NoError) {
         return engraving::make_ret(err, reader.params().filePath);
     }
@@ -236,9 +238,38 @@ mu::Ret NotationProject::doLoad(engraving::MscReader& reader, const io::path_t&
         excerpt->notation()->viewState()->read(reader, u"Excerpts/" + excerpt->name() + u"/");
     }
 
+    if (configuration()->isPartsPrefetchEnabled()) {
+        async::Async::call(this, [this]() {
+            prefetchExcerpts();
+        });
+    }
+
     return make_ret(Ret::Code::Ok);
 }
 
+void NotationProject::prefetchExcerpts()
+{
+    //! NOTE The excerpts are linked to the master score, so they are loaded in the main thread,
+    //! one per event loop iteration, to not block the UI
+    if (!m_masterNotation) {
+        return;
+    }
+
+    for (IExcerptNotationPtr excerpt : m_masterNotation->excerpts().val) {
+        if (excerpt->isLoaded()) {
+            continue;
+        }
+
+        excerpt->ensureLoaded();
+
+        async::Async::call(this, [this]() {
+            prefetchExcerpts();
+        });
+
+        return;
+    }
+}
+
 mu::Ret NotationProject::doImport(const io::path_t& path, const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
@@ -97,6 +97,7 @@ private:
 
     Ret doLoad(engraving::MscReader& reader, const io::path_t& stylePath, bool forceMode);
     Ret doImport(const io::path_t& path, const io::path_t& stylePath, bool forceMode);
+    void prefetchExcerpts();
 
     Ret saveScore(const io::path_t& path, const std::string& fileSuffix);
     Ret saveSelectionOnScore(const io::path_t& path = io::path_t());
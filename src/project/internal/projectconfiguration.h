@@ -108,6 +108,9 @@ public:
     void setAutoSaveInterval(int minutes) override;
     async::Channel<int> autoSaveIntervalChanged() const override;
 
+    bool isPartsPrefetchEnabled() const override;
+    void setPartsPrefetchEnabled(bool enabled) override;
+
     io::path_t newProjectTemporaryPath() const override;
 
     bool isAccessibleEnabled() const override;
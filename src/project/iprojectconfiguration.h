@@ -106,6 +106,9 @@ public:
     virtual void setAutoSaveInterval(int minutes) = 0;
     virtual async::Channel<int> autoSaveIntervalChanged() const = 0;
 
+    virtual bool isPartsPrefetchEnabled() const = 0;
+    virtual void setPartsPrefetchEnabled(bool enabled) = 0;
+
     virtual io::path_t newProjectTemporaryPath() const = 0;
 
     virtual bool isAccessibleEnabled() const = 0;
@@ -90,6 +90,9 @@ public:
     MOCK_METHOD(void, setAutoSaveInterval, (int), (override));
     MOCK_METHOD(async::Channel<int>, autoSaveIntervalChanged, (), (const, override));
 
+    MOCK_METHOD(bool, isPartsPrefetchEnabled, (), (const, override));
+    MOCK_METHOD(void, setPartsPrefetchEnabled, (bool), (override));
+
     MOCK_METHOD(io::path_t, newProjectTemporaryPath, (), (const, override));
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
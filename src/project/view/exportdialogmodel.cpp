@@ -25,6 +25,7 @@
 #include <QItemSelectionModel>
 
 #include "async/async.h"
+#include "containers.h"
 #include "translation.h"
 #include "log.h"
 
@@ -322,6 +323,13 @@ bool ExportDialogModel::exportScores()
         return false;
     }
 
+    //! NOTE The parts read from the file might be unloaded yet
+    for (IExcerptNotationPtr excerpt : masterNotation()->excerpts().val) {
+        if (mu::contains(notations, excerpt->notation())) {
+            excerpt->ensureLoaded();
+        }
+    }
+
     RetVal<io::path_t> exportPath = exportProjectScenario()->askExportPath(notations, m_selectedExportType, m_selectedUnitType);
     if (!exportPath.ret) {
         return false;